@@ -9,6 +9,8 @@
 #include "device/CalibrationHandler.hpp"
 #include "device/Device.hpp"
 #include "device/DeviceBootloader.hpp"
+#include "device/DeviceManager.hpp"
+#include "device/FleetFlasher.hpp"
 
 // Include Pipeline
 #include "pipeline/Pipeline.hpp"
@@ -19,6 +21,15 @@
 // Include common datatypes
 #include "pipeline/datatypes.hpp"
 
+// Include host side processing
+#include "host/HostSpatialLocationCalculator.hpp"
+#include "host/HostSynchronizer.hpp"
+#include "host/HostGraph.hpp"
+#include "host/HostNode.hpp"
+#include "host/HostImageManip.hpp"
+#include "host/HostNNPreprocessor.hpp"
+#include "host/HostInferenceWindow.hpp"
+
 // namespace dai {
 // namespace{
 // bool initializeForce = [](){initialize();};
@@ -0,0 +1,176 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+
+namespace dai {
+
+/**
+ * Sizes output queues by observed producer and consumer rates and message sizes, within a host memory budget.
+ *
+ * A queue whose consumer keeps up only absorbs jitter and stays small, unless it fills up anyway (a consumer taking
+ * messages in bursts), in which case it grows up to 'targetLatency' worth of produced messages. A lagging consumer
+ * fills any queue, so its queue holds at most what the consumer drains within 'targetLatency', as more depth would
+ * only age the messages. If all queues together would exceed the budget, bytes are shared max-min fairly, so small
+ * metadata streams keep their size while large frame streams get what is left.
+ *
+ * Queues which stay full for several updates have a consumer which is persistently slower than the producer, and are
+ * switched to overwrite the oldest messages instead of blocking the device. They are switched back once the consumer
+ * catches up.
+ */
+class AdaptiveQueuePolicy {
+   public:
+    struct Config {
+        /// Total bytes all managed queues may hold
+        std::size_t memoryBudget = 512 * 1024 * 1024;
+        /// Time span of produced messages a queue should be able to hold
+        std::chrono::milliseconds targetLatency{500};
+        unsigned minSize = 2;
+        unsigned maxSize = 64;
+        /// Interval between updates, when run by the device
+        std::chrono::milliseconds period{500};
+        /// Number of consecutive updates a queue must be full, before it is switched to overwrite oldest
+        unsigned slowUpdates = 4;
+        /// Weight of the latest measurement in smoothed rates and message sizes
+        float smoothing = 0.3f;
+    };
+
+    /// State of a managed queue
+    struct QueueState {
+        QueueStats stats;
+        /// Messages per second pushed by the device
+        float producerRate = 0.0f;
+        /// Messages per second retrieved by the application
+        float consumerRate = 0.0f;
+        /// Average message size in bytes
+        float messageBytes = 0.0f;
+        /// Whether the policy switched the queue to overwrite oldest
+        bool overwriting = false;
+        std::uint64_t numAdjustments = 0;
+    };
+
+    /// Change made to a queue
+    struct Adjustment {
+        std::chrono::steady_clock::time_point time;
+        std::string queue;
+        unsigned previousMaxSize = 0;
+        unsigned maxSize = 0;
+        bool previousBlocking = true;
+        bool blocking = true;
+        std::string reason;
+    };
+
+    /// Queue managed by the policy, implemented for DataOutputQueue
+    class Queue {
+       public:
+        virtual ~Queue() = default;
+        virtual QueueStats getStats() const = 0;
+        virtual void setMaxSize(unsigned maxSize) = 0;
+        virtual void setBlocking(bool blocking) = 0;
+        virtual bool isClosed() const = 0;
+    };
+
+    AdaptiveQueuePolicy();
+    explicit AdaptiveQueuePolicy(Config config);
+
+    /**
+     * Starts managing a queue. Its size and blocking behavior are from then on set by the policy, except while its
+     * size is 0 (messages only passed to callbacks, e.g. by HostGraph), which is left as is
+     */
+    void addQueue(std::shared_ptr<DataOutputQueue> queue);
+    void addQueue(std::shared_ptr<Queue> queue);
+
+    /**
+     * Stops managing a queue. It keeps its last size and blocking behavior
+     *
+     * @returns True if the queue was managed, false otherwise
+     */
+    bool removeQueue(const std::shared_ptr<DataOutputQueue>& queue);
+    bool removeQueue(const std::shared_ptr<Queue>& queue);
+
+    /**
+     * Measures all queues and adjusts them. Called periodically by the device, or manually
+     */
+    void update();
+
+    /**
+     * Measures all queues as of the given time and adjusts them, e.g. to replay recorded or simulated stats
+     *
+     * @param now Time of the measurement, rates are over the time since the previous update
+     */
+    void update(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Gets state of all managed queues as of the last update
+     */
+    std::vector<QueueState> getStates() const;
+
+    /**
+     * Gets recent adjustments, oldest first
+     */
+    std::vector<Adjustment> getAdjustments() const;
+
+    /**
+     * Sets callback called on each adjustment, from the thread calling update
+     */
+    void setAdjustmentCallback(std::function<void(const Adjustment&)> callback);
+
+    /**
+     * Gets number of messages dropped by all managed queues
+     */
+    std::uint64_t getNumDropped() const;
+
+    /**
+     * Gets policy configuration
+     */
+    Config getConfig() const;
+
+    /**
+     * Divides a budget max-min fairly: demands below the fair share are met, the rest is split among larger ones
+     *
+     * @param demands Requested amount of each consumer
+     * @param budget Total amount available
+     * @returns Amount given to each consumer
+     */
+    static std::vector<double> shareBudget(const std::vector<double>& demands, double budget);
+
+   private:
+    struct Managed {
+        std::shared_ptr<Queue> queue;
+        // Identifies the managed queue, the DataOutputQueue itself if wrapped
+        const void* key = nullptr;
+        QueueState state;
+        bool userBlocking = true;
+        bool measured = false;
+        bool behind = false;
+        unsigned fullUpdates = 0;
+        unsigned caughtUpUpdates = 0;
+    };
+    static constexpr std::size_t MAX_ADJUSTMENTS = 256;
+    // Consumer rates within this fraction of the producer rate count as keeping up, as both are smoothed estimates
+    static constexpr float KEEPING_UP_RATIO = 0.95f;
+
+    const Config config;
+    mutable std::mutex mtx;
+    std::vector<Managed> queues;
+    std::chrono::steady_clock::time_point lastUpdate;
+    std::deque<Adjustment> adjustments;
+    std::function<void(const Adjustment&)> adjustmentCallback;
+
+    void addManaged(std::shared_ptr<Queue> queue, const void* key);
+    bool removeManaged(const void* key);
+    unsigned getDesiredSize(const Managed& managed) const;
+};
+
+}  // namespace dai
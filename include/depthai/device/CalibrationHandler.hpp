@@ -1,4 +1,5 @@
 #pragma once
+#include <memory>
 #include <string>
 #include <tuple>
 
@@ -6,6 +7,7 @@
 #include "depthai-shared/common/EepromData.hpp"
 #include "depthai-shared/common/Point2f.hpp"
 #include "depthai-shared/common/Size2f.hpp"
+#include "depthai/utility/Matrix.hpp"
 #include "depthai/utility/Path.hpp"
 
 namespace dai {
@@ -281,6 +283,35 @@ class CalibrationHandler {
      */
     std::vector<std::vector<float>> getImuToCameraExtrinsics(CameraBoardSocket cameraId, bool useSpecTranslation = false) const;
 
+    /**
+     * Same as getCameraExtrinsics, but returns a fixed size 4x4 matrix.
+     * Transformations between all cameras are precomputed once per loaded calibration, which makes this a constant time lookup.
+     *
+     * @param srcCamera Camera Id of the camera which will be considered as origin.
+     * @param dstCamera  Camera Id of the destination camera to which we are fetching the rotation and translation from the SrcCamera
+     * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @return a transformationMatrix which is 4x4 in homogeneous coordinate system
+     */
+    Matrix4f getCameraExtrinsicsMatrix(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
+
+    /**
+     * Same as getCameraToImuExtrinsics, but returns a fixed size 4x4 matrix from the precomputed transformation table.
+     *
+     * @param cameraId Camera Id of the camera which will be considered as origin. from which Transformation matrix to the IMU will be found
+     * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @return Returns a transformationMatrix which is 4x4 in homogeneous coordinate system
+     */
+    Matrix4f getCameraToImuExtrinsicsMatrix(CameraBoardSocket cameraId, bool useSpecTranslation = false) const;
+
+    /**
+     * Same as getImuToCameraExtrinsics, but returns a fixed size 4x4 matrix from the precomputed transformation table.
+     *
+     * @param cameraId Camera Id of the camera which will be considered as destination. To which Transformation matrix from the IMU will be found.
+     * @param useSpecTranslation Enabling this bool uses the translation information from the board design data
+     * @return Returns a transformationMatrix which is 4x4 in homogeneous coordinate system
+     */
+    Matrix4f getImuToCameraExtrinsicsMatrix(CameraBoardSocket cameraId, bool useSpecTranslation = false) const;
+
     /**
      *
      * Get the Stereo Right Rectification Rotation object
@@ -545,8 +576,12 @@ class CalibrationHandler {
      */
     // bool isCameraArrayConnected;
     dai::EepromData eepromData;
-    std::vector<std::vector<float>> computeExtrinsicMatrix(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation = false) const;
-    bool checkExtrinsicsLink(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera) const;
+
+    // All-pairs transformation table between cameras and IMU, built once per loaded calibration and rebuilt lazily after modifications.
+    struct ExtrinsicsTable;
+    mutable std::shared_ptr<const ExtrinsicsTable> extrinsicsTable;
+    std::shared_ptr<const ExtrinsicsTable> getExtrinsicsTable() const;
+    void invalidateExtrinsicsTable();
     bool checkSrcLinks(CameraBoardSocket headSocket) const;
 };
 
@@ -0,0 +1,109 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+
+namespace dai {
+
+/**
+ * Linear model mapping device clock to host steady clock, as estimated by ClockSyncEstimator
+ */
+struct ClockModel {
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /// Whether the model was estimated from any samples
+    bool valid = false;
+    /// Device time at which offset is given, center of the samples
+    TimePoint deviceReference{};
+    /// Host minus device time at the reference
+    std::chrono::nanoseconds offset{0};
+    /// Rate of host clock relative to device clock, minus one (eg. 20e-6 is 20 ppm)
+    double drift = 0.0;
+    /// Error bound of mapped times at the reference
+    std::chrono::nanoseconds error{0};
+    /// Error bound of drift
+    double driftError = 0.0;
+    /// Number of samples the model was fitted to, after outliers were removed
+    std::size_t numSamples = 0;
+
+    /**
+     * Maps device time (eg. Buffer::getTimestampDevice) to host steady clock time
+     */
+    TimePoint toHost(TimePoint device) const;
+
+    /**
+     * Maps host steady clock time to device time
+     */
+    TimePoint toDevice(TimePoint host) const;
+
+    /**
+     * Error bound of a mapped time, growing with distance from the reference due to drift uncertainty
+     */
+    std::chrono::nanoseconds getError(TimePoint device) const;
+};
+
+/**
+ * Estimates offset and drift between device and host clocks from timesync samples.
+ *
+ * Each sample pairs device send time with host receive time of a packet, so it is offset by the link latency,
+ * which is never negative and spikes under load. Samples are grouped into buckets and only the one with the lowest
+ * latency of each bucket is kept. A line is then fitted to bucket minima over a sliding window, with minima which
+ * were still delayed by a spike rejected as outliers. Constant minimal link latency can't be observed from one way
+ * samples, so it is included in the offset and not in the error bound.
+ */
+class ClockSyncEstimator {
+   public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /**
+     * @param window Time span of samples the model is fitted to
+     * @param bucket Time span of samples of which only the lowest latency one is kept
+     */
+    explicit ClockSyncEstimator(std::chrono::milliseconds window = std::chrono::minutes(5),
+                                std::chrono::milliseconds bucket = std::chrono::seconds(1));
+
+    /**
+     * Adds a sample and updates the model
+     *
+     * @param device Device time at which the sample was sent
+     * @param host Host time at which the sample was received
+     */
+    void addSample(TimePoint device, TimePoint host);
+
+    /**
+     * Gets the current model
+     */
+    ClockModel getModel() const;
+
+    /**
+     * Removes all samples and invalidates the model
+     */
+    void reset();
+
+    /// Drift bound assumed until drift can be estimated, typical crystal tolerance
+    static constexpr double DEFAULT_DRIFT_BOUND = 100e-6;
+
+   private:
+    struct Bucket {
+        std::int64_t index;
+        // Lowest latency sample
+        TimePoint device;
+        TimePoint host;
+        // Spread of offsets within the bucket, latency jitter
+        std::chrono::nanoseconds minOffset;
+        std::chrono::nanoseconds maxOffset;
+    };
+    std::chrono::milliseconds window;
+    std::chrono::milliseconds bucketDuration;
+    mutable std::mutex mtx;
+    std::deque<Bucket> buckets;
+    ClockModel model;
+
+    void update();
+};
+
+}  // namespace dai
@@ -2,10 +2,13 @@
 
 // std
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 // project
+#include "depthai/device/LatencyTracer.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
 #include "depthai/utility/LockingQueue.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
@@ -16,6 +19,25 @@
 
 namespace dai {
 
+/// Counters of a queue
+struct QueueStats {
+    std::string name;
+    unsigned maxSize = 0;
+    bool blocking = true;
+    /// Maximum total bytes, zero if unlimited
+    std::size_t maxBytes = 0;
+    /// Number of messages currently in the queue
+    std::size_t size = 0;
+    /// Bytes of messages currently in the queue
+    std::size_t bytes = 0;
+    std::uint64_t numPushed = 0;
+    std::uint64_t numPopped = 0;
+    /// Messages overwritten by newer ones in non-blocking mode. Messages passing through a queue of size 0 aren't counted
+    std::uint64_t numDropped = 0;
+    /// Bytes of pushed messages, including metadata
+    std::uint64_t numBytesPushed = 0;
+};
+
 /**
  * Access to receive messages coming from XLink stream
  */
@@ -33,9 +55,22 @@ class DataOutputQueue {
     std::mutex callbacksMtx;
     std::unordered_map<CallbackId, std::function<void(std::string, std::shared_ptr<ADatatype>)>> callbacks;
     CallbackId uniqueCallbackId{0};
+    std::atomic<bool> tracing{false};
+    mutable std::mutex tracerMtx;
+    std::shared_ptr<LatencyTracer> tracer;
+    std::atomic<std::uint64_t> numPushed{0};
+    std::atomic<std::uint64_t> numPopped{0};
+    std::atomic<std::uint64_t> numBytesPushed{0};
 
     // const std::chrono::milliseconds READ_TIMEOUT{500};
 
+    std::shared_ptr<LatencyTracer> getActiveTracer() const;
+    void traceUserPop(const std::shared_ptr<ADatatype>& msg) const;
+    void onPop(const std::shared_ptr<ADatatype>& msg) {
+        numPopped++;
+        if(tracing) traceUserPop(msg);
+    }
+
    public:
     // DataOutputQueue constructor
     DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize = 16, bool blocking = true);
@@ -83,6 +118,22 @@ class DataOutputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum total size of queued messages in bytes, counting data and metadata. Applies together with maximum
+     * size, and once reached the queue blocks or overwrites oldest messages same as when full. A single message larger
+     * than the limit is still accepted into an empty queue
+     *
+     * @param maxBytes Maximum total bytes, zero disables the limit
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum total size of queued messages in bytes
+     *
+     * @returns Maximum total bytes, zero if unlimited
+     */
+    std::size_t getMaxBytes() const;
+
     /**
      * Gets queues name
      *
@@ -122,6 +173,27 @@ class DataOutputQueue {
      */
     bool removeCallback(CallbackId callbackId);
 
+    /**
+     * Sets a tracer which records per message latency of this queue, from device capture to user retrieval
+     *
+     * @param tracer Tracer to record to, can be shared between queues. nullptr disables tracing
+     */
+    void setLatencyTracer(std::shared_ptr<LatencyTracer> tracer);
+
+    /**
+     * Gets tracer set with setLatencyTracer
+     *
+     * @returns Tracer or nullptr if tracing is disabled
+     */
+    std::shared_ptr<LatencyTracer> getLatencyTracer() const;
+
+    /**
+     * Gets counters of the queue
+     *
+     * @returns Current size, limits and number of pushed, popped and dropped messages
+     */
+    QueueStats getStats() const;
+
     /**
      * Check whether front of the queue has message of type T
      * @returns True if queue isn't empty and the first element is of type T, false otherwise
@@ -155,6 +227,7 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
         std::shared_ptr<ADatatype> val = nullptr;
         if(!queue.tryPop(val)) return nullptr;
+        onPop(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -179,6 +252,7 @@ class DataOutputQueue {
         if(!queue.waitAndPop(val)) {
             throw std::runtime_error(exceptionMessage.c_str());
         }
+        onPop(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -229,6 +303,7 @@ class DataOutputQueue {
             return nullptr;
         }
         hasTimedout = false;
+        onPop(val);
         return std::dynamic_pointer_cast<T>(val);
     }
 
@@ -254,7 +329,8 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.consumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        queue.consumeAll([this, &messages](std::shared_ptr<ADatatype>& msg) {
+            onPop(msg);
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -283,7 +359,8 @@ class DataOutputQueue {
         if(!running) throw std::runtime_error(exceptionMessage.c_str());
 
         std::vector<std::shared_ptr<T>> messages;
-        queue.waitAndConsumeAll([&messages](std::shared_ptr<ADatatype>& msg) {
+        queue.waitAndConsumeAll([this, &messages](std::shared_ptr<ADatatype>& msg) {
+            onPop(msg);
             // dynamic pointer cast may return nullptr
             // in which case that message in vector will be nullptr
             messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -315,7 +392,8 @@ class DataOutputQueue {
 
         std::vector<std::shared_ptr<T>> messages;
         hasTimedout = !queue.waitAndConsumeAll(
-            [&messages](std::shared_ptr<ADatatype>& msg) {
+            [this, &messages](std::shared_ptr<ADatatype>& msg) {
+                onPop(msg);
                 // dynamic pointer cast may return nullptr
                 // in which case that message in vector will be nullptr
                 messages.push_back(std::dynamic_pointer_cast<T>(std::move(msg)));
@@ -413,6 +491,22 @@ class DataInputQueue {
      */
     unsigned int getMaxSize() const;
 
+    /**
+     * Sets maximum total size of queued messages in bytes, counting data and metadata. Applies together with maximum
+     * size, and once reached the queue blocks or overwrites oldest messages same as when full. A single message larger
+     * than the limit is still accepted into an empty queue
+     *
+     * @param maxBytes Maximum total bytes, zero disables the limit
+     */
+    void setMaxBytes(std::size_t maxBytes);
+
+    /**
+     * Gets maximum total size of queued messages in bytes
+     *
+     * @returns Maximum total bytes, zero if unlimited
+     */
+    std::size_t getMaxBytes() const;
+
     /**
      * Gets queues name
      *
@@ -3,6 +3,7 @@
 // std
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -11,9 +12,11 @@
 
 // project
 #include "DataQueue.hpp"
+#include "depthai/device/AdaptiveQueuePolicy.hpp"
 #include "depthai/device/DeviceBase.hpp"
 
 namespace dai {
+
 /**
  * Represents the DepthAI device with the methods to interact with it.
  * Implements the host-side queues to connect with XLinkIn and XLinkOut nodes
@@ -121,6 +124,52 @@ class Device : public DeviceBase {
      */
     std::vector<std::string> getOutputQueueNames() const;
 
+    /**
+     * Sets a tracer which records per message latency of all output queues, including queues created by
+     * pipelines started later. Traces can be exported to Chrome trace event format with LatencyTracer::exportChromeTrace
+     *
+     * @param tracer Tracer to record to, nullptr disables tracing
+     */
+    void setLatencyTracer(std::shared_ptr<LatencyTracer> tracer);
+
+    /**
+     * Gets tracer set with setLatencyTracer
+     *
+     * @returns Tracer or nullptr if tracing is disabled
+     */
+    std::shared_ptr<LatencyTracer> getLatencyTracer() const;
+
+    /**
+     * Lets a policy size all output queues by observed message rates and sizes within a host memory budget, including
+     * queues created by pipelines started later. Queues with a persistently slower consumer are switched to overwrite
+     * oldest messages. Sizes and blocking behavior set with getOutputQueue are overridden by the policy
+     *
+     * @param config Policy configuration
+     * @returns Policy, through which queue states and adjustments can be inspected
+     */
+    std::shared_ptr<AdaptiveQueuePolicy> enableAdaptiveQueues(AdaptiveQueuePolicy::Config config = {});
+
+    /**
+     * Lets the given policy size all output queues. Passing the same policy to several devices makes their queues
+     * share one host memory budget
+     *
+     * @param policy Policy, possibly used by other devices as well
+     * @returns The given policy
+     */
+    std::shared_ptr<AdaptiveQueuePolicy> enableAdaptiveQueues(std::shared_ptr<AdaptiveQueuePolicy> policy);
+
+    /**
+     * Stops adjusting queues of this device. Queues keep their last size and blocking behavior
+     */
+    void disableAdaptiveQueues();
+
+    /**
+     * Gets policy enabled with enableAdaptiveQueues
+     *
+     * @returns Policy or nullptr if adaptive queues are disabled
+     */
+    std::shared_ptr<AdaptiveQueuePolicy> getAdaptiveQueuePolicy() const;
+
     /**
      * Gets an input queue corresponding to stream name. If it doesn't exist it throws
      *
@@ -216,6 +265,10 @@ class Device : public DeviceBase {
     std::unordered_map<std::string, std::shared_ptr<DataOutputQueue>> outputQueueMap;
     std::unordered_map<std::string, std::shared_ptr<DataInputQueue>> inputQueueMap;
     std::unordered_map<std::string, DataOutputQueue::CallbackId> callbackIdMap;
+    std::shared_ptr<LatencyTracer> latencyTracer;
+
+    // Adaptive queues, possibly shared with other devices
+    std::shared_ptr<AdaptiveQueuePolicy> adaptiveQueuePolicy;
 
     // Event queue
     std::mutex eventMtx;
@@ -19,8 +19,11 @@
 #include "depthai/common/CameraFeatures.hpp"
 #include "depthai/common/UsbSpeed.hpp"
 #include "depthai/device/CalibrationHandler.hpp"
+#include "depthai/device/ClockSync.hpp"
+#include "depthai/device/Telemetry.hpp"
 #include "depthai/device/Version.hpp"
 #include "depthai/openvino/OpenVINO.hpp"
+#include "depthai/pipeline/datatype/SystemInformation.hpp"
 #include "depthai/utility/Pimpl.hpp"
 #include "depthai/utility/ProfilingData.hpp"
 #include "depthai/xlink/XLinkConnection.hpp"
@@ -43,6 +46,7 @@ namespace dai {
 
 // Forward declare Pipeline
 class Pipeline;
+class DeviceRuntime;
 
 /**
  * The core of depthai device for RAII, connects to device and maintains watchdog, timesync, ...
@@ -75,6 +79,17 @@ class DeviceBase {
         bool nonExclusiveMode = false;
         tl::optional<LogLevel> outputLogLevel;
         tl::optional<LogLevel> logLevel;
+        /// Run watchdog, monitor, timesync and logging on a runtime shared by all devices instead of own threads
+        bool sharedRuntime = false;
+    };
+
+    /**
+     * Device state retrieved at once with getStatus
+     */
+    struct Status {
+        SystemInformation systemInformation;
+        std::vector<CameraBoardSocket> connectedCameras;
+        bool pipelineRunning = false;
     };
 
     // static API
@@ -570,6 +585,59 @@ class DeviceBase {
      */
     ProfilingData getProfilingData();
 
+    /**
+     * Get per stream profiling data - bytes, packets, write stalls, read wait time and packet sizes -
+     * accumulated since connecting
+     *
+     * @returns Map of stream name to its profiling data
+     */
+    std::unordered_map<std::string, StreamProfilingData> getStreamProfilingData();
+
+    /**
+     * Get per stream profiling data within a recent time window, including read and write rates.
+     * Useful to find which streams use most of the link bandwidth
+     *
+     * @param window Time window, measured from snapshots of previous queries or connection start
+     * @returns Map of stream name to its profiling data within the window
+     */
+    std::unordered_map<std::string, StreamProfilingData> getStreamProfilingData(std::chrono::milliseconds window);
+
+    /**
+     * Sets callback which periodically receives per stream profiling data of the last period.
+     * Callback is called from a separate thread
+     *
+     * @param callback Callback with per stream data, or nullptr to stop
+     * @param period Time between calls and window of the reported data
+     */
+    void setStreamProfilingCallback(std::function<void(std::unordered_map<std::string, StreamProfilingData>)> callback,
+                                    std::chrono::milliseconds period = std::chrono::seconds(1));
+
+    /**
+     * Starts collecting telemetry - memory, cpu usage, chip temperature and XLink traffic - into a ring buffer.
+     * Samples are taken on a separate thread with a single batched RPC exchange, which doesn't use any of the data streams.
+     * Replaces the running collection if any. Safe to call concurrently with stopTelemetry and itself.
+     *
+     * @param period Time between samples
+     * @param capacity Number of samples kept, older ones are overwritten
+     * @param exportPath Optional file to which the latest sample is written in text exposition format after each sample
+     * @returns Buffer with collected samples, which can be queried from any thread without locking
+     */
+    std::shared_ptr<const TelemetryBuffer> startTelemetry(std::chrono::milliseconds period = std::chrono::seconds(1),
+                                                          std::size_t capacity = 3600,
+                                                          std::string exportPath = "");
+
+    /**
+     * Stops collecting telemetry. Already collected samples remain available
+     */
+    void stopTelemetry();
+
+    /**
+     * Gets telemetry buffer of last started collection
+     *
+     * @returns Buffer with collected samples or nullptr if telemetry was never started
+     */
+    std::shared_ptr<const TelemetryBuffer> getTelemetry() const;
+
     /**
      * Add a callback for device logging. The callback will be called from a separate thread with the LogMessage being passed.
      *
@@ -721,6 +789,22 @@ class DeviceBase {
      */
     ChipTemperature getChipTemperature();
 
+    /**
+     * Retrieves memory usage, cpu usage and chip temperature at once.
+     * All requests are sent together and pipelined, instead of paying a round trip per metric
+     *
+     * @returns SystemInformation with all metrics
+     */
+    SystemInformation getSystemInformation();
+
+    /**
+     * Retrieves system information, connected cameras and whether pipeline is running at once.
+     * Like getSystemInformation, all requests are sent together and pipelined
+     *
+     * @returns Status of the device
+     */
+    Status getStatus();
+
     /**
      * Retrieves average CSS Leon CPU usage
      *
@@ -873,6 +957,16 @@ class DeviceBase {
      */
     void setTimesync(bool enable);
 
+    /**
+     * Gets host side estimate of the device clock, fitted to timesync samples.
+     * Unlike message timestamps converted on device, the estimate rejects samples delayed by link latency spikes,
+     * so device timestamps (Buffer::getTimestampDevice) can be mapped to host time with ClockModel::toHost
+     * consistently across devices
+     *
+     * @returns Offset and drift model with error bounds, invalid until first timesync sample is received
+     */
+    ClockModel getClockModel() const;
+
     /**
      * Explicitly closes connection to device.
      * @note This function does not need to be explicitly called
@@ -969,6 +1063,17 @@ class DeviceBase {
     // Timesync thread
     std::thread timesyncThread;
     std::atomic<bool> timesyncRunning{true};
+    ClockSyncEstimator clockSync;
+
+    // Shared runtime, replaces watchdog, monitor, timesync and logging threads if used
+    std::shared_ptr<DeviceRuntime> runtime;
+    std::vector<std::uint64_t> runtimeTasks;
+    // Timesync and log streams are polled on the shared runtime, quickly while packets arrive and backing off while idle.
+    // Backoff is capped so timesync echoes and logs are delayed by at most a fraction of the timesync period
+    static constexpr std::chrono::milliseconds SHARED_RUNTIME_MIN_POLL_INTERVAL{1};
+    static constexpr std::chrono::milliseconds SHARED_RUNTIME_MAX_POLL_INTERVAL{50};
+    // XLink hands received packets over through its dispatcher thread, so a zero timeout read could miss them
+    static constexpr std::chrono::milliseconds SHARED_RUNTIME_READ_TIMEOUT{10};
 
     // Logging thread
     std::thread loggingThread;
@@ -977,6 +1082,24 @@ class DeviceBase {
     // Profiling thread
     std::thread profilingThread;
     std::atomic<bool> profilingRunning{true};
+    std::mutex profilingMtx;
+    std::condition_variable profilingCv;
+    bool profilingThreadActive{false};
+    bool profilingLog{false};
+    std::chrono::milliseconds profilingPeriod{1000};
+    std::function<void(std::unordered_map<std::string, StreamProfilingData>)> profilingCallback;
+    void startProfilingThread();
+
+    // Telemetry thread
+    // Serializes starting and stopping the thread
+    std::mutex telemetryControlMtx;
+    std::thread telemetryThread;
+    mutable std::mutex telemetryMtx;
+    std::condition_variable telemetryCv;
+    bool telemetryRunning{false};
+    std::shared_ptr<TelemetryBuffer> telemetry;
+    // Expects telemetryControlMtx to be held
+    void stopTelemetryThread();
 
     // Monitor thread
     std::thread monitorThread;
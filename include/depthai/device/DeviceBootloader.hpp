@@ -102,6 +102,18 @@ class DeviceBootloader {
         std::string info;
     };
 
+    /// Progress of a delta flash
+    struct DeltaFlashProgress {
+        /// Value between 0..1 which signifies current flashing progress
+        float progress = 0.0f;
+        /// Size of the whole package
+        std::size_t totalBytes = 0;
+        /// Bytes which are (being) rewritten
+        std::size_t writtenBytes = 0;
+        /// Bytes which were already up to date and are not rewritten
+        std::size_t skippedBytes = 0;
+    };
+
     // constants
 
     /// Default Bootloader type
@@ -260,14 +272,30 @@ class DeviceBootloader {
      * @param package Depthai application package to flash to the board
      */
     std::tuple<bool, std::string> flashDepthaiApplicationPackage(std::function<void(float)> progressCallback,
-                                                                 std::vector<uint8_t> package,
+                                                                 const std::vector<uint8_t>& package,
                                                                  Memory memory = Memory::AUTO);
 
     /**
      * Flashes a specific depthai application package that was generated using createDepthaiApplicationPackage or saveDepthaiApplicationPackage
      * @param package Depthai application package to flash to the board
      */
-    std::tuple<bool, std::string> flashDepthaiApplicationPackage(std::vector<uint8_t> package, Memory memory = Memory::AUTO);
+    std::tuple<bool, std::string> flashDepthaiApplicationPackage(const std::vector<uint8_t>& package, Memory memory = Memory::AUTO);
+
+    /**
+     * Flashes a depthai application package, rewriting only parts which differ from the application already in memory.
+     * Flashed SBR header is read back and sections with matching checksums are skipped. Other sections are compared
+     * in 64KiB blocks, except firmware which is rewritten as a whole. Without a valid flashed application the whole package is written.
+     * Updating just the pipeline of a flashed application therefore rewrites only a few blocks.
+     * If any section data changes, the flashed header is erased first and the new one is written last. An interrupted
+     * update then leaves no valid application (flash again to recover) rather than a mix of old and new data.
+     *
+     * @param progressCallback Callback with current progress and number of written and skipped bytes
+     * @param package Depthai application package to flash to the board
+     * @param memory Memory to flash to, AUTO selects eMMC on NETWORK bootloader if available and FLASH otherwise
+     */
+    std::tuple<bool, std::string> flashDepthaiApplicationPackageDelta(std::function<void(DeltaFlashProgress)> progressCallback,
+                                                                      const std::vector<uint8_t>& package,
+                                                                      Memory memory = Memory::AUTO);
 
     /**
      * Clears flashed application on the device, by removing SBR boot structure
@@ -496,6 +524,7 @@ class DeviceBootloader {
     template <typename T>
     void receiveResponseThrow(T& response);
     Version requestVersion();
+    void setApplicationMemory(Memory memory);
     std::tuple<bool, std::string> flashCustom(
         Memory memory, size_t offset, const uint8_t* data, size_t size, std::string filename, std::function<void(float)> progressCb);
     std::tuple<bool, std::string> readCustom(
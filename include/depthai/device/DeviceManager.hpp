@@ -0,0 +1,114 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/device/Device.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/xlink/XLinkConnection.hpp"
+
+namespace dai {
+
+/**
+ * Discovers and brings up multiple devices concurrently.
+ *
+ * Firmware for each distinct device configuration is prepared once up front and shared by all boots,
+ * after which devices are booted, connected and their pipelines started in parallel.
+ * Failures are reported per device and don't affect bring-up of the rest.
+ */
+class DeviceManager {
+   public:
+    /// Time spent in each phase of bring-up
+    struct Timings {
+        /// Preparing the (shared) firmware image
+        std::chrono::milliseconds firmware{0};
+        /// Booting, connecting and starting the device threads
+        std::chrono::milliseconds boot{0};
+        /// Starting the pipeline
+        std::chrono::milliseconds pipeline{0};
+        /// Total time until the device was ready or failed, including waiting for a free slot
+        std::chrono::milliseconds total{0};
+    };
+
+    /// Outcome of bringing up a single device
+    struct Result {
+        /// Device which was requested
+        DeviceInfo deviceInfo;
+        /// Connected device or nullptr on failure
+        std::shared_ptr<Device> device;
+        /// Error message on failure, empty otherwise
+        std::string error;
+        /// Phase timings
+        Timings timings;
+
+        /// True if device was brought up successfully
+        bool success() const {
+            return device != nullptr;
+        }
+    };
+
+    /// Creates a pipeline for a given device
+    using PipelineFactory = std::function<Pipeline(const DeviceInfo&)>;
+
+    /**
+     * Waits until at least the given number of devices is available or timeout passes
+     *
+     * @param minDevices Number of devices to wait for
+     * @param timeout Maximum time to wait
+     * @returns All available devices
+     */
+    static std::vector<DeviceInfo> discover(std::size_t minDevices = 1, std::chrono::milliseconds timeout = Device::getDefaultSearchTime());
+
+    /**
+     * Sets maximum number of devices brought up at the same time. 0 brings up all devices at once
+     */
+    void setMaxConcurrency(unsigned int maxConcurrency);
+
+    /**
+     * Gets maximum number of devices brought up at the same time
+     */
+    unsigned int getMaxConcurrency() const;
+
+    /**
+     * Boots and connects to given devices without starting a pipeline
+     *
+     * @param devices Devices to bring up
+     * @param config Device configuration used for all devices
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> open(const std::vector<DeviceInfo>& devices, const Device::Config& config = {}) const;
+
+    /**
+     * Boots given devices and starts the same pipeline on all of them
+     *
+     * @param devices Devices to bring up
+     * @param pipeline Pipeline to start
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> open(const std::vector<DeviceInfo>& devices, const Pipeline& pipeline) const;
+
+    /**
+     * Boots given devices and starts a per device pipeline on each of them.
+     * Factory is called for all devices before any boot starts, from the calling thread.
+     *
+     * @param devices Devices to bring up
+     * @param factory Function creating a pipeline for a device
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> open(const std::vector<DeviceInfo>& devices, const PipelineFactory& factory) const;
+
+   private:
+    unsigned int maxConcurrency = 0;
+
+    std::vector<Result> openImpl(const std::vector<DeviceInfo>& devices,
+                                 const std::vector<Device::Config>& configs,
+                                 const std::vector<const Pipeline*>& pipelines) const;
+};
+
+}  // namespace dai
@@ -0,0 +1,178 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/device/DeviceBootloader.hpp"
+#include "depthai/pipeline/Pipeline.hpp"
+#include "depthai/xlink/XLinkConnection.hpp"
+
+namespace dai {
+
+/**
+ * Flashes bootloaders and application packages to many devices concurrently.
+ *
+ * Application package is created once and shared read-only by all workers. Each device is flashed over its own
+ * bootloader connection. Transient failures - device not found, lost communication or a failed flash operation - are
+ * retried by reconnecting to the device, other errors fail the device right away.
+ * Failures are reported per device and don't affect flashing of the rest.
+ */
+class FleetFlasher {
+   public:
+    /// Current stage of flashing a device
+    enum class Stage {
+        /// Waiting for a free slot
+        PENDING,
+        /// Connecting to the bootloader
+        CONNECTING,
+        /// Flashing an updated bootloader
+        BOOTLOADER,
+        /// Flashing the application package
+        APPLICATION,
+        /// Device was flashed successfully
+        DONE,
+        /// Flashing failed, after all retries
+        FAILED
+    };
+
+    /// Progress update of a single device
+    struct Progress {
+        /// Index of the device in the given list
+        std::size_t index = 0;
+        /// Device being flashed
+        DeviceInfo deviceInfo;
+        /// Current stage
+        Stage stage = Stage::PENDING;
+        /// Value between 0..1 which signifies progress of current stage
+        float progress = 0.0f;
+        /// Current attempt, starting with 1
+        unsigned attempt = 0;
+        /// Value between 0..1 which signifies progress across all devices
+        float overall = 0.0f;
+    };
+
+    /// Outcome of flashing a single device
+    struct Result {
+        /// Device which was requested
+        DeviceInfo deviceInfo;
+        /// Error message on failure, empty otherwise
+        std::string error;
+        /// Number of attempts made
+        unsigned attempts = 0;
+        /// Whether bootloader was updated
+        bool bootloaderUpdated = false;
+        /// Time spent flashing the device, including retries
+        std::chrono::milliseconds duration{0};
+
+        /// True if device was flashed successfully
+        bool success() const {
+            return attempts > 0 && error.empty();
+        }
+    };
+
+    /// Progress callback, called from worker threads one at a time
+    using ProgressCallback = std::function<void(const Progress&)>;
+
+    /**
+     * Sets maximum number of devices flashed at the same time. 0 flashes all devices at once
+     */
+    void setMaxConcurrency(unsigned int maxConcurrency);
+
+    /**
+     * Gets maximum number of devices flashed at the same time
+     */
+    unsigned int getMaxConcurrency() const;
+
+    /**
+     * Sets number of retries after a transient failure, and delay before each of them
+     */
+    void setRetries(unsigned int maxRetries, std::chrono::milliseconds delay = std::chrono::milliseconds(1000));
+
+    /**
+     * Gets number of retries after a transient failure
+     */
+    unsigned int getRetries() const;
+
+    /**
+     * Sets whether bootloader is updated to the embedded version first, if an older one (or none) is flashed.
+     * Device is then reset into the updated bootloader, and its version checked, before the application is flashed
+     */
+    void setUpdateBootloader(bool updateBootloader);
+
+    /**
+     * Gets whether bootloader is updated to the embedded version first
+     */
+    bool getUpdateBootloader() const;
+
+    /**
+     * Sets whether only parts of the application which differ from the flashed one are rewritten.
+     * See DeviceBootloader::flashDepthaiApplicationPackageDelta
+     */
+    void setDeltaFlashing(bool delta);
+
+    /**
+     * Gets whether only parts of the application which differ from the flashed one are rewritten
+     */
+    bool getDeltaFlashing() const;
+
+    /**
+     * Sets memory to flash the application to
+     */
+    void setMemory(DeviceBootloader::Memory memory);
+
+    /**
+     * Gets memory to flash the application to
+     */
+    DeviceBootloader::Memory getMemory() const;
+
+    /**
+     * Sets callback with progress updates of each device
+     */
+    void setProgressCallback(ProgressCallback callback);
+
+    /**
+     * Flashes the given application package to all devices
+     *
+     * @param devices Devices to flash
+     * @param package Depthai application package, shared by all devices
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> flash(const std::vector<DeviceInfo>& devices, const std::vector<uint8_t>& package) const;
+
+    /**
+     * Creates an application package from the pipeline once and flashes it to all devices
+     *
+     * @param devices Devices to flash
+     * @param pipeline Pipeline to create the package from
+     * @param compress Optional boolean which specifies if device firmware should be compressed
+     * @param applicationName Optional name the application that is flashed
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> flash(const std::vector<DeviceInfo>& devices, const Pipeline& pipeline, bool compress = false, std::string applicationName = "") const;
+
+    /**
+     * Updates bootloader to the embedded version on all devices, without flashing an application
+     *
+     * @param devices Devices to flash
+     * @returns One result per device, in the same order
+     */
+    std::vector<Result> flashBootloader(const std::vector<DeviceInfo>& devices) const;
+
+   private:
+    unsigned int maxConcurrency = 0;
+    unsigned int maxRetries = 2;
+    std::chrono::milliseconds retryDelay{1000};
+    bool updateBootloader = false;
+    bool delta = false;
+    DeviceBootloader::Memory memory = DeviceBootloader::Memory::AUTO;
+    ProgressCallback progressCallback;
+
+    std::vector<Result> flashImpl(const std::vector<DeviceInfo>& devices, const std::vector<uint8_t>* package, bool forceBootloader) const;
+};
+
+}  // namespace dai
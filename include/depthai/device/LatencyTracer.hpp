@@ -0,0 +1,141 @@
+#pragma once
+
+// std
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "depthai/utility/Path.hpp"
+
+namespace dai {
+
+/**
+ * Records per message timing along the path from the device to the application.
+ *
+ * Each message gets a trace with timestamps of the stages it went through. Traces are kept in a bounded ring,
+ * older ones are overwritten. Recorded traces can be exported to the Chrome trace event JSON format, which can be
+ * opened in chrome://tracing or Perfetto UI.
+ */
+class LatencyTracer {
+   public:
+    using Id = std::uint64_t;
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    /// Stages of a message, in order
+    enum class Stage : std::uint8_t {
+        /// Capture time on device, as host synchronized message timestamp
+        DEVICE_CAPTURE,
+        /// Time device sent the packet, converted to host time
+        DEVICE_SEND,
+        /// Time XLink received the packet on host
+        HOST_RECEIVE,
+        PARSE_START,
+        PARSE_END,
+        QUEUE_PUSH,
+        /// Time message was retrieved from the queue by the user
+        USER_POP,
+        /// Time all queue callbacks completed
+        CALLBACK_END
+    };
+    static constexpr std::size_t NUM_STAGES = 8;
+
+    /// Timestamps of a single message
+    struct Trace {
+        Id id = 0;
+        std::string stream;
+        std::int64_t sequenceNum = -1;
+        /// Timestamps of each stage, default constructed if stage wasn't recorded
+        std::array<TimePoint, NUM_STAGES> timestamps{};
+
+        bool has(Stage stage) const;
+        TimePoint get(Stage stage) const;
+        void set(Stage stage, TimePoint time);
+
+        /**
+         * Time between two stages
+         *
+         * @returns Duration, or zero if either stage wasn't recorded
+         */
+        std::chrono::nanoseconds latency(Stage from, Stage to) const;
+    };
+
+    /**
+     * @param capacity Number of traces kept, older ones are overwritten
+     */
+    explicit LatencyTracer(std::size_t capacity = 4096);
+
+    /**
+     * Adds a trace, overwriting the oldest one if full
+     *
+     * @param trace Trace with stages recorded so far. Its id is assigned by the tracer
+     * @param message Optional message address, with which later stages can be recorded
+     * @returns Id of the trace
+     */
+    Id record(Trace trace, const void* message = nullptr);
+
+    /**
+     * Records a stage of a trace. Ignored if the trace was already overwritten
+     */
+    void mark(Id id, Stage stage, TimePoint time = std::chrono::steady_clock::now());
+
+    /**
+     * Records a stage of a trace by its message address. USER_POP is only recorded the first time
+     *
+     * @returns True if message is traced, false otherwise
+     */
+    bool mark(const void* message, Stage stage, TimePoint time = std::chrono::steady_clock::now());
+
+    /**
+     * Retrieves all kept traces, oldest first
+     */
+    std::vector<Trace> getTraces() const;
+
+    /**
+     * Removes all traces
+     */
+    void clear();
+
+    /**
+     * Renders kept traces in Chrome trace event JSON format.
+     * Each message is an async track per stream, with a slice spanning all its stages and nested slices between them
+     */
+    std::string toChromeTrace() const;
+
+    /**
+     * Writes traces in Chrome trace event JSON format to a file
+     *
+     * @param path Output file path
+     */
+    void exportChromeTrace(const dai::Path& path) const;
+
+    /**
+     * Gets number of traces kept
+     */
+    std::size_t getCapacity() const;
+
+    /**
+     * Name of a stage
+     */
+    static const char* getStageName(Stage stage);
+
+   private:
+    struct Slot {
+        Trace trace;
+        const void* message = nullptr;
+        bool popped = false;
+    };
+    mutable std::mutex mtx;
+    std::vector<Slot> slots;
+    Id nextId = 1;
+    std::unordered_map<const void*, Id> messages;
+
+    Slot* find(Id id);
+};
+
+}  // namespace dai
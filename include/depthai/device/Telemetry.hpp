@@ -0,0 +1,137 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/utility/ProfilingData.hpp"
+
+// shared
+#include "depthai-shared/common/ChipTemperature.hpp"
+#include "depthai-shared/common/CpuUsage.hpp"
+#include "depthai-shared/common/MemoryInfo.hpp"
+
+namespace dai {
+
+/// Single telemetry measurement of a device
+struct TelemetrySample {
+    /// Host time at which the sample was taken
+    std::chrono::steady_clock::time_point timestamp;
+    MemoryInfo ddrMemoryUsage;
+    MemoryInfo cmxMemoryUsage;
+    MemoryInfo leonCssMemoryUsage;
+    MemoryInfo leonMssMemoryUsage;
+    CpuUsage leonCssCpuUsage;
+    CpuUsage leonMssCpuUsage;
+    ChipTemperature chipTemperature;
+    /// Accumulated XLink traffic
+    ProfilingData profilingData;
+    /// XLink write rate since previous sample, in bytes per second
+    float xlinkWriteRate;
+    /// XLink read rate since previous sample, in bytes per second
+    float xlinkReadRate;
+};
+
+/// Value which can be queried from telemetry samples
+enum class TelemetryMetric {
+    DDR_MEMORY_USED,
+    CMX_MEMORY_USED,
+    LEON_CSS_HEAP_USED,
+    LEON_MSS_HEAP_USED,
+    LEON_CSS_CPU_USAGE,
+    LEON_MSS_CPU_USAGE,
+    CHIP_TEMPERATURE,
+    XLINK_WRITE_RATE,
+    XLINK_READ_RATE
+};
+
+/// Aggregate of a metric over a window of samples
+struct TelemetryStats {
+    float min = 0.0f;
+    float max = 0.0f;
+    float average = 0.0f;
+    /// Number of samples in the window, other fields are zero if none
+    std::size_t count = 0;
+};
+
+/**
+ * Fixed size time-series ring buffer of telemetry samples.
+ *
+ * Single writer appends samples, while any number of readers query them without locks. Each slot is a seqlock - a
+ * sequence counter guarding the sample stored as atomic words - readers retry a slot which is being written and skip
+ * samples which were already overwritten. Neither side ever blocks the other.
+ */
+class TelemetryBuffer {
+   public:
+    /**
+     * @param capacity Number of samples kept, older ones are overwritten
+     */
+    explicit TelemetryBuffer(std::size_t capacity);
+
+    /**
+     * Appends a sample. Must only be called by a single thread at a time
+     */
+    void push(const TelemetrySample& sample);
+
+    /**
+     * Retrieves the latest sample
+     *
+     * @param sample Output sample
+     * @returns True if there was any sample, false otherwise
+     */
+    bool latest(TelemetrySample& sample) const;
+
+    /**
+     * Retrieves samples taken within the given time window, oldest first
+     */
+    std::vector<TelemetrySample> window(std::chrono::nanoseconds duration) const;
+
+    /**
+     * Computes min, max and average of a metric over samples taken within the given time window
+     */
+    TelemetryStats stats(TelemetryMetric metric, std::chrono::nanoseconds duration) const;
+
+    /**
+     * Renders the latest sample in a text exposition format (Prometheus style)
+     *
+     * @param device Value of the 'device' label, usually the MX ID
+     * @returns Text with one line per metric, empty if there are no samples
+     */
+    std::string toText(const std::string& device) const;
+
+    /**
+     * Value of a metric in a sample
+     */
+    static float getValue(const TelemetrySample& sample, TelemetryMetric metric);
+
+    /**
+     * Gets number of samples kept
+     */
+    std::size_t getCapacity() const;
+
+    /**
+     * Gets number of samples pushed so far, including overwritten ones
+     */
+    std::uint64_t getNumPushed() const;
+
+   private:
+    // Sample is plain data, copied in and out of a slot word by word
+    static constexpr std::size_t NUM_WORDS = (sizeof(TelemetrySample) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> words[NUM_WORDS];
+    };
+    std::unique_ptr<Slot[]> slots;
+    std::size_t capacity;
+    std::atomic<std::uint64_t> numPushed{0};
+
+    bool read(std::uint64_t index, TelemetrySample& sample) const;
+};
+
+}  // namespace dai
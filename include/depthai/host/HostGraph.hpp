@@ -0,0 +1,118 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/host/HostNode.hpp"
+
+namespace dai {
+
+class WorkStealingPool;
+
+/**
+ * Graph of host side processing nodes, linked to each other and to device queues.
+ *
+ * Nodes run on a shared work stealing thread pool, each whenever its inputs have messages. Inputs are bounded. A full
+ * blocking input stops its producing nodes from being run until it has space again, and blocks the device queue
+ * feeding it, so a slow stage slows down the whole chain instead of growing memory.
+ */
+class HostGraph {
+   public:
+    /**
+     * @param numThreads Number of pool threads, zero for one per hardware thread
+     */
+    explicit HostGraph(std::size_t numThreads = 0);
+
+    /**
+     * Stops the graph
+     */
+    ~HostGraph();
+
+    HostGraph(const HostGraph&) = delete;
+    HostGraph& operator=(const HostGraph&) = delete;
+
+    /**
+     * Creates a node owned by the graph
+     *
+     * @returns Shared pointer to the node
+     */
+    template <typename N, typename... Args>
+    std::shared_ptr<N> create(Args&&... args) {
+        static_assert(std::is_base_of<HostNode, N>::value, "Node must derive from HostNode");
+        auto node = std::make_shared<N>(std::forward<Args>(args)...);
+        add(node);
+        return node;
+    }
+
+    /**
+     * Adds a node to the graph. A node can only be part of a single graph
+     */
+    void add(std::shared_ptr<HostNode> node);
+
+    /**
+     * Feeds messages of a device output queue to an input. Messages are consumed through the graph only, so the queue's
+     * own buffering is disabled (max size 0). Messages not of the input type are dropped
+     *
+     * @param queue Device output queue
+     * @param input Input of a node in this graph
+     */
+    template <typename T>
+    void link(std::shared_ptr<DataOutputQueue> queue, HostNode::Input<T>& input) {
+        link(std::move(queue), static_cast<HostNode::InputBase&>(input), [](const std::shared_ptr<ADatatype>& msg) {
+            return std::dynamic_pointer_cast<T>(msg) != nullptr;
+        });
+    }
+
+    /**
+     * Starts running nodes. Messages received before are kept and processed
+     */
+    void start();
+
+    /**
+     * Stops running nodes and waits for running ones to finish. Inputs are closed, so blocked senders return
+     */
+    void stop();
+
+    /**
+     * Checks whether the graph is running
+     */
+    bool isRunning() const;
+
+    /**
+     * Gets number of pool threads
+     */
+    std::size_t getNumThreads() const;
+
+    /**
+     * Gets statistics of all nodes
+     */
+    std::vector<HostNode::Stats> getStats() const;
+
+   private:
+    friend class HostNode;
+
+    struct QueueLink {
+        std::shared_ptr<DataOutputQueue> queue;
+        DataOutputQueue::CallbackId callbackId;
+    };
+
+    const std::size_t numThreads;
+    mutable std::mutex mtx;
+    std::vector<std::shared_ptr<HostNode>> nodes;
+    std::vector<QueueLink> queueLinks;
+    std::unique_ptr<WorkStealingPool> pool;
+    std::atomic<bool> running{false};
+
+    void link(std::shared_ptr<DataOutputQueue> queue, HostNode::InputBase& input, std::function<bool(const std::shared_ptr<ADatatype>&)> accepts);
+};
+
+}  // namespace dai
@@ -0,0 +1,92 @@
+#pragma once
+
+// std
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// project
+#include "depthai/pipeline/datatype/ImageManipConfig.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+
+namespace dai {
+
+/**
+ * Host side equivalent of the ImageManip node. Applies an ImageManipConfig to an ImgFrame with the same semantics as
+ * the device: crop (rectangle, rotated rectangle, center crop), rotation, 4 point and 3x3 warps, resize with stretch,
+ * keepAspectRatio (center crop) or thumbnail (letterbox) modes, border replicate or background color, flips, colormaps
+ * and frame type conversion.
+ *
+ * Geometry is applied per plane with fixed point kernels. Axis aligned transforms use a separable resize, others a
+ * per pixel warp. Output frames are taken from a pool and reused once they aren't referenced anymore, including by
+ * queues they were sent to.
+ *
+ * Supported types are GRAY8, RAW8, YUV400p, RGB888i, BGR888i, RGB888p, BGR888p, NV12, NV21 and YUV420p.
+ * BICUBIC interpolation is done as BILINEAR. reusePreviousImage and skipCurrentImage are handled by the caller,
+ * which decides which frames to apply a config to.
+ */
+class HostImageManip {
+   public:
+    /// Default number of pooled output frames
+    static constexpr std::size_t DEFAULT_MAX_POOL_SIZE = 4;
+
+    /// Config applied by apply(frame)
+    ImageManipConfig initialConfig;
+
+    /**
+     * Applies initialConfig to a frame
+     *
+     * @param frame Input frame
+     * @returns Output frame, with metadata (timestamps, sequence number, camera settings) of the input
+     */
+    std::shared_ptr<ImgFrame> apply(const ImgFrame& frame);
+
+    /**
+     * Applies a config to a frame
+     *
+     * @param frame Input frame
+     * @param config Config to apply
+     * @returns Output frame, with metadata (timestamps, sequence number, camera settings) of the input
+     */
+    std::shared_ptr<ImgFrame> apply(const ImgFrame& frame, const ImageManipConfig& config);
+
+    /**
+     * Sets maximum number of pooled output frames. When all are in use, new frames are allocated and not pooled
+     *
+     * @param size Number of frames, 0 disables pooling
+     */
+    void setMaxPoolSize(std::size_t size);
+
+    /**
+     * Gets maximum number of pooled output frames
+     */
+    std::size_t getMaxPoolSize() const;
+
+   private:
+    struct ColormapLut {
+        Colormap colormap = Colormap::NONE;
+        int min = 0;
+        int max = 0;
+        std::array<std::array<std::uint8_t, 3>, 256> values{};
+    };
+
+    mutable std::mutex mtx;
+    std::size_t maxPoolSize = DEFAULT_MAX_POOL_SIZE;
+    std::vector<std::shared_ptr<ImgFrame>> pool;
+    ColormapLut lut;
+
+    // Intermediate images, reused between frames
+    std::vector<std::uint8_t> sourceBuffer;
+    std::vector<std::uint8_t> transformBuffer;
+    std::vector<std::uint8_t> grayBuffer;
+    std::vector<std::uint8_t> colorBuffer;
+    std::vector<std::uint8_t> scratch;
+
+    std::shared_ptr<ImgFrame> acquire();
+    const ColormapLut& getLut(Colormap colormap, int min, int max);
+};
+
+}  // namespace dai
@@ -0,0 +1,203 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+#include "depthai/pipeline/datatype/NNData.hpp"
+
+namespace dai {
+
+class DeviceRuntime;
+
+/**
+ * Asynchronous inference over a host fed network: requests are sent to an input queue (XLinkIn feeding a
+ * NeuralNetwork) and responses read from an output queue are matched to them by sequence number.
+ *
+ * Up to 'maxInFlight' requests are kept outstanding, so transfers and inference on the device overlap instead of
+ * running one at a time, while the input queue never grows beyond the window. Requests without a response within
+ * 'timeout' are failed and free their slot, so a lost message doesn't stall the window.
+ *
+ * Result callbacks run on the thread that received the response (the output queue's reading thread) or, for timeouts,
+ * on the shared device runtime. They should be short.
+ */
+class HostInferenceWindow {
+   public:
+    struct Config {
+        /// Maximum number of requests sent and waiting for a response
+        unsigned int maxInFlight = 4;
+        /// Time after which a request without a response is failed
+        std::chrono::milliseconds timeout{1000};
+        /// Stamps requests with consecutive sequence numbers, otherwise their own must be unique among those in flight
+        bool assignSequenceNumbers = true;
+    };
+
+    struct Stats {
+        std::uint64_t numSent = 0;
+        std::uint64_t numCompleted = 0;
+        std::uint64_t numTimedOut = 0;
+        /// Responses without a matching request, e.g. arriving after their request timed out
+        std::uint64_t numUnmatched = 0;
+        std::size_t numInFlight = 0;
+        /// Completed requests per second, over the last second
+        float throughput = 0.0f;
+        /// Time from sending a request to receiving its response
+        std::chrono::microseconds averageLatency{0};
+        std::chrono::microseconds minLatency{0};
+        std::chrono::microseconds maxLatency{0};
+    };
+
+    /// Receives the response, or the error (e.g. timeout) with a null response
+    using Callback = std::function<void(std::shared_ptr<ADatatype> response, std::exception_ptr error)>;
+    /// Delivers a request to the device
+    using Sender = std::function<void(const std::shared_ptr<ADatatype>& request)>;
+
+    /**
+     * Pairs an input and an output queue. Responses are consumed through the window only, so the output queue's own
+     * buffering is disabled (max size 0)
+     *
+     * @param input Queue feeding the network
+     * @param output Queue of network results
+     */
+    HostInferenceWindow(std::shared_ptr<DataInputQueue> input, std::shared_ptr<DataOutputQueue> output);
+    HostInferenceWindow(std::shared_ptr<DataInputQueue> input, std::shared_ptr<DataOutputQueue> output, Config config);
+
+    /**
+     * Uses a custom transport, responses are passed to receive
+     *
+     * @param sender Function delivering requests
+     */
+    explicit HostInferenceWindow(Sender sender);
+    HostInferenceWindow(Sender sender, Config config);
+
+    /**
+     * Fails requests still in flight
+     */
+    ~HostInferenceWindow();
+
+    HostInferenceWindow(const HostInferenceWindow&) = delete;
+    HostInferenceWindow& operator=(const HostInferenceWindow&) = delete;
+
+    /**
+     * Sends a request, blocking while the window is full
+     *
+     * @param request Request message
+     * @param callback Called with the response or the error
+     */
+    void infer(std::shared_ptr<Buffer> request, Callback callback);
+
+    /**
+     * Sends a request, waiting at most 'wait' for a free slot in the window
+     *
+     * @param request Request message
+     * @param callback Called with the response or the error
+     * @param wait Maximum time to wait for a free slot
+     * @returns False if the window stayed full and nothing was sent
+     */
+    bool infer(std::shared_ptr<Buffer> request, Callback callback, std::chrono::milliseconds wait);
+
+    /**
+     * Sends a request, blocking while the window is full
+     *
+     * @param request Request message
+     * @returns Future of the response. On timeout or a response of a different type, it holds an exception
+     */
+    template <typename T = NNData>
+    std::future<std::shared_ptr<T>> infer(std::shared_ptr<Buffer> request) {
+        auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+        auto future = promise->get_future();
+        infer(std::move(request), [promise](std::shared_ptr<ADatatype> response, std::exception_ptr error) {
+            if(error) {
+                promise->set_exception(error);
+                return;
+            }
+            auto result = std::dynamic_pointer_cast<T>(response);
+            if(!result) {
+                promise->set_exception(std::make_exception_ptr(std::runtime_error("HostInferenceWindow - response is of unexpected type")));
+                return;
+            }
+            promise->set_value(std::move(result));
+        });
+        return future;
+    }
+
+    /**
+     * Matches a response to its request. Called by the output queue, or by a custom transport
+     *
+     * @param response Response message, carrying the sequence number of its request
+     */
+    void receive(std::shared_ptr<ADatatype> response);
+
+    /**
+     * Waits until no requests are in flight
+     *
+     * @param timeout Maximum time to wait
+     * @returns True if no requests are in flight
+     */
+    bool waitIdle(std::chrono::milliseconds timeout);
+
+    /**
+     * Sets maximum number of requests in flight
+     */
+    void setMaxInFlight(unsigned int maxInFlight);
+
+    /**
+     * Gets maximum number of requests in flight
+     */
+    unsigned int getMaxInFlight() const;
+
+    /**
+     * Gets number of requests in flight
+     */
+    std::size_t getNumInFlight() const;
+
+    /**
+     * Gets throughput and latency statistics
+     */
+    Stats getStats() const;
+
+   private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request {
+        Clock::time_point sent;
+        Callback callback;
+    };
+
+    Sender sender;
+    Config config;
+    std::shared_ptr<DataOutputQueue> output;
+    DataOutputQueue::CallbackId callbackId = 0;
+    std::shared_ptr<DeviceRuntime> runtime;
+    std::uint64_t timeoutTask = 0;
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    bool closed = false;
+    std::int64_t nextSequenceNum = 0;
+    std::map<std::int64_t, Request> requests;
+    Stats stats;
+    std::chrono::microseconds totalLatency{0};
+    Clock::time_point firstSent;
+    std::deque<Clock::time_point> completions;
+
+    void start();
+    bool submit(std::shared_ptr<Buffer> request, Callback callback, const Clock::time_point* deadline);
+    std::chrono::milliseconds expire();
+    static void fail(std::map<std::int64_t, Request>& failed, const std::string& message);
+};
+
+}  // namespace dai
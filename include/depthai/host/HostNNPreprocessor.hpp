@@ -0,0 +1,152 @@
+#pragma once
+
+// std
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// project
+#include "depthai/build/config.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/NNData.hpp"
+
+// optional
+#ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+    #include <opencv2/opencv.hpp>
+#endif
+
+namespace dai {
+
+/**
+ * Prepares host images as neural network input. Resize (stretch, letterbox or center crop), color conversion,
+ * mean/scale normalization and interleaved to planar conversion are done in a single pass over the output, writing
+ * U8 or FP16 values directly into an NNData layer or ImgFrame ready for DataInputQueue::send.
+ *
+ * Supported inputs are BGR888i, RGB888i, BGR888p, RGB888p, NV12, NV21 and GRAY8 frames, and 8 bit BGR or gray cv::Mat.
+ */
+class HostNNPreprocessor {
+   public:
+    enum class ResizeMode {
+        /// Scales each axis to the output size, aspect ratio isn't kept
+        STRETCH,
+        /// Scales the whole image inside the output, the rest is background
+        LETTERBOX,
+        /// Scales the image to cover the output, the center is kept
+        CROP
+    };
+
+    enum class DataType { U8, FP16 };
+
+    enum class ColorOrder { BGR, RGB };
+
+    struct Config {
+        /// Output size, zero keeps the input size
+        unsigned int width = 0;
+        unsigned int height = 0;
+        ResizeMode resizeMode = ResizeMode::LETTERBOX;
+        DataType dataType = DataType::U8;
+        ColorOrder colorOrder = ColorOrder::BGR;
+        /// Planar (CHW) output, interleaved (HWC) otherwise
+        bool planar = true;
+        /// Values are (value - mean) / scale per output channel, as OpenVINO mean and scale values. U8 output is rounded and saturated
+        std::array<float, 3> mean = {{0.0f, 0.0f, 0.0f}};
+        std::array<float, 3> scale = {{1.0f, 1.0f, 1.0f}};
+        /// Letterbox background as BGR, normalized like image values
+        std::array<std::uint8_t, 3> background = {{0, 0, 0}};
+    };
+
+    /**
+     * Maps output pixel coordinates to input pixel coordinates (input = output * scale + offset), for example to map
+     * detections back to the input image
+     */
+    struct Transform {
+        float scaleX = 1.0f;
+        float scaleY = 1.0f;
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+    };
+
+    HostNNPreprocessor() = default;
+    explicit HostNNPreprocessor(Config config);
+
+    /**
+     * Sets preprocessing config
+     */
+    void setConfig(Config config);
+
+    /**
+     * Gets preprocessing config
+     */
+    Config getConfig() const;
+
+    /**
+     * Prepares a frame into an NNData layer. Timestamps and sequence number of the frame are copied
+     *
+     * @param frame Input frame
+     * @param data NNData to set the layer in
+     * @param layer Name of the layer
+     * @returns Mapping from output to frame coordinates
+     */
+    Transform process(const ImgFrame& frame, NNData& data, const std::string& layer);
+
+    /**
+     * Prepares a frame into another frame, of type BGR888p, RGB888p, BGR888i or RGB888i for U8 output and the
+     * corresponding F16 types for FP16 output. Metadata of the input frame is copied
+     *
+     * @param frame Input frame
+     * @param output Output frame
+     * @returns Mapping from output to frame coordinates
+     */
+    Transform process(const ImgFrame& frame, ImgFrame& output);
+
+// Optional - OpenCV support
+#ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Prepares an 8 bit BGR (CV_8UC3) or gray (CV_8UC1) image into an NNData layer
+     *
+     * @param frame Input image
+     * @param data NNData to set the layer in
+     * @param layer Name of the layer
+     * @returns Mapping from output to image coordinates
+     */
+    Transform process(const cv::Mat& frame, NNData& data, const std::string& layer);
+
+    /**
+     * @note This API only available if OpenCV support is enabled
+     *
+     * Prepares an 8 bit BGR (CV_8UC3) or gray (CV_8UC1) image into a frame, see process(const ImgFrame&, ImgFrame&)
+     *
+     * @param frame Input image
+     * @param output Output frame
+     * @returns Mapping from output to image coordinates
+     */
+    Transform process(const cv::Mat& frame, ImgFrame& output);
+#endif
+
+   private:
+    // Input image in memory, stride is of the first plane, other planes follow tightly packed as in ImgFrame
+    struct Source {
+        ImgFrame::Type type = ImgFrame::Type::NONE;
+        const std::uint8_t* data = nullptr;
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+    };
+
+    Config config;
+
+    static Source getSource(const ImgFrame& frame);
+#ifdef DEPTHAI_HAVE_OPENCV_SUPPORT
+    static Source getSource(const cv::Mat& frame);
+#endif
+    Transform run(const Source& src, std::uint8_t* dst) const;
+    Transform run(const Source& src, NNData& data, const std::string& layer) const;
+    Transform run(const Source& src, ImgFrame& output) const;
+    std::size_t getOutputSize(const Source& src) const;
+    ImgFrame::Type getOutputType() const;
+};
+
+}  // namespace dai
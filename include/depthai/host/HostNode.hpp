@@ -0,0 +1,334 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/ADatatype.hpp"
+
+namespace dai {
+
+class HostGraph;
+
+/**
+ * Processing stage of a HostGraph. Derived nodes declare typed inputs and outputs as members and implement process(),
+ * which is run on the graph's thread pool whenever the inputs have messages.
+ */
+class HostNode {
+    friend class HostGraph;
+
+   public:
+    class InputBase;
+    class OutputBase;
+    template <typename T>
+    class Input;
+    template <typename T>
+    class Output;
+
+    /// Per input statistics
+    struct InputStats {
+        std::string name;
+        /// Number of received messages
+        std::uint64_t numReceived = 0;
+        /// Number of messages overwritten in non-blocking mode, or of wrong type
+        std::uint64_t numDropped = 0;
+        /// Number of messages currently queued
+        std::size_t size = 0;
+    };
+
+    /// Node statistics
+    struct Stats {
+        std::string name;
+        /// Number of process() calls
+        std::uint64_t numRuns = 0;
+        /// Number of process() calls which threw
+        std::uint64_t numErrors = 0;
+        /// Time spent in process()
+        std::chrono::nanoseconds totalTime{0};
+        std::chrono::nanoseconds averageTime{0};
+        std::chrono::nanoseconds maxTime{0};
+        std::vector<InputStats> inputs;
+    };
+
+    /**
+     * Untyped part of an input. Keeps a bounded queue of received messages
+     */
+    class InputBase {
+        friend class HostNode;
+        friend class HostGraph;
+        friend class OutputBase;
+
+       public:
+        InputBase(const InputBase&) = delete;
+        InputBase& operator=(const InputBase&) = delete;
+
+        /**
+         * Gets name of the input
+         */
+        const std::string& getName() const;
+
+        /**
+         * Sets queue behavior when full. Blocking applies backpressure to the producer, otherwise oldest messages are overwritten
+         */
+        void setBlocking(bool blocking);
+
+        /**
+         * Gets queue behavior when full
+         */
+        bool getBlocking() const;
+
+        /**
+         * Sets maximum number of queued messages
+         */
+        void setQueueSize(unsigned int size);
+
+        /**
+         * Gets maximum number of queued messages
+         */
+        unsigned int getQueueSize() const;
+
+        /**
+         * Sets whether the node waits for a message on this input before it runs
+         */
+        void setWaitForMessage(bool waitForMessage);
+
+        /**
+         * Gets whether the node waits for a message on this input before it runs
+         */
+        bool getWaitForMessage() const;
+
+        /**
+         * Checks whether a message is queued
+         */
+        bool has() const;
+
+        /**
+         * Gets number of queued messages
+         */
+        std::size_t size() const;
+
+       protected:
+        InputBase(HostNode& parent, std::string name, bool blocking, unsigned int queueSize, bool waitForMessage);
+        ~InputBase() = default;
+
+        void push(std::shared_ptr<ADatatype> msg);
+        std::shared_ptr<ADatatype> pop();
+        std::shared_ptr<ADatatype> front() const;
+
+       private:
+        HostNode& parent;
+        const std::string name;
+        mutable std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<std::shared_ptr<ADatatype>> queue;
+        bool blocking;
+        unsigned int queueSize;
+        std::atomic<bool> waitForMessage;
+        bool closed = false;
+        InputStats stats;
+        // Nodes with outputs linked to this input, rescheduled once it has space again
+        std::vector<HostNode*> sources;
+
+        bool isFull() const;
+        void open();
+        void close();
+        void drop();
+    };
+
+    /**
+     * Input receiving messages of type T or derived from it
+     */
+    template <typename T>
+    class Input : public InputBase {
+        static_assert(std::is_base_of<ADatatype, T>::value, "Input type must derive from ADatatype");
+
+       public:
+        /**
+         * @param parent Node the input belongs to
+         * @param name Name of the input
+         * @param blocking Whether a full queue blocks the producer or overwrites oldest messages. Default: true
+         * @param queueSize Maximum number of queued messages. Default: 8
+         * @param waitForMessage Whether the node only runs once this input has a message. Default: false
+         */
+        Input(HostNode& parent, std::string name, bool blocking = true, unsigned int queueSize = 8, bool waitForMessage = false)
+            : InputBase(parent, std::move(name), blocking, queueSize, waitForMessage) {}
+
+        /**
+         * Feeds a message from outside of the graph. Blocks while the queue is full, if blocking
+         */
+        void send(const std::shared_ptr<T>& msg) {
+            push(msg);
+        }
+
+        /**
+         * Retrieves a message, or nullptr if none is queued
+         */
+        std::shared_ptr<T> tryGet() {
+            return std::static_pointer_cast<T>(pop());
+        }
+
+        /**
+         * Gets first queued message without removing it, or nullptr if none is queued
+         */
+        std::shared_ptr<T> front() const {
+            return std::static_pointer_cast<T>(InputBase::front());
+        }
+    };
+
+    /**
+     * Untyped part of an output
+     */
+    class OutputBase {
+        friend class HostNode;
+        friend class HostGraph;
+
+       public:
+        OutputBase(const OutputBase&) = delete;
+        OutputBase& operator=(const OutputBase&) = delete;
+
+        /**
+         * Gets name of the output
+         */
+        const std::string& getName() const;
+
+        /**
+         * Sends messages to a device input queue. Sending blocks the pool thread while the device queue is full
+         */
+        void link(std::shared_ptr<DataInputQueue> queue);
+
+       protected:
+        OutputBase(HostNode& parent, std::string name);
+        ~OutputBase() = default;
+
+        void linkInput(InputBase& input);
+        void send(const std::shared_ptr<ADatatype>& msg);
+
+       private:
+        HostNode& parent;
+        const std::string name;
+        std::vector<InputBase*> targets;
+        std::vector<std::shared_ptr<DataInputQueue>> queues;
+
+        // Whether any blocking target is full, in which case the node isn't run
+        bool isBlocked() const;
+    };
+
+    /**
+     * Output sending messages of type T
+     */
+    template <typename T>
+    class Output : public OutputBase {
+        static_assert(std::is_base_of<ADatatype, T>::value, "Output type must derive from ADatatype");
+
+       public:
+        Output(HostNode& parent, std::string name) : OutputBase(parent, std::move(name)) {}
+
+        /**
+         * Links to an input of another node. Input type must be the same as, or a base of the output type
+         */
+        template <typename U>
+        void link(Input<U>& input) {
+            static_assert(std::is_base_of<U, T>::value, "Input type must be the same as, or a base of the output type");
+            linkInput(input);
+        }
+        using OutputBase::link;
+
+        /**
+         * Sends a message to all linked inputs and queues
+         */
+        void send(const std::shared_ptr<T>& msg) {
+            OutputBase::send(msg);
+        }
+    };
+
+    explicit HostNode(std::string name);
+    virtual ~HostNode() = default;
+
+    HostNode(const HostNode&) = delete;
+    HostNode& operator=(const HostNode&) = delete;
+
+    /**
+     * Gets name of the node
+     */
+    const std::string& getName() const;
+
+    /**
+     * Sets how many process() calls may run concurrently. Only nodes without state between calls should use more than one,
+     * and their outputs may then be out of order
+     */
+    void setMaxConcurrency(unsigned int maxConcurrency);
+
+    /**
+     * Gets how many process() calls may run concurrently
+     */
+    unsigned int getMaxConcurrency() const;
+
+    /**
+     * Gets timing and input statistics
+     */
+    Stats getStats() const;
+
+   protected:
+    /**
+     * Processes queued messages. Called when inputs waiting for messages all have one, or when any input has one if none waits.
+     * Messages are retrieved with Input::tryGet
+     */
+    virtual void process() = 0;
+
+   private:
+    const std::string name;
+    std::vector<InputBase*> inputs;
+    std::vector<OutputBase*> outputs;
+    HostGraph* graph = nullptr;
+
+    mutable std::mutex mtx;
+    std::condition_variable idleCv;
+    unsigned int maxConcurrency = 1;
+    unsigned int numActive = 0;
+    std::uint64_t numRuns = 0;
+    std::uint64_t numErrors = 0;
+    std::chrono::nanoseconds totalTime{0};
+    std::chrono::nanoseconds maxTime{0};
+
+    bool isReady() const;
+    void schedule();
+    void run();
+    void waitIdle();
+};
+
+/**
+ * Node applying a function to each message of its input, sending results which aren't nullptr
+ */
+template <typename TIn, typename TOut>
+class FunctionNode : public HostNode {
+   public:
+    Input<TIn> input{*this, "in"};
+    Output<TOut> output{*this, "out"};
+
+    FunctionNode(std::string name, std::function<std::shared_ptr<TOut>(std::shared_ptr<TIn>)> function)
+        : HostNode(std::move(name)), function(std::move(function)) {}
+
+   protected:
+    void process() override {
+        auto msg = input.tryGet();
+        if(!msg) return;
+        auto result = function(std::move(msg));
+        if(result) output.send(result);
+    }
+
+   private:
+    std::function<std::shared_ptr<TOut>(std::shared_ptr<TIn>)> function;
+};
+
+}  // namespace dai
@@ -0,0 +1,115 @@
+#pragma once
+
+// std
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// project
+#include "depthai/pipeline/datatype/ImgDetections.hpp"
+#include "depthai/pipeline/datatype/ImgFrame.hpp"
+#include "depthai/pipeline/datatype/SpatialImgDetections.hpp"
+#include "depthai/pipeline/datatype/SpatialLocationCalculatorConfig.hpp"
+#include "depthai/pipeline/datatype/SpatialLocationCalculatorData.hpp"
+
+// shared
+#include "depthai-shared/datatype/RawSpatialLocationCalculatorConfig.hpp"
+
+namespace dai {
+
+/**
+ * Host side equivalent of SpatialLocationCalculator and the spatial part of SpatialDetectionNetwork.
+ * Calculates depth statistics and spatial coordinates (X,Y,Z) for a batch of ROIs on a RAW16 depth frame.
+ *
+ * Per frame and threshold pair, integral images (average) and tiled min/max summaries are built, which keeps the per ROI cost roughly constant.
+ * Median and mode are calculated over sampled pixels, and ROIs are processed in parallel.
+ */
+class HostSpatialLocationCalculator {
+   public:
+    /// Default number of samples per ROI for MEDIAN/MODE with AUTO step size
+    static constexpr std::uint32_t DEFAULT_MAX_SAMPLES_PER_ROI = 16384;
+
+    /**
+     * Constructs a calculator for depth frames with the given horizontal field of view
+     *
+     * @param hfovDeg Horizontal field of view of the depth frame in degrees, e.g. CalibrationHandler::getFov of the aligned camera
+     */
+    explicit HostSpatialLocationCalculator(float hfovDeg);
+
+    /**
+     * Sets horizontal field of view of the depth frame, used to calculate X and Y coordinates
+     *
+     * @param hfovDeg Horizontal field of view in degrees
+     */
+    void setHfov(float hfovDeg);
+
+    /**
+     * Gets horizontal field of view of the depth frame in degrees
+     */
+    float getHfov() const;
+
+    /**
+     * Sets number of threads used to process ROIs. 0 uses all hardware threads
+     */
+    void setNumThreads(unsigned int numThreads);
+
+    /**
+     * Gets number of threads used to process ROIs
+     */
+    unsigned int getNumThreads() const;
+
+    /**
+     * Limits the number of sampled pixels per ROI for MEDIAN and MODE algorithms when step size is AUTO.
+     * Larger ROIs are sampled with a coarser step. Explicit step sizes are always honored.
+     *
+     * @param maxSamples Maximum number of samples per ROI
+     */
+    void setMaxSamplesPerRoi(std::uint32_t maxSamples);
+
+    /**
+     * Gets maximum number of sampled pixels per ROI for MEDIAN and MODE algorithms
+     */
+    std::uint32_t getMaxSamplesPerRoi() const;
+
+    /**
+     * Calculates spatial locations of given ROIs
+     *
+     * @param depth RAW16 depth frame
+     * @param rois Configuration for each ROI: region, thresholds, algorithm and step size
+     * @returns SpatialLocationCalculatorData with one entry per ROI, in the same order
+     */
+    std::shared_ptr<SpatialLocationCalculatorData> calculate(const ImgFrame& depth, const std::vector<SpatialLocationCalculatorConfigData>& rois) const;
+
+    /**
+     * Calculates spatial locations of ROIs carried by a SpatialLocationCalculatorConfig message
+     *
+     * @param depth RAW16 depth frame
+     * @param config Configuration message
+     * @returns SpatialLocationCalculatorData with one entry per ROI, in the same order
+     */
+    std::shared_ptr<SpatialLocationCalculatorData> calculate(const ImgFrame& depth, const SpatialLocationCalculatorConfig& config) const;
+
+    /**
+     * Calculates spatial coordinates of detections, same as SpatialDetectionNetwork.
+     * Detections must be normalized and correspond to the depth frame field of view.
+     *
+     * @param depth RAW16 depth frame
+     * @param detections Detections to localize
+     * @param settings Thresholds, algorithm and step size used for all detections. ROI is ignored
+     * @param boundingBoxScaleFactor Scale factor for detected bounding boxes, in the interval (0,1]
+     * @returns SpatialImgDetections with one entry per detection, in the same order
+     */
+    std::shared_ptr<SpatialImgDetections> calculate(const ImgFrame& depth,
+                                                    const ImgDetections& detections,
+                                                    const SpatialLocationCalculatorConfigData& settings = {},
+                                                    float boundingBoxScaleFactor = 1.0f) const;
+
+   private:
+    float hfovDeg;
+    unsigned int numThreads = 0;
+    std::uint32_t maxSamplesPerRoi = DEFAULT_MAX_SAMPLES_PER_ROI;
+
+    std::vector<SpatialLocations> calculateLocations(const ImgFrame& depth, const std::vector<SpatialLocationCalculatorConfigData>& rois) const;
+};
+
+}  // namespace dai
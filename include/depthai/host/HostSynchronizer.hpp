@@ -0,0 +1,251 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "depthai/device/DataQueue.hpp"
+#include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/pipeline/datatype/MessageGroup.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+
+namespace dai {
+
+/**
+ * Host side equivalent of the Sync node. Groups messages from multiple streams,
+ * e.g. DataOutputQueues of different devices, into MessageGroups whose members' timestamps are within a threshold.
+ *
+ * Each stream keeps a bounded, timestamp ordered buffer. A group is formed as soon as every stream has a message
+ * within the threshold of the latest "oldest" message across streams. Messages that can no longer be matched are dropped.
+ */
+class HostSynchronizer {
+   public:
+    /// Alias for callback id
+    using CallbackId = int;
+
+    /// Which message timestamp is used for matching
+    enum class TimestampSource {
+        /// Buffer::getTimestamp, synchronized to host clock. Use when combining multiple devices
+        HOST,
+        /// Buffer::getTimestampDevice, device clock. Only comparable between streams of the same device
+        DEVICE
+    };
+
+    /// What happens when a stream buffer is full
+    enum class OverflowPolicy {
+        /// Drop the oldest buffered message of the stream
+        DROP_OLDEST,
+        /// Drop the newly received message
+        DROP_NEWEST
+    };
+
+    /// Per stream statistics
+    struct StreamStats {
+        /// Number of received messages
+        std::uint64_t received = 0;
+        /// Number of messages which were emitted as part of a group
+        std::uint64_t matched = 0;
+        /// Number of messages dropped, either unmatched or on overflow
+        std::uint64_t dropped = 0;
+        /// Number of messages currently buffered
+        std::uint64_t buffered = 0;
+    };
+
+    /// Synchronizer statistics
+    struct Stats {
+        /// Number of emitted groups
+        std::uint64_t numGroups = 0;
+        /// Ratio of matched to received messages across all streams
+        float matchRate = 0.0f;
+        /// Average time between arrival of the first member of a group and its emission
+        std::chrono::microseconds averageLatency{0};
+        /// Maximum time between arrival of the first member of a group and its emission
+        std::chrono::microseconds maxLatency{0};
+        /// Statistics of each stream
+        std::unordered_map<std::string, StreamStats> streams;
+    };
+
+    /**
+     * Constructs a synchronizer
+     *
+     * @param threshold Maximal interval between the oldest and the newest message in a group
+     * @param source Which timestamp is used for matching
+     */
+    explicit HostSynchronizer(std::chrono::nanoseconds threshold = std::chrono::milliseconds(10), TimestampSource source = TimestampSource::HOST);
+    ~HostSynchronizer();
+
+    HostSynchronizer(const HostSynchronizer&) = delete;
+    HostSynchronizer& operator=(const HostSynchronizer&) = delete;
+
+    /**
+     * Attaches an output queue as a stream. Messages are consumed through the synchronizer,
+     * so the queue's own buffering is disabled (max size 0) to keep its reading thread from blocking.
+     *
+     * @param name Name of the stream, used as the name of the message in the emitted groups
+     * @param queue Queue to attach
+     */
+    void add(const std::string& name, std::shared_ptr<DataOutputQueue> queue);
+
+    /**
+     * Adds a stream which is fed manually with send()
+     *
+     * @param name Name of the stream
+     */
+    void addStream(const std::string& name);
+
+    /**
+     * Feeds a message to a stream
+     *
+     * @param name Name of the stream
+     * @param msg Message
+     */
+    void send(const std::string& name, const std::shared_ptr<ADatatype>& msg);
+
+    /**
+     * Sets maximal interval between the oldest and the newest message in a group
+     */
+    void setThreshold(std::chrono::nanoseconds threshold);
+
+    /**
+     * Gets maximal interval between the oldest and the newest message in a group
+     */
+    std::chrono::nanoseconds getThreshold() const;
+
+    /**
+     * Sets maximum number of buffered messages per stream and what to do when a buffer is full
+     *
+     * @param maxSize Maximum number of messages per stream
+     * @param policy Overflow policy
+     */
+    void setMaxBufferSize(unsigned int maxSize, OverflowPolicy policy = OverflowPolicy::DROP_OLDEST);
+
+    /**
+     * Gets maximum number of buffered messages per stream
+     */
+    unsigned int getMaxBufferSize() const;
+
+    /**
+     * Sets a callback which receives messages that were dropped, either unmatched or on overflow
+     *
+     * @param callback Callback function with stream name and message pointer
+     */
+    void setDroppedCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback);
+
+    /**
+     * Adds a callback on emitted group
+     *
+     * @param callback Callback function with group pointer
+     * @returns Callback id
+     */
+    CallbackId addCallback(std::function<void(std::shared_ptr<MessageGroup>)> callback);
+
+    /**
+     * Removes a callback
+     *
+     * @param callbackId Id of callback to be removed
+     * @returns True if callback was removed, false otherwise
+     */
+    bool removeCallback(CallbackId callbackId);
+
+    /**
+     * Sets maximum number of emitted groups kept in the output queue. When full, the oldest group is overwritten
+     *
+     * @param maxSize Maximum number of groups
+     */
+    void setMaxSize(unsigned int maxSize);
+
+    /**
+     * Gets maximum number of emitted groups kept in the output queue
+     */
+    unsigned int getMaxSize() const;
+
+    /**
+     * Try to retrieve a group. If no group available, return immediately with nullptr
+     *
+     * @returns Group or nullptr if no group available
+     */
+    std::shared_ptr<MessageGroup> tryGet();
+
+    /**
+     * Block until a group is available
+     *
+     * @returns Group
+     */
+    std::shared_ptr<MessageGroup> get();
+
+    /**
+     * Block until a group is available with a timeout
+     *
+     * @param timeout Duration for which the function should block
+     * @param[out] hasTimedout Outputs true if timeout occurred, false otherwise
+     * @returns Group or nullptr if timeout occurred
+     */
+    template <typename Rep, typename Period>
+    std::shared_ptr<MessageGroup> get(std::chrono::duration<Rep, Period> timeout, bool& hasTimedout) {
+        std::shared_ptr<MessageGroup> val = nullptr;
+        hasTimedout = !output.tryWaitAndPop(val, timeout);
+        return val;
+    }
+
+    /**
+     * Retrieves statistics
+     */
+    Stats getStats() const;
+
+    /**
+     * Resets statistics
+     */
+    void resetStats();
+
+    /**
+     * Detaches from all queues and unblocks waiting get() calls
+     */
+    void close();
+
+   private:
+    using Timepoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>;
+
+    struct Entry {
+        Timepoint ts;
+        Timepoint arrival;
+        std::shared_ptr<ADatatype> msg;
+    };
+
+    struct Stream {
+        std::string name;
+        std::deque<Entry> buffer;
+        StreamStats stats;
+        std::shared_ptr<DataOutputQueue> queue;
+        DataOutputQueue::CallbackId queueCallbackId = 0;
+    };
+
+    mutable std::mutex mtx;
+    std::vector<Stream> streams;
+    std::chrono::nanoseconds threshold;
+    TimestampSource source;
+    unsigned int maxBufferSize = 30;
+    OverflowPolicy overflowPolicy = OverflowPolicy::DROP_OLDEST;
+    std::function<void(std::string, std::shared_ptr<ADatatype>)> droppedCallback;
+    std::uint64_t numGroups = 0;
+    std::chrono::nanoseconds latencySum{0};
+    std::chrono::nanoseconds latencyMax{0};
+
+    LockingQueue<std::shared_ptr<MessageGroup>> output{8, false};
+    std::mutex callbacksMtx;
+    std::unordered_map<CallbackId, std::function<void(std::shared_ptr<MessageGroup>)>> callbacks;
+    CallbackId uniqueCallbackId{0};
+
+    Stream& findStream(const std::string& name);
+    std::vector<std::shared_ptr<MessageGroup>> match(std::vector<std::pair<std::string, std::shared_ptr<ADatatype>>>& dropped);
+    void dispatch(std::vector<std::shared_ptr<MessageGroup>>& groups, std::vector<std::pair<std::string, std::shared_ptr<ADatatype>>>& dropped);
+};
+
+}  // namespace dai
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "depthai-shared/pipeline/Assets.hpp"
@@ -16,9 +19,90 @@ struct Asset {
     Asset() = default;
     explicit Asset(std::string k) : key(std::move(k)) {}
     const std::string key;
+    /// In memory data. Empty for file backed assets (see mapped), getData() and getSize() cover both
     std::vector<std::uint8_t> data;
     std::uint32_t alignment = 1;
+    /// Read only file backed data, used instead of data when set. Only created by AssetManager::setMapped
+    std::shared_ptr<const std::uint8_t> mapped;
+    std::size_t mappedSize = 0;
     std::string getRelativeUri();
+
+    /// @returns Pointer to asset data, either mapped or in memory
+    const std::uint8_t* getData() const;
+    /// @returns Size of asset data, either mapped or in memory
+    std::size_t getSize() const;
+};
+
+/**
+ * @brief Layout of serialized assets, which references asset data instead of copying it.
+ * Assets are content addressed, so identical data added under several keys is stored once
+ */
+class AssetStorage {
+   public:
+    /// Content hash of asset data
+    using Hash = std::uint64_t;
+
+    /// Asset placed at an offset in storage, preceded by zero padding up to that offset
+    struct Chunk {
+        std::size_t offset;
+        std::shared_ptr<const Asset> asset;
+        Hash hash;
+    };
+
+    /**
+     * Places an asset at the end of storage, respecting its alignment.
+     * If storage already holds identical data at a suitably aligned offset, that offset is reused instead
+     *
+     * @returns Offset of the asset in storage
+     */
+    std::size_t add(std::shared_ptr<const Asset> asset);
+
+    /// @returns Chunks in order of their offsets
+    const std::vector<Chunk>& getChunks() const;
+
+    /// @returns Total size of storage
+    std::size_t size() const;
+
+    /// @returns True if storage holds no data
+    bool empty() const;
+
+    /**
+     * Passes storage contents, including padding, to a writer as consecutive pieces of at most maxSize bytes.
+     * Pieces are taken directly from asset data where possible and only assembled in a buffer across chunk boundaries
+     *
+     * @param maxSize Maximum size of a single piece
+     * @param writer Function called with each piece
+     */
+    void write(std::size_t maxSize, const std::function<void(const std::uint8_t*, std::size_t)>& writer) const;
+
+    /**
+     * Same as write, but leaves out data of chunks the receiver already holds, e.g. matched by their hashes.
+     * Padding and data of remaining chunks are written in order, so a receiver can rebuild storage from the chunk layout
+     *
+     * @param maxSize Maximum size of a single piece
+     * @param writer Function called with each piece
+     * @param skip Returns true for chunks whose data should be left out
+     */
+    void write(std::size_t maxSize,
+               const std::function<void(const std::uint8_t*, std::size_t)>& writer,
+               const std::function<bool(const Chunk&)>& skip) const;
+
+    /// @returns Contents of storage as a single contiguous buffer
+    std::vector<std::uint8_t> toVector() const;
+
+    /// @returns Number of bytes which weren't stored again, as identical data was already present
+    std::size_t getDeduplicatedSize() const;
+
+    /**
+     * Computes content hash of given data, as used for chunks
+     */
+    static Hash hash(const std::uint8_t* data, std::size_t size);
+
+   private:
+    std::vector<Chunk> chunks;
+    std::unordered_map<Hash, std::vector<std::size_t>> chunksByHash;
+    std::size_t storageSize = 0;
+    std::size_t deduplicatedSize = 0;
 };
 
 class AssetsMutable : public Assets {
@@ -66,6 +150,17 @@ class AssetManager /*: public Assets*/ {
      */
     std::shared_ptr<dai::Asset> set(const std::string& key, const dai::Path& path, int alignment = 64);
 
+    /**
+     * Loads file into asset manager under specified key, without reading it if large.
+     * Files of 1MiB or more are memory mapped and stay file backed until transferred, so they must not be modified
+     * while the asset is in use. Their Asset::data is empty, data is accessed through Asset::getData() and getSize()
+     *
+     * @param key Key under which the asset should be stored
+     * @param path Path to file which to load as asset
+     * @param alignment [Optional] alignment of asset data in asset storage. Default is 64B
+     */
+    std::shared_ptr<dai::Asset> setMapped(const std::string& key, const dai::Path& path, int alignment = 64);
+
     /**
      * Loads file into asset manager under specified key.
      *
@@ -110,6 +205,9 @@ class AssetManager /*: public Assets*/ {
 
     /// Serializes
     void serialize(AssetsMutable& assets, std::vector<std::uint8_t>& assetStorage, std::string prefix = "") const;
+
+    /// Serializes without copying asset data
+    void serialize(AssetsMutable& assets, AssetStorage& assetStorage, std::string prefix = "") const;
 };
 
 }  // namespace dai
@@ -63,6 +63,13 @@ class NNData : public Buffer {
      */
     NNData& setLayer(const std::string& name, std::vector<double> data);
 
+    /**
+     * Set a layer with datatype FP16 from values already in IEEE half precision format, which are stored as is.
+     * @param name Name of the layer
+     * @param data Data to store
+     */
+    NNData& setLayerFp16(const std::string& name, std::vector<std::uint16_t> data);
+
     // getters
     /**
      * @returns Names of all layers added
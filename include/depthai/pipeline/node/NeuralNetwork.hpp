@@ -59,6 +59,8 @@ class NeuralNetwork : public NodeCRTP<Node, NeuralNetwork, NeuralNetworkProperti
     // Specify local filesystem path to load the blob (which gets loaded at loadAssets)
     /**
      * Load network blob into assets and use once pipeline is started.
+     * Large blobs stay memory mapped until transferred (see AssetManager::setMapped), so the file must not be modified
+     * in the meantime, and the blob asset's data is accessed through Asset::getData() and getSize()
      *
      * @throws Error if file doesn't exist or isn't a valid network blob.
      * @param path Path to network blob
@@ -1,10 +1,11 @@
 #pragma once
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <mutex>
-#include <queue>
 
 namespace dai {
 
@@ -38,6 +39,45 @@ class LockingQueue {
         return blocking;
     }
 
+    /// Limits total bytes of queued elements, as given when pushed or measured. Zero disables the limit
+    void setMaxBytes(std::size_t bytes) {
+        {
+            std::unique_lock<std::mutex> lock(guard);
+            const bool remeasure = measure && (maxBytes == 0) != (bytes == 0);
+            maxBytes = bytes;
+            if(remeasure) {
+                // Elements are only measured while limited, so account the queued ones anew
+                numBytes = 0;
+                for(std::size_t i = 0; i < queue.size(); i++) {
+                    sizes[i] = bytesOf(queue[i], 0);
+                    numBytes += sizes[i];
+                }
+            }
+        }
+        // Waiting pushes may fit now
+        signalPop.notify_all();
+    }
+
+    /**
+     * Measures bytes of pushed elements, instead of taking them as given. Elements are measured only while a byte limit
+     * is set, while holding the lock, so measuring should be cheap
+     */
+    void setMeasure(std::function<std::size_t(const T&)> fn) {
+        std::unique_lock<std::mutex> lock(guard);
+        measure = std::move(fn);
+    }
+
+    std::size_t getMaxBytes() const {
+        std::unique_lock<std::mutex> lock(guard);
+        return maxBytes;
+    }
+
+    /// Total bytes of queued elements
+    std::size_t getBytes() const {
+        std::unique_lock<std::mutex> lock(guard);
+        return numBytes;
+    }
+
     void destruct() {
         std::unique_lock<std::mutex> lock(guard);
         if(!destructed) {
@@ -61,7 +101,7 @@ class LockingQueue {
             // Continue here if and only if queue has any elements
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -79,7 +119,7 @@ class LockingQueue {
 
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -95,7 +135,7 @@ class LockingQueue {
 
             while(!queue.empty()) {
                 callback(queue.front());
-                queue.pop();
+                popFront();
             }
         }
 
@@ -103,58 +143,72 @@ class LockingQueue {
         return true;
     }
 
-    bool push(T const& data) {
+    /**
+     * Pushes an element, blocking or overwriting oldest elements while either the element count or byte limit is exceeded.
+     * An element larger than the byte limit is still accepted into an empty queue
+     */
+    bool push(T const& data, std::size_t bytes = 0) {
         {
             std::unique_lock<std::mutex> lock(guard);
             if(maxSize == 0) {
-                // necessary if maxSize was changed
+                // necessary if maxSize was changed. Elements passing through an unbuffered queue aren't dropped ones
+                numDropped += queue.size();
                 while(!queue.empty()) {
-                    queue.pop();
+                    popFront();
                 }
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                bytes = bytesOf(data, bytes);
+                while(!queue.empty() && !fits(bytes)) {
+                    popFront();
+                    numDropped++;
                 }
             } else {
-                signalPop.wait(lock, [this]() { return queue.size() < maxSize || destructed; });
+                signalPop.wait(lock, [this, &data, &bytes]() { return fits(bytes = bytesOf(data, bytes)) || destructed; });
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            queue.push_back(data);
+            sizes.push_back(bytes);
+            numBytes += bytes;
         }
         signalPush.notify_all();
         return true;
     }
 
     template <typename Rep, typename Period>
-    bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout) {
+    bool tryWaitAndPush(T const& data, std::chrono::duration<Rep, Period> timeout, std::size_t bytes = 0) {
         {
             std::unique_lock<std::mutex> lock(guard);
             if(maxSize == 0) {
-                // necessary if maxSize was changed
+                // necessary if maxSize was changed. Elements passing through an unbuffered queue aren't dropped ones
+                numDropped += queue.size();
                 while(!queue.empty()) {
-                    queue.pop();
+                    popFront();
                 }
                 return true;
             }
             if(!blocking) {
                 // if non blocking, remove as many oldest elements as necessary, so next one will fit
                 // necessary if maxSize was changed
-                while(queue.size() >= maxSize) {
-                    queue.pop();
+                bytes = bytesOf(data, bytes);
+                while(!queue.empty() && !fits(bytes)) {
+                    popFront();
+                    numDropped++;
                 }
             } else {
                 // First checks predicate, then waits
-                bool pred = signalPop.wait_for(lock, timeout, [this]() { return queue.size() < maxSize || destructed; });
+                bool pred = signalPop.wait_for(lock, timeout, [this, &data, &bytes]() { return fits(bytes = bytesOf(data, bytes)) || destructed; });
                 if(!pred) return false;
                 if(destructed) return false;
             }
 
-            queue.push(data);
+            queue.push_back(data);
+            sizes.push_back(bytes);
+            numBytes += bytes;
         }
         signalPush.notify_all();
         return true;
@@ -165,6 +219,17 @@ class LockingQueue {
         return queue.empty();
     }
 
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(guard);
+        return queue.size();
+    }
+
+    /// Number of elements discarded to make room for new ones, or pushed while maxSize was zero
+    std::uint64_t getNumDropped() const {
+        std::lock_guard<std::mutex> lock(guard);
+        return numDropped;
+    }
+
     bool front(T& value) {
         std::unique_lock<std::mutex> lock(guard);
         if(queue.empty()) {
@@ -183,7 +248,7 @@ class LockingQueue {
             }
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -198,7 +263,7 @@ class LockingQueue {
             if(destructed) return false;
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -215,7 +280,7 @@ class LockingQueue {
             if(destructed) return false;
 
             value = std::move(queue.front());
-            queue.pop();
+            popFront();
         }
         signalPop.notify_all();
         return true;
@@ -229,11 +294,35 @@ class LockingQueue {
    private:
     unsigned maxSize = std::numeric_limits<unsigned>::max();
     bool blocking = true;
-    std::queue<T> queue;
+    std::size_t maxBytes = 0;
+    std::deque<T> queue;
+    // Bytes of each element, in lockstep with queue
+    std::deque<std::size_t> sizes;
+    std::size_t numBytes = 0;
+    std::function<std::size_t(const T&)> measure;
     mutable std::mutex guard;
     bool destructed{false};
+    std::uint64_t numDropped{0};
     std::condition_variable signalPop;
     std::condition_variable signalPush;
+
+    // Whether an element of given bytes can be pushed without exceeding limits. Expects lock to be held
+    bool fits(std::size_t bytes) const {
+        if(queue.size() >= maxSize) return false;
+        return maxBytes == 0 || queue.empty() || numBytes + bytes <= maxBytes;
+    }
+
+    // Bytes of an element, measured if a measure is set. Expects lock to be held
+    std::size_t bytesOf(const T& data, std::size_t given) const {
+        if(!measure) return given;
+        return maxBytes == 0 ? 0 : measure(data);
+    }
+
+    void popFront() {
+        numBytes -= sizes.front();
+        sizes.pop_front();
+        queue.pop_front();
+    }
 };
 
 }  // namespace dai
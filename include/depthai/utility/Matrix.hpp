@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace dai {
+
+/// Row-major 3x3 float matrix
+using Matrix3f = std::array<std::array<float, 3>, 3>;
+/// Row-major 4x4 float matrix, used for homogeneous transformations
+using Matrix4f = std::array<std::array<float, 4>, 4>;
+
+namespace matrix {
+
+/**
+ * @brief Returns an N x N identity matrix
+ */
+template <std::size_t N>
+inline std::array<std::array<float, N>, N> identity() {
+    std::array<std::array<float, N>, N> res{};
+    for(std::size_t i = 0; i < N; ++i) {
+        res[i][i] = 1.0f;
+    }
+    return res;
+}
+
+/**
+ * @brief Multiplies two fixed size square matrices -> a * b
+ */
+template <std::size_t N>
+inline std::array<std::array<float, N>, N> multiply(const std::array<std::array<float, N>, N>& a, const std::array<std::array<float, N>, N>& b) {
+    std::array<std::array<float, N>, N> res{};
+    for(std::size_t i = 0; i < N; ++i) {
+        for(std::size_t k = 0; k < N; ++k) {
+            const float aik = a[i][k];
+            for(std::size_t j = 0; j < N; ++j) {
+                res[i][j] += aik * b[k][j];
+            }
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Inverts a rigid (SE(3)) 4x4 transformation. The inverse of (R, t) is (R^T, -R^T t)
+ */
+inline Matrix4f invertSe3(const Matrix4f& mat) {
+    Matrix4f res = identity<4>();
+    for(std::size_t i = 0; i < 3; ++i) {
+        for(std::size_t j = 0; j < 3; ++j) {
+            res[i][j] = mat[j][i];
+        }
+    }
+    for(std::size_t i = 0; i < 3; ++i) {
+        res[i][3] = 0;
+        for(std::size_t j = 0; j < 3; ++j) {
+            res[i][3] -= res[i][j] * mat[j][3];
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Converts a fixed size matrix to a vector of vectors representation
+ */
+template <std::size_t N>
+inline std::vector<std::vector<float>> toVector(const std::array<std::array<float, N>, N>& mat) {
+    std::vector<std::vector<float>> res(N);
+    for(std::size_t i = 0; i < N; ++i) {
+        res[i].assign(mat[i].begin(), mat[i].end());
+    }
+    return res;
+}
+
+}  // namespace matrix
+}  // namespace dai
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+
 namespace dai {
 
 struct ProfilingData {
@@ -7,4 +12,77 @@ struct ProfilingData {
     long long numBytesRead;
 };
 
+/// Traffic of a single XLink stream
+struct StreamProfilingData {
+    long long numBytesWritten = 0;
+    long long numBytesRead = 0;
+    long long numPacketsWritten = 0;
+    long long numPacketsRead = 0;
+    /// Time spent blocked in writes, waiting for the device to accept packets
+    std::chrono::nanoseconds writeStallTime{0};
+    /// Time spent in reads, waiting for packets to arrive
+    std::chrono::nanoseconds readWaitTime{0};
+    /// Smallest packet written or read, zero if none
+    long long minPacketSize = 0;
+    /// Largest packet written or read, zero if none
+    long long maxPacketSize = 0;
+    /// Write rate in bytes per second, only set by windowed queries
+    float writeRate = 0.0f;
+    /// Read rate in bytes per second, only set by windowed queries
+    float readRate = 0.0f;
+};
+
+/**
+ * Thread safe, lock free accumulator of a stream's traffic
+ */
+class StreamProfilingCounters {
+   public:
+    void recordWrite(std::size_t size, std::chrono::steady_clock::duration stall) {
+        numBytesWritten.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        numPacketsWritten.fetch_add(1, std::memory_order_relaxed);
+        writeStallTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(stall).count(), std::memory_order_relaxed);
+        recordSize(static_cast<long long>(size));
+    }
+
+    void recordRead(std::size_t size, std::chrono::steady_clock::duration wait) {
+        numBytesRead.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+        numPacketsRead.fetch_add(1, std::memory_order_relaxed);
+        readWaitTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count(), std::memory_order_relaxed);
+        recordSize(static_cast<long long>(size));
+    }
+
+    StreamProfilingData get() const {
+        StreamProfilingData data;
+        data.numBytesWritten = numBytesWritten.load(std::memory_order_relaxed);
+        data.numBytesRead = numBytesRead.load(std::memory_order_relaxed);
+        data.numPacketsWritten = numPacketsWritten.load(std::memory_order_relaxed);
+        data.numPacketsRead = numPacketsRead.load(std::memory_order_relaxed);
+        data.writeStallTime = std::chrono::nanoseconds(writeStallTime.load(std::memory_order_relaxed));
+        data.readWaitTime = std::chrono::nanoseconds(readWaitTime.load(std::memory_order_relaxed));
+        const auto minSize = minPacketSize.load(std::memory_order_relaxed);
+        data.minPacketSize = minSize == std::numeric_limits<long long>::max() ? 0 : minSize;
+        data.maxPacketSize = maxPacketSize.load(std::memory_order_relaxed);
+        return data;
+    }
+
+   private:
+    std::atomic<long long> numBytesWritten{0};
+    std::atomic<long long> numBytesRead{0};
+    std::atomic<long long> numPacketsWritten{0};
+    std::atomic<long long> numPacketsRead{0};
+    std::atomic<long long> writeStallTime{0};
+    std::atomic<long long> readWaitTime{0};
+    std::atomic<long long> minPacketSize{std::numeric_limits<long long>::max()};
+    std::atomic<long long> maxPacketSize{0};
+
+    void recordSize(long long size) {
+        auto current = minPacketSize.load(std::memory_order_relaxed);
+        while(size < current && !minPacketSize.compare_exchange_weak(current, size, std::memory_order_relaxed)) {
+        }
+        current = maxPacketSize.load(std::memory_order_relaxed);
+        while(size > current && !maxPacketSize.compare_exchange_weak(current, size, std::memory_order_relaxed)) {
+        }
+    }
+};
+
 }  // namespace dai
@@ -0,0 +1,136 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "depthai/xlink/XLinkConnection.hpp"
+
+namespace dai {
+
+/**
+ * Process wide table of connected devices.
+ *
+ * A single background scanner keeps the table up to date while it is in use, i.e. while there are subscribers,
+ * threads waiting for devices, or the table was read recently. Readers get the table without re-enumerating,
+ * waiters are woken as soon as a scan finds a matching device, and subscribers are notified when devices appear,
+ * change state or disappear.
+ */
+class DeviceDiscovery {
+   public:
+    /// Alias for callback id
+    using CallbackId = int;
+
+    /// Default interval between scans of the background scanner
+    static constexpr std::chrono::milliseconds DEFAULT_SCAN_INTERVAL{100};
+    /// Default time for which the scanner keeps running after the table was last accessed
+    static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{3000};
+
+    /// Kind of change in the device table
+    enum class Event {
+        /// Device appeared
+        ADDED,
+        /// Device changed state or status, e.g. was booted
+        CHANGED,
+        /// Device disappeared
+        REMOVED
+    };
+
+    static DeviceDiscovery& getInstance();
+    DeviceDiscovery(const DeviceDiscovery&) = delete;
+    void operator=(const DeviceDiscovery&) = delete;
+
+    /**
+     * Returns all connected devices. Uses the table if it is up to date, otherwise scans once (shared by concurrent callers)
+     *
+     * @param skipInvalidDevices Whether or not to skip over devices that cannot be successfully communicated with
+     * @returns Vector of connected device information
+     */
+    std::vector<DeviceInfo> getDevices(bool skipInvalidDevices = true);
+
+    /**
+     * Waits until the table satisfies a predicate or timeout passes
+     *
+     * @param predicate Predicate evaluated on the table, including invalid devices, after every change
+     * @param timeout Maximum time to wait
+     * @returns Device table at the time the predicate was satisfied or timeout passed
+     */
+    std::vector<DeviceInfo> waitFor(const std::function<bool(const std::vector<DeviceInfo>&)>& predicate, std::chrono::milliseconds timeout);
+
+    /**
+     * Adds a callback on changes of the device table. Keeps the background scanner running until removed.
+     * Callbacks are called in order of events from the thread which performed the scan, usually the scanner thread.
+     * They may use the table and add or remove callbacks, including themselves
+     *
+     * @param callback Callback function with the kind of change and the (new) device information
+     * @returns Callback id
+     */
+    CallbackId addCallback(std::function<void(Event, DeviceInfo)> callback);
+
+    /**
+     * Removes a callback. It might still be running or receive the event currently being delivered
+     *
+     * @param callbackId Id of callback to be removed
+     * @returns True if callback was removed, false otherwise
+     */
+    bool removeCallback(CallbackId callbackId);
+
+    /**
+     * Sets interval between scans of the background scanner
+     */
+    void setScanInterval(std::chrono::milliseconds interval);
+
+    /**
+     * Gets interval between scans of the background scanner
+     */
+    std::chrono::milliseconds getScanInterval() const;
+
+    /**
+     * Marks the table as outdated, so the next read scans again. Useful after changing a device's state
+     */
+    void invalidate();
+
+   private:
+    DeviceDiscovery() = default;
+    ~DeviceDiscovery();
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<DeviceInfo> devices;
+    std::uint64_t generation = 0;
+    std::chrono::steady_clock::time_point lastScan;
+    std::chrono::steady_clock::time_point lastAccess;
+    bool scanning = false;
+    int numWaiters = 0;
+    std::chrono::milliseconds scanInterval = DEFAULT_SCAN_INTERVAL;
+
+    bool scannerRunning = false;
+    bool stopping = false;
+    std::thread scannerThread;
+
+    std::mutex callbacksMtx;
+    std::unordered_map<CallbackId, std::function<void(Event, DeviceInfo)>> callbacks;
+    CallbackId uniqueCallbackId{0};
+    int numCallbacks = 0;
+
+    // Events of finished scans, delivered in order by a single thread at a time without holding any lock
+    std::mutex eventsMtx;
+    std::deque<std::pair<Event, DeviceInfo>> pendingEvents;
+    bool delivering = false;
+
+    bool isFresh() const;
+    void scan(std::unique_lock<std::mutex>& lock);
+    void deliverEvents();
+    void ensureScanner();
+    void scannerLoop();
+};
+
+}  // namespace dai
@@ -4,7 +4,9 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -93,6 +95,10 @@ class XLinkConnection {
     static ProfilingData getGlobalProfilingData();
 
     XLinkConnection(const DeviceInfo& deviceDesc, std::vector<std::uint8_t> mvcmdBinary, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
+    /// Boots from a shared image, which isn't copied. Lets boots of multiple devices use the same image
+    XLinkConnection(const DeviceInfo& deviceDesc,
+                    std::shared_ptr<const std::vector<std::uint8_t>> mvcmdBinary,
+                    XLinkDeviceState_t expectedState = X_LINK_BOOTED);
     XLinkConnection(const DeviceInfo& deviceDesc, dai::Path pathToMvcmd, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
     explicit XLinkConnection(const DeviceInfo& deviceDesc, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
 
@@ -126,12 +132,37 @@ class XLinkConnection {
      */
     ProfilingData getProfilingData();
 
+    /**
+     * Get counters of a stream, shared by all XLinkStreams of the same name on this connection
+     *
+     * @param name Stream name
+     * @returns Counters which streams update on each packet
+     */
+    std::shared_ptr<StreamProfilingCounters> getStreamProfilingCounters(const std::string& name);
+
+    /**
+     * Get per stream profiling data, accumulated since connecting
+     *
+     * @returns Map of stream name to its profiling data
+     */
+    std::unordered_map<std::string, StreamProfilingData> getStreamProfilingData();
+
+    /**
+     * Get per stream profiling data of a recent time window, including rates.
+     * Window is measured against snapshots taken by previous calls, so its start is the newest snapshot at least
+     * 'window' old, or connection start if there is none. Min and max packet sizes are since connecting
+     *
+     * @param window Time window
+     * @returns Map of stream name to its profiling data within the window
+     */
+    std::unordered_map<std::string, StreamProfilingData> getStreamProfilingData(std::chrono::milliseconds window);
+
    private:
     friend struct XLinkReadError;
     friend struct XLinkWriteError;
     // static
     static bool bootAvailableDevice(const deviceDesc_t& deviceToBoot, const dai::Path& pathToMvcmd);
-    static bool bootAvailableDevice(const deviceDesc_t& deviceToBoot, std::vector<std::uint8_t>& mvcmd);
+    static bool bootAvailableDevice(const deviceDesc_t& deviceToBoot, const std::vector<std::uint8_t>& mvcmd);
     static std::string convertErrorCodeToString(XLinkError_t errorCode);
 
     void initDevice(const DeviceInfo& deviceToInit, XLinkDeviceState_t expectedState = X_LINK_BOOTED);
@@ -139,7 +170,7 @@ class XLinkConnection {
     bool bootDevice = true;
     bool bootWithPath = true;
     dai::Path pathToMvcmd;
-    std::vector<std::uint8_t> mvcmd;
+    std::shared_ptr<const std::vector<std::uint8_t>> mvcmd;
 
     bool rebootOnDestruction{true};
 
@@ -151,6 +182,13 @@ class XLinkConnection {
     mutable std::mutex closedMtx;
     bool closed{false};
 
+    // Per stream profiling
+    using StreamProfilingSnapshot = std::pair<std::chrono::steady_clock::time_point, std::unordered_map<std::string, StreamProfilingData>>;
+    std::mutex streamProfilingMtx;
+    std::unordered_map<std::string, std::shared_ptr<StreamProfilingCounters>> streamProfilingCounters;
+    std::chrono::steady_clock::time_point streamProfilingStart = std::chrono::steady_clock::now();
+    std::deque<StreamProfilingSnapshot> streamProfilingHistory;
+
     constexpr static std::chrono::milliseconds WAIT_FOR_BOOTUP_TIMEOUT{15000};
     constexpr static std::chrono::milliseconds WAIT_FOR_CONNECT_TIMEOUT{5000};
     constexpr static std::chrono::milliseconds POLLING_DELAY_TIME{10};
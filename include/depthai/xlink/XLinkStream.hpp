@@ -42,6 +42,7 @@ class XLinkStream {
     std::shared_ptr<XLinkConnection> connection;
     std::string streamName;
     streamId_t streamId{INVALID_STREAM_ID};
+    std::shared_ptr<StreamProfilingCounters> profilingCounters;
 
    public:
     XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std::string& name, std::size_t maxWriteSize);
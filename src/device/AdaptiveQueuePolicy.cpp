@@ -0,0 +1,298 @@
+#include "depthai/device/AdaptiveQueuePolicy.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+// project
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+constexpr std::size_t AdaptiveQueuePolicy::MAX_ADJUSTMENTS;
+constexpr float AdaptiveQueuePolicy::KEEPING_UP_RATIO;
+
+namespace {
+
+class OutputQueue : public AdaptiveQueuePolicy::Queue {
+   public:
+    explicit OutputQueue(std::shared_ptr<DataOutputQueue> queue) : queue(std::move(queue)) {}
+    QueueStats getStats() const override {
+        return queue->getStats();
+    }
+    void setMaxSize(unsigned maxSize) override {
+        queue->setMaxSize(maxSize);
+    }
+    void setBlocking(bool blocking) override {
+        queue->setBlocking(blocking);
+    }
+    bool isClosed() const override {
+        return queue->isClosed();
+    }
+
+   private:
+    std::shared_ptr<DataOutputQueue> queue;
+};
+
+}  // namespace
+
+AdaptiveQueuePolicy::AdaptiveQueuePolicy() : AdaptiveQueuePolicy(Config{}) {}
+
+AdaptiveQueuePolicy::AdaptiveQueuePolicy(Config config) : config(config), lastUpdate(std::chrono::steady_clock::now()) {
+    if(config.minSize == 0) throw std::invalid_argument("AdaptiveQueuePolicy - minimum size must be greater than zero");
+    if(config.maxSize < config.minSize) throw std::invalid_argument("AdaptiveQueuePolicy - maximum size must not be smaller than minimum size");
+    if(config.period <= std::chrono::milliseconds(0)) throw std::invalid_argument("AdaptiveQueuePolicy - period must be positive");
+    if(config.smoothing <= 0.0f || config.smoothing > 1.0f) throw std::invalid_argument("AdaptiveQueuePolicy - smoothing must be in range (0, 1]");
+}
+
+void AdaptiveQueuePolicy::addQueue(std::shared_ptr<DataOutputQueue> queue) {
+    if(queue == nullptr) throw std::invalid_argument("AdaptiveQueuePolicy - queue is null");
+    const void* key = queue.get();
+    addManaged(std::make_shared<OutputQueue>(std::move(queue)), key);
+}
+
+void AdaptiveQueuePolicy::addQueue(std::shared_ptr<Queue> queue) {
+    if(queue == nullptr) throw std::invalid_argument("AdaptiveQueuePolicy - queue is null");
+    const void* key = queue.get();
+    addManaged(std::move(queue), key);
+}
+
+void AdaptiveQueuePolicy::addManaged(std::shared_ptr<Queue> queue, const void* key) {
+    std::unique_lock<std::mutex> lock(mtx);
+    for(const auto& managed : queues) {
+        if(managed.key == key) return;
+    }
+    Managed managed;
+    managed.queue = std::move(queue);
+    managed.key = key;
+    managed.state.stats = managed.queue->getStats();
+    managed.userBlocking = managed.state.stats.blocking;
+    queues.push_back(std::move(managed));
+}
+
+bool AdaptiveQueuePolicy::removeQueue(const std::shared_ptr<DataOutputQueue>& queue) {
+    return removeManaged(queue.get());
+}
+
+bool AdaptiveQueuePolicy::removeQueue(const std::shared_ptr<Queue>& queue) {
+    return removeManaged(queue.get());
+}
+
+bool AdaptiveQueuePolicy::removeManaged(const void* key) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = std::find_if(queues.begin(), queues.end(), [key](const Managed& managed) { return managed.key == key; });
+    if(it == queues.end()) return false;
+    queues.erase(it);
+    return true;
+}
+
+std::vector<double> AdaptiveQueuePolicy::shareBudget(const std::vector<double>& demands, double budget) {
+    std::vector<double> shares(demands.size(), 0.0);
+    std::vector<std::size_t> order(demands.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&demands](std::size_t a, std::size_t b) { return demands[a] < demands[b]; });
+
+    // Serve smallest demands first, each gets at most an equal part of what is left
+    double left = std::max(0.0, budget);
+    for(std::size_t i = 0; i < order.size(); i++) {
+        const double fair = left / static_cast<double>(order.size() - i);
+        const double share = std::min(std::max(0.0, demands[order[i]]), fair);
+        shares[order[i]] = share;
+        left -= share;
+    }
+    return shares;
+}
+
+unsigned AdaptiveQueuePolicy::getDesiredSize(const Managed& managed) const {
+    const auto& state = managed.state;
+    const double latency = std::chrono::duration<double>(config.targetLatency).count();
+    double wanted = 0.0;
+    if(state.consumerRate >= state.producerRate * KEEPING_UP_RATIO) {
+        // Keeping up, only a message arriving while one is retrieved needs room. Filling up anyway means the consumer
+        // takes messages in bursts, the queue then grows up to what is produced within the target latency
+        wanted = state.producerRate > 0.0f ? 2.0 : 0.0;
+        if(managed.behind) {
+            const double current = state.stats.maxSize;
+            wanted = std::max(current, std::min(2.0 * current, state.producerRate * latency));
+        }
+    } else {
+        // Lagging, the queue stays full, so more than what is drained within the target latency only ages messages
+        wanted = state.consumerRate * latency;
+    }
+    return static_cast<unsigned>(std::min<double>(config.maxSize, std::max<double>(config.minSize, std::ceil(wanted))));
+}
+
+void AdaptiveQueuePolicy::update() {
+    update(std::chrono::steady_clock::now());
+}
+
+void AdaptiveQueuePolicy::update(std::chrono::steady_clock::time_point now) {
+    std::vector<Adjustment> made;
+    std::function<void(const Adjustment&)> callback;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        const double dt = std::chrono::duration<double>(now - lastUpdate).count();
+        lastUpdate = now;
+
+        // Closed queues won't receive anymore
+        queues.erase(std::remove_if(queues.begin(), queues.end(), [](const Managed& managed) { return managed.queue->isClosed(); }), queues.end());
+
+        auto apply = [&](Managed& managed, unsigned maxSize, bool blocking, std::string reason) {
+            Adjustment adjustment;
+            adjustment.time = now;
+            adjustment.queue = managed.state.stats.name;
+            adjustment.previousMaxSize = managed.state.stats.maxSize;
+            adjustment.previousBlocking = managed.state.stats.blocking;
+            adjustment.maxSize = maxSize;
+            adjustment.blocking = blocking;
+            adjustment.reason = std::move(reason);
+            try {
+                if(maxSize != adjustment.previousMaxSize) managed.queue->setMaxSize(maxSize);
+                if(blocking != adjustment.previousBlocking) managed.queue->setBlocking(blocking);
+            } catch(const std::exception& ex) {
+                // Queue was closed in the meantime
+                logger::debug("Couldn't adjust queue '{}': {}", adjustment.queue, ex.what());
+                return;
+            }
+            managed.state.stats.maxSize = maxSize;
+            managed.state.stats.blocking = blocking;
+            managed.state.numAdjustments++;
+            logger::debug("Queue '{}' adjusted - size: {} -> {}, blocking: {} -> {} ({})",
+                          adjustment.queue,
+                          adjustment.previousMaxSize,
+                          maxSize,
+                          adjustment.previousBlocking,
+                          blocking,
+                          adjustment.reason);
+            made.push_back(std::move(adjustment));
+        };
+
+        // Measure rates and message sizes since the last update
+        for(auto& managed : queues) {
+            auto& state = managed.state;
+            const auto stats = managed.queue->getStats();
+            const auto pushed = stats.numPushed - state.stats.numPushed;
+            const auto popped = stats.numPopped - state.stats.numPopped;
+            const auto bytes = stats.numBytesPushed - state.stats.numBytesPushed;
+            const auto dropped = stats.numDropped - state.stats.numDropped;
+            state.stats = stats;
+
+            // Unbuffered queues only pass messages to callbacks, there is nothing to size
+            if(stats.maxSize == 0) {
+                managed.measured = false;
+                managed.behind = false;
+                managed.fullUpdates = 0;
+                managed.caughtUpUpdates = 0;
+                continue;
+            }
+            if(dt <= 0.0) continue;
+
+            const float alpha = managed.measured ? config.smoothing : 1.0f;
+            state.producerRate += alpha * (static_cast<float>(pushed / dt) - state.producerRate);
+            state.consumerRate += alpha * (static_cast<float>(popped / dt) - state.consumerRate);
+            if(pushed > 0) {
+                const float messageBytes = static_cast<float>(bytes) / static_cast<float>(pushed);
+                state.messageBytes = state.messageBytes > 0.0f ? state.messageBytes + config.smoothing * (messageBytes - state.messageBytes) : messageBytes;
+            }
+            managed.measured = true;
+
+            // A full blocking queue stalls the device, a full overwriting one drops. Either way the consumer is behind
+            managed.behind = stats.size >= stats.maxSize || dropped > 0;
+            managed.fullUpdates = managed.behind ? managed.fullUpdates + 1 : 0;
+            managed.caughtUpUpdates = !managed.behind && stats.size * 2 <= stats.maxSize ? managed.caughtUpUpdates + 1 : 0;
+
+            if(stats.blocking && managed.fullUpdates >= config.slowUpdates) {
+                state.overwriting = true;
+                managed.caughtUpUpdates = 0;
+                apply(managed, stats.maxSize, false, "consumer persistently slower than producer, overwriting oldest messages");
+            } else if(state.overwriting && managed.caughtUpUpdates >= config.slowUpdates) {
+                state.overwriting = false;
+                managed.fullUpdates = 0;
+                apply(managed, stats.maxSize, managed.userBlocking, "consumer caught up");
+            }
+        }
+
+        // Size queues by producer and consumer rates, sharing the memory budget fairly by bytes
+        std::vector<double> demands;
+        std::vector<unsigned> desired;
+        double currentBytes = 0.0;
+        for(const auto& managed : queues) {
+            const auto& state = managed.state;
+            const auto size = managed.measured ? getDesiredSize(managed) : state.stats.maxSize;
+            desired.push_back(size);
+            demands.push_back(size * static_cast<double>(state.messageBytes));
+            currentBytes += state.stats.maxSize * static_cast<double>(state.messageBytes);
+        }
+        const bool overBudget = currentBytes > static_cast<double>(config.memoryBudget);
+        const auto shares = shareBudget(demands, static_cast<double>(config.memoryBudget));
+
+        for(std::size_t i = 0; i < queues.size(); i++) {
+            auto& managed = queues[i];
+            if(!managed.measured) continue;
+            unsigned size = desired[i];
+            if(managed.state.messageBytes > 0.0f) {
+                const auto affordable = static_cast<unsigned>(std::floor(shares[i] / managed.state.messageBytes));
+                size = std::max(config.minSize, std::min(size, affordable));
+            }
+
+            // Ignore small changes, so sizes don't follow every rate fluctuation. Budget is always enforced
+            const unsigned current = managed.state.stats.maxSize;
+            const unsigned delta = size > current ? size - current : current - size;
+            if(delta == 0) continue;
+            if(delta <= current / 4 && !(overBudget && size < current)) continue;
+            apply(managed,
+                  size,
+                  managed.state.stats.blocking,
+                  fmt::format("{:.1f} messages/s produced, {:.1f} consumed, of {:.0f} bytes, {} bytes of budget",
+                              managed.state.producerRate,
+                              managed.state.consumerRate,
+                              managed.state.messageBytes,
+                              static_cast<std::uint64_t>(shares[i])));
+        }
+
+        for(const auto& adjustment : made) {
+            adjustments.push_back(adjustment);
+            if(adjustments.size() > MAX_ADJUSTMENTS) adjustments.pop_front();
+        }
+        callback = adjustmentCallback;
+    }
+
+    // Call without holding the lock, so the callback may query the policy
+    if(callback) {
+        for(const auto& adjustment : made) callback(adjustment);
+    }
+}
+
+std::vector<AdaptiveQueuePolicy::QueueState> AdaptiveQueuePolicy::getStates() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::vector<QueueState> states;
+    states.reserve(queues.size());
+    for(const auto& managed : queues) states.push_back(managed.state);
+    return states;
+}
+
+std::vector<AdaptiveQueuePolicy::Adjustment> AdaptiveQueuePolicy::getAdjustments() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return {adjustments.begin(), adjustments.end()};
+}
+
+void AdaptiveQueuePolicy::setAdjustmentCallback(std::function<void(const Adjustment&)> callback) {
+    std::unique_lock<std::mutex> lock(mtx);
+    adjustmentCallback = std::move(callback);
+}
+
+std::uint64_t AdaptiveQueuePolicy::getNumDropped() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::uint64_t numDropped = 0;
+    for(const auto& managed : queues) numDropped += managed.queue->getStats().numDropped;
+    return numDropped;
+}
+
+AdaptiveQueuePolicy::Config AdaptiveQueuePolicy::getConfig() const {
+    return config;
+}
+
+}  // namespace dai
@@ -6,6 +6,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <unordered_set>
@@ -22,31 +23,52 @@ namespace dai {
 
 using namespace matrix;
 
+struct CalibrationHandler::ExtrinsicsTable {
+    struct Entry {
+        Matrix4f transformation;
+        // Non-empty if the transformation is not available, holds the error which is thrown on access
+        std::string error;
+    };
+
+    // Dense (N + 1) x (N + 1) table, indexed by 'indices'. Last row and column belong to the IMU
+    std::unordered_map<CameraBoardSocket, size_t> indices;
+    size_t imuIndex = 0;
+    std::vector<Entry> entries[2];  // [useSpecTranslation]
+
+    const Entry& at(size_t src, size_t dst, bool useSpecTranslation) const {
+        return entries[useSpecTranslation ? 1 : 0][src * (imuIndex + 1) + dst];
+    }
+};
+
 namespace {
-void invertSe3Matrix4x4InPlace(std::vector<std::vector<float>>& mat) {
-    // Transpose in-place
-    float temp = mat[0][1];
-    mat[0][1] = mat[1][0];
-    mat[1][0] = temp;
-
-    temp = mat[0][2];
-    mat[0][2] = mat[2][0];
-    mat[2][0] = temp;
-
-    temp = mat[1][2];
-    mat[1][2] = mat[2][1];
-    mat[2][1] = temp;
-
-    // The inverse of an SE(3) transformation (R, t) is (R^T, -R^T t)
-    float newTrans[3];
-    for(int i = 0; i < 3; ++i) {
-        newTrans[i] = 0;
-        for(int j = 0; j < 3; ++j) {
-            newTrans[i] -= mat[i][j] * mat[j][3];
+
+constexpr const char* NO_EXTRINSICS_LINK_ERROR =
+    "Extrinsic connection between the requested cameraId's doesn't exist. Please recalibrate or modify your calibration data";
+
+// Returns the transformation from the extrinsics origin to its 'toCameraSocket', or sets 'error' if unavailable
+Matrix4f toTransformationMatrix(const Extrinsics& extrinsics, bool useSpecTranslation, bool checkSpecTranslation, std::string& error) {
+    Matrix4f mat = matrix::identity<4>();
+    if(extrinsics.rotationMatrix.size() != 3 || extrinsics.rotationMatrix[0].size() != 3 || extrinsics.rotationMatrix[1].size() != 3
+       || extrinsics.rotationMatrix[2].size() != 3) {
+        error = "Defined Extrinsic conenction but rotation matrix is not available. Please cross check your calibration data configuration.";
+        return mat;
+    }
+    const dai::Point3f& trans = useSpecTranslation ? extrinsics.specTranslation : extrinsics.translation;
+    if(useSpecTranslation && checkSpecTranslation && trans.x == 0 && trans.y == 0 && trans.z == 0) {
+        error = "Cannot use useSpecTranslation argument since specTranslation has {0, 0, 0}";
+        return mat;
+    }
+    for(size_t i = 0; i < 3; ++i) {
+        for(size_t j = 0; j < 3; ++j) {
+            mat[i][j] = extrinsics.rotationMatrix[i][j];
         }
     }
-    for(int i = 0; i < 3; ++i) mat[i][3] = newTrans[i];
+    mat[0][3] = trans.x;
+    mat[1][3] = trans.y;
+    mat[2][3] = trans.z;
+    return mat;
 }
+
 }  // namespace
 
 CalibrationHandler::CalibrationHandler(dai::Path eepromDataPath) {
@@ -60,11 +82,13 @@ CalibrationHandler::CalibrationHandler(dai::Path eepromDataPath) {
     }
     nlohmann::json jsonData = nlohmann::json::parse(jsonStream);
     eepromData = jsonData;
+    getExtrinsicsTable();
 }
 
 CalibrationHandler CalibrationHandler::fromJson(nlohmann::json eepromDataJson) {
     CalibrationHandler calib;
     calib.eepromData = eepromDataJson;
+    calib.getExtrinsicsTable();
     return calib;
 }
 
@@ -191,10 +215,13 @@ CalibrationHandler::CalibrationHandler(dai::Path calibrationDataPath, dai::Path
     temp = camera.extrinsics.rotationMatrix[1][2];
     camera.extrinsics.rotationMatrix[1][2] = camera.extrinsics.rotationMatrix[2][1];
     camera.extrinsics.rotationMatrix[2][1] = temp;
+
+    getExtrinsicsTable();
 }
 
 CalibrationHandler::CalibrationHandler(EepromData newEepromData) {
     eepromData = newEepromData;
+    getExtrinsicsTable();
 }
 
 dai::EepromData CalibrationHandler::getEepromData() const {
@@ -357,34 +384,30 @@ CameraModel CalibrationHandler::getDistortionModel(CameraBoardSocket cameraId) c
 std::vector<std::vector<float>> CalibrationHandler::getCameraExtrinsics(CameraBoardSocket srcCamera,
                                                                         CameraBoardSocket dstCamera,
                                                                         bool useSpecTranslation) const {
+    return matrix::toVector(getCameraExtrinsicsMatrix(srcCamera, dstCamera, useSpecTranslation));
+}
+
+Matrix4f CalibrationHandler::getCameraExtrinsicsMatrix(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const {
     /**
      * 1. Check if both camera ID exists.
-     * 2. Check if the forward link exists from source to dest camera. if No go to step 5
-     * 3. Call computeExtrinsicMatrix to get the projection matrix from source -> destination camera.
-     * 4. Jump to end and return the projection matrix
-     * 5. if no check if there is forward link from dest to source. if No return an error that link doesn't exist.
-     * 6. Call computeExtrinsicMatrix to get the projection matrix from destination -> source camera.
-     * 7. Carry Transpose on the rotation matrix and get neg of Final translation
-     * 8. Return the Final TransformationMatrix containing both rotation matrix and Translation
+     * 2. Lookup the precomputed transformation from source -> destination camera.
+     *    The table holds either the forward link or the inverted backward link between the two cameras, see getExtrinsicsTable
      */
-    if(eepromData.cameraData.find(srcCamera) == eepromData.cameraData.end()) {
+    auto table = getExtrinsicsTable();
+    auto src = table->indices.find(srcCamera);
+    if(src == table->indices.end()) {
         throw std::runtime_error("There is no Camera data available corresponding to the the requested source cameraId");
     }
-    if(eepromData.cameraData.find(dstCamera) == eepromData.cameraData.end()) {
+    auto dst = table->indices.find(dstCamera);
+    if(dst == table->indices.end()) {
         throw std::runtime_error("There is no Camera data available corresponding to the the requested destination cameraId");
     }
 
-    std::vector<std::vector<float>> extrinsics;
-    if(checkExtrinsicsLink(srcCamera, dstCamera)) {
-        return computeExtrinsicMatrix(srcCamera, dstCamera, useSpecTranslation);
-    } else if(checkExtrinsicsLink(dstCamera, srcCamera)) {
-        extrinsics = computeExtrinsicMatrix(dstCamera, srcCamera, useSpecTranslation);
-        invertSe3Matrix4x4InPlace(extrinsics);
-        return extrinsics;
-    } else {
-        throw std::runtime_error("Extrinsic connection between the requested cameraId's doesn't exist. Please recalibrate or modify your calibration data");
+    const auto& entry = table->at(src->second, dst->second, useSpecTranslation);
+    if(!entry.error.empty()) {
+        throw std::runtime_error(entry.error);
     }
-    return extrinsics;
+    return entry.transformation;
 }
 
 std::vector<float> CalibrationHandler::getCameraTranslationVector(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera, bool useSpecTranslation) const {
@@ -407,38 +430,45 @@ float CalibrationHandler::getBaselineDistance(CameraBoardSocket cam1, CameraBoar
 }
 
 std::vector<std::vector<float>> CalibrationHandler::getCameraToImuExtrinsics(CameraBoardSocket cameraId, bool useSpecTranslation) const {
-    std::vector<std::vector<float>> transformationMatrix = getImuToCameraExtrinsics(cameraId, useSpecTranslation);
-    invertSe3Matrix4x4InPlace(transformationMatrix);
-    return transformationMatrix;
+    return matrix::toVector(getCameraToImuExtrinsicsMatrix(cameraId, useSpecTranslation));
 }
 
 std::vector<std::vector<float>> CalibrationHandler::getImuToCameraExtrinsics(CameraBoardSocket cameraId, bool useSpecTranslation) const {
+    return matrix::toVector(getImuToCameraExtrinsicsMatrix(cameraId, useSpecTranslation));
+}
+
+Matrix4f CalibrationHandler::getCameraToImuExtrinsicsMatrix(CameraBoardSocket cameraId, bool useSpecTranslation) const {
+    auto table = getExtrinsicsTable();
     if(eepromData.imuExtrinsics.rotationMatrix.size() == 0 || eepromData.imuExtrinsics.toCameraSocket == CameraBoardSocket::AUTO) {
         throw std::runtime_error("IMU calibration data is not available on device yet.");
-    } else if(eepromData.cameraData.find(cameraId) == eepromData.cameraData.end()) {
+    }
+    auto cam = table->indices.find(cameraId);
+    if(cam == table->indices.end()) {
         throw std::runtime_error("There is no Camera data available corresponding to the requested source cameraId");
     }
 
-    std::vector<std::vector<float>> currTransformationMatrixImu = eepromData.imuExtrinsics.rotationMatrix;
-    if(useSpecTranslation) {
-        currTransformationMatrixImu[0].push_back(eepromData.imuExtrinsics.specTranslation.x);
-        currTransformationMatrixImu[1].push_back(eepromData.imuExtrinsics.specTranslation.y);
-        currTransformationMatrixImu[2].push_back(eepromData.imuExtrinsics.specTranslation.z);
-    } else {
-        currTransformationMatrixImu[0].push_back(eepromData.imuExtrinsics.translation.x);
-        currTransformationMatrixImu[1].push_back(eepromData.imuExtrinsics.translation.y);
-        currTransformationMatrixImu[2].push_back(eepromData.imuExtrinsics.translation.z);
+    const auto& entry = table->at(cam->second, table->imuIndex, useSpecTranslation);
+    if(!entry.error.empty()) {
+        throw std::runtime_error(entry.error);
     }
-    std::vector<float> homogeneous_vector = {0, 0, 0, 1};
-    currTransformationMatrixImu.push_back(homogeneous_vector);
+    return entry.transformation;
+}
 
-    if(eepromData.imuExtrinsics.toCameraSocket == cameraId) {
-        return currTransformationMatrixImu;
-    } else {
-        std::vector<std::vector<float>> destTransformationMatrixCurr =
-            getCameraExtrinsics(eepromData.imuExtrinsics.toCameraSocket, cameraId, useSpecTranslation);
-        return matMul(destTransformationMatrixCurr, currTransformationMatrixImu);
+Matrix4f CalibrationHandler::getImuToCameraExtrinsicsMatrix(CameraBoardSocket cameraId, bool useSpecTranslation) const {
+    auto table = getExtrinsicsTable();
+    if(eepromData.imuExtrinsics.rotationMatrix.size() == 0 || eepromData.imuExtrinsics.toCameraSocket == CameraBoardSocket::AUTO) {
+        throw std::runtime_error("IMU calibration data is not available on device yet.");
     }
+    auto cam = table->indices.find(cameraId);
+    if(cam == table->indices.end()) {
+        throw std::runtime_error("There is no Camera data available corresponding to the requested source cameraId");
+    }
+
+    const auto& entry = table->at(table->imuIndex, cam->second, useSpecTranslation);
+    if(!entry.error.empty()) {
+        throw std::runtime_error(entry.error);
+    }
+    return entry.transformation;
 }
 
 std::vector<std::vector<float>> CalibrationHandler::getStereoRightRectificationRotation() const {
@@ -477,69 +507,101 @@ nlohmann::json CalibrationHandler::eepromToJson() const {
     return eepromData;
 }
 
-std::vector<std::vector<float>> CalibrationHandler::computeExtrinsicMatrix(CameraBoardSocket srcCamera,
-                                                                           CameraBoardSocket dstCamera,
-                                                                           bool useSpecTranslation) const {
-    if(srcCamera == CameraBoardSocket::AUTO || dstCamera == CameraBoardSocket::AUTO) {
-        throw std::runtime_error("Invalid cameraId input..");
-    }
-    if(eepromData.cameraData.at(srcCamera).extrinsics.toCameraSocket == dstCamera) {
-        if(eepromData.cameraData.at(srcCamera).extrinsics.rotationMatrix.size() == 0
-           || eepromData.cameraData.at(srcCamera).extrinsics.toCameraSocket == CameraBoardSocket::AUTO) {
-            throw std::runtime_error(
-                "Defined Extrinsic conenction but rotation matrix is not available. Please cross check your calibration data configuration.");
+std::shared_ptr<const CalibrationHandler::ExtrinsicsTable> CalibrationHandler::getExtrinsicsTable() const {
+    auto table = std::atomic_load(&extrinsicsTable);
+    if(table) return table;
+
+    /**
+     * Builds transformations between all pairs of cameras and the IMU:
+     * 1. For each camera, walk the forward 'toCameraSocket' chain and accumulate the transformation to each camera on it.
+     *    Any missing rotation or spec translation on the way marks the rest of the chain as unavailable, with the respective error.
+     * 2. For pairs without a forward link, use the inverse of the backward link if it exists.
+     * 3. IMU to camera is the IMU extrinsics followed by the transformation from the IMU's 'toCameraSocket' to the camera,
+     *    and camera to IMU its inverse.
+     */
+    auto newTable = std::make_shared<ExtrinsicsTable>();
+    for(const auto& kv : eepromData.cameraData) {
+        newTable->indices.emplace(kv.first, newTable->indices.size());
+    }
+    const size_t numCameras = newTable->indices.size();
+    const size_t stride = numCameras + 1;
+    newTable->imuIndex = numCameras;
+
+    for(int spec = 0; spec < 2; spec++) {
+        const bool useSpecTranslation = spec == 1;
+        auto& entries = newTable->entries[spec];
+        ExtrinsicsTable::Entry noLink{matrix::identity<4>(), NO_EXTRINSICS_LINK_ERROR};
+        entries.assign(stride * stride, noLink);
+
+        // Forward links
+        std::vector<bool> hasForward(stride * stride, false);
+        for(const auto& src : newTable->indices) {
+            std::vector<bool> visited(numCameras, false);
+            visited[src.second] = true;
+            Matrix4f accumulated = matrix::identity<4>();
+            std::string error;
+            CameraBoardSocket current = src.first;
+            while(true) {
+                const auto& extrinsics = eepromData.cameraData.at(current).extrinsics;
+                auto next = newTable->indices.find(extrinsics.toCameraSocket);
+                if(next == newTable->indices.end() || visited[next->second]) break;
+                if(error.empty()) {
+                    Matrix4f hop = toTransformationMatrix(extrinsics, useSpecTranslation, true, error);
+                    if(error.empty()) accumulated = matrix::multiply(hop, accumulated);
+                }
+                auto& entry = entries[src.second * stride + next->second];
+                entry.transformation = accumulated;
+                entry.error = error;
+                hasForward[src.second * stride + next->second] = true;
+                visited[next->second] = true;
+                current = next->first;
+            }
         }
-        std::vector<std::vector<float>> transformationMatrix = eepromData.cameraData.at(srcCamera).extrinsics.rotationMatrix;
-        if(useSpecTranslation) {
-            const dai::Point3f& mTrans = eepromData.cameraData.at(srcCamera).extrinsics.specTranslation;
-            if(mTrans.x == 0 && mTrans.y == 0 && mTrans.z == 0) {
-                throw std::runtime_error("Cannot use useSpecTranslation argument since specTranslation has {0, 0, 0}");
+
+        // Backward links
+        for(size_t src = 0; src < numCameras; src++) {
+            for(size_t dst = 0; dst < numCameras; dst++) {
+                if(hasForward[src * stride + dst] || !hasForward[dst * stride + src]) continue;
+                const auto& backward = entries[dst * stride + src];
+                auto& entry = entries[src * stride + dst];
+                entry.error = backward.error;
+                if(entry.error.empty()) entry.transformation = matrix::invertSe3(backward.transformation);
             }
-            transformationMatrix[0].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.x);
-            transformationMatrix[1].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.y);
-            transformationMatrix[2].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.z);
-        } else {
-            transformationMatrix[0].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.x);
-            transformationMatrix[1].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.y);
-            transformationMatrix[2].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.z);
         }
-        std::vector<float> homogeneous_vector = {0, 0, 0, 1};
-        transformationMatrix.push_back(homogeneous_vector);
-        return transformationMatrix;
-    } else {
-        std::vector<std::vector<float>> destTransformationMatrixCurr =
-            computeExtrinsicMatrix(eepromData.cameraData.at(srcCamera).extrinsics.toCameraSocket, dstCamera, useSpecTranslation);
-        std::vector<std::vector<float>> currTransformationMatrixSrc = eepromData.cameraData.at(srcCamera).extrinsics.rotationMatrix;
-        if(useSpecTranslation) {
-            const dai::Point3f& mTrans = eepromData.cameraData.at(srcCamera).extrinsics.specTranslation;
-            if(mTrans.x == 0 && mTrans.y == 0 && mTrans.z == 0) {
-                throw std::runtime_error("Cannot use useSpecTranslation argument since specTranslation has {0, 0, 0}");
+
+        // IMU
+        const auto& imuExtrinsics = eepromData.imuExtrinsics;
+        if(imuExtrinsics.rotationMatrix.size() == 0 || imuExtrinsics.toCameraSocket == CameraBoardSocket::AUTO) continue;
+        std::string imuError;
+        Matrix4f imuToLinked = toTransformationMatrix(imuExtrinsics, useSpecTranslation, false, imuError);
+        auto linked = newTable->indices.find(imuExtrinsics.toCameraSocket);
+        for(size_t cam = 0; cam < numCameras; cam++) {
+            auto& imuToCam = entries[numCameras * stride + cam];
+            auto& camToImu = entries[cam * stride + numCameras];
+            if(!imuError.empty()) {
+                imuToCam.error = imuError;
+            } else if(linked == newTable->indices.end()) {
+                imuToCam.error = "There is no Camera data available corresponding to the the requested source cameraId";
+            } else if(linked->second == cam) {
+                imuToCam.transformation = imuToLinked;
+                imuToCam.error.clear();
+            } else {
+                const auto& linkedToCam = entries[linked->second * stride + cam];
+                imuToCam.error = linkedToCam.error;
+                if(imuToCam.error.empty()) imuToCam.transformation = matrix::multiply(linkedToCam.transformation, imuToLinked);
             }
-            currTransformationMatrixSrc[0].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.x);
-            currTransformationMatrixSrc[1].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.y);
-            currTransformationMatrixSrc[2].push_back(eepromData.cameraData.at(srcCamera).extrinsics.specTranslation.z);
-        } else {
-            currTransformationMatrixSrc[0].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.x);
-            currTransformationMatrixSrc[1].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.y);
-            currTransformationMatrixSrc[2].push_back(eepromData.cameraData.at(srcCamera).extrinsics.translation.z);
+            camToImu.error = imuToCam.error;
+            if(camToImu.error.empty()) camToImu.transformation = matrix::invertSe3(imuToCam.transformation);
         }
-        std::vector<float> homogeneous_vector = {0, 0, 0, 1};
-        currTransformationMatrixSrc.push_back(homogeneous_vector);
-        return matMul(destTransformationMatrixCurr, currTransformationMatrixSrc);
     }
+
+    table = std::move(newTable);
+    std::atomic_store(&extrinsicsTable, table);
+    return table;
 }
 
-bool CalibrationHandler::checkExtrinsicsLink(CameraBoardSocket srcCamera, CameraBoardSocket dstCamera) const {
-    bool isConnectionFound = false;
-    CameraBoardSocket currentCameraId = srcCamera;
-    while(currentCameraId != CameraBoardSocket::AUTO) {
-        currentCameraId = eepromData.cameraData.at(currentCameraId).extrinsics.toCameraSocket;
-        if(currentCameraId == dstCamera) {
-            isConnectionFound = true;
-            break;
-        }
-    }
-    return isConnectionFound;
+void CalibrationHandler::invalidateExtrinsicsTable() {
+    std::atomic_store(&extrinsicsTable, std::shared_ptr<const ExtrinsicsTable>());
 }
 
 void CalibrationHandler::setBoardInfo(std::string boardName, std::string boardRev) {
@@ -630,6 +692,7 @@ void CalibrationHandler::setCameraIntrinsics(CameraBoardSocket cameraId, std::ve
         camera_info.width = width;
         camera_info.intrinsicMatrix = intrinsics;
         eepromData.cameraData.emplace(cameraId, camera_info);
+        invalidateExtrinsicsTable();
     } else {
         eepromData.cameraData.at(cameraId).height = height;
         eepromData.cameraData.at(cameraId).width = width;
@@ -668,6 +731,7 @@ void CalibrationHandler::setDistortionCoefficients(CameraBoardSocket cameraId, s
         dai::CameraInfo camera_info;
         camera_info.distortionCoeff = distortionCoefficients;
         eepromData.cameraData.emplace(cameraId, camera_info);
+        invalidateExtrinsicsTable();
     } else {
         eepromData.cameraData.at(cameraId).distortionCoeff = distortionCoefficients;
     }
@@ -679,6 +743,7 @@ void CalibrationHandler::setFov(CameraBoardSocket cameraId, float hfov) {
         dai::CameraInfo camera_info;
         camera_info.specHfovDeg = hfov;
         eepromData.cameraData.emplace(cameraId, camera_info);
+        invalidateExtrinsicsTable();
     } else {
         eepromData.cameraData.at(cameraId).specHfovDeg = hfov;
     }
@@ -690,6 +755,7 @@ void CalibrationHandler::setLensPosition(CameraBoardSocket cameraId, uint8_t len
         dai::CameraInfo camera_info;
         camera_info.lensPosition = lensPosition;
         eepromData.cameraData.emplace(cameraId, camera_info);
+        invalidateExtrinsicsTable();
     } else {
         eepromData.cameraData.at(cameraId).lensPosition = lensPosition;
     }
@@ -701,6 +767,7 @@ void CalibrationHandler::setCameraType(CameraBoardSocket cameraId, CameraModel c
         dai::CameraInfo camera_info;
         camera_info.cameraType = cameraModel;
         eepromData.cameraData.emplace(cameraId, camera_info);
+        invalidateExtrinsicsTable();
     } else {
         eepromData.cameraData.at(cameraId).cameraType = cameraModel;
     }
@@ -735,6 +802,7 @@ void CalibrationHandler::setCameraExtrinsics(CameraBoardSocket srcCameraId,
     } else {
         eepromData.cameraData[srcCameraId].extrinsics = extrinsics;
     }
+    invalidateExtrinsicsTable();
     return;
 }
 
@@ -758,6 +826,7 @@ void CalibrationHandler::setImuExtrinsics(CameraBoardSocket destCameraId,
     extrinsics.specTranslation = dai::Point3f(specTranslation[0], specTranslation[1], specTranslation[2]);
     extrinsics.toCameraSocket = destCameraId;
     eepromData.imuExtrinsics = extrinsics;
+    invalidateExtrinsicsTable();
     return;
 }
 
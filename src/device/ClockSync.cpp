@@ -0,0 +1,151 @@
+#include "depthai/device/ClockSync.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace dai {
+
+constexpr double ClockSyncEstimator::DEFAULT_DRIFT_BOUND;
+
+ClockModel::TimePoint ClockModel::toHost(TimePoint device) const {
+    const auto sinceReference = std::chrono::duration<double, std::nano>(device - deviceReference).count();
+    return device + offset + std::chrono::duration_cast<TimePoint::duration>(std::chrono::duration<double, std::nano>(drift * sinceReference));
+}
+
+ClockModel::TimePoint ClockModel::toDevice(TimePoint host) const {
+    // Inverse of toHost: host = device + offset + drift * (device - reference)
+    const auto sinceReference = std::chrono::duration<double, std::nano>(host - offset - deviceReference).count() / (1.0 + drift);
+    return deviceReference + std::chrono::duration_cast<TimePoint::duration>(std::chrono::duration<double, std::nano>(sinceReference));
+}
+
+std::chrono::nanoseconds ClockModel::getError(TimePoint device) const {
+    const auto sinceReference = std::abs(std::chrono::duration<double, std::nano>(device - deviceReference).count());
+    return error + std::chrono::nanoseconds(static_cast<std::int64_t>(std::ceil(driftError * sinceReference)));
+}
+
+ClockSyncEstimator::ClockSyncEstimator(std::chrono::milliseconds window, std::chrono::milliseconds bucket) : window(window), bucketDuration(bucket) {
+    if(bucket <= std::chrono::milliseconds(0)) throw std::invalid_argument("ClockSyncEstimator - bucket duration must be positive");
+    if(window < bucket) throw std::invalid_argument("ClockSyncEstimator - window must be at least one bucket long");
+}
+
+void ClockSyncEstimator::addSample(TimePoint device, TimePoint host) {
+    std::unique_lock<std::mutex> lock(mtx);
+    const auto offset = std::chrono::duration_cast<std::chrono::nanoseconds>(host - device);
+    const std::int64_t index = device.time_since_epoch() / bucketDuration;
+
+    // Device clock went backwards, eg. after a reboot
+    if(!buckets.empty() && index < buckets.back().index) buckets.clear();
+
+    if(buckets.empty() || index != buckets.back().index) {
+        buckets.push_back({index, device, host, offset, offset});
+    } else {
+        auto& bucket = buckets.back();
+        if(offset < bucket.minOffset) {
+            bucket.device = device;
+            bucket.host = host;
+            bucket.minOffset = offset;
+        }
+        bucket.maxOffset = std::max(bucket.maxOffset, offset);
+    }
+
+    while(buckets.front().device < device - window) buckets.pop_front();
+    update();
+}
+
+ClockModel ClockSyncEstimator::getModel() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return model;
+}
+
+void ClockSyncEstimator::reset() {
+    std::unique_lock<std::mutex> lock(mtx);
+    buckets.clear();
+    model = {};
+}
+
+void ClockSyncEstimator::update() {
+    using namespace std::chrono;
+    model = {};
+    if(buckets.empty()) return;
+
+    // Offsets in ns against seconds of device time, both relative to the first bucket to keep precision
+    struct Point {
+        double x;
+        double y;
+    };
+    const auto deviceBase = buckets.front().device;
+    const auto offsetBase = buckets.front().minOffset;
+    std::vector<Point> points;
+    points.reserve(buckets.size());
+    for(const auto& bucket : buckets) {
+        points.push_back({duration<double>(bucket.device - deviceBase).count(), static_cast<double>((bucket.minOffset - offsetBase).count())});
+    }
+
+    double cx = 0.0, cy = 0.0, slope = 0.0, sxx = 0.0;
+    auto fit = [&]() {
+        cx = cy = sxx = 0.0;
+        for(const auto& p : points) {
+            cx += p.x;
+            cy += p.y;
+        }
+        cx /= points.size();
+        cy /= points.size();
+        double sxy = 0.0;
+        for(const auto& p : points) {
+            sxx += (p.x - cx) * (p.x - cx);
+            sxy += (p.x - cx) * (p.y - cy);
+        }
+        // Drift is only trusted with enough spread, two noisy minima close together give arbitrary slopes
+        slope = points.size() >= 3 && sxx > 0.0 ? sxy / sxx : 0.0;
+    };
+    auto residual = [&](const Point& p) { return p.y - (cy + slope * (p.x - cx)); };
+
+    fit();
+    if(points.size() >= 3) {
+        // Reject minima still delayed by a latency spike, using median absolute deviation of residuals
+        std::vector<double> residuals;
+        for(const auto& p : points) residuals.push_back(residual(p));
+        auto median = [](std::vector<double> values) {
+            std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+            return values[values.size() / 2];
+        };
+        const double med = median(residuals);
+        std::vector<double> deviations;
+        for(auto r : residuals) deviations.push_back(std::abs(r - med));
+        const double threshold = med + std::max(3.0 * 1.4826 * median(deviations), 1000.0);
+
+        std::vector<Point> inliers;
+        for(std::size_t i = 0; i < points.size(); i++) {
+            if(residuals[i] <= threshold) inliers.push_back(points[i]);
+        }
+        if(inliers.size() >= 3 && inliers.size() < points.size()) {
+            points = std::move(inliers);
+            fit();
+        }
+    }
+
+    model.valid = true;
+    model.numSamples = points.size();
+    model.deviceReference = deviceBase + duration_cast<TimePoint::duration>(duration<double>(cx));
+    model.offset = offsetBase + nanoseconds(static_cast<std::int64_t>(std::llround(cy)));
+    model.drift = slope * 1e-9;
+
+    if(points.size() >= 3) {
+        double sumSquares = 0.0;
+        for(const auto& p : points) sumSquares += residual(p) * residual(p);
+        const double sigma = std::sqrt(sumSquares / (points.size() - 2));
+        model.error = nanoseconds(static_cast<std::int64_t>(std::ceil(3.0 * sigma / std::sqrt(static_cast<double>(points.size())))));
+        model.driftError = 3.0 * sigma / std::sqrt(sxx) * 1e-9;
+    } else {
+        // Too few buckets for statistics, fall back to the observed latency jitter and a typical drift bound
+        nanoseconds spread{0};
+        for(const auto& bucket : buckets) spread = std::max(spread, bucket.maxOffset - bucket.minOffset);
+        model.error = spread;
+        model.driftError = DEFAULT_DRIFT_BOUND;
+    }
+}
+
+}  // namespace dai
@@ -9,6 +9,7 @@
 #include "depthai-shared/datatype/DatatypeEnum.hpp"
 #include "depthai-shared/datatype/RawMessageGroup.hpp"
 #include "depthai/pipeline/datatype/ADatatype.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
 #include "depthai/xlink/XLinkStream.hpp"
 #include "pipeline/datatype/MessageGroup.hpp"
 #include "pipeline/datatype/StreamMessageParser.hpp"
@@ -25,6 +26,52 @@
 
 namespace dai {
 
+// Size of a message as sent over XLink, data and serialized metadata, including messages of a group
+static std::size_t getMessageBytes(const RawBuffer& raw) {
+    std::vector<std::uint8_t> metadata;
+    DatatypeEnum type;
+    raw.serialize(metadata, type);
+    std::size_t bytes = raw.data.size() + metadata.size();
+    if(type == DatatypeEnum::MessageGroup) {
+        const auto& group = static_cast<const RawMessageGroup&>(raw);
+        for(const auto& msg : group.group) {
+            if(msg.second.buffer) bytes += getMessageBytes(*msg.second.buffer);
+        }
+    }
+    return bytes;
+}
+
+// Records stages known once a message is parsed
+static LatencyTracer::Id traceMessage(LatencyTracer& tracer,
+                                      const std::string& name,
+                                      const StreamPacketDesc& packet,
+                                      const std::shared_ptr<ADatatype>& data,
+                                      LatencyTracer::TimePoint parseStart,
+                                      LatencyTracer::TimePoint parseEnd) {
+    using namespace std::chrono;
+    auto toTimePoint = [](const XLinkTimespec& ts) { return LatencyTracer::TimePoint{seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec)}; };
+
+    LatencyTracer::Trace trace;
+    trace.stream = name;
+    // XLink receive time is host monotonic time, same as steady_clock
+    if(packet.tReceived.tv_sec != 0 || packet.tReceived.tv_nsec != 0) trace.set(LatencyTracer::Stage::HOST_RECEIVE, toTimePoint(packet.tReceived));
+    trace.set(LatencyTracer::Stage::PARSE_START, parseStart);
+    trace.set(LatencyTracer::Stage::PARSE_END, parseEnd);
+
+    const auto buffer = std::dynamic_pointer_cast<Buffer>(data);
+    if(buffer != nullptr) {
+        trace.sequenceNum = buffer->getSequenceNum();
+        const auto ts = buffer->getTimestamp();
+        const auto tsDevice = buffer->getTimestampDevice();
+        if(ts.time_since_epoch().count() != 0) trace.set(LatencyTracer::Stage::DEVICE_CAPTURE, ts);
+        // Send time is in device clock, same as 'tsDevice', so shift it by the timesync offset of the message
+        if((packet.tRemoteSent.tv_sec != 0 || packet.tRemoteSent.tv_nsec != 0) && tsDevice.time_since_epoch().count() != 0) {
+            trace.set(LatencyTracer::Stage::DEVICE_SEND, toTimePoint(packet.tRemoteSent) + (ts - tsDevice));
+        }
+    }
+    return tracer.record(std::move(trace), data.get());
+}
+
 // DATA OUTPUT QUEUE
 DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking)
     : queue(maxSize, blocking), name(streamName) {
@@ -39,9 +86,11 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
             while(running) {
                 // Blocking -- parse packet and gather timing information
                 auto packet = stream.readMove();
+                const auto tracer = getActiveTracer();
                 DatatypeEnum type;
                 const auto t1Parse = std::chrono::steady_clock::now();
                 const auto data = StreamMessageParser::parseMessageToADatatype(&packet, type);
+                std::size_t numBytes = packet.length;
                 if(type == DatatypeEnum::MessageGroup) {
                     auto msgGrp = std::static_pointer_cast<MessageGroup>(data);
                     unsigned int size = msgGrp->getNumMessages();
@@ -49,6 +98,7 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
                     packets.reserve(size);
                     for(unsigned int i = 0; i < size; ++i) {
                         auto dpacket = stream.readMove();
+                        numBytes += dpacket.length;
                         packets.push_back(StreamMessageParser::parseMessageToADatatype(&dpacket));
                     }
                     auto rawMsgGrp = std::static_pointer_cast<RawMessageGroup>(data->getRaw());
@@ -71,10 +121,17 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
                                   spdlog::to_hex(metadata));
                 }
 
+                // Trace before pushing, so the message can be found once popped
+                LatencyTracer::Id traceId = 0;
+                if(tracer) traceId = traceMessage(*tracer, name, packet, data, t1Parse, t2Parse);
+
                 // Add 'data' to queue
-                if(!queue.push(data)) {
+                numPushed++;
+                numBytesPushed += numBytes;
+                if(!queue.push(data, numBytes)) {
                     throw std::runtime_error(fmt::format("Underlying queue destructed"));
                 }
+                if(tracer) tracer->mark(traceId, LatencyTracer::Stage::QUEUE_PUSH);
 
                 // Increment numPacketsRead
                 numPacketsRead++;
@@ -90,6 +147,7 @@ DataOutputQueue::DataOutputQueue(const std::shared_ptr<XLinkConnection> conn, co
                             logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
                         }
                     }
+                    if(tracer && !callbacks.empty()) tracer->mark(traceId, LatencyTracer::Stage::CALLBACK_END);
                 }
             }
 
@@ -152,6 +210,16 @@ unsigned int DataOutputQueue::getMaxSize() const {
     return queue.getMaxSize();
 }
 
+void DataOutputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMaxBytes(maxBytes);
+}
+
+std::size_t DataOutputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMaxBytes();
+}
+
 std::string DataOutputQueue::getName() const {
     return name;
 }
@@ -180,6 +248,42 @@ int DataOutputQueue::addCallback(std::function<void()> callback) {
     return addCallback([callback = std::move(callback)](std::string, std::shared_ptr<ADatatype>) { callback(); });
 }
 
+void DataOutputQueue::setLatencyTracer(std::shared_ptr<LatencyTracer> tracer) {
+    std::unique_lock<std::mutex> l(tracerMtx);
+    tracing = tracer != nullptr;
+    this->tracer = std::move(tracer);
+}
+
+std::shared_ptr<LatencyTracer> DataOutputQueue::getLatencyTracer() const {
+    std::unique_lock<std::mutex> l(tracerMtx);
+    return tracer;
+}
+
+QueueStats DataOutputQueue::getStats() const {
+    QueueStats stats;
+    stats.name = name;
+    stats.maxSize = queue.getMaxSize();
+    stats.blocking = queue.getBlocking();
+    stats.maxBytes = queue.getMaxBytes();
+    stats.size = queue.size();
+    stats.bytes = queue.getBytes();
+    stats.numPushed = numPushed;
+    stats.numPopped = numPopped;
+    stats.numDropped = queue.getNumDropped();
+    stats.numBytesPushed = numBytesPushed;
+    return stats;
+}
+
+std::shared_ptr<LatencyTracer> DataOutputQueue::getActiveTracer() const {
+    if(!tracing) return nullptr;
+    return getLatencyTracer();
+}
+
+void DataOutputQueue::traceUserPop(const std::shared_ptr<ADatatype>& msg) const {
+    const auto tracer = getActiveTracer();
+    if(tracer && msg) tracer->mark(msg.get(), LatencyTracer::Stage::USER_POP);
+}
+
 bool DataOutputQueue::removeCallback(int callbackId) {
     // Lock first
     std::unique_lock<std::mutex> l(callbacksMtx);
@@ -196,6 +300,9 @@ bool DataOutputQueue::removeCallback(int callbackId) {
 DataInputQueue::DataInputQueue(
     const std::shared_ptr<XLinkConnection> conn, const std::string& streamName, unsigned int maxSize, bool blocking, std::size_t maxDataSize)
     : queue(maxSize, blocking), name(streamName), maxDataSize(maxDataSize) {
+    // Serializing metadata only to measure is wasted without a byte limit, so messages are only measured while one is set
+    queue.setMeasure([](const std::shared_ptr<RawBuffer>& raw) { return getMessageBytes(*raw); });
+
     // open stream with maxDataSize write size
     XLinkStream stream(std::move(conn), name, maxDataSize + device::XLINK_MESSAGE_METADATA_MAX_SIZE);
 
@@ -306,6 +413,16 @@ unsigned int DataInputQueue::getMaxSize() const {
     return queue.getMaxSize();
 }
 
+void DataInputQueue::setMaxBytes(std::size_t maxBytes) {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    queue.setMaxBytes(maxBytes);
+}
+
+std::size_t DataInputQueue::getMaxBytes() const {
+    if(!running) throw std::runtime_error(exceptionMessage.c_str());
+    return queue.getMaxBytes();
+}
+
 // BUGBUG https://github.com/luxonis/depthai-core/issues/762
 void DataInputQueue::setMaxDataSize(std::size_t maxSize) {
     maxDataSize = maxSize;
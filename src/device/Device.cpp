@@ -2,6 +2,8 @@
 
 // std
 #include <iostream>
+#include <map>
+#include <mutex>
 
 // shared
 #include "depthai-bootloader-shared/Bootloader.hpp"
@@ -11,6 +13,7 @@
 
 // project
 #include "DeviceLogger.hpp"
+#include "DeviceRuntime.hpp"
 #include "depthai/device/DeviceBootloader.hpp"
 #include "depthai/pipeline/node/XLinkIn.hpp"
 #include "depthai/pipeline/node/XLinkOut.hpp"
@@ -20,6 +23,55 @@
 
 namespace dai {
 
+namespace {
+
+// Periodic updates of adaptive queue policies, one task per policy however many devices use it
+class AdaptiveQueueUpdates {
+   public:
+    static void acquire(const std::shared_ptr<AdaptiveQueuePolicy>& policy) {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto& entry = entries[policy.get()];
+        if(entry.numDevices++ > 0) return;
+
+        // Updates are short, so they run on the runtime shared by all devices
+        entry.runtime = DeviceRuntime::getShared();
+        std::weak_ptr<AdaptiveQueuePolicy> weakPolicy = policy;
+        const auto period = policy->getConfig().period;
+        entry.task = entry.runtime->schedule(period, [weakPolicy, period]() {
+            auto policy = weakPolicy.lock();
+            if(!policy) return DeviceRuntime::STOP;
+            policy->update();
+            return period;
+        });
+    }
+
+    static void release(const std::shared_ptr<AdaptiveQueuePolicy>& policy) {
+        Entry entry;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            auto it = entries.find(policy.get());
+            if(it == entries.end() || --it->second.numDevices > 0) return;
+            entry = std::move(it->second);
+            entries.erase(it);
+        }
+        // Waits for a running update, so done without holding the lock
+        entry.runtime->cancel(entry.task);
+    }
+
+   private:
+    struct Entry {
+        std::size_t numDevices = 0;
+        std::shared_ptr<DeviceRuntime> runtime;
+        DeviceRuntime::TaskId task = 0;
+    };
+    static std::mutex mtx;
+    static std::map<const AdaptiveQueuePolicy*, Entry> entries;
+};
+std::mutex AdaptiveQueueUpdates::mtx;
+std::map<const AdaptiveQueuePolicy*, AdaptiveQueueUpdates::Entry> AdaptiveQueueUpdates::entries;
+
+}  // namespace
+
 // Common explicit instantiation, to remove the need to define in header
 constexpr std::size_t Device::EVENT_QUEUE_MAXIMUM_SIZE;
 
@@ -73,6 +125,9 @@ void Device::closeImpl() {
     // Clear map
     callbackIdMap.clear();
 
+    // Stop adjusting queues which are about to be closed
+    disableAdaptiveQueues();
+
     // Close the device before clearing the queues
     DeviceBase::closeImpl();
 
@@ -117,6 +172,41 @@ std::vector<std::string> Device::getOutputQueueNames() const {
     return names;
 }
 
+void Device::setLatencyTracer(std::shared_ptr<LatencyTracer> tracer) {
+    latencyTracer = std::move(tracer);
+    for(auto& kv : outputQueueMap) kv.second->setLatencyTracer(latencyTracer);
+}
+
+std::shared_ptr<LatencyTracer> Device::getLatencyTracer() const {
+    return latencyTracer;
+}
+
+std::shared_ptr<AdaptiveQueuePolicy> Device::enableAdaptiveQueues(AdaptiveQueuePolicy::Config config) {
+    return enableAdaptiveQueues(std::make_shared<AdaptiveQueuePolicy>(config));
+}
+
+std::shared_ptr<AdaptiveQueuePolicy> Device::enableAdaptiveQueues(std::shared_ptr<AdaptiveQueuePolicy> policy) {
+    if(!policy) throw std::invalid_argument("Device - adaptive queue policy is null");
+    disableAdaptiveQueues();
+
+    for(auto& kv : outputQueueMap) policy->addQueue(kv.second);
+    AdaptiveQueueUpdates::acquire(policy);
+    adaptiveQueuePolicy = std::move(policy);
+    return adaptiveQueuePolicy;
+}
+
+void Device::disableAdaptiveQueues() {
+    if(!adaptiveQueuePolicy) return;
+    // Queues of other devices sharing the policy stay managed
+    for(auto& kv : outputQueueMap) adaptiveQueuePolicy->removeQueue(kv.second);
+    AdaptiveQueueUpdates::release(adaptiveQueuePolicy);
+    adaptiveQueuePolicy = nullptr;
+}
+
+std::shared_ptr<AdaptiveQueuePolicy> Device::getAdaptiveQueuePolicy() const {
+    return adaptiveQueuePolicy;
+}
+
 std::shared_ptr<DataInputQueue> Device::getInputQueue(const std::string& name) {
     // Throw if queue not created
     // all queues for xlink streams are created upfront
@@ -280,6 +370,8 @@ bool Device::startPipelineImpl(const Pipeline& pipeline) {
         auto streamName = xlinkOut->getStreamName();
         if(outputQueueMap.count(streamName) != 0) throw std::invalid_argument(fmt::format("Streams have duplicate name '{}'", streamName));
         outputQueueMap[streamName] = std::make_shared<DataOutputQueue>(connection, streamName);
+        if(latencyTracer) outputQueueMap[streamName]->setLatencyTracer(latencyTracer);
+        if(adaptiveQueuePolicy) adaptiveQueuePolicy->addQueue(outputQueueMap[streamName]);
 
         // Add callback for events
         callbackIdMap[std::move(streamName)] =
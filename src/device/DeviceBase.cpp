@@ -1,6 +1,10 @@
 #include "depthai/device/DeviceBase.hpp"
 
 // std
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 
 // shared
@@ -17,9 +21,12 @@
 
 // project
 #include "DeviceLogger.hpp"
+#include "DeviceRuntime.hpp"
+#include "RpcTransport.hpp"
 #include "depthai/device/EepromError.hpp"
 #include "depthai/pipeline/node/XLinkIn.hpp"
 #include "depthai/pipeline/node/XLinkOut.hpp"
+#include "depthai/xlink/DeviceDiscovery.hpp"
 #include "pipeline/Pipeline.hpp"
 #include "utility/EepromDataParser.hpp"
 #include "utility/Environment.hpp"
@@ -118,6 +125,9 @@ constexpr float DeviceBase::DEFAULT_SYSTEM_INFORMATION_LOGGING_RATE_HZ;
 constexpr UsbSpeed DeviceBase::DEFAULT_USB_SPEED;
 constexpr std::chrono::milliseconds DeviceBase::DEFAULT_TIMESYNC_PERIOD;
 constexpr bool DeviceBase::DEFAULT_TIMESYNC_RANDOM;
+constexpr std::chrono::milliseconds DeviceBase::SHARED_RUNTIME_MIN_POLL_INTERVAL;
+constexpr std::chrono::milliseconds DeviceBase::SHARED_RUNTIME_MAX_POLL_INTERVAL;
+constexpr std::chrono::milliseconds DeviceBase::SHARED_RUNTIME_READ_TIMEOUT;
 constexpr int DeviceBase::DEFAULT_TIMESYNC_NUM_SAMPLES;
 
 std::chrono::milliseconds DeviceBase::getDefaultSearchTime() {
@@ -142,16 +152,29 @@ std::tuple<bool, DeviceInfo> DeviceBase::getAnyAvailableDevice(std::chrono::mill
 
 std::tuple<bool, DeviceInfo> DeviceBase::getAnyAvailableDevice(std::chrono::milliseconds timeout, std::function<void()> cb) {
     using namespace std::chrono;
-    constexpr auto POOL_SLEEP_TIME = milliseconds(100);
+    constexpr auto CALLBACK_INTERVAL = milliseconds(100);
+    const std::array<XLinkDeviceState_t, 3> searchStates = {X_LINK_UNBOOTED, X_LINK_BOOTLOADER, X_LINK_FLASH_BOOTED};
+
+    auto hasAvailableDevice = [&searchStates](const std::vector<DeviceInfo>& devices) {
+        for(const auto& device : devices) {
+            if(device.status != X_LINK_SUCCESS) continue;
+            for(auto searchState : searchStates) {
+                if(device.state == searchState) return true;
+            }
+        }
+        return false;
+    };
 
     // First looks for UNBOOTED, then BOOTLOADER, for 'timeout' time
+    // Discovery table is kept up to date in the background and wakes up as soon as a device is available
     auto searchStartTime = steady_clock::now();
     bool found = false;
     DeviceInfo deviceInfo;
     std::unordered_map<std::string, DeviceInfo> invalidDevices;
     do {
-        auto devices = XLinkConnection::getAllConnectedDevices(X_LINK_ANY_STATE, false);
-        for(auto searchState : {X_LINK_UNBOOTED, X_LINK_BOOTLOADER, X_LINK_FLASH_BOOTED}) {
+        auto remaining = timeout - duration_cast<milliseconds>(steady_clock::now() - searchStartTime);
+        auto devices = DeviceDiscovery::getInstance().waitFor(hasAvailableDevice, std::max(milliseconds(0), std::min(remaining, CALLBACK_INTERVAL)));
+        for(auto searchState : searchStates) {
             for(const auto& device : devices) {
                 if(device.state == searchState) {
                     if(device.status == X_LINK_SUCCESS) {
@@ -170,15 +193,6 @@ std::tuple<bool, DeviceInfo> DeviceBase::getAnyAvailableDevice(std::chrono::mill
 
         // Call the callback
         if(cb) cb();
-
-        // If 'timeout' < 'POOL_SLEEP_TIME', use 'timeout' as sleep time and then break
-        if(timeout < POOL_SLEEP_TIME) {
-            // sleep for 'timeout'
-            std::this_thread::sleep_for(timeout);
-            break;
-        } else {
-            std::this_thread::sleep_for(POOL_SLEEP_TIME);  // default pool rate
-        }
     } while(steady_clock::now() - searchStartTime < timeout);
 
     // Check if its an invalid device
@@ -211,7 +225,7 @@ std::tuple<bool, DeviceInfo> DeviceBase::getAnyAvailableDevice() {
 // First tries to find UNBOOTED device, then BOOTLOADER device
 std::tuple<bool, DeviceInfo> DeviceBase::getFirstAvailableDevice(bool skipInvalidDevice) {
     // Get all connected devices
-    auto devices = XLinkConnection::getAllConnectedDevices(X_LINK_ANY_STATE, skipInvalidDevice);
+    auto devices = DeviceDiscovery::getInstance().getDevices(skipInvalidDevice);
     // Search order - first unbooted, then bootloader and last flash booted
     for(auto searchState : {X_LINK_UNBOOTED, X_LINK_BOOTLOADER, X_LINK_FLASH_BOOTED}) {
         for(const auto& device : devices) {
@@ -226,7 +240,7 @@ std::tuple<bool, DeviceInfo> DeviceBase::getFirstAvailableDevice(bool skipInvali
 // Returns all devices which aren't already booted
 std::vector<DeviceInfo> DeviceBase::getAllAvailableDevices() {
     std::vector<DeviceInfo> availableDevices;
-    auto connectedDevices = XLinkConnection::getAllConnectedDevices();
+    auto connectedDevices = DeviceDiscovery::getInstance().getDevices();
     for(const auto& d : connectedDevices) {
         if(d.state != X_LINK_BOOTED) availableDevices.push_back(d);
     }
@@ -235,7 +249,7 @@ std::vector<DeviceInfo> DeviceBase::getAllAvailableDevices() {
 
 // Returns all devices, also the ones that are already booted
 std::vector<DeviceInfo> DeviceBase::getAllConnectedDevices() {
-    return XLinkConnection::getAllConnectedDevices();
+    return DeviceDiscovery::getInstance().getDevices();
 }
 
 // First tries to find UNBOOTED device with mxId, then BOOTLOADER device with mxId
@@ -287,15 +301,60 @@ class DeviceBase::Impl {
     DeviceLogger logger{"host", stdoutColorSink};
 
     // RPC
-    std::mutex rpcMutex;
+    using RpcClient = nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>;
     std::shared_ptr<XLinkStream> rpcStream;
-    std::unique_ptr<nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>> rpcClient;
+    std::shared_ptr<RpcTransport> rpcTransport;
+    std::unique_ptr<RpcClient> rpcClient;
+
+    // Issues all calls at once, pipelined, and only then waits for their responses
+    using BatchCall = std::function<void(RpcClient&)>;
+    void callBatch(const std::vector<BatchCall>& calls);
+    static void addSystemInformationCalls(SystemInformation& info, std::vector<BatchCall>& calls);
 
     void setLogLevel(LogLevel level);
     LogLevel getLogLevel();
     void setPattern(const std::string& pattern);
 };
 
+void DeviceBase::Impl::callBatch(const std::vector<BatchCall>& calls) {
+    // Calls are made twice, first to only capture their requests, then to parse the responses received for them
+    struct DeferredCall {};
+    std::vector<RpcTransport::Buffer> requests;
+    RpcClient recorder([&requests](nanorpc::core::type::buffer request) -> nanorpc::core::type::buffer {
+        requests.push_back(std::move(request));
+        throw DeferredCall{};
+    });
+    for(const auto& call : calls) {
+        try {
+            call(recorder);
+        } catch(const DeferredCall&) {
+        }
+    }
+    if(requests.size() != calls.size()) throw std::invalid_argument("Each call in a batch must issue exactly one RPC");
+
+    std::vector<RpcTransport::Buffer> responses;
+    try {
+        responses = rpcTransport->call(std::move(requests));
+    } catch(const std::exception& e) {
+        logger.debug("RPC error: {}", e.what());
+        throw std::system_error(std::make_error_code(std::errc::io_error), "Device already closed or disconnected");
+    }
+
+    std::size_t next = 0;
+    RpcClient replay([&responses, &next](nanorpc::core::type::buffer) { return std::move(responses[next++]); });
+    for(const auto& call : calls) call(replay);
+}
+
+void DeviceBase::Impl::addSystemInformationCalls(SystemInformation& info, std::vector<BatchCall>& calls) {
+    calls.push_back([&info](RpcClient& c) { info.ddrMemoryUsage = c.call("getDdrUsage").as<MemoryInfo>(); });
+    calls.push_back([&info](RpcClient& c) { info.cmxMemoryUsage = c.call("getCmxUsage").as<MemoryInfo>(); });
+    calls.push_back([&info](RpcClient& c) { info.leonCssMemoryUsage = c.call("getLeonCssHeapUsage").as<MemoryInfo>(); });
+    calls.push_back([&info](RpcClient& c) { info.leonMssMemoryUsage = c.call("getLeonMssHeapUsage").as<MemoryInfo>(); });
+    calls.push_back([&info](RpcClient& c) { info.leonCssCpuUsage = c.call("getLeonCssCpuUsage").as<CpuUsage>(); });
+    calls.push_back([&info](RpcClient& c) { info.leonMssCpuUsage = c.call("getLeonMssCpuUsage").as<CpuUsage>(); });
+    calls.push_back([&info](RpcClient& c) { info.chipTemperature = c.call("getChipTemperature").as<ChipTemperature>(); });
+}
+
 void DeviceBase::Impl::setPattern(const std::string& pattern) {
     logger.set_pattern(pattern);
 }
@@ -561,11 +620,24 @@ void DeviceBase::closeImpl() {
     watchdogRunning = false;
     // Stop watchdog first (this resets and waits for link to fall down)
     if(watchdogThread.joinable()) watchdogThread.join();
+    // Shared runtime tasks wait for their current run to finish, which closed connection unblocks
+    if(runtime) {
+        for(auto id : runtimeTasks) runtime->cancel(id);
+        runtimeTasks.clear();
+        runtime = nullptr;
+    }
+
+    // Stop telemetry before RPC goes away
+    stopTelemetry();
 
     // Stop various threads
     timesyncRunning = false;
     loggingRunning = false;
-    profilingRunning = false;
+    {
+        std::unique_lock<std::mutex> lock(profilingMtx);
+        profilingRunning = false;
+    }
+    profilingCv.notify_all();
 
     // Then stop timesync
     if(timesyncThread.joinable()) timesyncThread.join();
@@ -579,6 +651,7 @@ void DeviceBase::closeImpl() {
     // Close rpcStream
     pimpl->rpcStream = nullptr;
     pimpl->rpcClient = nullptr;
+    pimpl->rpcTransport = nullptr;
 
     if(!dumpOnly) {
         auto timeout = getCrashdumpTimeout(deviceInfo.protocol);
@@ -757,7 +830,8 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
         nlohmann::json jBoardConfig = config.board;
         pimpl->logger.debug("Device - BoardConfig: {} \nlibnop:{}", jBoardConfig.dump(), spdlog::to_hex(utility::serialize(config.board)));
     }
-    std::vector<std::uint8_t> fwWithConfig = Resources::getInstance().getDeviceFirmware(config, pathToMvcmd);
+    // Shared with other boots of the same configuration
+    auto fwWithConfig = Resources::getInstance().getDeviceFirmwareImage(config, pathToMvcmd);
 
     // Init device (if bootloader, handle correctly - issue USB boot command)
     if(deviceInfo.state == X_LINK_UNBOOTED) {
@@ -777,7 +851,7 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
                 using namespace std::chrono;
                 // Boot the given FW
                 auto t1 = steady_clock::now();
-                bl.bootMemory(fwWithConfig);
+                bl.bootMemory(*fwWithConfig);
                 auto t2 = steady_clock::now();
                 pimpl->logger.debug("Booting FW with Bootloader. Version {}, Time taken: {}", version.toString(), duration_cast<milliseconds>(t2 - t1));
 
@@ -808,24 +882,21 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
     // prepare rpc for both attached and host controlled mode
     pimpl->rpcStream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_MAIN_RPC, device::XLINK_USB_BUFFER_MAX_SIZE);
     auto rpcStream = pimpl->rpcStream;
+    // Requests of concurrent callers are pipelined, responses are matched back to them in order
+    auto rpcTransport = std::make_shared<RpcTransport>([rpcStream](RpcTransport::Buffer request) { rpcStream->write(std::move(request)); },
+                                                       [rpcStream]() { return rpcStream->read(); });
+    pimpl->rpcTransport = rpcTransport;
 
-    pimpl->rpcClient = std::make_unique<nanorpc::core::client<nanorpc::packer::nlohmann_msgpack>>([this, rpcStream](nanorpc::core::type::buffer request) {
-        // Lock for time of the RPC call, to not mix the responses between calling threads.
-        // Note: might cause issues on Windows on incorrect shutdown. To be investigated
-        std::unique_lock<std::mutex> lock(pimpl->rpcMutex);
-
+    pimpl->rpcClient = std::make_unique<Impl::RpcClient>([this, rpcTransport](nanorpc::core::type::buffer request) {
         // Log the request data
         if(getLogOutputLevel() == LogLevel::TRACE) {
             pimpl->logger.trace("RPC: {}", nlohmann::json::from_msgpack(request).dump());
         }
 
         try {
-            // Send request to device
-            rpcStream->write(std::move(request));
-
-            // Receive response back
+            // Send request to device and wait for its response
             // Send to nanorpc to parse
-            return rpcStream->read();
+            return rpcTransport->call(std::move(request));
         } catch(const std::exception& e) {
             // If any exception is thrown, log it and rethrow
             pimpl->logger.debug("RPC error: {}", e.what());
@@ -833,6 +904,12 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
         }
     });
 
+    // Housekeeping either runs on threads of this device or on the runtime shared by all devices
+    if(config.sharedRuntime || utility::getEnv("DEPTHAI_SHARED_RUNTIME") == "1") {
+        runtime = DeviceRuntime::getShared();
+        pimpl->logger.debug("Using shared runtime with {} threads", runtime->getNumThreads());
+    }
+
     // prepare watchdog thread, which will keep device alive
     // separate stream so it doesn't miss between potentially long RPC calls
     // Only create the thread if watchdog is enabled
@@ -843,50 +920,86 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
             lastWatchdogPingTime = std::chrono::steady_clock::now() + std::chrono::seconds(5);
         }
 
-        // Start watchdog thread for device
-        watchdogThread = std::thread([this, watchdogTimeout]() {
+        // Check if wd was pinged in the specified watchdogTimeout time.
+        auto monitorCheck = [this, watchdogTimeout]() {
+            decltype(lastWatchdogPingTime) prevPingTime;
+            {
+                std::unique_lock<std::mutex> lock(lastWatchdogPingTimeMtx);
+                prevPingTime = lastWatchdogPingTime;
+            }
+            // Recheck if watchdogRunning wasn't already closed and close if more than twice of WD passed
+            if(watchdogRunning && std::chrono::steady_clock::now() - prevPingTime > watchdogTimeout * 2) {
+                pimpl->logger.warn("Monitor thread (device: {} [{}]) - ping was missed, closing the device connection", deviceInfo.mxid, deviceInfo.name);
+                // ping was missed, reset the device
+                watchdogRunning = false;
+                // close the underlying connection
+                connection->close();
+            }
+        };
+
+        if(runtime) {
             try {
-                XLinkStream stream(connection, device::XLINK_CHANNEL_WATCHDOG, 128);
-                std::vector<uint8_t> watchdogKeepalive = {0, 0, 0, 0};
-                while(watchdogRunning) {
-                    stream.write(watchdogKeepalive);
-                    {
-                        std::unique_lock<std::mutex> lock(lastWatchdogPingTimeMtx);
-                        lastWatchdogPingTime = std::chrono::steady_clock::now();
+                auto stream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_WATCHDOG, 128);
+                runtimeTasks.push_back(runtime->schedule(std::chrono::milliseconds(0), [this, stream, watchdogTimeout]() -> std::chrono::milliseconds {
+                    static const std::vector<uint8_t> watchdogKeepalive = {0, 0, 0, 0};
+                    if(!watchdogRunning) return DeviceRuntime::STOP;
+                    try {
+                        // Bounded write, so a stalled device doesn't hold up workers. Missed pings are caught by the monitor
+                        if(stream->write(watchdogKeepalive, watchdogTimeout)) {
+                            std::unique_lock<std::mutex> lock(lastWatchdogPingTimeMtx);
+                            lastWatchdogPingTime = std::chrono::steady_clock::now();
+                        }
+                    } catch(const std::exception& ex) {
+                        pimpl->logger.debug("Watchdog task exception caught: {}", ex.what());
+                        // Watchdog ended. Useful for checking disconnects
+                        watchdogRunning = false;
+                        return DeviceRuntime::STOP;
                     }
                     // Ping with a period half of that of the watchdog timeout
-                    std::this_thread::sleep_for(watchdogTimeout / 2);
-                }
+                    return watchdogTimeout / 2;
+                }));
             } catch(const std::exception& ex) {
-                // ignore
-                pimpl->logger.debug("Watchdog thread exception caught: {}", ex.what());
+                pimpl->logger.debug("Watchdog task exception caught: {}", ex.what());
+                watchdogRunning = false;
             }
 
-            // Watchdog ended. Useful for checking disconnects
-            watchdogRunning = false;
-        });
-
-        // Start monitor thread for host - makes sure that device is responding to pings, otherwise it disconnects
-        monitorThread = std::thread([this, watchdogTimeout]() {
-            while(watchdogRunning) {
-                // Ping with a period half of that of the watchdog timeout
-                std::this_thread::sleep_for(watchdogTimeout);
-                // Check if wd was pinged in the specified watchdogTimeout time.
-                decltype(lastWatchdogPingTime) prevPingTime;
-                {
-                    std::unique_lock<std::mutex> lock(lastWatchdogPingTimeMtx);
-                    prevPingTime = lastWatchdogPingTime;
+            runtimeTasks.push_back(runtime->schedule(watchdogTimeout, [this, watchdogTimeout, monitorCheck]() -> std::chrono::milliseconds {
+                monitorCheck();
+                return watchdogRunning ? watchdogTimeout : DeviceRuntime::STOP;
+            }));
+        } else {
+            // Start watchdog thread for device
+            watchdogThread = std::thread([this, watchdogTimeout]() {
+                try {
+                    XLinkStream stream(connection, device::XLINK_CHANNEL_WATCHDOG, 128);
+                    std::vector<uint8_t> watchdogKeepalive = {0, 0, 0, 0};
+                    while(watchdogRunning) {
+                        stream.write(watchdogKeepalive);
+                        {
+                            std::unique_lock<std::mutex> lock(lastWatchdogPingTimeMtx);
+                            lastWatchdogPingTime = std::chrono::steady_clock::now();
+                        }
+                        // Ping with a period half of that of the watchdog timeout
+                        std::this_thread::sleep_for(watchdogTimeout / 2);
+                    }
+                } catch(const std::exception& ex) {
+                    // ignore
+                    pimpl->logger.debug("Watchdog thread exception caught: {}", ex.what());
                 }
-                // Recheck if watchdogRunning wasn't already closed and close if more than twice of WD passed
-                if(watchdogRunning && std::chrono::steady_clock::now() - prevPingTime > watchdogTimeout * 2) {
-                    pimpl->logger.warn("Monitor thread (device: {} [{}]) - ping was missed, closing the device connection", deviceInfo.mxid, deviceInfo.name);
-                    // ping was missed, reset the device
-                    watchdogRunning = false;
-                    // close the underlying connection
-                    connection->close();
+
+                // Watchdog ended. Useful for checking disconnects
+                watchdogRunning = false;
+            });
+
+            // Start monitor thread for host - makes sure that device is responding to pings, otherwise it disconnects
+            monitorThread = std::thread([this, watchdogTimeout, monitorCheck]() {
+                while(watchdogRunning) {
+                    // Ping with a period half of that of the watchdog timeout
+                    std::this_thread::sleep_for(watchdogTimeout);
+                    monitorCheck();
                 }
-            }
-        });
+            });
+        }
 
     } else {
         // Still set watchdogRunning explictitly
@@ -909,108 +1022,144 @@ void DeviceBase::init2(Config cfg, const dai::Path& pathToMvcmd, tl::optional<co
             throw;
         }
 
-        // prepare timesync thread, which will keep device synchronized
-        timesyncThread = std::thread([this]() {
+        // Echo timestamp back to device, which keeps it synchronized
+        auto handleTimesync = [this](XLinkStream& stream, const StreamPacketDesc& packet) {
             using namespace std::chrono;
 
-            try {
-                XLinkStream stream(connection, device::XLINK_CHANNEL_TIMESYNC, 128);
-                while(timesyncRunning) {
-                    // Block
-                    XLinkTimespec timestamp;
-                    stream.read(timestamp);
-
-                    // Write timestamp back
-                    stream.write(&timestamp, sizeof(timestamp));
-                }
-            } catch(const std::exception& ex) {
-                // ignore
-                pimpl->logger.debug("Timesync thread exception caught: {}", ex.what());
-            }
+            // Write timestamp back
+            XLinkTimespec timestamp = packet.tReceived;
+            stream.write(&timestamp, sizeof(timestamp));
 
-            timesyncRunning = false;
-        });
+            // Device send time against host receive time, for host side estimate
+            if(packet.tRemoteSent.tv_sec != 0 || packet.tRemoteSent.tv_nsec != 0) {
+                auto toTimePoint = [](const XLinkTimespec& ts) { return steady_clock::time_point{seconds(ts.tv_sec) + nanoseconds(ts.tv_nsec)}; };
+                clockSync.addSample(toTimePoint(packet.tRemoteSent), toTimePoint(packet.tReceived));
+            }
+        };
 
-        // prepare logging thread, which will log device messages
-        loggingThread = std::thread([this]() {
-            using namespace std::chrono;
+        // Log device messages and pass them to callbacks
+        auto handleLog = [this](const std::vector<std::uint8_t>& log) {
             std::vector<LogMessage> messages;
             try {
-                XLinkStream stream(connection, device::XLINK_CHANNEL_LOG, 128);
-                while(loggingRunning) {
-                    // Block
-                    auto log = stream.read();
-
-                    try {
-                        // Deserialize incoming messages
-                        utility::deserialize(log, messages);
+                // Deserialize incoming messages
+                utility::deserialize(log, messages);
 
-                        pimpl->logger.trace("Log vector decoded, size: {}", messages.size());
+                pimpl->logger.trace("Log vector decoded, size: {}", messages.size());
 
-                        // log the messages in incremental order (0 -> size-1)
-                        for(const auto& msg : messages) {
-                            pimpl->logger.logMessage(msg);
-                        }
+                // log the messages in incremental order (0 -> size-1)
+                for(const auto& msg : messages) {
+                    pimpl->logger.logMessage(msg);
+                }
 
-                        // Log to callbacks
-                        {
-                            // lock mtx to callback map (shared)
-                            std::unique_lock<std::mutex> l(logCallbackMapMtx);
-                            for(const auto& msg : messages) {
-                                for(const auto& kv : logCallbackMap) {
-                                    const auto& cb = kv.second;
-                                    // If available, callback with msg
-                                    if(cb) cb(msg);
-                                }
-                            }
+                // Log to callbacks
+                {
+                    // lock mtx to callback map (shared)
+                    std::unique_lock<std::mutex> l(logCallbackMapMtx);
+                    for(const auto& msg : messages) {
+                        for(const auto& kv : logCallbackMap) {
+                            const auto& cb = kv.second;
+                            // If available, callback with msg
+                            if(cb) cb(msg);
                         }
-
-                    } catch(const nlohmann::json::exception& ex) {
-                        pimpl->logger.error("Exception while parsing or calling callbacks for log message from device: {}", ex.what());
                     }
                 }
+
+            } catch(const nlohmann::json::exception& ex) {
+                pimpl->logger.error("Exception while parsing or calling callbacks for log message from device: {}", ex.what());
+            }
+        };
+
+        if(runtime) {
+            // Poll both streams from a single task, faster while packets are arriving
+            std::shared_ptr<XLinkStream> timesyncStream, logStream;
+            try {
+                timesyncStream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_TIMESYNC, 128);
+            } catch(const std::exception& ex) {
+                pimpl->logger.debug("Timesync task exception caught: {}", ex.what());
+                timesyncRunning = false;
+            }
+            try {
+                logStream = std::make_shared<XLinkStream>(connection, device::XLINK_CHANNEL_LOG, 128);
             } catch(const std::exception& ex) {
-                // ignore exception from logging
-                pimpl->logger.debug("Log thread exception caught: {}", ex.what());
+                pimpl->logger.debug("Log task exception caught: {}", ex.what());
+                loggingRunning = false;
             }
 
-            loggingRunning = false;
-        });
+            auto interval = SHARED_RUNTIME_MIN_POLL_INTERVAL;
+            auto poll = [this, timesyncStream, logStream, handleTimesync, handleLog, interval]() mutable -> std::chrono::milliseconds {
+                bool received = false;
+                try {
+                    while(timesyncRunning) {
+                        StreamPacketDesc packet;
+                        if(!timesyncStream->readMove(packet, SHARED_RUNTIME_READ_TIMEOUT)) break;
+                        handleTimesync(*timesyncStream, packet);
+                        received = true;
+                    }
+                } catch(const std::exception& ex) {
+                    // ignore
+                    pimpl->logger.debug("Timesync task exception caught: {}", ex.what());
+                    timesyncRunning = false;
+                }
+                try {
+                    while(loggingRunning) {
+                        StreamPacketDesc packet;
+                        if(!logStream->readMove(packet, SHARED_RUNTIME_READ_TIMEOUT)) break;
+                        handleLog(std::vector<std::uint8_t>(packet.data, packet.data + packet.length));
+                        received = true;
+                    }
+                } catch(const std::exception& ex) {
+                    // ignore exception from logging
+                    pimpl->logger.debug("Log task exception caught: {}", ex.what());
+                    loggingRunning = false;
+                }
 
-        if(utility::getEnv("DEPTHAI_PROFILING") == "1") {
-            // prepare profiling thread, which will log device messages
-            profilingThread = std::thread([this]() {
-                using namespace std::chrono;
+                if(!timesyncRunning && !loggingRunning) return DeviceRuntime::STOP;
+                interval = received ? SHARED_RUNTIME_MIN_POLL_INTERVAL : std::min(interval * 2, SHARED_RUNTIME_MAX_POLL_INTERVAL);
+                return interval;
+            };
+            runtimeTasks.push_back(runtime->schedule(std::chrono::milliseconds(0), poll));
+        } else {
+            // prepare timesync thread, which will keep device synchronized
+            timesyncThread = std::thread([this, handleTimesync]() {
                 try {
-                    ProfilingData lastData = {};
-                    // TODO(themarpe) - expose
-                    float rate = 1.0f;
-                    while(profilingRunning) {
-                        ProfilingData data = getProfilingData();
-                        long long w = data.numBytesWritten - lastData.numBytesWritten;
-                        long long r = data.numBytesRead - lastData.numBytesRead;
-                        w = static_cast<long long>(w / rate);
-                        r = static_cast<long long>(r / rate);
-
-                        lastData = data;
-
-                        pimpl->logger.debug("Profiling write speed: {:.2f} MiB/s, read speed: {:.2f} MiB/s, total written: {:.2f} MiB, read: {:.2f} MiB",
-                                            w / 1024.0f / 1024.0f,
-                                            r / 1024.0f / 1024.0f,
-                                            data.numBytesWritten / 1024.0f / 1024.0f,
-                                            data.numBytesRead / 1024.0f / 1024.0f);
-
-                        std::this_thread::sleep_for(duration<float>(1) / rate);
+                    XLinkStream stream(connection, device::XLINK_CHANNEL_TIMESYNC, 128);
+                    while(timesyncRunning) {
+                        // Block
+                        auto packet = stream.readMove();
+                        handleTimesync(stream, packet);
+                    }
+                } catch(const std::exception& ex) {
+                    // ignore
+                    pimpl->logger.debug("Timesync thread exception caught: {}", ex.what());
+                }
+
+                timesyncRunning = false;
+            });
+
+            // prepare logging thread, which will log device messages
+            loggingThread = std::thread([this, handleLog]() {
+                try {
+                    XLinkStream stream(connection, device::XLINK_CHANNEL_LOG, 128);
+                    while(loggingRunning) {
+                        // Block
+                        handleLog(stream.read());
                     }
                 } catch(const std::exception& ex) {
                     // ignore exception from logging
-                    pimpl->logger.debug("Profiling thread exception caught: {}", ex.what());
+                    pimpl->logger.debug("Log thread exception caught: {}", ex.what());
                 }
 
-                profilingRunning = false;
+                loggingRunning = false;
             });
         }
 
+        if(utility::getEnv("DEPTHAI_PROFILING") == "1") {
+            // profiling thread logs per stream bandwidth
+            std::unique_lock<std::mutex> lock(profilingMtx);
+            profilingLog = true;
+            startProfilingThread();
+        }
+
         // Below can throw - make sure to gracefully exit threads
         try {
             // Starts and waits for inital timesync
@@ -1184,6 +1333,24 @@ tl::optional<Version> DeviceBase::getBootloaderVersion() {
     return bootloaderVersion;
 }
 
+SystemInformation DeviceBase::getSystemInformation() {
+    SystemInformation info;
+    std::vector<Impl::BatchCall> calls;
+    Impl::addSystemInformationCalls(info, calls);
+    pimpl->callBatch(calls);
+    return info;
+}
+
+DeviceBase::Status DeviceBase::getStatus() {
+    Status status;
+    std::vector<Impl::BatchCall> calls;
+    Impl::addSystemInformationCalls(status.systemInformation, calls);
+    calls.push_back([&status](Impl::RpcClient& c) { status.connectedCameras = c.call("getConnectedCameras").as<std::vector<CameraBoardSocket>>(); });
+    calls.push_back([&status](Impl::RpcClient& c) { status.pipelineRunning = c.call("isPipelineRunning").as<bool>(); });
+    pimpl->callBatch(calls);
+    return status;
+}
+
 bool DeviceBase::isPipelineRunning() {
     return pimpl->rpcClient->call("isPipelineRunning").as<bool>();
 }
@@ -1264,6 +1431,167 @@ ProfilingData DeviceBase::getProfilingData() {
     return connection->getProfilingData();
 }
 
+std::unordered_map<std::string, StreamProfilingData> DeviceBase::getStreamProfilingData() {
+    return connection->getStreamProfilingData();
+}
+
+std::unordered_map<std::string, StreamProfilingData> DeviceBase::getStreamProfilingData(std::chrono::milliseconds window) {
+    return connection->getStreamProfilingData(window);
+}
+
+void DeviceBase::setStreamProfilingCallback(std::function<void(std::unordered_map<std::string, StreamProfilingData>)> callback,
+                                            std::chrono::milliseconds period) {
+    if(period <= std::chrono::milliseconds(0)) throw std::invalid_argument("Profiling period must be positive");
+    std::unique_lock<std::mutex> lock(profilingMtx);
+    profilingCallback = std::move(callback);
+    profilingPeriod = period;
+    if(profilingCallback) startProfilingThread();
+    lock.unlock();
+    profilingCv.notify_all();
+}
+
+void DeviceBase::startProfilingThread() {
+    // Thread exits on its own once there is nothing to report
+    if(profilingThreadActive || !profilingRunning) return;
+    if(profilingThread.joinable()) profilingThread.join();
+    profilingThreadActive = true;
+
+    profilingThread = std::thread([this]() {
+        using namespace std::chrono;
+        std::unique_lock<std::mutex> lock(profilingMtx);
+        while(profilingRunning && (profilingLog || profilingCallback)) {
+            auto period = profilingPeriod;
+            auto callback = profilingCallback;
+            bool log = profilingLog;
+            lock.unlock();
+
+            try {
+                auto data = connection->getStreamProfilingData(period);
+                if(log) {
+                    // Heaviest streams first
+                    std::vector<std::pair<std::string, StreamProfilingData>> streams(data.begin(), data.end());
+                    std::sort(streams.begin(), streams.end(), [](const decltype(streams)::value_type& a, const decltype(streams)::value_type& b) {
+                        return a.second.writeRate + a.second.readRate > b.second.writeRate + b.second.readRate;
+                    });
+                    for(const auto& kv : streams) {
+                        const auto& s = kv.second;
+                        if(s.numPacketsWritten == 0 && s.numPacketsRead == 0) continue;
+                        pimpl->logger.debug("Profiling stream '{}' write: {:.2f} MiB/s ({} packets, stalled {}ms), "
+                                            "read: {:.2f} MiB/s ({} packets, waited {}ms)",
+                                            kv.first,
+                                            s.writeRate / 1024.0f / 1024.0f,
+                                            s.numPacketsWritten,
+                                            duration_cast<milliseconds>(s.writeStallTime).count(),
+                                            s.readRate / 1024.0f / 1024.0f,
+                                            s.numPacketsRead,
+                                            duration_cast<milliseconds>(s.readWaitTime).count());
+                    }
+                    ProfilingData total = getProfilingData();
+                    pimpl->logger.debug("Profiling total written: {:.2f} MiB, read: {:.2f} MiB",
+                                        total.numBytesWritten / 1024.0f / 1024.0f,
+                                        total.numBytesRead / 1024.0f / 1024.0f);
+                }
+                if(callback) callback(std::move(data));
+            } catch(const std::exception& ex) {
+                // ignore exception from profiling
+                pimpl->logger.debug("Profiling thread exception caught: {}", ex.what());
+            }
+
+            lock.lock();
+            profilingCv.wait_for(lock, period, [this]() { return !profilingRunning; });
+        }
+        profilingThreadActive = false;
+    });
+}
+
+std::shared_ptr<const TelemetryBuffer> DeviceBase::startTelemetry(std::chrono::milliseconds period, std::size_t capacity, std::string exportPath) {
+    if(period <= std::chrono::milliseconds(0)) throw std::invalid_argument("Telemetry period must be positive");
+    // Concurrent calls would otherwise both start a thread, overwriting a joinable one
+    std::unique_lock<std::mutex> control(telemetryControlMtx);
+    stopTelemetryThread();
+
+    auto buffer = std::make_shared<TelemetryBuffer>(capacity);
+    {
+        std::unique_lock<std::mutex> lock(telemetryMtx);
+        telemetry = buffer;
+        telemetryRunning = true;
+    }
+
+    telemetryThread = std::thread([this, buffer, period, exportPath]() {
+        using namespace std::chrono;
+        const auto mxId = deviceInfo.getMxId();
+        TelemetrySample previous = {};
+        bool hasPrevious = false;
+        std::unique_lock<std::mutex> lock(telemetryMtx);
+        while(telemetryRunning) {
+            lock.unlock();
+            try {
+                TelemetrySample sample = {};
+                auto info = getSystemInformation();
+                sample.profilingData = getProfilingData();
+                sample.timestamp = steady_clock::now();
+                sample.ddrMemoryUsage = info.ddrMemoryUsage;
+                sample.cmxMemoryUsage = info.cmxMemoryUsage;
+                sample.leonCssMemoryUsage = info.leonCssMemoryUsage;
+                sample.leonMssMemoryUsage = info.leonMssMemoryUsage;
+                sample.leonCssCpuUsage = info.leonCssCpuUsage;
+                sample.leonMssCpuUsage = info.leonMssCpuUsage;
+                sample.chipTemperature = info.chipTemperature;
+                if(hasPrevious) {
+                    const auto elapsed = duration<float>(sample.timestamp - previous.timestamp).count();
+                    if(elapsed > 0.0f) {
+                        sample.xlinkWriteRate = (sample.profilingData.numBytesWritten - previous.profilingData.numBytesWritten) / elapsed;
+                        sample.xlinkReadRate = (sample.profilingData.numBytesRead - previous.profilingData.numBytesRead) / elapsed;
+                    }
+                }
+                buffer->push(sample);
+                previous = sample;
+                hasPrevious = true;
+
+                if(!exportPath.empty()) {
+                    // Replace the file at once, so readers never see a partially written one
+                    const auto tmpPath = exportPath + ".tmp";
+                    {
+                        std::ofstream file(tmpPath, std::ios::out | std::ios::trunc);
+                        file << buffer->toText(mxId);
+                    }
+                    // Renaming over an existing file fails on some platforms, remove it then
+                    if(std::rename(tmpPath.c_str(), exportPath.c_str()) != 0
+                       && (std::remove(exportPath.c_str()) != 0 || std::rename(tmpPath.c_str(), exportPath.c_str()) != 0)) {
+                        pimpl->logger.debug("Couldn't write telemetry to '{}'", exportPath);
+                    }
+                }
+            } catch(const std::exception& ex) {
+                pimpl->logger.debug("Telemetry thread exception caught: {}", ex.what());
+                if(isClosed()) break;
+            }
+            lock.lock();
+            telemetryCv.wait_for(lock, period, [this]() { return !telemetryRunning; });
+        }
+    });
+
+    return buffer;
+}
+
+void DeviceBase::stopTelemetry() {
+    std::unique_lock<std::mutex> control(telemetryControlMtx);
+    stopTelemetryThread();
+}
+
+void DeviceBase::stopTelemetryThread() {
+    {
+        std::unique_lock<std::mutex> lock(telemetryMtx);
+        telemetryRunning = false;
+    }
+    telemetryCv.notify_all();
+    if(telemetryThread.joinable()) telemetryThread.join();
+}
+
+std::shared_ptr<const TelemetryBuffer> DeviceBase::getTelemetry() const {
+    std::unique_lock<std::mutex> lock(telemetryMtx);
+    return telemetry;
+}
+
 int DeviceBase::addLogCallback(std::function<void(LogMessage)> callback) {
     // Lock first
     std::unique_lock<std::mutex> l(logCallbackMapMtx);
@@ -1299,6 +1627,10 @@ void DeviceBase::setTimesync(std::chrono::milliseconds period, int numSamples, b
     pimpl->rpcClient->call("setTimesync", duration_cast<milliseconds>(period).count(), numSamples, random);
 }
 
+ClockModel DeviceBase::getClockModel() const {
+    return clockSync.getModel();
+}
+
 void DeviceBase::setTimesync(bool enable) {
     if(enable) {
         setTimesync(DEFAULT_TIMESYNC_PERIOD, DEFAULT_TIMESYNC_NUM_SAMPLES, DEFAULT_TIMESYNC_RANDOM);
@@ -1506,7 +1838,7 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
-    std::vector<std::uint8_t> assetStorage;
+    AssetStorage assetStorage;
     pipeline.serialize(schema, assets, assetStorage);
 
     // if debug or lower
@@ -1515,6 +1847,7 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
         pimpl->logger.debug("Schema dump: {}", jSchema.dump());
         nlohmann::json jAssets = assets;
         pimpl->logger.debug("Asset map dump: {}", jAssets.dump());
+        pimpl->logger.debug("Asset storage size: {}B, deduplicated: {}B", assetStorage.size(), assetStorage.getDeduplicatedSize());
     }
 
     // Load pipelineDesc, assets, and asset storage
@@ -1524,16 +1857,11 @@ bool DeviceBase::startPipelineImpl(const Pipeline& pipeline) {
     if(!assetStorage.empty()) {
         pimpl->rpcClient->call("setAssets", assets);
 
-        // Transfer the whole assetStorage in a separate thread
+        // Transfer the whole assetStorage in a separate thread, directly from (mapped) asset data
         const std::string streamAssetStorage = "__stream_asset_storage";
         std::thread t1([this, &streamAssetStorage, &assetStorage]() {
             XLinkStream stream(connection, streamAssetStorage, device::XLINK_USB_BUFFER_MAX_SIZE);
-            int64_t offset = 0;
-            do {
-                int64_t toTransfer = std::min(static_cast<int64_t>(device::XLINK_USB_BUFFER_MAX_SIZE), static_cast<int64_t>(assetStorage.size() - offset));
-                stream.write(&assetStorage[offset], toTransfer);
-                offset += toTransfer;
-            } while(offset < static_cast<int64_t>(assetStorage.size()));
+            assetStorage.write(device::XLINK_USB_BUFFER_MAX_SIZE, [&stream](const std::uint8_t* data, std::size_t size) { stream.write(data, size); });
         });
 
         pimpl->rpcClient->call("readAssetStorageFromXLink", streamAssetStorage, assetStorage.size());
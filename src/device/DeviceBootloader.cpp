@@ -1,7 +1,15 @@
 #include "device/DeviceBootloader.hpp"
 
 // std
+#include <algorithm>
+#include <cstring>
+#include <exception>
 #include <fstream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 // shared
 #include "depthai-bootloader-shared/Bootloader.hpp"
@@ -16,9 +24,13 @@
 // project
 #include "device/Device.hpp"
 #include "pipeline/Pipeline.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+#include "utility/Compression.hpp"
+#include "utility/Environment.hpp"
 #include "utility/Platform.hpp"
 #include "utility/Resources.hpp"
 #include "utility/spdlog-fmt.hpp"
+#include "xlink/DeviceDiscovery.hpp"
 
 // libraries
 #include "XLink/XLink.h"
@@ -47,7 +59,7 @@ constexpr const DeviceBootloader::Type DeviceBootloader::DEFAULT_TYPE;
 // First tries to find UNBOOTED device, then BOOTLOADER device
 std::tuple<bool, DeviceInfo> DeviceBootloader::getFirstAvailableDevice() {
     // Get all connected devices
-    auto devices = XLinkConnection::getAllConnectedDevices();
+    auto devices = DeviceDiscovery::getInstance().getDevices();
     // Search order - first unbooted, then bootloader and last flash booted
     for(auto searchState : {X_LINK_UNBOOTED, X_LINK_BOOTLOADER, X_LINK_FLASH_BOOTED}) {
         for(const auto& device : devices) {
@@ -62,28 +74,138 @@ std::tuple<bool, DeviceInfo> DeviceBootloader::getFirstAvailableDevice() {
 // Returns all devices which aren't already booted
 std::vector<DeviceInfo> DeviceBootloader::getAllAvailableDevices() {
     std::vector<DeviceInfo> availableDevices;
-    auto connectedDevices = XLinkConnection::getAllConnectedDevices();
+    auto connectedDevices = DeviceDiscovery::getInstance().getDevices();
     for(const auto& d : connectedDevices) {
         if(d.state != X_LINK_BOOTED) availableDevices.push_back(d);
     }
     return availableDevices;
 }
 
+// Produces chunks on a separate thread while previous ones are consumed on the calling thread.
+// At most 'depth' chunk buffers exist and are reused, which keeps memory bounded regardless of total size
+static void transferChunked(std::size_t numChunks,
+                            const std::function<void(std::size_t, std::vector<uint8_t>&)>& produce,
+                            const std::function<void(std::size_t, std::vector<uint8_t>&)>& consume,
+                            unsigned depth = 3) {
+    using Chunk = std::shared_ptr<std::vector<uint8_t>>;
+    LockingQueue<Chunk> filled(depth), empty(depth);
+    for(unsigned i = 0; i < depth; i++) empty.push(std::make_shared<std::vector<uint8_t>>());
+
+    std::exception_ptr producerError;
+    std::thread producer([&]() {
+        try {
+            for(std::size_t i = 0; i < numChunks; i++) {
+                Chunk chunk;
+                if(!empty.waitAndPop(chunk)) return;
+                produce(i, *chunk);
+                if(!filled.push(chunk)) return;
+            }
+        } catch(...) {
+            producerError = std::current_exception();
+            filled.destruct();
+        }
+    });
+
+    try {
+        for(std::size_t i = 0; i < numChunks; i++) {
+            Chunk chunk;
+            if(!filled.waitAndPop(chunk)) break;
+            consume(i, *chunk);
+            empty.push(chunk);
+        }
+    } catch(...) {
+        empty.destruct();
+        filled.destruct();
+        producer.join();
+        throw;
+    }
+    producer.join();
+    if(producerError) std::rethrow_exception(producerError);
+}
+
+// Compressed firmware for Depthai Application Packages, shared by all packages built with the same firmware
+static std::shared_ptr<const std::vector<uint8_t>> getCompressedDeviceFirmware(const DeviceBase::Config& config, const dai::Path& pathToCmd) {
+    constexpr std::size_t MAX_CACHED_FIRMWARES = 8;
+    struct Entry {
+        std::shared_ptr<const std::vector<uint8_t>> firmware;
+        // Position of the key in recency list
+        std::list<std::string>::iterator position;
+    };
+    static std::mutex mtx;
+    // Keys from most to least recently used, the latter is evicted when the cache is full
+    static std::list<std::string> recency;
+    static std::map<std::string, Entry> cache;
+
+    // Only embedded firmware is cached, which is fully determined by library version, OpenVINO version and board config
+    const bool cacheable = pathToCmd.empty() && utility::getEnv("DEPTHAI_DEVICE_BINARY").empty();
+    std::string key;
+    if(cacheable) {
+        auto board = utility::serialize(config.board);
+        key = fmt::format("{}/{}/", DEPTHAI_DEVICE_VERSION, OpenVINO::getVersionName(config.version)) + std::string(board.begin(), board.end());
+        std::unique_lock<std::mutex> lock(mtx);
+        auto cached = cache.find(key);
+        if(cached != cache.end()) {
+            recency.splice(recency.begin(), recency, cached->second.position);
+            return cached->second.firmware;
+        }
+    }
+
+    std::vector<uint8_t> deviceFirmware = Resources::getInstance().getDeviceFirmware(config, pathToCmd);
+    if(deviceFirmware.empty()) {
+        throw std::runtime_error("Error getting device firmware");
+    }
+
+    using namespace std::chrono;
+    auto t1 = steady_clock::now();
+    // Chosen impirically
+    constexpr int COMPRESSION_LEVEL = 9;
+    // Independent blocks compressed in parallel, still a single zlib stream as expected by SBR_COMPRESSION_ZLIB
+    auto compressed = std::make_shared<const std::vector<uint8_t>>(utility::deflateParallel(deviceFirmware.data(), deviceFirmware.size(), COMPRESSION_LEVEL));
+
+    auto diff = duration_cast<milliseconds>(steady_clock::now() - t1);
+    logger::debug("Compressed firmware for Dephai Application Package. Took {}, size reduced from {:.2f}MiB to {:.2f}MiB",
+                  diff,
+                  deviceFirmware.size() / (1024.0f * 1024.0f),
+                  compressed->size() / (1024.0f * 1024.0f));
+
+    if(cacheable) {
+        std::unique_lock<std::mutex> lock(mtx);
+        // Another thread might have compressed the same firmware meanwhile
+        auto cached = cache.find(key);
+        if(cached != cache.end()) {
+            recency.splice(recency.begin(), recency, cached->second.position);
+            return cached->second.firmware;
+        }
+        if(cache.size() >= MAX_CACHED_FIRMWARES) {
+            cache.erase(recency.back());
+            recency.pop_back();
+        }
+        recency.push_front(key);
+        cache[key] = Entry{compressed, recency.begin()};
+    }
+    return compressed;
+}
+
 std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     const Pipeline& pipeline, const dai::Path& pathToCmd, bool compress, std::string applicationName, bool checkChecksum) {
     // Serialize the pipeline
     PipelineSchema schema;
     Assets assets;
-    std::vector<std::uint8_t> assetStorage;
+    AssetStorage assetStorage;
     pipeline.serialize(schema, assets, assetStorage);
 
     // Get DeviceConfig
     DeviceBase::Config deviceConfig = pipeline.getDeviceConfig();
 
-    // Prepare device firmware
-    std::vector<uint8_t> deviceFirmware = Resources::getInstance().getDeviceFirmware(deviceConfig, pathToCmd);
-    if(deviceFirmware.empty()) {
-        throw std::runtime_error("Error getting device firmware");
+    // Prepare device firmware, compressed one is reused across packages
+    std::shared_ptr<const std::vector<uint8_t>> deviceFirmware;
+    if(compress) {
+        deviceFirmware = getCompressedDeviceFirmware(deviceConfig, pathToCmd);
+    } else {
+        deviceFirmware = std::make_shared<const std::vector<uint8_t>>(Resources::getInstance().getDeviceFirmware(deviceConfig, pathToCmd));
+        if(deviceFirmware->empty()) {
+            throw std::runtime_error("Error getting device firmware");
+        }
     }
 
     // Serialize data
@@ -120,43 +242,11 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
         return ((((S) + (SECTION_ALIGNMENT_SIZE)-1)) & ~((SECTION_ALIGNMENT_SIZE)-1));
     };
 
-    // Should compress firmware?
-    if(compress) {
-        using namespace std::chrono;
-
-        auto t1 = steady_clock::now();
-        auto compressBufferSize = compressBound(static_cast<decltype(compressBound(1))>(deviceFirmware.size()));
-        std::vector<uint8_t> compressBuffer(compressBufferSize);
-        // Chosen impirically
-        constexpr int COMPRESSION_LEVEL = 9;
-        if(compress2(compressBuffer.data(),
-                     &compressBufferSize,
-                     deviceFirmware.data(),
-                     static_cast<decltype(compressBufferSize)>(deviceFirmware.size()),
-                     COMPRESSION_LEVEL)
-           != Z_OK) {
-            throw std::runtime_error("Error while compressing device firmware\n");
-        }
-
-        // Resize output buffer
-        compressBuffer.resize(compressBufferSize);
-
-        // Set the compressed firmware
-        auto prevSize = deviceFirmware.size();
-        deviceFirmware = std::move(compressBuffer);
-
-        auto diff = duration_cast<milliseconds>(steady_clock::now() - t1);
-        logger::debug("Compressed firmware for Dephai Application Package. Took {}, size reduced from {:.2f}MiB to {:.2f}MiB",
-                      diff,
-                      prevSize / (1024.0f * 1024.0f),
-                      deviceFirmware.size() / (1024.0f * 1024.0f));
-    }
-
     // Section, MVCMD, name '__firmware'
     sbr_section_set_name(fwSection, "__firmware");
     sbr_section_set_bootable(fwSection, true);
-    sbr_section_set_size(fwSection, static_cast<uint32_t>(deviceFirmware.size()));
-    sbr_section_set_checksum(fwSection, sbr_compute_checksum(deviceFirmware.data(), static_cast<uint32_t>(deviceFirmware.size())));
+    sbr_section_set_size(fwSection, static_cast<uint32_t>(deviceFirmware->size()));
+    sbr_section_set_checksum(fwSection, sbr_compute_checksum(deviceFirmware->data(), static_cast<uint32_t>(deviceFirmware->size())));
     sbr_section_set_offset(fwSection, SBR_RAW_SIZE);
     if(checkChecksum) {
         // Don't ignore checksum, use it when booting
@@ -187,7 +277,6 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     // Section, asset storage, name 'asset_storage'
     sbr_section_set_name(assetStorageSection, "asset_storage");
     sbr_section_set_size(assetStorageSection, static_cast<uint32_t>(assetStorage.size()));
-    sbr_section_set_checksum(assetStorageSection, sbr_compute_checksum(assetStorage.data(), static_cast<uint32_t>(assetStorage.size())));
     sbr_section_set_offset(assetStorageSection, getSectionAlignedOffsetSmall(assetsSection->offset + assetsSection->size));
 
     // Section, firmware version
@@ -208,17 +297,22 @@ std::vector<uint8_t> DeviceBootloader::createDepthaiApplicationPackage(
     std::vector<uint8_t> fwPackage;
     fwPackage.resize(lastSection->offset + lastSection->size);
 
+    // Write to fwPackage
+    std::copy(deviceFirmware->begin(), deviceFirmware->end(), fwPackage.begin() + fwSection->offset);
+    std::copy(fwVersionBuffer.begin(), fwVersionBuffer.end(), fwPackage.begin() + fwVersionSection->offset);
+    std::copy(applicationName.begin(), applicationName.end(), fwPackage.begin() + appNameSection->offset);
+    std::copy(pipelineBinary.begin(), pipelineBinary.end(), fwPackage.begin() + pipelineSection->offset);
+    std::copy(assetsBinary.begin(), assetsBinary.end(), fwPackage.begin() + assetsSection->offset);
+    // Asset storage is written directly from asset data, its checksum computed in place
+    auto assetStorageOffset = fwPackage.begin() + assetStorageSection->offset;
+    assetStorage.write(assetStorage.size() > 0 ? assetStorage.size() : 1, [&assetStorageOffset](const std::uint8_t* data, std::size_t size) {
+        assetStorageOffset = std::copy(data, data + size, assetStorageOffset);
+    });
+    sbr_section_set_checksum(assetStorageSection, sbr_compute_checksum(&fwPackage[assetStorageSection->offset], assetStorageSection->size));
+
     // Serialize SBR
     sbr_serialize(&sbr, fwPackage.data(), static_cast<uint32_t>(fwPackage.size()));
 
-    // Write to fwPackage
-    for(std::size_t i = 0; i < deviceFirmware.size(); i++) fwPackage[fwSection->offset + i] = deviceFirmware[i];
-    for(std::size_t i = 0; i < fwVersionBuffer.size(); i++) fwPackage[fwVersionSection->offset + i] = fwVersionBuffer[i];
-    for(std::size_t i = 0; i < applicationName.size(); i++) fwPackage[appNameSection->offset + i] = applicationName[i];
-    for(std::size_t i = 0; i < pipelineBinary.size(); i++) fwPackage[pipelineSection->offset + i] = pipelineBinary[i];
-    for(std::size_t i = 0; i < assetsBinary.size(); i++) fwPackage[assetsSection->offset + i] = assetsBinary[i];
-    for(std::size_t i = 0; i < assetStorage.size(); i++) fwPackage[assetStorageSection->offset + i] = assetStorage[i];
-
     // Debug
     if(logger::get_level() == spdlog::level::debug) {
         SBR_SECTION* cur = &sbr.sections[0];
@@ -744,7 +838,7 @@ bool DeviceBootloader::isUserBootloader() {
 }
 
 std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackage(std::function<void(float)> progressCb,
-                                                                               std::vector<uint8_t> package,
+                                                                               const std::vector<uint8_t>& package,
                                                                                Memory memory) {
     // Bug in NETWORK bootloader in version 0.0.12 < 0.0.14 - flashing can cause a soft brick
     if(!getFlashedVersion()) {
@@ -801,6 +895,16 @@ std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackage(s
     }
 
     // Try specifing final app memory if set explicitly or if AUTO would be EMMC
+    setApplicationMemory(memory);
+
+    return ret;
+}
+
+std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackage(const std::vector<uint8_t>& package, Memory memory) {
+    return flashDepthaiApplicationPackage(nullptr, package, memory);
+}
+
+void DeviceBootloader::setApplicationMemory(Memory memory) {
     try {
         Memory finalAppMem = Memory::FLASH;
         if(memory != Memory::AUTO) {
@@ -835,12 +939,155 @@ std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackage(s
     } catch(const std::exception& ex) {
         logger::debug("Error while trying to specify final appMem configuration: {}", ex.what());
     }
-
-    return ret;
 }
 
-std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackage(std::vector<uint8_t> package, Memory memory) {
-    return flashDepthaiApplicationPackage(nullptr, package, memory);
+std::tuple<bool, std::string> DeviceBootloader::flashDepthaiApplicationPackageDelta(std::function<void(DeltaFlashProgress)> progressCb,
+                                                                                    const std::vector<uint8_t>& package,
+                                                                                    Memory memory) {
+    // Granularity in which sections are compared and rewritten
+    constexpr std::size_t DELTA_BLOCK_SIZE = 64 * 1024;
+
+    // Same restrictions as for regular flashing apply
+    if(!getFlashedVersion()) {
+        return {false, "Can't flash DepthAI application package without knowing flashed bootloader version."};
+    }
+    auto bootloaderVersion = *getFlashedVersion();
+    if(bootloaderType == Type::NETWORK && bootloaderVersion < Version(0, 0, 14)) {
+        throw std::invalid_argument("Network bootloader requires version 0.0.14 or higher to flash applications. Current version: "
+                                    + bootloaderVersion.toString());
+    }
+    if(getVersion() < Version(0, 0, 12)) {
+        throw std::runtime_error("Current bootloader version doesn't support custom flashing");
+    }
+
+    SBR sbr = {};
+    if(package.size() < SBR_RAW_SIZE || sbr_parse(package.data(), SBR_RAW_SIZE, &sbr) != 0) {
+        throw std::invalid_argument("Package doesn't contain a valid SBR header");
+    }
+
+    // Resolve memory in which the application resides, same as bootloader does for AUTO
+    Memory targetMemory = memory;
+    if(memory == Memory::AUTO) {
+        targetMemory = Memory::FLASH;
+        if(bootloaderType == Type::NETWORK && getMemoryInfo(Memory::EMMC).available) {
+            targetMemory = Memory::EMMC;
+        }
+    }
+    const std::size_t appOffset = bootloader::getStructure(getType()).offset.at(Section::APPLICATION);
+
+    const std::size_t numBlocks = (package.size() + DELTA_BLOCK_SIZE - 1) / DELTA_BLOCK_SIZE;
+    std::vector<bool> dirty(numBlocks, false);
+    auto markDirty = [&](std::size_t offset, std::size_t size) {
+        if(size == 0) return;
+        for(std::size_t b = offset / DELTA_BLOCK_SIZE; b <= (offset + size - 1) / DELTA_BLOCK_SIZE && b < numBlocks; b++) dirty[b] = true;
+    };
+
+    // Read back the header of flashed application
+    bool success;
+    std::string errorMsg;
+    std::vector<uint8_t> flashedHeader;
+    SBR flashed = {};
+    std::tie(success, errorMsg) = readCustom(targetMemory, appOffset, SBR_RAW_SIZE, flashedHeader, nullptr);
+    if(!success || sbr_parse(flashedHeader.data(), SBR_RAW_SIZE, &flashed) != 0) {
+        logger::debug("No valid flashed application found ({}), flashing whole package", success ? "invalid header" : errorMsg);
+        markDirty(0, package.size());
+    } else {
+        if(memcmp(flashedHeader.data(), package.data(), SBR_RAW_SIZE) != 0) markDirty(0, SBR_RAW_SIZE);
+
+        std::vector<uint8_t> flashedData;
+        for(const auto& section : sbr.sections) {
+            if(section.name[0] == '\0' || section.size == 0) continue;
+            if(static_cast<std::size_t>(section.offset) + section.size > package.size()) {
+                throw std::invalid_argument(fmt::format("Section '{}' lies outside of the package", section.name));
+            }
+
+            const SBR_SECTION* old = nullptr;
+            for(const auto& s : flashed.sections) {
+                if(strncmp(s.name, section.name, sizeof(s.name)) == 0) old = &s;
+            }
+            if(old != nullptr && old->offset == section.offset && old->size == section.size && old->checksum == section.checksum
+               && old->type == section.type && old->flags == section.flags) {
+                continue;
+            }
+
+            // Firmware is compressed as a whole and a change shifts all of it, compare others per block
+            bool compare = old != nullptr && old->offset == section.offset && strncmp(section.name, "__firmware", sizeof(section.name)) != 0;
+            if(compare) {
+                std::tie(success, errorMsg) = readCustom(targetMemory, appOffset + section.offset, section.size, flashedData, nullptr);
+                compare = success;
+            }
+            if(!compare) {
+                markDirty(section.offset, section.size);
+                continue;
+            }
+            for(std::size_t start = section.offset; start < section.offset + section.size;) {
+                std::size_t end = std::min<std::size_t>((start / DELTA_BLOCK_SIZE + 1) * DELTA_BLOCK_SIZE, section.offset + section.size);
+                if(memcmp(&flashedData[start - section.offset], &package[start], end - start) != 0) markDirty(start, end - start);
+                start = end;
+            }
+        }
+    }
+
+    // Merge dirty blocks into runs, header block is handled below
+    std::vector<std::pair<std::size_t, std::size_t>> runs;
+    for(std::size_t b = 1; b < numBlocks; b++) {
+        if(!dirty[b]) continue;
+        if(!runs.empty() && runs.back().first + runs.back().second == b * DELTA_BLOCK_SIZE) {
+            runs.back().second += DELTA_BLOCK_SIZE;
+        } else {
+            runs.emplace_back(b * DELTA_BLOCK_SIZE, DELTA_BLOCK_SIZE);
+        }
+    }
+    // Flashed header stays valid while the sections it describes are rewritten, and isn't necessarily checksum checked.
+    // So it is erased before any data is written and the new one is written last - an interrupted update leaves
+    // no valid application instead of a valid looking header over a mix of old and new data
+    const bool rewritesData = !runs.empty();
+    if(rewritesData) dirty[0] = true;
+    if(dirty[0]) runs.emplace_back(0, DELTA_BLOCK_SIZE);
+
+    DeltaFlashProgress progress;
+    progress.totalBytes = package.size();
+    for(auto& run : runs) {
+        run.second = std::min(run.second, package.size() - run.first);
+        progress.writtenBytes += run.second;
+    }
+    progress.skippedBytes = progress.totalBytes - progress.writtenBytes;
+    logger::debug("Delta flashing application package, writing {} and skipping {} of {} bytes in {} run(s)",
+                  progress.writtenBytes,
+                  progress.skippedBytes,
+                  progress.totalBytes,
+                  runs.size());
+
+    const std::vector<uint8_t> erasedHeader(rewritesData ? SBR_RAW_SIZE : 0, 0xFF);
+    const std::size_t totalWrite = erasedHeader.size() + progress.writtenBytes;
+    std::size_t done = 0;
+    auto flashRun = [&](std::size_t offset, const uint8_t* data, std::size_t size) {
+        std::function<void(float)> runCb = nullptr;
+        if(progressCb != nullptr) {
+            runCb = [&](float p) {
+                progress.progress = (done + p * size) / static_cast<float>(totalWrite);
+                progressCb(progress);
+            };
+        }
+        auto result = flashCustom(targetMemory, appOffset + offset, data, size, runCb);
+        done += size;
+        return result;
+    };
+
+    if(rewritesData) {
+        std::tie(success, errorMsg) = flashRun(0, erasedHeader.data(), erasedHeader.size());
+        if(!success) return {false, errorMsg};
+    }
+    for(const auto& run : runs) {
+        std::tie(success, errorMsg) = flashRun(run.first, &package[run.first], run.second);
+        if(!success) return {false, errorMsg};
+    }
+    progress.progress = 1.0f;
+    if(progressCb != nullptr) progressCb(progress);
+
+    setApplicationMemory(memory);
+
+    return {true, ""};
 }
 
 std::tuple<bool, std::string> DeviceBootloader::flashClear(Memory memory) {
@@ -1138,13 +1385,14 @@ std::tuple<bool, std::string> DeviceBootloader::flashCustom(
         throw std::runtime_error("Current bootloader version doesn't support custom flashing");
     }
 
-    std::vector<uint8_t> optFileData;
+    std::ifstream optFile;
     if(!filename.empty()) {
-        // Read file into memory first
-        std::ifstream optFile(filename, std::ios::in | std::ios::binary);
-        optFileData = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(optFile), {});
-        data = optFileData.data();
-        size = optFileData.size();
+        // File is streamed in chunks while being sent, only its size is needed upfront
+        optFile.open(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if(!optFile.is_open()) return {false, fmt::format("Couldn't open file '{}' to flash", filename)};
+        size = static_cast<size_t>(optFile.tellg());
+        optFile.seekg(0);
+        if(size == 0) return {false, fmt::format("File '{}' to flash is empty", filename)};
     }
 
     // send request to FLASH BOOTLOADER
@@ -1156,7 +1404,21 @@ std::tuple<bool, std::string> DeviceBootloader::flashCustom(
     if(!sendRequest(updateFlashEx2)) return {false, "Couldn't send bootloader flash request"};
 
     // After that send numPackets of data
-    stream->writeSplit(data, size, bootloader::XLINK_STREAM_MAX_SIZE);
+    if(filename.empty()) {
+        stream->writeSplit(data, size, bootloader::XLINK_STREAM_MAX_SIZE);
+    } else {
+        // Read next packet from file while the current one is being sent
+        transferChunked(
+            updateFlashEx2.numPackets,
+            [&](std::size_t i, std::vector<uint8_t>& chunk) {
+                const size_t packetOffset = i * bootloader::XLINK_STREAM_MAX_SIZE;
+                chunk.resize(std::min<size_t>(bootloader::XLINK_STREAM_MAX_SIZE, size - packetOffset));
+                if(!optFile.read(reinterpret_cast<char*>(chunk.data()), chunk.size())) {
+                    throw std::runtime_error(fmt::format("Couldn't read file '{}' at offset {}", filename, packetOffset));
+                }
+            },
+            [&](std::size_t, std::vector<uint8_t>& chunk) { stream->write(chunk); });
+    }
 
     // Then wait for response by bootloader
     // Wait till FLASH_COMPLETE response
@@ -1218,6 +1480,12 @@ std::tuple<bool, std::string> DeviceBootloader::readCustom(
     //     throw std::invalid_argument("Only FLASH memory is supported for now");
     // }
 
+    std::ofstream outputFile;
+    if(!filename.empty()) {
+        outputFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!outputFile.is_open()) return {false, fmt::format("Couldn't open file '{}' for writing", filename)};
+    }
+
     // send request to Read Flash
     Request::ReadFlash readFlash;
     readFlash.memory = memory;
@@ -1238,19 +1506,26 @@ std::tuple<bool, std::string> DeviceBootloader::readCustom(
         // Read to buffer
         size_t dataOffset = 0;
         for(unsigned i = 0; i < response.numPackets; i++) {
-            auto d = stream->read();
-            memcpy(data + dataOffset, d.data(), d.size());
-            dataOffset += d.size();
+            auto packet = stream->readMove();
+            memcpy(data + dataOffset, packet.data, packet.length);
+            dataOffset += packet.length;
             if(progressCb) progressCb((1.0f / response.numPackets) * (i + 1));
         }
     } else {
-        // Write to file
-        std::ofstream outputFile(filename);
-        for(unsigned i = 0; i < response.numPackets; i++) {
-            auto d = stream->read();
-            outputFile.write(reinterpret_cast<char*>(d.data()), d.size());
-            if(progressCb) progressCb((1.0f / response.numPackets) * (i + 1));
-        }
+        // Write to file, while the next packet is being received
+        transferChunked(
+            response.numPackets,
+            [&](std::size_t, std::vector<uint8_t>& chunk) {
+                // Copy into the reused buffer, instead of allocating a new one per packet
+                auto packet = stream->readMove();
+                chunk.assign(packet.data, packet.data + packet.length);
+            },
+            [&](std::size_t i, std::vector<uint8_t>& chunk) {
+                if(!outputFile.write(reinterpret_cast<const char*>(chunk.data()), chunk.size())) {
+                    throw std::runtime_error(fmt::format("Couldn't write to file '{}'", filename));
+                }
+                if(progressCb) progressCb((1.0f / response.numPackets) * (i + 1));
+            });
     }
 
     // Return if flashing was successful
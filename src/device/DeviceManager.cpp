@@ -0,0 +1,141 @@
+#include "depthai/device/DeviceManager.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+// project
+#include "depthai/xlink/DeviceDiscovery.hpp"
+#include "utility/Logging.hpp"
+#include "utility/Resources.hpp"
+
+namespace dai {
+
+static std::chrono::milliseconds elapsedSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+}
+
+// Same selection as Device::getAllAvailableDevices - valid devices which aren't booted yet
+static std::vector<DeviceInfo> getAvailableDevices(const std::vector<DeviceInfo>& devices) {
+    std::vector<DeviceInfo> available;
+    for(const auto& device : devices) {
+        if(device.status == X_LINK_SUCCESS && device.state != X_LINK_BOOTED) available.push_back(device);
+    }
+    return available;
+}
+
+std::vector<DeviceInfo> DeviceManager::discover(std::size_t minDevices, std::chrono::milliseconds timeout) {
+    // Discovery table is kept up to date in the background and wakes up as soon as enough devices are available
+    auto devices = DeviceDiscovery::getInstance().waitFor(
+        [minDevices](const std::vector<DeviceInfo>& devices) { return getAvailableDevices(devices).size() >= minDevices; }, timeout);
+    return getAvailableDevices(devices);
+}
+
+void DeviceManager::setMaxConcurrency(unsigned int maxConcurrency) {
+    this->maxConcurrency = maxConcurrency;
+}
+
+unsigned int DeviceManager::getMaxConcurrency() const {
+    return maxConcurrency;
+}
+
+std::vector<DeviceManager::Result> DeviceManager::open(const std::vector<DeviceInfo>& devices, const Device::Config& config) const {
+    return openImpl(devices, std::vector<Device::Config>(devices.size(), config), std::vector<const Pipeline*>(devices.size(), nullptr));
+}
+
+std::vector<DeviceManager::Result> DeviceManager::open(const std::vector<DeviceInfo>& devices, const Pipeline& pipeline) const {
+    return openImpl(devices, std::vector<Device::Config>(devices.size(), pipeline.getDeviceConfig()), std::vector<const Pipeline*>(devices.size(), &pipeline));
+}
+
+std::vector<DeviceManager::Result> DeviceManager::open(const std::vector<DeviceInfo>& devices, const PipelineFactory& factory) const {
+    if(!factory) throw std::invalid_argument("DeviceManager - pipeline factory is empty");
+
+    std::vector<Pipeline> pipelines;
+    pipelines.reserve(devices.size());
+    for(const auto& deviceInfo : devices) {
+        pipelines.push_back(factory(deviceInfo));
+    }
+
+    std::vector<Device::Config> configs;
+    std::vector<const Pipeline*> pipelinePtrs;
+    for(const auto& pipeline : pipelines) {
+        configs.push_back(pipeline.getDeviceConfig());
+        pipelinePtrs.push_back(&pipeline);
+    }
+    return openImpl(devices, configs, pipelinePtrs);
+}
+
+std::vector<DeviceManager::Result> DeviceManager::openImpl(const std::vector<DeviceInfo>& devices,
+                                                           const std::vector<Device::Config>& configs,
+                                                           const std::vector<const Pipeline*>& pipelines) const {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<Result> results(devices.size());
+    for(std::size_t i = 0; i < devices.size(); i++) {
+        results[i].deviceInfo = devices[i];
+    }
+
+    // Prepare firmware images up front and hold them while booting, boots below share the image of their configuration
+    std::vector<std::shared_ptr<const std::vector<std::uint8_t>>> images(devices.size());
+    for(std::size_t i = 0; i < devices.size(); i++) {
+        auto t1 = std::chrono::steady_clock::now();
+        try {
+            images[i] = Resources::getInstance().getDeviceFirmwareImage(configs[i]);
+        } catch(const std::exception& ex) {
+            results[i].error = ex.what();
+        }
+        results[i].timings.firmware = elapsedSince(t1);
+    }
+
+    auto bringUp = [&](std::size_t i) {
+        auto& result = results[i];
+        if(result.error.empty()) {
+            std::shared_ptr<Device> device;
+            try {
+                auto t1 = std::chrono::steady_clock::now();
+                device = std::make_shared<Device>(configs[i], devices[i]);
+                result.timings.boot = elapsedSince(t1);
+                // Image is freed once the last device using it is booted
+                images[i] = nullptr;
+
+                if(pipelines[i] != nullptr) {
+                    auto t2 = std::chrono::steady_clock::now();
+                    if(!device->startPipeline(*pipelines[i])) {
+                        throw std::runtime_error("Couldn't start the pipeline");
+                    }
+                    result.timings.pipeline = elapsedSince(t2);
+                }
+                result.device = std::move(device);
+            } catch(const std::exception& ex) {
+                result.error = ex.what();
+            }
+        }
+        result.timings.total = elapsedSince(startTime);
+
+        if(result.success()) {
+            logger::debug("DeviceManager - device {} ready, firmware: {}ms, boot: {}ms, pipeline: {}ms, total: {}ms",
+                          devices[i].toString(),
+                          result.timings.firmware.count(),
+                          result.timings.boot.count(),
+                          result.timings.pipeline.count(),
+                          result.timings.total.count());
+        } else {
+            logger::warn("DeviceManager - device {} failed: {}", devices[i].toString(), result.error);
+        }
+    };
+
+    std::size_t numThreads = maxConcurrency == 0 ? devices.size() : std::min<std::size_t>(maxConcurrency, devices.size());
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            for(std::size_t i = next++; i < devices.size(); i = next++) bringUp(i);
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    return results;
+}
+
+}  // namespace dai
@@ -0,0 +1,178 @@
+#include "DeviceRuntime.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// project
+#include "utility/Environment.hpp"
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+constexpr std::chrono::milliseconds DeviceRuntime::STOP;
+constexpr std::size_t DeviceRuntime::WHEEL_SIZE;
+
+std::shared_ptr<DeviceRuntime> DeviceRuntime::getShared() {
+    static std::mutex sharedMtx;
+    static std::weak_ptr<DeviceRuntime> shared;
+
+    std::unique_lock<std::mutex> lock(sharedMtx);
+    auto runtime = shared.lock();
+    if(runtime) return runtime;
+
+    // Tasks only block for short reads and writes, so a few workers serve many devices
+    std::size_t numThreads = std::min<std::size_t>(4, std::max<std::size_t>(2, std::thread::hardware_concurrency() / 2));
+    auto numThreadsStr = utility::getEnv("DEPTHAI_SHARED_RUNTIME_THREADS");
+    if(!numThreadsStr.empty()) {
+        try {
+            numThreads = std::max(1, std::stoi(numThreadsStr));
+        } catch(const std::invalid_argument& e) {
+            logger::warn("DEPTHAI_SHARED_RUNTIME_THREADS value invalid: {}", e.what());
+        }
+    }
+    runtime = std::make_shared<DeviceRuntime>(numThreads);
+    shared = runtime;
+    return runtime;
+}
+
+DeviceRuntime::DeviceRuntime(std::size_t numThreads, std::chrono::milliseconds tick)
+    : tick(tick), start(std::chrono::steady_clock::now()), wheel(WHEEL_SIZE) {
+    if(numThreads == 0) throw std::invalid_argument("DeviceRuntime - number of threads must be greater than zero");
+    if(tick <= std::chrono::milliseconds(0)) throw std::invalid_argument("DeviceRuntime - tick must be positive");
+
+    timerThread = std::thread([this]() { timerLoop(); });
+    for(std::size_t i = 0; i < numThreads; i++) {
+        workers.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+DeviceRuntime::~DeviceRuntime() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        running = false;
+    }
+    timerCv.notify_all();
+    workerCv.notify_all();
+
+    if(timerThread.joinable()) timerThread.join();
+    for(auto& worker : workers) {
+        if(worker.joinable()) worker.join();
+    }
+}
+
+DeviceRuntime::TaskId DeviceRuntime::schedule(std::chrono::milliseconds delay, Task task) {
+    if(!task) throw std::invalid_argument("DeviceRuntime - task is empty");
+    std::unique_lock<std::mutex> lock(mtx);
+    const TaskId id = nextId++;
+    auto state = std::make_shared<TaskState>();
+    state->task = std::move(task);
+    tasks[id] = std::move(state);
+    arm(id, delay);
+    return id;
+}
+
+void DeviceRuntime::cancel(TaskId id) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = tasks.find(id);
+    if(it == tasks.end()) return;
+    auto state = it->second;
+    state->cancelled = true;
+
+    // Timers of a removed task are skipped once they expire
+    if(!state->running) {
+        tasks.erase(it);
+        return;
+    }
+    if(state->runner == std::this_thread::get_id()) return;
+    doneCv.wait(lock, [&state]() { return !state->running; });
+}
+
+std::size_t DeviceRuntime::getNumThreads() const {
+    return workers.size();
+}
+
+void DeviceRuntime::arm(TaskId id, std::chrono::milliseconds delay) {
+    // Round up, so a task never runs earlier than requested
+    const auto due = std::chrono::steady_clock::now() - start + delay;
+    const auto tickNs = std::chrono::duration_cast<std::chrono::nanoseconds>(tick);
+    const auto deadline = std::max<std::uint64_t>(currentTick + 1, static_cast<std::uint64_t>((due + tickNs - std::chrono::nanoseconds(1)) / tickNs));
+    wheel[deadline % WHEEL_SIZE].push_back({id, deadline});
+
+    // Wakes the timer thread if it sleeps past the new deadline
+    const bool earliest = deadlines.empty() || deadline < deadlines.top();
+    deadlines.push(deadline);
+    if(earliest) timerCv.notify_all();
+}
+
+void DeviceRuntime::timerLoop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(running) {
+        if(deadlines.empty()) {
+            timerCv.wait(lock, [this]() { return !running || !deadlines.empty(); });
+        } else {
+            const auto next = deadlines.top();
+            timerCv.wait_until(lock, start + tick * next, [this, next]() { return !running || deadlines.top() < next; });
+        }
+        if(!running) break;
+
+        const auto now = static_cast<std::uint64_t>((std::chrono::steady_clock::now() - start) / tick);
+        if(deadlines.empty() || deadlines.top() > now) continue;
+
+        // Ticks before the earliest deadline have nothing to expire, catch up on the rest in case the thread was delayed
+        currentTick = std::max(currentTick, deadlines.top() - 1);
+        bool expired = false;
+        while(currentTick < now) {
+            currentTick++;
+            auto& slot = wheel[currentTick % WHEEL_SIZE];
+            // Timers further than a wheel revolution away stay in the slot
+            auto it = std::partition(slot.begin(), slot.end(), [this](const Timer& timer) { return timer.deadline > currentTick; });
+            for(auto t = it; t != slot.end(); t++) {
+                if(tasks.count(t->id) == 0) continue;
+                ready.push_back(t->id);
+                expired = true;
+            }
+            slot.erase(it, slot.end());
+        }
+        while(!deadlines.empty() && deadlines.top() <= currentTick) deadlines.pop();
+        if(expired) workerCv.notify_all();
+    }
+}
+
+void DeviceRuntime::workerLoop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+        workerCv.wait(lock, [this]() { return !running || !ready.empty(); });
+        if(!running) break;
+
+        const auto id = ready.front();
+        ready.pop_front();
+        auto it = tasks.find(id);
+        if(it == tasks.end()) continue;
+        auto state = it->second;
+        if(state->cancelled) continue;
+
+        state->running = true;
+        state->runner = std::this_thread::get_id();
+        lock.unlock();
+
+        std::chrono::milliseconds delay = STOP;
+        try {
+            delay = state->task();
+        } catch(const std::exception& ex) {
+            logger::error("Device runtime task throwed an exception: {}", ex.what());
+        }
+
+        lock.lock();
+        state->running = false;
+        state->runner = {};
+        if(state->cancelled || delay < std::chrono::milliseconds(0)) {
+            tasks.erase(id);
+            doneCv.notify_all();
+        } else {
+            arm(id, delay);
+        }
+    }
+}
+
+}  // namespace dai
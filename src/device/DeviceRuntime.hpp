@@ -0,0 +1,106 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Shared runtime for periodic per device housekeeping (watchdog pings, monitor checks, log and timesync polling).
+ *
+ * A single timer thread keeps tasks in a hashed timer wheel and hands expired ones to a small worker pool, so the
+ * number of threads doesn't grow with the number of devices. The timer thread sleeps until the earliest deadline. Each task reschedules itself by returning the delay
+ * until its next run, and never runs concurrently with itself.
+ */
+class DeviceRuntime {
+   public:
+    using TaskId = std::uint64_t;
+    /// Task returns delay until its next run, or STOP to end
+    using Task = std::function<std::chrono::milliseconds()>;
+    static constexpr std::chrono::milliseconds STOP{-1};
+
+    /**
+     * Gets runtime shared by all devices, created on first use and destroyed with the last device using it.
+     * Number of workers can be set with DEPTHAI_SHARED_RUNTIME_THREADS
+     */
+    static std::shared_ptr<DeviceRuntime> getShared();
+
+    /**
+     * @param numThreads Number of worker threads
+     * @param tick Timer resolution
+     */
+    explicit DeviceRuntime(std::size_t numThreads, std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+    /**
+     * Stops and joins all threads. Must not be destroyed from one of its tasks
+     */
+    ~DeviceRuntime();
+
+    DeviceRuntime(const DeviceRuntime&) = delete;
+    DeviceRuntime& operator=(const DeviceRuntime&) = delete;
+
+    /**
+     * Schedules a task to first run after the given delay
+     *
+     * @returns Id with which the task can be cancelled
+     */
+    TaskId schedule(std::chrono::milliseconds delay, Task task);
+
+    /**
+     * Cancels a task. If it is currently running, waits for it to finish, unless called from the task itself
+     */
+    void cancel(TaskId id);
+
+    /**
+     * Gets number of worker threads
+     */
+    std::size_t getNumThreads() const;
+
+   private:
+    struct TaskState {
+        Task task;
+        bool running = false;
+        bool cancelled = false;
+        std::thread::id runner;
+    };
+    struct Timer {
+        TaskId id;
+        std::uint64_t deadline;
+    };
+    static constexpr std::size_t WHEEL_SIZE = 512;
+
+    const std::chrono::milliseconds tick;
+    const std::chrono::steady_clock::time_point start;
+
+    std::mutex mtx;
+    std::condition_variable timerCv;
+    std::condition_variable workerCv;
+    std::condition_variable doneCv;
+    bool running = true;
+    TaskId nextId = 1;
+    std::uint64_t currentTick = 0;
+    std::vector<std::vector<Timer>> wheel;
+    // Deadlines of all timers in the wheel, earliest on top
+    std::priority_queue<std::uint64_t, std::vector<std::uint64_t>, std::greater<std::uint64_t>> deadlines;
+    std::unordered_map<TaskId, std::shared_ptr<TaskState>> tasks;
+    std::deque<TaskId> ready;
+
+    std::thread timerThread;
+    std::vector<std::thread> workers;
+
+    void arm(TaskId id, std::chrono::milliseconds delay);
+    void timerLoop();
+    void workerLoop();
+};
+
+}  // namespace dai
@@ -0,0 +1,257 @@
+#include "depthai/device/FleetFlasher.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// project
+#include "depthai/xlink/DeviceDiscovery.hpp"
+#include "depthai/xlink/XLinkStream.hpp"
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+
+// Failure which may pass on another attempt with a new connection - device not found (yet, eg. while rebooting),
+// lost communication or a flash operation reported as failed by the device. Anything else, like an invalid argument
+// or an unsupported bootloader, fails the device right away
+struct RetryableError : public std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+// Time for a device to reset and come back up in its bootloader
+constexpr std::chrono::seconds REBOOT_TIMEOUT{10};
+
+std::unique_ptr<DeviceBootloader> connect(const DeviceInfo& info, bool allowFlashingBootloader) {
+    try {
+        return std::unique_ptr<DeviceBootloader>(new DeviceBootloader(info, allowFlashingBootloader));
+    } catch(const std::invalid_argument&) {
+        throw;
+    } catch(const std::runtime_error& ex) {
+        throw RetryableError(std::string("Couldn't connect to the bootloader: ") + ex.what());
+    }
+}
+
+// Waits for a device to reset and come back up in its bootloader
+void waitForReboot(const std::string& mxid) {
+    auto inBootloader = [&mxid](const std::vector<DeviceInfo>& devices) {
+        return std::any_of(devices.begin(), devices.end(), [&mxid](const DeviceInfo& d) {
+            return d.mxid == mxid && d.state == X_LINK_BOOTLOADER && d.status == X_LINK_SUCCESS;
+        });
+    };
+    auto& discovery = DeviceDiscovery::getInstance();
+    // Device first disappears, so the entry from before the reset isn't mistaken for the rebooted one
+    discovery.waitFor([&](const std::vector<DeviceInfo>& devices) { return !inBootloader(devices); }, REBOOT_TIMEOUT);
+    discovery.waitFor(inBootloader, REBOOT_TIMEOUT);
+}
+
+}  // namespace
+
+void FleetFlasher::setMaxConcurrency(unsigned int maxConcurrency) {
+    this->maxConcurrency = maxConcurrency;
+}
+
+unsigned int FleetFlasher::getMaxConcurrency() const {
+    return maxConcurrency;
+}
+
+void FleetFlasher::setRetries(unsigned int maxRetries, std::chrono::milliseconds delay) {
+    this->maxRetries = maxRetries;
+    this->retryDelay = delay;
+}
+
+unsigned int FleetFlasher::getRetries() const {
+    return maxRetries;
+}
+
+void FleetFlasher::setUpdateBootloader(bool updateBootloader) {
+    this->updateBootloader = updateBootloader;
+}
+
+bool FleetFlasher::getUpdateBootloader() const {
+    return updateBootloader;
+}
+
+void FleetFlasher::setDeltaFlashing(bool delta) {
+    this->delta = delta;
+}
+
+bool FleetFlasher::getDeltaFlashing() const {
+    return delta;
+}
+
+void FleetFlasher::setMemory(DeviceBootloader::Memory memory) {
+    this->memory = memory;
+}
+
+DeviceBootloader::Memory FleetFlasher::getMemory() const {
+    return memory;
+}
+
+void FleetFlasher::setProgressCallback(ProgressCallback callback) {
+    progressCallback = std::move(callback);
+}
+
+std::vector<FleetFlasher::Result> FleetFlasher::flash(const std::vector<DeviceInfo>& devices, const std::vector<uint8_t>& package) const {
+    if(package.empty()) throw std::invalid_argument("FleetFlasher - application package is empty");
+    return flashImpl(devices, &package, false);
+}
+
+std::vector<FleetFlasher::Result> FleetFlasher::flash(const std::vector<DeviceInfo>& devices,
+                                                      const Pipeline& pipeline,
+                                                      bool compress,
+                                                      std::string applicationName) const {
+    // Package is created once, all workers flash the same buffer
+    const auto package = DeviceBootloader::createDepthaiApplicationPackage(pipeline, compress, applicationName);
+    return flashImpl(devices, &package, false);
+}
+
+std::vector<FleetFlasher::Result> FleetFlasher::flashBootloader(const std::vector<DeviceInfo>& devices) const {
+    return flashImpl(devices, nullptr, true);
+}
+
+std::vector<FleetFlasher::Result> FleetFlasher::flashImpl(const std::vector<DeviceInfo>& devices,
+                                                          const std::vector<uint8_t>* package,
+                                                          bool forceBootloader) const {
+    const auto startTime = std::chrono::steady_clock::now();
+    const bool withBootloader = forceBootloader || updateBootloader;
+
+    std::vector<Result> results(devices.size());
+    for(std::size_t i = 0; i < devices.size(); i++) {
+        results[i].deviceInfo = devices[i];
+    }
+
+    // Progress of each device, with bootloader and application taking an equal share if both are flashed
+    std::mutex progressMtx;
+    std::vector<float> deviceProgress(devices.size(), 0.0f);
+    auto report = [&](std::size_t i, Stage stage, float progress, unsigned attempt) {
+        float fraction = progress;
+        if(stage == Stage::DONE || stage == Stage::FAILED) {
+            fraction = 1.0f;
+        } else if(stage == Stage::BOOTLOADER) {
+            fraction = package != nullptr ? progress / 2.0f : progress;
+        } else if(stage == Stage::APPLICATION) {
+            fraction = withBootloader ? 0.5f + progress / 2.0f : progress;
+        } else {
+            fraction = 0.0f;
+        }
+
+        std::unique_lock<std::mutex> l(progressMtx);
+        deviceProgress[i] = std::max(deviceProgress[i], fraction);
+        if(!progressCallback) return;
+
+        Progress update;
+        update.index = i;
+        update.deviceInfo = devices[i];
+        update.stage = stage;
+        update.progress = progress;
+        update.attempt = attempt;
+        float sum = 0.0f;
+        for(auto p : deviceProgress) sum += p;
+        update.overall = sum / deviceProgress.size();
+        try {
+            progressCallback(update);
+        } catch(const std::exception& ex) {
+            logger::error("FleetFlasher progress callback throwed an exception: {}", ex.what());
+        }
+    };
+
+    auto flashDevice = [&](std::size_t i) {
+        auto& result = results[i];
+        const auto deviceStartTime = std::chrono::steady_clock::now();
+
+        for(unsigned attempt = 1; attempt <= maxRetries + 1; attempt++) {
+            result.attempts = attempt;
+            result.error.clear();
+            try {
+                report(i, Stage::CONNECTING, 0.0f, attempt);
+                // Device may have rebooted after an error, so reconnect by its MX ID if known
+                DeviceInfo info = devices[i];
+                if(attempt > 1 && !info.mxid.empty()) info = DeviceInfo(info.mxid);
+                auto bl = connect(info, withBootloader);
+
+                bool success = true;
+                std::string error;
+                auto flashedVersion = bl->getFlashedVersion();
+                const auto embeddedVersion = DeviceBootloader::getEmbeddedBootloaderVersion();
+                if(withBootloader && (forceBootloader || !flashedVersion || *flashedVersion < embeddedVersion)) {
+                    std::tie(success, error) = bl->flashBootloader(DeviceBootloader::Memory::FLASH, bl->getType(), [&](float p) {
+                        report(i, Stage::BOOTLOADER, p, attempt);
+                    });
+                    if(!success) throw RetryableError("Couldn't flash bootloader: " + error);
+                    result.bootloaderUpdated = true;
+
+                    // Device keeps running the previous bootloader, whose version is cached by the connection. Reset it into the
+                    // updated one and query the version again, so the application is flashed knowing the actual bootloader
+                    if(package != nullptr && !info.mxid.empty()) {
+                        bl->close();
+                        bl = nullptr;
+                        waitForReboot(info.mxid);
+                        bl = connect(DeviceInfo(info.mxid), false);
+                        flashedVersion = bl->getFlashedVersion();
+                        if(!flashedVersion || *flashedVersion < embeddedVersion) {
+                            throw RetryableError(fmt::format("Bootloader update didn't take effect, running version {}",
+                                                             flashedVersion ? flashedVersion->toString() : "unknown"));
+                        }
+                    }
+                }
+
+                if(package != nullptr) {
+                    if(delta) {
+                        std::tie(success, error) = bl->flashDepthaiApplicationPackageDelta(
+                            [&](DeviceBootloader::DeltaFlashProgress p) { report(i, Stage::APPLICATION, p.progress, attempt); }, *package, memory);
+                    } else {
+                        std::tie(success, error) =
+                            bl->flashDepthaiApplicationPackage([&](float p) { report(i, Stage::APPLICATION, p, attempt); }, *package, memory);
+                    }
+                    if(!success) throw RetryableError("Couldn't flash application: " + error);
+                }
+                break;
+            } catch(const std::exception& ex) {
+                // Only transient failures are retried with a new connection
+                result.error = ex.what();
+                const bool retryable = dynamic_cast<const RetryableError*>(&ex) != nullptr || dynamic_cast<const XLinkError*>(&ex) != nullptr;
+                if(!retryable) break;
+                if(attempt <= maxRetries) {
+                    logger::warn("FleetFlasher - device {} attempt {} failed: {}, retrying", devices[i].toString(), attempt, ex.what());
+                    std::this_thread::sleep_for(retryDelay);
+                }
+            }
+        }
+
+        result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - deviceStartTime);
+        if(result.success()) {
+            logger::debug("FleetFlasher - device {} flashed in {}ms, attempts: {}", devices[i].toString(), result.duration.count(), result.attempts);
+            report(i, Stage::DONE, 1.0f, result.attempts);
+        } else {
+            logger::warn("FleetFlasher - device {} failed: {}", devices[i].toString(), result.error);
+            report(i, Stage::FAILED, 1.0f, result.attempts);
+        }
+    };
+
+    std::size_t numThreads = maxConcurrency == 0 ? devices.size() : std::min<std::size_t>(maxConcurrency, devices.size());
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> threads;
+    for(std::size_t t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            for(std::size_t i = next++; i < devices.size(); i = next++) flashDevice(i);
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    std::size_t numSuccess = std::count_if(results.begin(), results.end(), [](const Result& r) { return r.success(); });
+    logger::info("FleetFlasher - flashed {}/{} devices in {}ms",
+                 numSuccess,
+                 devices.size(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    return results;
+}
+
+}  // namespace dai
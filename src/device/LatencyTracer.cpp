@@ -0,0 +1,185 @@
+#include "depthai/device/LatencyTracer.hpp"
+
+// std
+#include <fstream>
+#include <stdexcept>
+
+// libraries
+#include "nlohmann/json.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+constexpr std::size_t LatencyTracer::NUM_STAGES;
+
+bool LatencyTracer::Trace::has(Stage stage) const {
+    return timestamps[static_cast<std::size_t>(stage)] != TimePoint{};
+}
+
+LatencyTracer::TimePoint LatencyTracer::Trace::get(Stage stage) const {
+    return timestamps[static_cast<std::size_t>(stage)];
+}
+
+void LatencyTracer::Trace::set(Stage stage, TimePoint time) {
+    timestamps[static_cast<std::size_t>(stage)] = time;
+}
+
+std::chrono::nanoseconds LatencyTracer::Trace::latency(Stage from, Stage to) const {
+    if(!has(from) || !has(to)) return std::chrono::nanoseconds(0);
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(get(to) - get(from));
+}
+
+LatencyTracer::LatencyTracer(std::size_t capacity) : slots(capacity) {
+    if(capacity == 0) throw std::invalid_argument("LatencyTracer - capacity must be greater than zero");
+}
+
+LatencyTracer::Id LatencyTracer::record(Trace trace, const void* message) {
+    std::unique_lock<std::mutex> lock(mtx);
+    const Id id = nextId++;
+    auto& slot = slots[id % slots.size()];
+
+    // Forget message of the overwritten trace, unless its address was already reused by a newer one
+    if(slot.message != nullptr) {
+        auto it = messages.find(slot.message);
+        if(it != messages.end() && it->second == slot.trace.id) messages.erase(it);
+    }
+
+    trace.id = id;
+    slot.trace = std::move(trace);
+    slot.message = message;
+    slot.popped = false;
+    if(message != nullptr) messages[message] = id;
+    return id;
+}
+
+LatencyTracer::Slot* LatencyTracer::find(Id id) {
+    auto& slot = slots[id % slots.size()];
+    return slot.trace.id == id ? &slot : nullptr;
+}
+
+void LatencyTracer::mark(Id id, Stage stage, TimePoint time) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto* slot = find(id);
+    if(slot != nullptr) slot->trace.set(stage, time);
+}
+
+bool LatencyTracer::mark(const void* message, Stage stage, TimePoint time) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto it = messages.find(message);
+    if(it == messages.end()) return false;
+    auto* slot = find(it->second);
+    if(slot == nullptr) return false;
+
+    // Same message may be retrieved more than once (eg. front then get), first one counts
+    if(stage == Stage::USER_POP) {
+        if(slot->popped) return true;
+        slot->popped = true;
+    }
+    slot->trace.set(stage, time);
+    return true;
+}
+
+std::vector<LatencyTracer::Trace> LatencyTracer::getTraces() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::vector<Trace> traces;
+    const Id oldest = nextId > slots.size() ? nextId - slots.size() : 1;
+    traces.reserve(nextId - oldest);
+    for(Id id = oldest; id < nextId; id++) {
+        // Skip slots emptied by clear()
+        const auto& trace = slots[id % slots.size()].trace;
+        if(trace.id == id) traces.push_back(trace);
+    }
+    return traces;
+}
+
+void LatencyTracer::clear() {
+    std::unique_lock<std::mutex> lock(mtx);
+    for(auto& slot : slots) slot = Slot{};
+    messages.clear();
+}
+
+std::size_t LatencyTracer::getCapacity() const {
+    return slots.size();
+}
+
+const char* LatencyTracer::getStageName(Stage stage) {
+    switch(stage) {
+        case Stage::DEVICE_CAPTURE:
+            return "device_capture";
+        case Stage::DEVICE_SEND:
+            return "device_send";
+        case Stage::HOST_RECEIVE:
+            return "host_receive";
+        case Stage::PARSE_START:
+            return "parse_start";
+        case Stage::PARSE_END:
+            return "parse_end";
+        case Stage::QUEUE_PUSH:
+            return "queue_push";
+        case Stage::USER_POP:
+            return "user_pop";
+        case Stage::CALLBACK_END:
+            return "callback_end";
+    }
+    return "unknown";
+}
+
+std::string LatencyTracer::toChromeTrace() const {
+    const auto traces = getTraces();
+
+    // Slices between consecutive recorded stages, named after the work done up to the given stage
+    static constexpr const char* segmentNames[NUM_STAGES] = {"", "device", "xlink", "dispatch", "parse", "push", "queue", "callbacks"};
+    auto toUs = [](TimePoint time) { return std::chrono::duration<double, std::micro>(time.time_since_epoch()).count(); };
+
+    nlohmann::json events = nlohmann::json::array();
+    auto addEvent = [&](const char* phase, const std::string& name, const Trace& trace, TimePoint time) -> nlohmann::json& {
+        events.push_back({{"name", name}, {"cat", trace.stream}, {"ph", phase}, {"id", trace.id}, {"pid", 1}, {"tid", 1}, {"ts", toUs(time)}});
+        return events.back();
+    };
+    auto addSlice = [&](Stage from, Stage to, const Trace& trace) {
+        const auto* name = segmentNames[static_cast<std::size_t>(to)];
+        addEvent("b", name, trace, trace.get(from));
+        addEvent("e", name, trace, trace.get(to));
+    };
+
+    for(const auto& trace : traces) {
+        // Recorded stages in order. Callbacks run alongside the queue, so they get their own slice from push
+        std::vector<Stage> stages;
+        for(std::size_t i = 0; i < NUM_STAGES; i++) {
+            const auto stage = static_cast<Stage>(i);
+            if(stage != Stage::CALLBACK_END && trace.has(stage)) stages.push_back(stage);
+        }
+        if(stages.empty()) continue;
+
+        const auto begin = trace.get(stages.front());
+        auto end = trace.get(stages.back());
+        if(trace.has(Stage::CALLBACK_END) && trace.get(Stage::CALLBACK_END) > end) end = trace.get(Stage::CALLBACK_END);
+
+        const auto name = fmt::format("{} #{}", trace.stream, trace.sequenceNum);
+        auto& args = addEvent("b", name, trace, begin)["args"];
+        args["sequenceNum"] = trace.sequenceNum;
+        args["latency_ms"] = std::chrono::duration<double, std::milli>(end - begin).count();
+        for(std::size_t i = 0; i < NUM_STAGES; i++) {
+            const auto stage = static_cast<Stage>(i);
+            if(trace.has(stage)) args[getStageName(stage)] = toUs(trace.get(stage));
+        }
+
+        for(std::size_t i = 1; i < stages.size(); i++) addSlice(stages[i - 1], stages[i], trace);
+        if(trace.has(Stage::QUEUE_PUSH) && trace.has(Stage::CALLBACK_END)) addSlice(Stage::QUEUE_PUSH, Stage::CALLBACK_END, trace);
+        addEvent("e", name, trace, end);
+    }
+
+    nlohmann::json json;
+    json["displayTimeUnit"] = "ms";
+    json["traceEvents"] = std::move(events);
+    return json.dump();
+}
+
+void LatencyTracer::exportChromeTrace(const dai::Path& path) const {
+    std::ofstream stream(path, std::ios::out | std::ios::trunc);
+    if(!stream.is_open()) throw std::runtime_error(fmt::format("Couldn't open '{}' for writing", path));
+    stream << toChromeTrace();
+    if(!stream) throw std::runtime_error(fmt::format("Couldn't write latency trace to '{}'", path));
+}
+
+}  // namespace dai
@@ -0,0 +1,100 @@
+#include "RpcTransport.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+namespace dai {
+
+RpcTransport::RpcTransport(std::function<void(Buffer)> write, std::function<Buffer()> read) : write(std::move(write)), read(std::move(read)) {}
+
+RpcTransport::Id RpcTransport::send(Buffer request) {
+    std::unique_lock<std::mutex> writeLock(writeMtx);
+    Id id;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(!error.empty()) throw std::runtime_error(error);
+        id = nextId++;
+        pending.push_back(id);
+        maxInFlight = std::max(maxInFlight, pending.size());
+    }
+
+    try {
+        write(std::move(request));
+    } catch(const std::exception& ex) {
+        // Unknown whether the request went out, responses can't be matched anymore
+        fail(ex.what());
+        throw;
+    }
+    return id;
+}
+
+RpcTransport::Buffer RpcTransport::receive(Id id) {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(true) {
+        auto it = responses.find(id);
+        if(it != responses.end()) {
+            Buffer response = std::move(it->second);
+            responses.erase(it);
+            return response;
+        }
+        if(!error.empty()) throw std::runtime_error(error);
+
+        if(reading) {
+            cv.wait(lock);
+            continue;
+        }
+
+        // Read the next response on behalf of whoever it belongs to
+        reading = true;
+        lock.unlock();
+        Buffer response;
+        try {
+            response = read();
+        } catch(const std::exception& ex) {
+            fail(ex.what());
+            throw;
+        }
+        lock.lock();
+        reading = false;
+        if(pending.empty()) {
+            lock.unlock();
+            fail("Received RPC response without a request");
+            throw std::runtime_error("Received RPC response without a request");
+        }
+        responses[pending.front()] = std::move(response);
+        pending.pop_front();
+        cv.notify_all();
+    }
+}
+
+RpcTransport::Buffer RpcTransport::call(Buffer request) {
+    return receive(send(std::move(request)));
+}
+
+std::vector<RpcTransport::Buffer> RpcTransport::call(std::vector<Buffer> requests) {
+    std::vector<Id> ids;
+    ids.reserve(requests.size());
+    for(auto& request : requests) ids.push_back(send(std::move(request)));
+
+    std::vector<Buffer> responses;
+    responses.reserve(ids.size());
+    for(auto id : ids) responses.push_back(receive(id));
+    return responses;
+}
+
+std::size_t RpcTransport::getMaxInFlight() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return maxInFlight;
+}
+
+void RpcTransport::fail(const std::string& message) {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(error.empty()) error = message.empty() ? "RPC transport failed" : message;
+        reading = false;
+    }
+    cv.notify_all();
+}
+
+}  // namespace dai
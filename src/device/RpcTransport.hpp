@@ -0,0 +1,76 @@
+#pragma once
+
+// std
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Pipelined request/response transport for RPC over a single stream.
+ *
+ * Device serves requests in order, so each request gets a host side sequence id and responses are matched to
+ * requests in the order they were sent. Requests are written without waiting for previous responses, which
+ * lets concurrent callers and batches have several calls in flight. Whichever waiting caller is first reads
+ * the next response and hands it to its owner, so no extra reader thread is needed.
+ */
+class RpcTransport {
+   public:
+    using Buffer = std::vector<std::uint8_t>;
+    using Id = std::uint64_t;
+
+    RpcTransport(std::function<void(Buffer)> write, std::function<Buffer()> read);
+
+    /**
+     * Sends a request without waiting for its response
+     *
+     * @returns Id with which to receive the response
+     */
+    Id send(Buffer request);
+
+    /**
+     * Waits for response of a previously sent request. Each id must be received exactly once
+     */
+    Buffer receive(Id id);
+
+    /**
+     * Sends a request and waits for its response
+     */
+    Buffer call(Buffer request);
+
+    /**
+     * Sends all requests at once and waits for all responses
+     */
+    std::vector<Buffer> call(std::vector<Buffer> requests);
+
+    /**
+     * Maximum number of requests which were in flight at the same time
+     */
+    std::size_t getMaxInFlight() const;
+
+   private:
+    std::function<void(Buffer)> write;
+    std::function<Buffer()> read;
+
+    // Serializes writes, so requests are sent in order of their ids
+    std::mutex writeMtx;
+    Id nextId = 0;
+
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Id> pending;
+    std::unordered_map<Id, Buffer> responses;
+    bool reading = false;
+    std::string error;
+    std::size_t maxInFlight = 0;
+
+    void fail(const std::string& message);
+};
+
+}  // namespace dai
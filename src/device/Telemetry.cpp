@@ -0,0 +1,167 @@
+#include "depthai/device/Telemetry.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+static_assert(std::is_trivially_copyable<TelemetrySample>::value, "TelemetrySample is copied word by word");
+
+constexpr std::size_t TelemetryBuffer::NUM_WORDS;
+
+TelemetryBuffer::TelemetryBuffer(std::size_t capacity) : capacity(capacity) {
+    if(capacity == 0) throw std::invalid_argument("TelemetryBuffer - capacity must be greater than zero");
+    slots.reset(new Slot[capacity]);
+}
+
+void TelemetryBuffer::push(const TelemetrySample& sample) {
+    const auto index = numPushed.load(std::memory_order_relaxed);
+    auto& slot = slots[index % capacity];
+
+    std::uint64_t words[NUM_WORDS] = {};
+    std::memcpy(words, &sample, sizeof(sample));
+
+    // Odd sequence marks the slot as being written, even one holds sample number (sequence / 2 - 1)
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for(std::size_t i = 0; i < NUM_WORDS; i++) slot.words[i].store(words[i], std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    numPushed.store(index + 1, std::memory_order_release);
+}
+
+bool TelemetryBuffer::read(std::uint64_t index, TelemetrySample& sample) const {
+    const auto& slot = slots[index % capacity];
+    const auto expected = 2 * index + 2;
+    std::uint64_t words[NUM_WORDS];
+    while(true) {
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        // Overwritten by a newer sample, or not written yet
+        if(before > expected || before + 1 < expected) return false;
+        // Being written, retry
+        if(before != expected) continue;
+
+        for(std::size_t i = 0; i < NUM_WORDS; i++) words[i] = slot.words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) == before) {
+            std::memcpy(&sample, words, sizeof(sample));
+            return true;
+        }
+    }
+}
+
+bool TelemetryBuffer::latest(TelemetrySample& sample) const {
+    auto pushed = numPushed.load(std::memory_order_acquire);
+    // Writer may lap the reader, in which case move on to the newer latest
+    while(pushed > 0) {
+        if(read(pushed - 1, sample)) return true;
+        pushed = numPushed.load(std::memory_order_acquire);
+    }
+    return false;
+}
+
+std::vector<TelemetrySample> TelemetryBuffer::window(std::chrono::nanoseconds duration) const {
+    const auto since = std::chrono::steady_clock::now() - duration;
+    const auto pushed = numPushed.load(std::memory_order_acquire);
+    const auto oldest = pushed > capacity ? pushed - capacity : 0;
+
+    // Walk from the newest towards older samples until out of the window
+    std::vector<TelemetrySample> samples;
+    TelemetrySample sample;
+    for(auto index = pushed; index > oldest; index--) {
+        if(!read(index - 1, sample)) break;
+        if(sample.timestamp < since) break;
+        samples.push_back(sample);
+    }
+    std::reverse(samples.begin(), samples.end());
+    return samples;
+}
+
+TelemetryStats TelemetryBuffer::stats(TelemetryMetric metric, std::chrono::nanoseconds duration) const {
+    TelemetryStats stats;
+    stats.min = std::numeric_limits<float>::max();
+    stats.max = std::numeric_limits<float>::lowest();
+    double sum = 0.0;
+    for(const auto& sample : window(duration)) {
+        const float value = getValue(sample, metric);
+        stats.min = std::min(stats.min, value);
+        stats.max = std::max(stats.max, value);
+        sum += value;
+        stats.count++;
+    }
+    if(stats.count == 0) return {};
+    stats.average = static_cast<float>(sum / stats.count);
+    return stats;
+}
+
+float TelemetryBuffer::getValue(const TelemetrySample& sample, TelemetryMetric metric) {
+    switch(metric) {
+        case TelemetryMetric::DDR_MEMORY_USED:
+            return static_cast<float>(sample.ddrMemoryUsage.used);
+        case TelemetryMetric::CMX_MEMORY_USED:
+            return static_cast<float>(sample.cmxMemoryUsage.used);
+        case TelemetryMetric::LEON_CSS_HEAP_USED:
+            return static_cast<float>(sample.leonCssMemoryUsage.used);
+        case TelemetryMetric::LEON_MSS_HEAP_USED:
+            return static_cast<float>(sample.leonMssMemoryUsage.used);
+        case TelemetryMetric::LEON_CSS_CPU_USAGE:
+            return sample.leonCssCpuUsage.average;
+        case TelemetryMetric::LEON_MSS_CPU_USAGE:
+            return sample.leonMssCpuUsage.average;
+        case TelemetryMetric::CHIP_TEMPERATURE:
+            return sample.chipTemperature.average;
+        case TelemetryMetric::XLINK_WRITE_RATE:
+            return sample.xlinkWriteRate;
+        case TelemetryMetric::XLINK_READ_RATE:
+            return sample.xlinkReadRate;
+    }
+    return 0.0f;
+}
+
+std::string TelemetryBuffer::toText(const std::string& device) const {
+    TelemetrySample sample;
+    if(!latest(sample)) return "";
+
+    std::string text;
+    auto add = [&](const char* name, const char* type, const char* help, const std::string& labels, double value) {
+        text += fmt::format("# HELP {} {}\n# TYPE {} {}\n{}{{device=\"{}\"{}}} {}\n", name, help, name, type, name, device, labels, value);
+    };
+    auto addMemory = [&](const char* memory, const MemoryInfo& info) {
+        const auto labels = fmt::format(",memory=\"{}\"", memory);
+        text += fmt::format("depthai_memory_used_bytes{{device=\"{}\"{}}} {}\n", device, labels, info.used);
+        text += fmt::format("depthai_memory_total_bytes{{device=\"{}\"{}}} {}\n", device, labels, info.total);
+    };
+
+    text += "# HELP depthai_memory_used_bytes Used device memory\n# TYPE depthai_memory_used_bytes gauge\n";
+    text += "# HELP depthai_memory_total_bytes Total device memory\n# TYPE depthai_memory_total_bytes gauge\n";
+    addMemory("ddr", sample.ddrMemoryUsage);
+    addMemory("cmx", sample.cmxMemoryUsage);
+    addMemory("leon_css_heap", sample.leonCssMemoryUsage);
+    addMemory("leon_mss_heap", sample.leonMssMemoryUsage);
+
+    text += "# HELP depthai_cpu_usage Average CPU usage, 0..1\n# TYPE depthai_cpu_usage gauge\n";
+    text += fmt::format("depthai_cpu_usage{{device=\"{}\",cpu=\"leon_css\"}} {}\n", device, sample.leonCssCpuUsage.average);
+    text += fmt::format("depthai_cpu_usage{{device=\"{}\",cpu=\"leon_mss\"}} {}\n", device, sample.leonMssCpuUsage.average);
+
+    add("depthai_chip_temperature_celsius", "gauge", "Average chip temperature", "", sample.chipTemperature.average);
+    add("depthai_xlink_written_bytes_total", "counter", "Bytes written over XLink", "", static_cast<double>(sample.profilingData.numBytesWritten));
+    add("depthai_xlink_read_bytes_total", "counter", "Bytes read over XLink", "", static_cast<double>(sample.profilingData.numBytesRead));
+    return text;
+}
+
+std::size_t TelemetryBuffer::getCapacity() const {
+    return capacity;
+}
+
+std::uint64_t TelemetryBuffer::getNumPushed() const {
+    return numPushed.load(std::memory_order_acquire);
+}
+
+}  // namespace dai
@@ -0,0 +1,113 @@
+#include "depthai/host/HostGraph.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+// project
+#include "utility/WorkStealingPool.hpp"
+
+// libraries
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+HostGraph::HostGraph(std::size_t numThreads) : numThreads(numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : numThreads) {}
+
+HostGraph::~HostGraph() {
+    stop();
+
+    // Inputs are closed, so callbacks don't block anymore
+    for(auto& link : queueLinks) link.queue->removeCallback(link.callbackId);
+
+    // Nodes may outlive the graph
+    for(auto& node : nodes) {
+        std::unique_lock<std::mutex> lock(node->mtx);
+        node->graph = nullptr;
+    }
+}
+
+void HostGraph::add(std::shared_ptr<HostNode> node) {
+    if(!node) throw std::invalid_argument("HostGraph - node is null");
+    std::unique_lock<std::mutex> lock(mtx);
+    if(running) throw std::runtime_error("Can't add nodes to a running HostGraph");
+    if(node->graph != nullptr) throw std::invalid_argument(fmt::format("HostNode '{}' is already part of a graph", node->getName()));
+    node->graph = this;
+    nodes.push_back(std::move(node));
+}
+
+void HostGraph::link(std::shared_ptr<DataOutputQueue> queue, HostNode::InputBase& input, std::function<bool(const std::shared_ptr<ADatatype>&)> accepts) {
+    if(!queue) throw std::invalid_argument("HostGraph - queue is null");
+    if(input.parent.graph != this) throw std::invalid_argument(fmt::format("HostNode '{}' isn't part of this graph", input.parent.getName()));
+
+    // Messages are consumed through the graph only
+    queue->setMaxSize(0);
+    auto* target = &input;
+    auto id = queue->addCallback([target, accepts](std::shared_ptr<ADatatype> msg) {
+        if(!accepts(msg)) {
+            target->drop();
+            return;
+        }
+        target->push(std::move(msg));
+    });
+
+    std::unique_lock<std::mutex> lock(mtx);
+    queueLinks.push_back({std::move(queue), id});
+}
+
+void HostGraph::start() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(running) return;
+
+    for(const auto& node : nodes) {
+        for(const auto* output : node->outputs) {
+            for(const auto* target : output->targets) {
+                if(target->parent.graph != this) {
+                    throw std::invalid_argument(
+                        fmt::format("HostNode '{}' is linked to '{}', which isn't part of the same graph", node->getName(), target->parent.getName()));
+                }
+            }
+        }
+    }
+
+    pool = std::make_unique<WorkStealingPool>(numThreads);
+    for(const auto& node : nodes) {
+        for(auto* input : node->inputs) input->open();
+    }
+    running = true;
+
+    // Process messages received while stopped
+    for(const auto& node : nodes) node->schedule();
+}
+
+void HostGraph::stop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(!running) return;
+    running = false;
+
+    for(const auto& node : nodes) {
+        for(auto* input : node->inputs) input->close();
+    }
+    for(const auto& node : nodes) node->waitIdle();
+    pool.reset();
+}
+
+bool HostGraph::isRunning() const {
+    return running;
+}
+
+std::size_t HostGraph::getNumThreads() const {
+    return numThreads;
+}
+
+std::vector<HostNode::Stats> HostGraph::getStats() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    std::vector<HostNode::Stats> stats;
+    stats.reserve(nodes.size());
+    for(const auto& node : nodes) stats.push_back(node->getStats());
+    return stats;
+}
+
+}  // namespace dai
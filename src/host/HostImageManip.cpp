@@ -0,0 +1,394 @@
+#include "depthai/host/HostImageManip.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <stdexcept>
+
+// project
+#include "ImageKernels.hpp"
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+constexpr std::size_t HostImageManip::DEFAULT_MAX_POOL_SIZE;
+
+namespace {
+
+using Type = RawImgFrame::Type;
+using image::Matrix3;
+
+constexpr double PI = 3.14159265358979323846;
+
+Matrix3 translation(double x, double y) {
+    return {1.0, 0.0, x, 0.0, 1.0, y, 0.0, 0.0, 1.0};
+}
+
+Matrix3 scaling(double x, double y) {
+    return {x, 0.0, 0.0, 0.0, y, 0.0, 0.0, 0.0, 1.0};
+}
+
+Matrix3 rotation(double deg) {
+    const double rad = deg * PI / 180.0;
+    const double c = std::cos(rad);
+    const double s = std::sin(rad);
+    return {c, -s, 0.0, s, c, 0.0, 0.0, 0.0, 1.0};
+}
+
+Matrix3 multiply(std::initializer_list<Matrix3> matrices) {
+    Matrix3 result = translation(0.0, 0.0);
+    for(const auto& m : matrices) result = image::multiply(result, m);
+    return result;
+}
+
+// Output of the config's geometry. Pixels of the region (in output coordinates) map to the source through transform,
+// in continuous coordinates where pixel centers are at +0.5. Output outside the region is background
+struct Geometry {
+    int width = 0;
+    int height = 0;
+    int regionX = 0;
+    int regionY = 0;
+    int regionWidth = 0;
+    int regionHeight = 0;
+    Matrix3 transform = translation(0.0, 0.0);
+    image::Border border = image::Border::CONSTANT;
+};
+
+int toSize(double value) {
+    return std::max(1, static_cast<int>(std::lround(value)));
+}
+
+Geometry getGeometry(const RawImageManipConfig& cfg, int srcWidth, int srcHeight, bool subsampled) {
+    const auto& crop = cfg.cropConfig;
+    const auto& resize = cfg.resizeConfig;
+    const bool enableResize = cfg.enableResize;
+    const int resizeWidth = enableResize ? resize.width : 0;
+    const int resizeHeight = enableResize ? resize.height : 0;
+
+    Geometry geo;
+    geo.border = enableResize && resize.warpBorderReplicate ? image::Border::REPLICATE : image::Border::CONSTANT;
+
+    if(enableResize && resize.enableWarp4pt) {
+        // Warp replaces crop, output rectangle corners map to the points (clockwise from top left)
+        if(resize.warpFourPoints.size() != 4) throw std::invalid_argument("ImageManipConfig - 4 point warp requires exactly 4 points");
+        std::array<double, 8> points{};
+        for(std::size_t i = 0; i < 4; i++) {
+            points[2 * i] = resize.warpFourPoints[i].x * (resize.normalizedCoords ? srcWidth : 1.0);
+            points[2 * i + 1] = resize.warpFourPoints[i].y * (resize.normalizedCoords ? srcHeight : 1.0);
+        }
+        auto distance = [&points](int a, int b) { return std::hypot(points[2 * a] - points[2 * b], points[2 * a + 1] - points[2 * b + 1]); };
+        geo.width = resizeWidth > 0 ? resizeWidth : toSize(std::max(distance(0, 1), distance(3, 2)));
+        geo.height = resizeHeight > 0 ? resizeHeight : toSize(std::max(distance(0, 3), distance(1, 2)));
+        if(!image::getPerspectiveTransform(geo.width, geo.height, points, geo.transform)) {
+            throw std::invalid_argument("ImageManipConfig - 4 point warp points are degenerate");
+        }
+    } else if(enableResize && resize.enableWarpMatrix) {
+        // Matrix maps source pixels to output pixels
+        if(resize.warpMatrix3x3.size() != 9) throw std::invalid_argument("ImageManipConfig - warp matrix must have 9 elements");
+        Matrix3 forward{};
+        std::copy(resize.warpMatrix3x3.begin(), resize.warpMatrix3x3.end(), forward.begin());
+        Matrix3 inverse{};
+        if(!image::invert(forward, inverse)) throw std::invalid_argument("ImageManipConfig - warp matrix isn't invertible");
+        geo.width = resizeWidth > 0 ? resizeWidth : srcWidth;
+        geo.height = resizeHeight > 0 ? resizeHeight : srcHeight;
+        geo.transform = multiply({translation(0.5, 0.5), inverse, translation(-0.5, -0.5)});
+    } else {
+        // Crop as center, size and angle in source pixels
+        double cx = srcWidth / 2.0;
+        double cy = srcHeight / 2.0;
+        double cw = srcWidth;
+        double ch = srcHeight;
+        double angle = 0.0;
+        if(cfg.enableCrop) {
+            const double sx = crop.normalizedCoords ? srcWidth : 1.0;
+            const double sy = crop.normalizedCoords ? srcHeight : 1.0;
+            if(crop.enableRotatedRect) {
+                const auto& rr = crop.cropRotatedRect;
+                cx = rr.center.x * sx;
+                cy = rr.center.y * sy;
+                cw = rr.size.width * sx;
+                ch = rr.size.height * sy;
+                angle = rr.angle;
+            } else if(crop.enableCenterCropRectangle) {
+                // Largest rectangle of the aspect ratio, scaled by ratio
+                const double aspect = crop.widthHeightAspectRatio > 0.0f ? crop.widthHeightAspectRatio : 1.0;
+                cw = std::min<double>(srcWidth, srcHeight * aspect) * crop.cropRatio;
+                ch = cw / aspect;
+            } else {
+                const auto& rect = crop.cropRect;
+                cx = (rect.xmin + rect.xmax) / 2.0 * sx;
+                cy = (rect.ymin + rect.ymax) / 2.0 * sy;
+                cw = (rect.xmax - rect.xmin) * sx;
+                ch = (rect.ymax - rect.ymin) * sy;
+            }
+            if(cw <= 0.0 || ch <= 0.0) throw std::invalid_argument("ImageManipConfig - crop region is empty");
+        }
+
+        // Clockwise rotation of the cropped content, output holds its bounding box
+        const double rotationDeg = enableResize && resize.enableRotation ? resize.rotationAngleDeg : 0.0;
+        const double rad = rotationDeg * PI / 180.0;
+        const double extentWidth = std::abs(cw * std::cos(rad)) + std::abs(ch * std::sin(rad));
+        const double extentHeight = std::abs(cw * std::sin(rad)) + std::abs(ch * std::cos(rad));
+
+        geo.width = resizeWidth > 0 ? resizeWidth : toSize(extentWidth);
+        geo.height = resizeHeight > 0 ? resizeHeight : toSize(extentHeight);
+        geo.regionWidth = geo.width;
+        geo.regionHeight = geo.height;
+
+        double kx = extentWidth / geo.width;
+        double ky = extentHeight / geo.height;
+        if(enableResize && resize.lockAspectRatioFill) {
+            // Thumbnail, whole content letterboxed
+            const double k = std::max(kx, ky);
+            geo.regionWidth = std::min(geo.width, toSize(extentWidth / k));
+            geo.regionHeight = std::min(geo.height, toSize(extentHeight / k));
+            geo.regionX = (geo.width - geo.regionWidth) / 2;
+            geo.regionY = (geo.height - geo.regionHeight) / 2;
+            if(subsampled) {
+                // Region must cover whole chroma samples
+                geo.regionX &= ~1;
+                geo.regionY &= ~1;
+                geo.regionWidth = std::max(2, geo.regionWidth & ~1);
+                geo.regionHeight = std::max(2, geo.regionHeight & ~1);
+            }
+            kx = extentWidth / geo.regionWidth;
+            ky = extentHeight / geo.regionHeight;
+        } else if(resizeWidth > 0 && resizeHeight > 0 && resize.keepAspectRatio) {
+            // Center of the content is cropped to the output aspect ratio
+            kx = ky = std::min(kx, ky);
+        }
+
+        geo.transform = multiply({translation(cx, cy),
+                                  rotation(angle),
+                                  rotation(-rotationDeg),
+                                  scaling(kx, ky),
+                                  translation(-geo.regionWidth / 2.0, -geo.regionHeight / 2.0)});
+    }
+
+    if(geo.regionWidth == 0) {
+        geo.regionWidth = geo.width;
+        geo.regionHeight = geo.height;
+    }
+
+    if(cfg.enableFormat) {
+        if(cfg.formatConfig.flipHorizontal) {
+            geo.transform = multiply({geo.transform, translation(geo.regionWidth, 0.0), scaling(-1.0, 1.0)});
+        }
+        if(cfg.formatConfig.flipVertical) {
+            geo.transform = multiply({geo.transform, translation(0.0, geo.regionHeight), scaling(1.0, -1.0)});
+        }
+    }
+    return geo;
+}
+
+bool isIdentity(const Geometry& geo, int srcWidth, int srcHeight) {
+    if(geo.width != srcWidth || geo.height != srcHeight || geo.regionWidth != srcWidth || geo.regionHeight != srcHeight) return false;
+    const auto identity = translation(0.0, 0.0);
+    for(std::size_t i = 0; i < identity.size(); i++) {
+        if(std::abs(geo.transform[i] - identity[i]) > 1e-9) return false;
+    }
+    return true;
+}
+
+image::Plane getRegion(const image::Plane& plane, int x, int y, int width, int height) {
+    image::Plane region = plane;
+    region.data += static_cast<std::ptrdiff_t>(y) * plane.stride + x * plane.channels;
+    region.width = width;
+    region.height = height;
+    return region;
+}
+
+void transform(const image::Image& src, const image::Image& dst, const Geometry& geo, image::Interpolation interpolation, const RawImageManipConfig& cfg) {
+    const auto fillValues = image::getFillValues(dst.type,
+                                                 static_cast<std::uint8_t>(cfg.resizeConfig.bgRed),
+                                                 static_cast<std::uint8_t>(cfg.resizeConfig.bgGreen),
+                                                 static_cast<std::uint8_t>(cfg.resizeConfig.bgBlue));
+    const bool letterbox = geo.regionWidth != geo.width || geo.regionHeight != geo.height;
+
+    for(std::size_t i = 0; i < dst.planes.size(); i++) {
+        const int s = i > 0 && image::isSubsampled(dst.type) ? 2 : 1;
+        const auto& srcPlane = src.planes[i];
+        auto dstPlane = dst.planes[i];
+        const auto* fill = fillValues[i].data();
+        if(letterbox) {
+            image::fill(dstPlane, fill);
+            dstPlane = getRegion(dstPlane, geo.regionX / s, geo.regionY / s, geo.regionWidth / s, geo.regionHeight / s);
+        }
+
+        // Pixel index coordinates of this plane
+        auto m = multiply({translation(-0.5, -0.5), scaling(1.0 / s, 1.0 / s), geo.transform, scaling(s, s), translation(0.5, 0.5)});
+        for(auto& v : m) v /= m[8];
+
+        const bool axisAligned = std::abs(m[1]) < 1e-12 && std::abs(m[3]) < 1e-12 && std::abs(m[6]) < 1e-12 && std::abs(m[7]) < 1e-12;
+        auto inside = [](double a, double b, int size) { return std::min(a, b) >= -0.5 && std::max(a, b) <= size - 0.5; };
+        if(axisAligned
+           && (geo.border == image::Border::REPLICATE
+               || (inside(m[2], m[0] * (dstPlane.width - 1) + m[2], srcPlane.width)
+                   && inside(m[5], m[4] * (dstPlane.height - 1) + m[5], srcPlane.height)))) {
+            image::resize(srcPlane, dstPlane, m[0], m[2], m[4], m[5], interpolation);
+        } else {
+            image::warp(srcPlane, dstPlane, m, interpolation, geo.border, fill);
+        }
+    }
+}
+
+std::array<double, 3> getColor(Colormap colormap, double t) {
+    auto clamp = [](double v) { return std::min(1.0, std::max(0.0, v)); };
+    if(colormap == Colormap::JET || colormap == Colormap::STEREO_JET) {
+        return {clamp(1.5 - std::abs(4.0 * t - 3.0)), clamp(1.5 - std::abs(4.0 * t - 2.0)), clamp(1.5 - std::abs(4.0 * t - 1.0))};
+    }
+    // Polynomial approximation of Turbo
+    const double r = 0.13572138 + t * (4.61539260 + t * (-42.66032258 + t * (132.13108234 + t * (-152.94239396 + t * 59.28637943))));
+    const double g = 0.09140261 + t * (2.19418839 + t * (4.84296658 + t * (-14.18503333 + t * (4.27729857 + t * 2.82956604))));
+    const double b = 0.10667330 + t * (12.64194608 + t * (-60.58204836 + t * (110.36276771 + t * (-89.90310912 + t * 27.34824973))));
+    return {clamp(r), clamp(g), clamp(b)};
+}
+
+}  // namespace
+
+std::shared_ptr<ImgFrame> HostImageManip::apply(const ImgFrame& frame) {
+    return apply(frame, initialConfig);
+}
+
+std::shared_ptr<ImgFrame> HostImageManip::apply(const ImgFrame& frame, const ImageManipConfig& config) {
+    const auto cfg = config.get();
+    const auto inType = frame.getType();
+    const int width = static_cast<int>(frame.getWidth());
+    const int height = static_cast<int>(frame.getHeight());
+    auto& data = frame.getData();
+
+    if(!image::isSupported(inType)) throw std::runtime_error(fmt::format("HostImageManip - frame type {} isn't supported", static_cast<int>(inType)));
+    if(width <= 0 || height <= 0) throw std::invalid_argument("HostImageManip - frame is empty");
+    if(data.size() < image::getSize(inType, width, height)) {
+        throw std::invalid_argument(fmt::format("HostImageManip - frame data size {} is too small for {}x{}", data.size(), width, height));
+    }
+
+    const auto& format = cfg.formatConfig;
+    const bool colormap = cfg.enableFormat && format.colormap != Colormap::NONE;
+    Type outType = inType;
+    if(cfg.enableFormat && format.type != Type::NONE) {
+        outType = format.type;
+    } else if(colormap) {
+        outType = Type::BGR888i;
+    }
+    if(!image::isSupported(outType)) throw std::runtime_error(fmt::format("HostImageManip - output type {} isn't supported", static_cast<int>(outType)));
+
+    auto interpolation = cfg.interpolation == Interpolation::NEAREST_NEIGHBOR ? image::Interpolation::NEAREST : image::Interpolation::BILINEAR;
+
+    std::unique_lock<std::mutex> lock(mtx);
+
+    auto src = image::wrap(inType, width, height, data.data());
+    auto geo = getGeometry(cfg, width, height, image::isSubsampled(inType));
+    if(image::isSubsampled(outType) && (geo.width % 2 != 0 || geo.height % 2 != 0)) {
+        throw std::invalid_argument(fmt::format("HostImageManip - output size {}x{} must be even for YUV 4:2:0 types", geo.width, geo.height));
+    }
+
+    // Chroma of 4:2:0 types can't be resampled to odd sizes, so such input is converted first
+    if(image::isSubsampled(inType) && (geo.width % 2 != 0 || geo.height % 2 != 0 || geo.regionX % 2 != 0 || geo.regionY % 2 != 0)) {
+        sourceBuffer.resize(image::getSize(Type::BGR888i, width, height));
+        auto converted = image::wrap(Type::BGR888i, width, height, sourceBuffer.data());
+        image::convert(src, converted, scratch);
+        src = converted;
+        geo = getGeometry(cfg, width, height, false);
+    }
+
+    auto output = acquire();
+    auto& outData = output->getData();
+    outData.resize(image::getSize(outType, geo.width, geo.height));
+    const auto dst = image::wrap(outType, geo.width, geo.height, outData.data());
+
+    // Geometry, written directly to the output when no conversion follows
+    image::Image transformed = src;
+    if(!isIdentity(geo, width, height)) {
+        if(src.type == outType && !colormap) {
+            transformed = dst;
+        } else {
+            transformBuffer.resize(image::getSize(src.type, geo.width, geo.height));
+            transformed = image::wrap(src.type, geo.width, geo.height, transformBuffer.data());
+        }
+        transform(src, transformed, geo, interpolation, cfg);
+    }
+
+    if(colormap) {
+        grayBuffer.resize(image::getSize(Type::GRAY8, geo.width, geo.height));
+        colorBuffer.resize(image::getSize(Type::RGB888i, geo.width, geo.height));
+        const auto gray = image::wrap(Type::GRAY8, geo.width, geo.height, grayBuffer.data());
+        const auto color = image::wrap(Type::RGB888i, geo.width, geo.height, colorBuffer.data());
+        image::convert(transformed, gray, scratch);
+        image::applyLut(gray.planes[0], color.planes[0], getLut(format.colormap, format.colormapMin, format.colormapMax).values);
+        image::convert(color, dst, scratch);
+    } else if(transformed.planes[0].data != dst.planes[0].data) {
+        image::convert(transformed, dst, scratch);
+    }
+
+    // Metadata of the input
+    auto inRaw = std::dynamic_pointer_cast<RawImgFrame>(frame.getRaw());
+    auto outRaw = std::dynamic_pointer_cast<RawImgFrame>(output->getRaw());
+    outRaw->ts = inRaw->ts;
+    outRaw->tsDevice = inRaw->tsDevice;
+    outRaw->sequenceNum = inRaw->sequenceNum;
+    outRaw->cam = inRaw->cam;
+    outRaw->category = inRaw->category;
+    outRaw->instanceNum = inRaw->instanceNum;
+
+    auto& fb = outRaw->fb;
+    fb.type = outType;
+    fb.width = geo.width;
+    fb.height = geo.height;
+    fb.bytesPP = RawImgFrame::typeToBpp(outType);
+    fb.stride = geo.width * fb.bytesPP;
+    fb.p1Offset = 0;
+    fb.p2Offset = 0;
+    fb.p3Offset = 0;
+    if(dst.planes.size() > 1) {
+        fb.p2Offset = static_cast<unsigned int>(dst.planes[1].data - dst.planes[0].data);
+        fb.p3Offset = static_cast<unsigned int>(dst.planes.back().data - dst.planes[0].data);
+    }
+    return output;
+}
+
+void HostImageManip::setMaxPoolSize(std::size_t size) {
+    std::unique_lock<std::mutex> lock(mtx);
+    maxPoolSize = size;
+    if(pool.size() > maxPoolSize) pool.resize(maxPoolSize);
+}
+
+std::size_t HostImageManip::getMaxPoolSize() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return maxPoolSize;
+}
+
+std::shared_ptr<ImgFrame> HostImageManip::acquire() {
+    // Free when only the pool holds the frame and its raw message, the latter is also held by queues until sent
+    for(const auto& frame : pool) {
+        if(frame.use_count() == 1 && frame->getRaw().use_count() == 2) return frame;
+    }
+    auto frame = std::make_shared<ImgFrame>();
+    if(pool.size() < maxPoolSize) pool.push_back(frame);
+    return frame;
+}
+
+const HostImageManip::ColormapLut& HostImageManip::getLut(Colormap colormap, int min, int max) {
+    if(lut.colormap == colormap && lut.min == min && lut.max == max) return lut;
+    lut.colormap = colormap;
+    lut.min = min;
+    lut.max = max;
+    const bool stereo = colormap == Colormap::STEREO_TURBO || colormap == Colormap::STEREO_JET;
+    const double range = std::max(1, max - min);
+    for(int v = 0; v < 256; v++) {
+        // Stereo colormaps show invalid (zero) disparity as black
+        if(stereo && v == 0) {
+            lut.values[v] = {0, 0, 0};
+            continue;
+        }
+        const double t = std::min(1.0, std::max(0.0, (v - min) / range));
+        const auto color = getColor(colormap, t);
+        for(int c = 0; c < 3; c++) lut.values[v][c] = static_cast<std::uint8_t>(std::lround(color[c] * 255.0));
+    }
+    return lut;
+}
+
+}  // namespace dai
@@ -0,0 +1,223 @@
+#include "depthai/host/HostInferenceWindow.hpp"
+
+// std
+#include <algorithm>
+
+// project
+#include "device/DeviceRuntime.hpp"
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+static const HostInferenceWindow::Config& validate(const HostInferenceWindow::Config& config) {
+    if(config.maxInFlight == 0) throw std::invalid_argument("HostInferenceWindow - maxInFlight must be at least 1");
+    if(config.timeout <= std::chrono::milliseconds(0)) throw std::invalid_argument("HostInferenceWindow - timeout must be positive");
+    return config;
+}
+
+// Timeouts are checked a few times per timeout period, so a request fails at most ~25% (and 100ms) late
+static std::chrono::milliseconds getExpirePeriod(std::chrono::milliseconds timeout) {
+    return std::min(std::max(timeout / 4, std::chrono::milliseconds(1)), std::chrono::milliseconds(100));
+}
+
+HostInferenceWindow::HostInferenceWindow(std::shared_ptr<DataInputQueue> input, std::shared_ptr<DataOutputQueue> output)
+    : HostInferenceWindow(std::move(input), std::move(output), Config()) {}
+
+HostInferenceWindow::HostInferenceWindow(std::shared_ptr<DataInputQueue> input, std::shared_ptr<DataOutputQueue> output, Config config)
+    : config(validate(config)), output(std::move(output)) {
+    if(!input || !this->output) throw std::invalid_argument("HostInferenceWindow - queue is null");
+    sender = [input](const std::shared_ptr<ADatatype>& request) { input->send(request); };
+    // Responses are only consumed through the callback
+    this->output->setMaxSize(0);
+    callbackId = this->output->addCallback([this](std::shared_ptr<ADatatype> response) { receive(std::move(response)); });
+    start();
+}
+
+HostInferenceWindow::HostInferenceWindow(Sender sender) : HostInferenceWindow(std::move(sender), Config()) {}
+
+HostInferenceWindow::HostInferenceWindow(Sender sender, Config config) : sender(std::move(sender)), config(validate(config)) {
+    if(!this->sender) throw std::invalid_argument("HostInferenceWindow - sender is null");
+    start();
+}
+
+HostInferenceWindow::~HostInferenceWindow() {
+    if(output) output->removeCallback(callbackId);
+    // Waits for a running expire to finish
+    if(runtime) runtime->cancel(timeoutTask);
+
+    std::map<std::int64_t, Request> pending;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        closed = true;
+        pending.swap(requests);
+    }
+    cv.notify_all();
+    fail(pending, "HostInferenceWindow - destroyed before the response was received");
+}
+
+void HostInferenceWindow::start() {
+    runtime = DeviceRuntime::getShared();
+    timeoutTask = runtime->schedule(getExpirePeriod(config.timeout), [this]() { return expire(); });
+}
+
+void HostInferenceWindow::infer(std::shared_ptr<Buffer> request, Callback callback) {
+    submit(std::move(request), std::move(callback), nullptr);
+}
+
+bool HostInferenceWindow::infer(std::shared_ptr<Buffer> request, Callback callback, std::chrono::milliseconds wait) {
+    const auto deadline = Clock::now() + wait;
+    return submit(std::move(request), std::move(callback), &deadline);
+}
+
+bool HostInferenceWindow::submit(std::shared_ptr<Buffer> request, Callback callback, const Clock::time_point* deadline) {
+    if(!request) throw std::invalid_argument("HostInferenceWindow - request is null");
+    if(!callback) throw std::invalid_argument("HostInferenceWindow - callback is null");
+
+    std::int64_t sequenceNum = 0;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto hasSlot = [this]() { return closed || requests.size() < config.maxInFlight; };
+        if(deadline == nullptr) {
+            cv.wait(lock, hasSlot);
+        } else if(!cv.wait_until(lock, *deadline, hasSlot)) {
+            return false;
+        }
+        if(closed) throw std::runtime_error("HostInferenceWindow is closed");
+
+        if(config.assignSequenceNumbers) {
+            sequenceNum = nextSequenceNum++;
+            request->setSequenceNum(sequenceNum);
+        } else {
+            sequenceNum = request->getSequenceNum();
+            if(requests.count(sequenceNum) > 0) {
+                throw std::invalid_argument(fmt::format("HostInferenceWindow - request with sequence number {} already in flight", sequenceNum));
+            }
+        }
+
+        // Registered before sending, as the response can arrive before send returns
+        const auto now = Clock::now();
+        if(stats.numSent == 0) firstSent = now;
+        requests[sequenceNum] = Request{now, std::move(callback)};
+        stats.numSent++;
+    }
+
+    try {
+        sender(request);
+    } catch(...) {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            if(requests.erase(sequenceNum) > 0) stats.numSent--;
+        }
+        cv.notify_all();
+        throw;
+    }
+    return true;
+}
+
+void HostInferenceWindow::receive(std::shared_ptr<ADatatype> response) {
+    auto buffer = std::dynamic_pointer_cast<Buffer>(response);
+
+    Request request;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        auto it = buffer ? requests.find(buffer->getSequenceNum()) : requests.end();
+        if(it == requests.end()) {
+            stats.numUnmatched++;
+            return;
+        }
+        request = std::move(it->second);
+        requests.erase(it);
+
+        const auto now = Clock::now();
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(now - request.sent);
+        stats.numCompleted++;
+        totalLatency += latency;
+        stats.minLatency = stats.numCompleted == 1 ? latency : std::min(stats.minLatency, latency);
+        stats.maxLatency = std::max(stats.maxLatency, latency);
+        completions.push_back(now);
+        while(now - completions.front() > std::chrono::seconds(1)) completions.pop_front();
+    }
+    cv.notify_all();
+
+    try {
+        request.callback(std::move(response), nullptr);
+    } catch(const std::exception& ex) {
+        logger::error("HostInferenceWindow callback throwed an exception: {}", ex.what());
+    }
+}
+
+std::chrono::milliseconds HostInferenceWindow::expire() {
+    std::map<std::int64_t, Request> expired;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(closed) return DeviceRuntime::STOP;
+        const auto now = Clock::now();
+        for(auto it = requests.begin(); it != requests.end();) {
+            if(now - it->second.sent >= config.timeout) {
+                expired.insert(*it);
+                it = requests.erase(it);
+                stats.numTimedOut++;
+            } else {
+                ++it;
+            }
+        }
+    }
+    if(!expired.empty()) {
+        cv.notify_all();
+        fail(expired, "HostInferenceWindow - request timed out");
+    }
+    return getExpirePeriod(config.timeout);
+}
+
+void HostInferenceWindow::fail(std::map<std::int64_t, Request>& failed, const std::string& message) {
+    for(auto& kv : failed) {
+        try {
+            kv.second.callback(nullptr, std::make_exception_ptr(std::runtime_error(fmt::format("{} (sequence number {})", message, kv.first))));
+        } catch(const std::exception& ex) {
+            logger::error("HostInferenceWindow callback throwed an exception: {}", ex.what());
+        }
+    }
+}
+
+bool HostInferenceWindow::waitIdle(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    return cv.wait_for(lock, timeout, [this]() { return requests.empty(); });
+}
+
+void HostInferenceWindow::setMaxInFlight(unsigned int maxInFlight) {
+    if(maxInFlight == 0) throw std::invalid_argument("HostInferenceWindow - maxInFlight must be at least 1");
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        config.maxInFlight = maxInFlight;
+    }
+    cv.notify_all();
+}
+
+unsigned int HostInferenceWindow::getMaxInFlight() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return config.maxInFlight;
+}
+
+std::size_t HostInferenceWindow::getNumInFlight() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return requests.size();
+}
+
+HostInferenceWindow::Stats HostInferenceWindow::getStats() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    Stats result = stats;
+    result.numInFlight = requests.size();
+    if(stats.numCompleted > 0) result.averageLatency = totalLatency / stats.numCompleted;
+
+    // Completions within the last second, over a shorter span while the window is younger than that
+    const auto now = Clock::now();
+    const auto span = std::min<Clock::duration>(now - firstSent, std::chrono::seconds(1));
+    const auto recent = std::count_if(completions.begin(), completions.end(), [&](Clock::time_point t) { return now - t <= std::chrono::seconds(1); });
+    if(recent > 0 && span > Clock::duration::zero()) {
+        result.throughput = static_cast<float>(recent) / std::chrono::duration<float>(span).count();
+    }
+    return result;
+}
+
+}  // namespace dai
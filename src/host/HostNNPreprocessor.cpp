@@ -0,0 +1,371 @@
+#include "depthai/host/HostNNPreprocessor.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+// project
+#include "ImageKernels.hpp"
+
+// libraries
+#include "fp16/fp16.h"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+
+using Type = ImgFrame::Type;
+using Config = HostNNPreprocessor::Config;
+
+// Resampled rows are scaled by 2^(2 * WEIGHT_BITS)
+constexpr float FIXED_TO_FLOAT = 1.0f / static_cast<float>(1 << (2 * image::WEIGHT_BITS));
+
+// Output region and mapping of its pixels to source pixel index coordinates
+struct Layout {
+    int width = 0;
+    int height = 0;
+    int regionX = 0;
+    int regionY = 0;
+    int regionWidth = 0;
+    int regionHeight = 0;
+    double scaleX = 1.0;
+    double scaleY = 1.0;
+    double offsetX = 0.0;
+    double offsetY = 0.0;
+};
+
+int toSize(double value) {
+    return std::max(1, static_cast<int>(std::lround(value)));
+}
+
+Layout getLayout(const Config& config, int srcWidth, int srcHeight) {
+    Layout layout;
+    layout.width = config.width > 0 ? static_cast<int>(config.width) : srcWidth;
+    layout.height = config.height > 0 ? static_cast<int>(config.height) : srcHeight;
+    layout.regionWidth = layout.width;
+    layout.regionHeight = layout.height;
+
+    double kx = static_cast<double>(srcWidth) / layout.width;
+    double ky = static_cast<double>(srcHeight) / layout.height;
+    double sourceX = 0.0;
+    double sourceY = 0.0;
+    if(config.resizeMode == HostNNPreprocessor::ResizeMode::LETTERBOX) {
+        const double k = std::max(kx, ky);
+        layout.regionWidth = std::min(layout.width, toSize(srcWidth / k));
+        layout.regionHeight = std::min(layout.height, toSize(srcHeight / k));
+        layout.regionX = (layout.width - layout.regionWidth) / 2;
+        layout.regionY = (layout.height - layout.regionHeight) / 2;
+        kx = static_cast<double>(srcWidth) / layout.regionWidth;
+        ky = static_cast<double>(srcHeight) / layout.regionHeight;
+    } else if(config.resizeMode == HostNNPreprocessor::ResizeMode::CROP) {
+        kx = ky = std::min(kx, ky);
+        sourceX = (srcWidth - layout.width * kx) / 2.0;
+        sourceY = (srcHeight - layout.height * ky) / 2.0;
+    }
+
+    // Pixel centers are at +0.5 in continuous coordinates
+    layout.scaleX = kx;
+    layout.scaleY = ky;
+    layout.offsetX = 0.5 * kx + sourceX - 0.5;
+    layout.offsetY = 0.5 * ky + sourceY - 0.5;
+    return layout;
+}
+
+inline void store(float value, std::uint8_t& out) {
+    out = static_cast<std::uint8_t>(std::min(255.0f, std::max(0.0f, value)) + 0.5f);
+}
+
+inline void store(float value, std::uint16_t& out) {
+    out = fp16_ieee_from_fp32_value(value);
+}
+
+// BT.601 limited range, as the rest of the host image conversions
+inline void yuvToBgr(float y, float u, float v, float& b, float& g, float& r) {
+    const float c = 1.1640625f * (y - 16.0f);
+    const float d = u - 128.0f;
+    const float e = v - 128.0f;
+    b = std::min(255.0f, std::max(0.0f, c + 2.015625f * d));
+    g = std::min(255.0f, std::max(0.0f, c - 0.390625f * d - 0.8125f * e));
+    r = std::min(255.0f, std::max(0.0f, c + 1.59765625f * e));
+}
+
+template <typename T>
+class Writer {
+   public:
+    Writer(const Config& config, const Layout& layout, std::uint8_t* dst)
+        : dst(reinterpret_cast<T*>(dst)), width(layout.width), area(static_cast<std::ptrdiff_t>(layout.width) * layout.height), planar(config.planar) {
+        for(int c = 0; c < 3; c++) {
+            multiplier[c] = 1.0f / config.scale[c];
+            bias[c] = -config.mean[c] / config.scale[c];
+        }
+        // Background is given as BGR
+        const bool rgb = config.colorOrder == HostNNPreprocessor::ColorOrder::RGB;
+        const int order[3] = {rgb ? 2 : 0, 1, rgb ? 0 : 2};
+        for(int c = 0; c < 3; c++) store(config.background[order[c]] * multiplier[c] + bias[c], background[c]);
+    }
+
+    // Writes a span of a row from per channel values in output channel order, in 0..255 range times unit
+    void write(int y, int x, int count, const float* const values[3], float unit) {
+        for(int c = 0; c < 3; c++) {
+            const float m = multiplier[c] * unit;
+            const float b = bias[c];
+            const float* v = values[c];
+            if(planar) {
+                T* d = dst + c * area + static_cast<std::ptrdiff_t>(y) * width + x;
+                for(int i = 0; i < count; i++) store(v[i] * m + b, d[i]);
+            } else {
+                T* d = dst + (static_cast<std::ptrdiff_t>(y) * width + x) * 3 + c;
+                for(int i = 0; i < count; i++) store(v[i] * m + b, d[i * 3]);
+            }
+        }
+    }
+
+    void fill(int y, int x, int count) {
+        for(int c = 0; c < 3; c++) {
+            if(planar) {
+                std::fill_n(dst + c * area + static_cast<std::ptrdiff_t>(y) * width + x, count, background[c]);
+            } else {
+                T* d = dst + (static_cast<std::ptrdiff_t>(y) * width + x) * 3 + c;
+                for(int i = 0; i < count; i++) d[i * 3] = background[c];
+            }
+        }
+    }
+
+   private:
+    T* dst;
+    int width;
+    std::ptrdiff_t area;
+    bool planar;
+    float multiplier[3];
+    float bias[3];
+    T background[3];
+};
+
+image::Plane getPlane(const std::uint8_t* data, int width, int height, int stride, int channels) {
+    image::Plane plane;
+    plane.data = const_cast<std::uint8_t*>(data);
+    plane.width = width;
+    plane.height = height;
+    plane.stride = stride;
+    plane.channels = channels;
+    return plane;
+}
+
+bool isInterleaved(Type type) {
+    return type == Type::BGR888i || type == Type::RGB888i;
+}
+
+bool isPlanar(Type type) {
+    return type == Type::BGR888p || type == Type::RGB888p;
+}
+
+bool isNv(Type type) {
+    return type == Type::NV12 || type == Type::NV21;
+}
+
+// Fused pass: each output row is resampled, converted to per channel values, normalized and written out
+template <typename T>
+void prepare(Type type, const std::uint8_t* data, int width, int height, int stride, const Config& config, const Layout& layout, Writer<T>& writer) {
+    const int regionRight = layout.regionX + layout.regionWidth;
+    for(int y = 0; y < layout.height; y++) {
+        if(y < layout.regionY || y >= layout.regionY + layout.regionHeight) {
+            writer.fill(y, 0, layout.width);
+            continue;
+        }
+        if(layout.regionX > 0) writer.fill(y, 0, layout.regionX);
+        if(regionRight < layout.width) writer.fill(y, regionRight, layout.width - regionRight);
+    }
+
+    const int n = layout.regionWidth;
+    std::vector<float> blue(n), green(n), red(n);
+    const bool rgb = config.colorOrder == HostNNPreprocessor::ColorOrder::RGB;
+    const float* const values[3] = {rgb ? red.data() : blue.data(), green.data(), rgb ? blue.data() : red.data()};
+    auto resampler = [&](const std::uint8_t* planeData, int planeWidth, int planeHeight, int channels, double subsampling) {
+        // Index coordinates of a plane subsampled by the given factor
+        return image::RowResampler(getPlane(planeData, planeWidth, planeHeight, stride, channels),
+                                   n,
+                                   layout.scaleX / subsampling,
+                                   (layout.offsetX + 0.5) / subsampling - 0.5,
+                                   layout.scaleY / subsampling,
+                                   (layout.offsetY + 0.5) / subsampling - 0.5);
+    };
+
+    if(isInterleaved(type)) {
+        auto color = resampler(data, width, height, 3, 1.0);
+        const int b = type == Type::BGR888i ? 0 : 2;
+        const int r = 2 - b;
+        for(int y = 0; y < layout.regionHeight; y++) {
+            const int* row = color.getRow(y);
+            for(int x = 0; x < n; x++) {
+                blue[x] = static_cast<float>(row[3 * x + b]);
+                green[x] = static_cast<float>(row[3 * x + 1]);
+                red[x] = static_cast<float>(row[3 * x + r]);
+            }
+            writer.write(layout.regionY + y, layout.regionX, n, values, FIXED_TO_FLOAT);
+        }
+    } else if(isPlanar(type)) {
+        // Planes in memory order
+        const auto planeSize = static_cast<std::ptrdiff_t>(stride) * height;
+        auto first = resampler(data, width, height, 1, 1.0);
+        auto second = resampler(data + planeSize, width, height, 1, 1.0);
+        auto third = resampler(data + 2 * planeSize, width, height, 1, 1.0);
+        auto& firstValues = type == Type::BGR888p ? blue : red;
+        auto& thirdValues = type == Type::BGR888p ? red : blue;
+        for(int y = 0; y < layout.regionHeight; y++) {
+            const int* r0 = first.getRow(y);
+            const int* r1 = second.getRow(y);
+            const int* r2 = third.getRow(y);
+            for(int x = 0; x < n; x++) {
+                firstValues[x] = static_cast<float>(r0[x]);
+                green[x] = static_cast<float>(r1[x]);
+                thirdValues[x] = static_cast<float>(r2[x]);
+            }
+            writer.write(layout.regionY + y, layout.regionX, n, values, FIXED_TO_FLOAT);
+        }
+    } else if(isNv(type)) {
+        auto luma = resampler(data, width, height, 1, 1.0);
+        auto chroma = resampler(data + static_cast<std::ptrdiff_t>(stride) * height, width / 2, height / 2, 2, 2.0);
+        const int u = type == Type::NV12 ? 0 : 1;
+        const int v = 1 - u;
+        for(int y = 0; y < layout.regionHeight; y++) {
+            const int* ry = luma.getRow(y);
+            const int* ruv = chroma.getRow(y);
+            for(int x = 0; x < n; x++) {
+                yuvToBgr(ry[x] * FIXED_TO_FLOAT, ruv[2 * x + u] * FIXED_TO_FLOAT, ruv[2 * x + v] * FIXED_TO_FLOAT, blue[x], green[x], red[x]);
+            }
+            writer.write(layout.regionY + y, layout.regionX, n, values, 1.0f);
+        }
+    } else {
+        auto gray = resampler(data, width, height, 1, 1.0);
+        const float* const grayValues[3] = {blue.data(), blue.data(), blue.data()};
+        for(int y = 0; y < layout.regionHeight; y++) {
+            const int* row = gray.getRow(y);
+            for(int x = 0; x < n; x++) blue[x] = static_cast<float>(row[x]);
+            writer.write(layout.regionY + y, layout.regionX, n, grayValues, FIXED_TO_FLOAT);
+        }
+    }
+}
+
+}  // namespace
+
+HostNNPreprocessor::HostNNPreprocessor(Config config) {
+    setConfig(std::move(config));
+}
+
+void HostNNPreprocessor::setConfig(Config config) {
+    for(const auto scale : config.scale) {
+        if(scale == 0.0f) throw std::invalid_argument("HostNNPreprocessor - scale values must be non zero");
+    }
+    this->config = config;
+}
+
+HostNNPreprocessor::Config HostNNPreprocessor::getConfig() const {
+    return config;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::process(const ImgFrame& frame, NNData& data, const std::string& layer) {
+    const auto transform = run(getSource(frame), data, layer);
+    data.setTimestamp(frame.getTimestamp());
+    data.setTimestampDevice(frame.getTimestampDevice());
+    data.setSequenceNum(frame.getSequenceNum());
+    return transform;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::process(const ImgFrame& frame, ImgFrame& output) {
+    const auto transform = run(getSource(frame), output);
+    output.setTimestamp(frame.getTimestamp());
+    output.setTimestampDevice(frame.getTimestampDevice());
+    output.setSequenceNum(frame.getSequenceNum());
+    output.setInstanceNum(frame.getInstanceNum());
+    output.setCategory(frame.getCategory());
+    return transform;
+}
+
+HostNNPreprocessor::Source HostNNPreprocessor::getSource(const ImgFrame& frame) {
+    Source src;
+    src.type = frame.getType();
+    src.width = static_cast<int>(frame.getWidth());
+    src.height = static_cast<int>(frame.getHeight());
+    src.data = frame.getData().data();
+    src.stride = isInterleaved(src.type) ? src.width * 3 : src.width;
+
+    const auto area = static_cast<std::size_t>(src.width) * src.height;
+    std::size_t required = 0;
+    if(isInterleaved(src.type) || isPlanar(src.type)) {
+        required = area * 3;
+    } else if(isNv(src.type)) {
+        required = area * 3 / 2;
+    } else if(src.type == Type::GRAY8) {
+        required = area;
+    } else {
+        throw std::runtime_error(fmt::format("HostNNPreprocessor - frame type {} isn't supported", static_cast<int>(src.type)));
+    }
+    if(src.width <= 0 || src.height <= 0) throw std::invalid_argument("HostNNPreprocessor - frame is empty");
+    const auto size = frame.getData().size();
+    if(size < required) throw std::invalid_argument(fmt::format("HostNNPreprocessor - frame data size {} is too small for {}x{}", size, src.width, src.height));
+    return src;
+}
+
+std::size_t HostNNPreprocessor::getOutputSize(const Source& src) const {
+    const auto width = config.width > 0 ? config.width : static_cast<unsigned int>(src.width);
+    const auto height = config.height > 0 ? config.height : static_cast<unsigned int>(src.height);
+    return static_cast<std::size_t>(width) * height * 3;
+}
+
+ImgFrame::Type HostNNPreprocessor::getOutputType() const {
+    const bool bgr = config.colorOrder == ColorOrder::BGR;
+    if(config.dataType == DataType::FP16) {
+        if(config.planar) return bgr ? Type::BGRF16F16F16p : Type::RGBF16F16F16p;
+        return bgr ? Type::BGRF16F16F16i : Type::RGBF16F16F16i;
+    }
+    if(config.planar) return bgr ? Type::BGR888p : Type::RGB888p;
+    return bgr ? Type::BGR888i : Type::RGB888i;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::run(const Source& src, NNData& data, const std::string& layer) const {
+    Transform transform;
+    if(config.dataType == DataType::FP16) {
+        std::vector<std::uint16_t> values(getOutputSize(src));
+        transform = run(src, reinterpret_cast<std::uint8_t*>(values.data()));
+        data.setLayerFp16(layer, std::move(values));
+    } else {
+        std::vector<std::uint8_t> values(getOutputSize(src));
+        transform = run(src, values.data());
+        data.setLayer(layer, std::move(values));
+    }
+    return transform;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::run(const Source& src, ImgFrame& output) const {
+    const auto size = getOutputSize(src);
+    auto& data = output.getData();
+    data.resize(config.dataType == DataType::FP16 ? size * sizeof(std::uint16_t) : size);
+    const auto transform = run(src, data.data());
+    output.setType(getOutputType());
+    output.setSize(config.width > 0 ? config.width : src.width, config.height > 0 ? config.height : src.height);
+    return transform;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::run(const Source& src, std::uint8_t* dst) const {
+    const auto layout = getLayout(config, src.width, src.height);
+    if(config.dataType == DataType::FP16) {
+        Writer<std::uint16_t> writer(config, layout, dst);
+        prepare(src.type, src.data, src.width, src.height, src.stride, config, layout, writer);
+    } else {
+        Writer<std::uint8_t> writer(config, layout, dst);
+        prepare(src.type, src.data, src.width, src.height, src.stride, config, layout, writer);
+    }
+
+    Transform transform;
+    transform.scaleX = static_cast<float>(layout.scaleX);
+    transform.scaleY = static_cast<float>(layout.scaleY);
+    transform.offsetX = static_cast<float>(layout.offsetX + 0.5 - 0.5 * layout.scaleX - layout.regionX * layout.scaleX);
+    transform.offsetY = static_cast<float>(layout.offsetY + 0.5 - 0.5 * layout.scaleY - layout.regionY * layout.scaleY);
+    return transform;
+}
+
+}  // namespace dai
@@ -0,0 +1,307 @@
+#include "depthai/host/HostNode.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// project
+#include "depthai/host/HostGraph.hpp"
+#include "utility/WorkStealingPool.hpp"
+
+// libraries
+#include "utility/Logging.hpp"
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+
+namespace {
+// Graph whose node is running on the current thread. Sends from within a graph never block, as that could stall all pool threads
+thread_local const HostGraph* currentGraph = nullptr;
+}  // namespace
+
+// INPUT
+HostNode::InputBase::InputBase(HostNode& parent, std::string name, bool blocking, unsigned int queueSize, bool waitForMessage)
+    : parent(parent), name(std::move(name)), blocking(blocking), queueSize(queueSize), waitForMessage(waitForMessage) {
+    if(queueSize == 0) throw std::invalid_argument(fmt::format("HostNode input '{}' - queue size must be greater than zero", this->name));
+    stats.name = this->name;
+    parent.inputs.push_back(this);
+}
+
+const std::string& HostNode::InputBase::getName() const {
+    return name;
+}
+
+void HostNode::InputBase::setBlocking(bool blocking) {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        this->blocking = blocking;
+    }
+    cv.notify_all();
+}
+
+bool HostNode::InputBase::getBlocking() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return blocking;
+}
+
+void HostNode::InputBase::setQueueSize(unsigned int size) {
+    if(size == 0) throw std::invalid_argument(fmt::format("HostNode input '{}' - queue size must be greater than zero", name));
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        queueSize = size;
+    }
+    cv.notify_all();
+    for(auto* source : sources) source->schedule();
+}
+
+unsigned int HostNode::InputBase::getQueueSize() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return queueSize;
+}
+
+void HostNode::InputBase::setWaitForMessage(bool waitForMessage) {
+    this->waitForMessage = waitForMessage;
+    parent.schedule();
+}
+
+bool HostNode::InputBase::getWaitForMessage() const {
+    return waitForMessage;
+}
+
+bool HostNode::InputBase::has() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return !queue.empty();
+}
+
+std::size_t HostNode::InputBase::size() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return queue.size();
+}
+
+bool HostNode::InputBase::isFull() const {
+    return queue.size() >= queueSize;
+}
+
+void HostNode::InputBase::push(std::shared_ptr<ADatatype> msg) {
+    if(!msg) return;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stats.numReceived++;
+        if(blocking && currentGraph != parent.graph) {
+            cv.wait(lock, [this]() { return !blocking || !isFull() || closed; });
+        }
+        if(closed) {
+            stats.numDropped++;
+            return;
+        }
+        if(!blocking) {
+            while(isFull()) {
+                queue.pop_front();
+                stats.numDropped++;
+            }
+        }
+        // Blocking inputs may exceed their size by what running producers send, the producers aren't run again until there's space
+        queue.push_back(std::move(msg));
+    }
+    parent.schedule();
+}
+
+std::shared_ptr<ADatatype> HostNode::InputBase::pop() {
+    std::shared_ptr<ADatatype> msg;
+    bool freed = false;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(queue.empty()) return nullptr;
+        const bool wasFull = isFull();
+        msg = std::move(queue.front());
+        queue.pop_front();
+        freed = wasFull && !isFull();
+    }
+    cv.notify_all();
+    if(freed) {
+        for(auto* source : sources) source->schedule();
+    }
+    return msg;
+}
+
+std::shared_ptr<ADatatype> HostNode::InputBase::front() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(queue.empty()) return nullptr;
+    return queue.front();
+}
+
+void HostNode::InputBase::open() {
+    std::unique_lock<std::mutex> lock(mtx);
+    closed = false;
+}
+
+void HostNode::InputBase::close() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        closed = true;
+    }
+    cv.notify_all();
+}
+
+void HostNode::InputBase::drop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    stats.numReceived++;
+    stats.numDropped++;
+}
+
+// OUTPUT
+HostNode::OutputBase::OutputBase(HostNode& parent, std::string name) : parent(parent), name(std::move(name)) {
+    parent.outputs.push_back(this);
+}
+
+const std::string& HostNode::OutputBase::getName() const {
+    return name;
+}
+
+void HostNode::OutputBase::link(std::shared_ptr<DataInputQueue> queue) {
+    if(!queue) throw std::invalid_argument(fmt::format("HostNode output '{}' - queue is null", name));
+    if(parent.graph != nullptr && parent.graph->isRunning()) throw std::runtime_error("Can't link outputs of a running HostGraph");
+    queues.push_back(std::move(queue));
+}
+
+void HostNode::OutputBase::linkInput(InputBase& input) {
+    if(parent.graph != nullptr && parent.graph->isRunning()) throw std::runtime_error("Can't link outputs of a running HostGraph");
+    if(&input.parent == &parent) throw std::invalid_argument(fmt::format("HostNode '{}' can't be linked to itself", parent.name));
+    if(std::find(targets.begin(), targets.end(), &input) != targets.end()) return;
+    targets.push_back(&input);
+    if(std::find(input.sources.begin(), input.sources.end(), &parent) == input.sources.end()) input.sources.push_back(&parent);
+}
+
+void HostNode::OutputBase::send(const std::shared_ptr<ADatatype>& msg) {
+    if(!msg) return;
+    for(auto* target : targets) target->push(msg);
+    for(auto& queue : queues) queue->send(msg);
+}
+
+bool HostNode::OutputBase::isBlocked() const {
+    for(const auto* target : targets) {
+        std::unique_lock<std::mutex> lock(target->mtx);
+        if(target->blocking && target->isFull() && !target->closed) return true;
+    }
+    return false;
+}
+
+// NODE
+HostNode::HostNode(std::string name) : name(std::move(name)) {}
+
+const std::string& HostNode::getName() const {
+    return name;
+}
+
+void HostNode::setMaxConcurrency(unsigned int maxConcurrency) {
+    if(maxConcurrency == 0) throw std::invalid_argument(fmt::format("HostNode '{}' - maximum concurrency must be greater than zero", name));
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        this->maxConcurrency = maxConcurrency;
+    }
+    schedule();
+}
+
+unsigned int HostNode::getMaxConcurrency() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return maxConcurrency;
+}
+
+HostNode::Stats HostNode::getStats() const {
+    Stats stats;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stats.name = name;
+        stats.numRuns = numRuns;
+        stats.numErrors = numErrors;
+        stats.totalTime = totalTime;
+        stats.maxTime = maxTime;
+        if(numRuns > 0) stats.averageTime = totalTime / numRuns;
+    }
+    for(const auto* input : inputs) {
+        std::unique_lock<std::mutex> lock(input->mtx);
+        stats.inputs.push_back(input->stats);
+        stats.inputs.back().size = input->queue.size();
+    }
+    return stats;
+}
+
+bool HostNode::isReady() const {
+    if(inputs.empty()) return false;
+    bool anyWaiting = false;
+    bool anyMessage = false;
+    for(const auto* input : inputs) {
+        const bool has = input->has();
+        if(input->waitForMessage) {
+            if(!has) return false;
+            anyWaiting = true;
+        }
+        anyMessage = anyMessage || has;
+    }
+    if(!anyWaiting && !anyMessage) return false;
+    for(const auto* output : outputs) {
+        if(output->isBlocked()) return false;
+    }
+    return true;
+}
+
+void HostNode::schedule() {
+    std::unique_lock<std::mutex> lock(mtx);
+    if(graph == nullptr || !graph->isRunning()) return;
+    if(numActive >= maxConcurrency || !isReady()) return;
+
+    // One more run than needed is harmless, it finds no messages and returns
+    std::size_t numQueued = 0;
+    for(const auto* input : inputs) numQueued += input->size();
+    const auto numTasks = std::min<std::size_t>(maxConcurrency - numActive, numQueued);
+    for(std::size_t i = 0; i < numTasks; i++) {
+        numActive++;
+        graph->pool->submit([this]() { run(); });
+    }
+}
+
+void HostNode::run() {
+    bool ready = false;
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        ready = graph->isRunning() && isReady();
+    }
+
+    if(ready) {
+        const auto previousGraph = currentGraph;
+        currentGraph = graph;
+        bool failed = false;
+        const auto t1 = std::chrono::steady_clock::now();
+        try {
+            process();
+        } catch(const std::exception& ex) {
+            failed = true;
+            logger::error("HostNode '{}' process threw an exception: {}", name, ex.what());
+        }
+        const auto t2 = std::chrono::steady_clock::now();
+        currentGraph = previousGraph;
+
+        std::unique_lock<std::mutex> lock(mtx);
+        const auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1);
+        numRuns++;
+        if(failed) numErrors++;
+        totalTime += time;
+        maxTime = std::max(maxTime, time);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        numActive--;
+    }
+    idleCv.notify_all();
+
+    // Messages which arrived while running didn't schedule another run if concurrency was exhausted
+    schedule();
+}
+
+void HostNode::waitIdle() {
+    std::unique_lock<std::mutex> lock(mtx);
+    idleCv.wait(lock, [this]() { return numActive == 0; });
+}
+
+}  // namespace dai
@@ -0,0 +1,406 @@
+#define _USE_MATH_DEFINES
+
+#include "depthai/host/HostSpatialLocationCalculator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace dai {
+
+namespace {
+
+constexpr int TILE_SIZE = 16;
+
+// Runs fn(i) for i in [0, count), split across up to numThreads threads
+template <typename F>
+void parallelFor(size_t count, unsigned int numThreads, F&& fn) {
+    if(numThreads <= 1 || count <= 1) {
+        for(size_t i = 0; i < count; i++) fn(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for(size_t i = next++; i < count; i = next++) fn(i);
+    };
+    std::vector<std::thread> threads;
+    const auto numWorkers = std::min<size_t>(numThreads, count) - 1;
+    threads.reserve(numWorkers);
+    for(size_t i = 0; i < numWorkers; i++) threads.emplace_back(worker);
+    worker();
+    for(auto& t : threads) t.join();
+}
+
+struct DepthView {
+    const std::uint16_t* data;
+    int width;
+    int height;
+
+    std::uint16_t at(int x, int y) const {
+        return data[static_cast<size_t>(y) * width + x];
+    }
+};
+
+struct PixelRect {
+    int x0, y0, x1, y1;
+
+    bool empty() const {
+        return x0 >= x1 || y0 >= y1;
+    }
+    size_t area() const {
+        return empty() ? 0 : static_cast<size_t>(x1 - x0) * (y1 - y0);
+    }
+};
+
+struct Stats {
+    std::uint64_t sum = 0;
+    std::uint32_t count = 0;
+    std::uint16_t min = 65535;
+    std::uint16_t max = 0;
+
+    void add(std::uint16_t value) {
+        sum += value;
+        count++;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+    void merge(std::uint16_t tileMin, std::uint16_t tileMax) {
+        min = std::min(min, tileMin);
+        max = std::max(max, tileMax);
+    }
+};
+
+// Per threshold pair summary of a depth frame, built once per calculate call
+class DepthSummary {
+    int width, height;
+    int tilesX, tilesY;
+    std::uint32_t lower, upper;
+    // (width + 1) x (height + 1) integral images of valid pixel count and their sum
+    std::vector<std::uint64_t> sum;
+    std::vector<std::uint32_t> count;
+    // Min and max of valid pixels per TILE_SIZE x TILE_SIZE tile
+    std::vector<std::uint16_t> tileMin, tileMax;
+
+    size_t idx(int x, int y) const {
+        return static_cast<size_t>(y) * (width + 1) + x;
+    }
+
+   public:
+    DepthSummary(const DepthView& depth, std::uint32_t lower, std::uint32_t upper, unsigned int numThreads)
+        : width(depth.width),
+          height(depth.height),
+          tilesX((depth.width + TILE_SIZE - 1) / TILE_SIZE),
+          tilesY((depth.height + TILE_SIZE - 1) / TILE_SIZE),
+          lower(lower),
+          upper(upper),
+          sum(static_cast<size_t>(depth.width + 1) * (depth.height + 1), 0),
+          count(static_cast<size_t>(depth.width + 1) * (depth.height + 1), 0),
+          tileMin(static_cast<size_t>(tilesX) * tilesY, 65535),
+          tileMax(static_cast<size_t>(tilesX) * tilesY, 0) {
+        // Row prefix sums and tile min/max, parallel over tile rows
+        parallelFor(tilesY, numThreads, [&](size_t ty) {
+            const int yEnd = std::min(height, static_cast<int>(ty + 1) * TILE_SIZE);
+            for(int y = static_cast<int>(ty) * TILE_SIZE; y < yEnd; y++) {
+                std::uint64_t rowSum = 0;
+                std::uint32_t rowCount = 0;
+                for(int x = 0; x < width; x++) {
+                    const std::uint16_t value = depth.at(x, y);
+                    if(isValid(value)) {
+                        rowSum += value;
+                        rowCount++;
+                        const size_t tile = ty * tilesX + x / TILE_SIZE;
+                        tileMin[tile] = std::min(tileMin[tile], value);
+                        tileMax[tile] = std::max(tileMax[tile], value);
+                    }
+                    sum[idx(x + 1, y + 1)] = rowSum;
+                    count[idx(x + 1, y + 1)] = rowCount;
+                }
+            }
+        });
+        // Column accumulation, parallel over column blocks
+        const size_t columnBlocks = (width + 255) / 256;
+        parallelFor(columnBlocks, numThreads, [&](size_t block) {
+            const int xEnd = std::min(width, static_cast<int>(block + 1) * 256);
+            for(int y = 1; y < height; y++) {
+                for(int x = static_cast<int>(block) * 256; x < xEnd; x++) {
+                    sum[idx(x + 1, y + 1)] += sum[idx(x + 1, y)];
+                    count[idx(x + 1, y + 1)] += count[idx(x + 1, y)];
+                }
+            }
+        });
+    }
+
+    bool isValid(std::uint16_t value) const {
+        return value > lower && value < upper;
+    }
+
+    Stats query(const DepthView& depth, const PixelRect& r) const {
+        Stats stats;
+        if(r.empty()) return stats;
+
+        // Average and count in constant time
+        stats.sum = sum[idx(r.x1, r.y1)] - sum[idx(r.x0, r.y1)] - sum[idx(r.x1, r.y0)] + sum[idx(r.x0, r.y0)];
+        stats.count = count[idx(r.x1, r.y1)] - count[idx(r.x0, r.y1)] - count[idx(r.x1, r.y0)] + count[idx(r.x0, r.y0)];
+        if(stats.count == 0) return stats;
+
+        // Min and max from fully covered tiles, remaining border pixels are scanned
+        auto scan = [&](int x0, int y0, int x1, int y1) {
+            for(int y = y0; y < y1; y++) {
+                for(int x = x0; x < x1; x++) {
+                    const std::uint16_t value = depth.at(x, y);
+                    if(isValid(value)) stats.merge(value, value);
+                }
+            }
+        };
+        const int tx0 = (r.x0 + TILE_SIZE - 1) / TILE_SIZE, tx1 = r.x1 / TILE_SIZE;
+        const int ty0 = (r.y0 + TILE_SIZE - 1) / TILE_SIZE, ty1 = r.y1 / TILE_SIZE;
+        if(tx0 >= tx1 || ty0 >= ty1) {
+            scan(r.x0, r.y0, r.x1, r.y1);
+            return stats;
+        }
+        for(int ty = ty0; ty < ty1; ty++) {
+            for(int tx = tx0; tx < tx1; tx++) {
+                const size_t tile = static_cast<size_t>(ty) * tilesX + tx;
+                stats.merge(tileMin[tile], tileMax[tile]);
+            }
+        }
+        scan(r.x0, r.y0, r.x1, ty0 * TILE_SIZE);
+        scan(r.x0, ty1 * TILE_SIZE, r.x1, r.y1);
+        scan(r.x0, ty0 * TILE_SIZE, tx0 * TILE_SIZE, ty1 * TILE_SIZE);
+        scan(tx1 * TILE_SIZE, ty0 * TILE_SIZE, r.x1, ty1 * TILE_SIZE);
+        return stats;
+    }
+};
+
+PixelRect toPixelRect(const Rect& roi, int width, int height) {
+    const Rect r = roi.denormalize(width, height);
+    PixelRect p;
+    p.x0 = std::max(0, static_cast<int>(std::floor(r.x)));
+    p.y0 = std::max(0, static_cast<int>(std::floor(r.y)));
+    p.x1 = std::min(width, static_cast<int>(std::ceil(r.x + r.width)));
+    p.y1 = std::min(height, static_cast<int>(std::ceil(r.y + r.height)));
+    return p;
+}
+
+bool needsSamples(SpatialLocationCalculatorAlgorithm algorithm) {
+    return algorithm == SpatialLocationCalculatorAlgorithm::MEDIAN || algorithm == SpatialLocationCalculatorAlgorithm::MODE;
+}
+
+// Same defaults as on device: AUTO is 1 for AVERAGE/MIN/MAX and 2 for MODE/MEDIAN
+int resolveStepSize(const SpatialLocationCalculatorConfigData& config, size_t area, std::uint32_t maxSamples) {
+    if(config.stepSize != SpatialLocationCalculatorConfigData::AUTO) return std::max(1, static_cast<int>(config.stepSize));
+    if(!needsSamples(config.calculationAlgorithm)) return 1;
+    int step = 2;
+    if(maxSamples > 0 && area / 4 > maxSamples) {
+        step = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(area) / maxSamples)));
+    }
+    return step;
+}
+
+float calculateMedian(std::vector<std::uint16_t>& samples) {
+    if(samples.empty()) return 0.0f;
+    auto middle = samples.begin() + samples.size() / 2;
+    std::nth_element(samples.begin(), middle, samples.end());
+    return *middle;
+}
+
+float calculateMode(std::vector<std::uint16_t>& samples) {
+    if(samples.empty()) return 0.0f;
+    std::sort(samples.begin(), samples.end());
+    std::uint16_t mode = samples[0];
+    size_t modeCount = 0;
+    for(size_t i = 0; i < samples.size();) {
+        size_t j = i;
+        while(j < samples.size() && samples[j] == samples[i]) j++;
+        if(j - i > modeCount) {
+            modeCount = j - i;
+            mode = samples[i];
+        }
+        i = j;
+    }
+    return mode;
+}
+
+}  // namespace
+
+HostSpatialLocationCalculator::HostSpatialLocationCalculator(float hfovDeg) : hfovDeg(hfovDeg) {}
+
+void HostSpatialLocationCalculator::setHfov(float hfov) {
+    hfovDeg = hfov;
+}
+
+float HostSpatialLocationCalculator::getHfov() const {
+    return hfovDeg;
+}
+
+void HostSpatialLocationCalculator::setNumThreads(unsigned int threads) {
+    numThreads = threads;
+}
+
+unsigned int HostSpatialLocationCalculator::getNumThreads() const {
+    return numThreads;
+}
+
+void HostSpatialLocationCalculator::setMaxSamplesPerRoi(std::uint32_t maxSamples) {
+    maxSamplesPerRoi = maxSamples;
+}
+
+std::uint32_t HostSpatialLocationCalculator::getMaxSamplesPerRoi() const {
+    return maxSamplesPerRoi;
+}
+
+std::vector<SpatialLocations> HostSpatialLocationCalculator::calculateLocations(const ImgFrame& depth,
+                                                                                const std::vector<SpatialLocationCalculatorConfigData>& rois) const {
+    if(depth.getType() != ImgFrame::Type::RAW16) {
+        throw std::invalid_argument("HostSpatialLocationCalculator requires a RAW16 depth frame");
+    }
+    const int width = static_cast<int>(depth.getWidth());
+    const int height = static_cast<int>(depth.getHeight());
+    const auto& data = depth.getData();
+    if(data.size() < static_cast<size_t>(width) * height * sizeof(std::uint16_t)) {
+        throw std::invalid_argument("Depth frame data is smaller than its width and height");
+    }
+    const DepthView view{reinterpret_cast<const std::uint16_t*>(data.data()), width, height};
+    const unsigned int threads = numThreads == 0 ? std::max(1u, std::thread::hardware_concurrency()) : numThreads;
+
+    // Resolve regions and step sizes, and build a summary for each threshold pair used by ROIs with step size 1
+    std::vector<PixelRect> rects(rois.size());
+    std::vector<int> steps(rois.size());
+    std::map<std::pair<std::uint32_t, std::uint32_t>, std::unique_ptr<DepthSummary>> summaries;
+    for(size_t i = 0; i < rois.size(); i++) {
+        rects[i] = toPixelRect(rois[i].roi, width, height);
+        steps[i] = resolveStepSize(rois[i], rects[i].area(), maxSamplesPerRoi);
+        if(steps[i] == 1 && !rects[i].empty()) {
+            summaries[{rois[i].depthThresholds.lowerThreshold, rois[i].depthThresholds.upperThreshold}] = nullptr;
+        }
+    }
+    for(auto& kv : summaries) {
+        kv.second = std::make_unique<DepthSummary>(view, kv.first.first, kv.first.second, threads);
+    }
+
+    const float tanHalfHfov = std::tan(hfovDeg * static_cast<float>(M_PI) / 180.0f / 2.0f);
+    std::vector<SpatialLocations> locations(rois.size());
+    parallelFor(rois.size(), threads, [&](size_t i) {
+        const auto& config = rois[i];
+        const auto& r = rects[i];
+        const int step = steps[i];
+        const std::uint32_t lower = config.depthThresholds.lowerThreshold;
+        const std::uint32_t upper = config.depthThresholds.upperThreshold;
+        const bool sampled = needsSamples(config.calculationAlgorithm);
+
+        Stats stats;
+        std::vector<std::uint16_t> samples;
+        if(step == 1 && !sampled) {
+            if(!r.empty()) stats = summaries.at({lower, upper})->query(view, r);
+        } else {
+            if(sampled) samples.reserve(r.area() / (static_cast<size_t>(step) * step) + 1);
+            for(int y = r.y0; y < r.y1; y += step) {
+                for(int x = r.x0; x < r.x1; x += step) {
+                    const std::uint16_t value = view.at(x, y);
+                    if(value > lower && value < upper) {
+                        stats.add(value);
+                        if(sampled) samples.push_back(value);
+                    }
+                }
+            }
+        }
+
+        auto& loc = locations[i];
+        loc.config = config;
+        loc.depthAveragePixelCount = stats.count;
+        if(stats.count > 0) {
+            loc.depthAverage = static_cast<float>(static_cast<double>(stats.sum) / stats.count);
+            loc.depthMin = stats.min;
+            loc.depthMax = stats.max;
+        }
+
+        float z = 0.0f;
+        switch(config.calculationAlgorithm) {
+            case SpatialLocationCalculatorAlgorithm::AVERAGE:
+                z = loc.depthAverage;
+                break;
+            case SpatialLocationCalculatorAlgorithm::MIN:
+                z = loc.depthMin;
+                break;
+            case SpatialLocationCalculatorAlgorithm::MAX:
+                z = loc.depthMax;
+                break;
+            case SpatialLocationCalculatorAlgorithm::MODE:
+                loc.depthMode = calculateMode(samples);
+                z = loc.depthMode;
+                break;
+            case SpatialLocationCalculatorAlgorithm::MEDIAN:
+                loc.depthMedian = calculateMedian(samples);
+                z = loc.depthMedian;
+                break;
+        }
+
+        // Angles relative to the optical center, derived from the horizontal field of view
+        if(!r.empty()) {
+            const float halfWidth = width / 2.0f;
+            const float dx = (r.x0 + r.x1) / 2.0f - halfWidth;
+            const float dy = (r.y0 + r.y1) / 2.0f - height / 2.0f;
+            loc.spatialCoordinates.x = z * tanHalfHfov * dx / halfWidth;
+            loc.spatialCoordinates.y = -z * tanHalfHfov * dy / halfWidth;
+            loc.spatialCoordinates.z = z;
+        }
+    });
+    return locations;
+}
+
+std::shared_ptr<SpatialLocationCalculatorData> HostSpatialLocationCalculator::calculate(const ImgFrame& depth,
+                                                                                        const std::vector<SpatialLocationCalculatorConfigData>& rois) const {
+    auto data = std::make_shared<SpatialLocationCalculatorData>();
+    data->spatialLocations = calculateLocations(depth, rois);
+    data->setTimestamp(depth.getTimestamp());
+    data->setTimestampDevice(depth.getTimestampDevice());
+    data->setSequenceNum(depth.getSequenceNum());
+    return data;
+}
+
+std::shared_ptr<SpatialLocationCalculatorData> HostSpatialLocationCalculator::calculate(const ImgFrame& depth,
+                                                                                        const SpatialLocationCalculatorConfig& config) const {
+    return calculate(depth, config.getConfigData());
+}
+
+std::shared_ptr<SpatialImgDetections> HostSpatialLocationCalculator::calculate(const ImgFrame& depth,
+                                                                               const ImgDetections& detections,
+                                                                               const SpatialLocationCalculatorConfigData& settings,
+                                                                               float boundingBoxScaleFactor) const {
+    if(boundingBoxScaleFactor <= 0.0f || boundingBoxScaleFactor > 1.0f) {
+        throw std::invalid_argument("Bounding box scale factor must be in the interval (0,1]");
+    }
+
+    // Map detections to scaled, normalized ROIs around the same center
+    std::vector<SpatialLocationCalculatorConfigData> rois(detections.detections.size(), settings);
+    for(size_t i = 0; i < rois.size(); i++) {
+        const auto& det = detections.detections[i];
+        const float cx = (det.xmin + det.xmax) / 2.0f, cy = (det.ymin + det.ymax) / 2.0f;
+        const float halfW = (det.xmax - det.xmin) * boundingBoxScaleFactor / 2.0f;
+        const float halfH = (det.ymax - det.ymin) * boundingBoxScaleFactor / 2.0f;
+        const float xmin = std::max(0.0f, cx - halfW), ymin = std::max(0.0f, cy - halfH);
+        const float xmax = std::min(1.0f, cx + halfW), ymax = std::min(1.0f, cy + halfH);
+        rois[i].roi = Rect(xmin, ymin, std::max(0.0f, xmax - xmin), std::max(0.0f, ymax - ymin));
+    }
+    auto locations = calculateLocations(depth, rois);
+
+    auto spatial = std::make_shared<SpatialImgDetections>();
+    spatial->detections.resize(locations.size());
+    for(size_t i = 0; i < locations.size(); i++) {
+        auto& out = spatial->detections[i];
+        static_cast<ImgDetection&>(out) = detections.detections[i];
+        out.spatialCoordinates = locations[i].spatialCoordinates;
+        out.boundingBoxMapping = locations[i].config;
+    }
+    spatial->setTimestamp(detections.getTimestamp());
+    spatial->setTimestampDevice(detections.getTimestampDevice());
+    spatial->setSequenceNum(detections.getSequenceNum());
+    return spatial;
+}
+
+}  // namespace dai
@@ -0,0 +1,291 @@
+#include "depthai/host/HostSynchronizer.hpp"
+
+// std
+#include <algorithm>
+#include <stdexcept>
+
+// project
+#include "depthai/pipeline/datatype/Buffer.hpp"
+
+// libraries
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+HostSynchronizer::HostSynchronizer(std::chrono::nanoseconds threshold, TimestampSource source) : threshold(threshold), source(source) {}
+
+HostSynchronizer::~HostSynchronizer() {
+    close();
+}
+
+void HostSynchronizer::add(const std::string& name, std::shared_ptr<DataOutputQueue> queue) {
+    if(!queue) throw std::invalid_argument("HostSynchronizer - queue is null");
+    addStream(name);
+
+    // Messages are consumed through the synchronizer only
+    queue->setMaxSize(0);
+    auto id = queue->addCallback([this, name](std::shared_ptr<ADatatype> msg) { send(name, msg); });
+
+    std::unique_lock<std::mutex> l(mtx);
+    auto& stream = findStream(name);
+    stream.queue = std::move(queue);
+    stream.queueCallbackId = id;
+}
+
+void HostSynchronizer::addStream(const std::string& name) {
+    std::unique_lock<std::mutex> l(mtx);
+    for(const auto& stream : streams) {
+        if(stream.name == name) throw std::invalid_argument("HostSynchronizer - stream '" + name + "' already exists");
+    }
+    Stream stream;
+    stream.name = name;
+    streams.push_back(std::move(stream));
+}
+
+HostSynchronizer::Stream& HostSynchronizer::findStream(const std::string& name) {
+    for(auto& stream : streams) {
+        if(stream.name == name) return stream;
+    }
+    throw std::invalid_argument("HostSynchronizer - stream '" + name + "' doesn't exist");
+}
+
+void HostSynchronizer::send(const std::string& name, const std::shared_ptr<ADatatype>& msg) {
+    if(!msg) return;
+
+    Entry entry;
+    entry.arrival = std::chrono::steady_clock::now();
+    entry.ts = entry.arrival;
+    entry.msg = msg;
+    if(auto buffer = std::dynamic_pointer_cast<Buffer>(msg)) {
+        entry.ts = source == TimestampSource::HOST ? buffer->getTimestamp() : buffer->getTimestampDevice();
+    }
+
+    std::vector<std::shared_ptr<MessageGroup>> groups;
+    std::vector<std::pair<std::string, std::shared_ptr<ADatatype>>> dropped;
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        auto& stream = findStream(name);
+        stream.stats.received++;
+
+        auto& buffer = stream.buffer;
+        if(buffer.size() >= maxBufferSize) {
+            stream.stats.dropped++;
+            if(overflowPolicy == OverflowPolicy::DROP_NEWEST) {
+                dropped.emplace_back(name, std::move(entry.msg));
+                l.unlock();
+                dispatch(groups, dropped);
+                return;
+            }
+            dropped.emplace_back(name, std::move(buffer.front().msg));
+            buffer.pop_front();
+        }
+
+        // Keep buffer ordered by timestamp, messages mostly arrive in order
+        if(buffer.empty() || buffer.back().ts <= entry.ts) {
+            buffer.push_back(std::move(entry));
+        } else {
+            auto it = std::upper_bound(buffer.begin(), buffer.end(), entry.ts, [](const Timepoint& ts, const Entry& e) { return ts < e.ts; });
+            buffer.insert(it, std::move(entry));
+        }
+
+        groups = match(dropped);
+    }
+    dispatch(groups, dropped);
+}
+
+std::vector<std::shared_ptr<MessageGroup>> HostSynchronizer::match(std::vector<std::pair<std::string, std::shared_ptr<ADatatype>>>& dropped) {
+    std::vector<std::shared_ptr<MessageGroup>> groups;
+    if(streams.empty()) return groups;
+
+    auto dropFront = [&dropped](Stream& stream) {
+        stream.stats.dropped++;
+        dropped.emplace_back(stream.name, std::move(stream.buffer.front().msg));
+        stream.buffer.pop_front();
+    };
+
+    while(true) {
+        // Anchor is the newest of the oldest messages, as no stream can provide an older match for it
+        Timepoint anchor = Timepoint::min();
+        for(const auto& stream : streams) {
+            if(stream.buffer.empty()) return groups;
+            anchor = std::max(anchor, stream.buffer.front().ts);
+        }
+
+        // Drop messages which are too old to ever be matched
+        bool waiting = false;
+        for(auto& stream : streams) {
+            while(!stream.buffer.empty() && stream.buffer.front().ts < anchor - threshold) dropFront(stream);
+            if(stream.buffer.empty()) waiting = true;
+        }
+        if(waiting) return groups;
+
+        // From each stream take the message closest to (and not newer than) the anchor
+        auto group = std::make_shared<MessageGroup>();
+        Timepoint firstArrival = Timepoint::max();
+        Timepoint latestTs = Timepoint::min(), latestTsDevice = Timepoint::min();
+        for(auto& stream : streams) {
+            auto& buffer = stream.buffer;
+            auto it = std::upper_bound(buffer.begin(), buffer.end(), anchor, [](const Timepoint& ts, const Entry& e) { return ts < e.ts; });
+            const auto skipped = std::distance(buffer.begin(), it) - 1;
+            for(auto i = 0; i < skipped; i++) dropFront(stream);
+
+            auto& chosen = buffer.front();
+            firstArrival = std::min(firstArrival, chosen.arrival);
+            if(auto msg = std::dynamic_pointer_cast<Buffer>(chosen.msg)) {
+                latestTs = std::max(latestTs, msg->getTimestamp());
+                latestTsDevice = std::max(latestTsDevice, msg->getTimestampDevice());
+            }
+            group->add(stream.name, chosen.msg);
+            stream.stats.matched++;
+            buffer.pop_front();
+        }
+        if(latestTs != Timepoint::min()) {
+            group->setTimestamp(latestTs);
+            group->setTimestampDevice(latestTsDevice);
+        }
+        group->setSequenceNum(static_cast<int64_t>(numGroups));
+
+        const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - firstArrival);
+        latencySum += latency;
+        latencyMax = std::max(latencyMax, latency);
+        numGroups++;
+        groups.push_back(std::move(group));
+    }
+}
+
+void HostSynchronizer::dispatch(std::vector<std::shared_ptr<MessageGroup>>& groups,
+                                std::vector<std::pair<std::string, std::shared_ptr<ADatatype>>>& dropped) {
+    if(!dropped.empty()) {
+        std::function<void(std::string, std::shared_ptr<ADatatype>)> callback;
+        {
+            std::unique_lock<std::mutex> l(mtx);
+            callback = droppedCallback;
+        }
+        if(callback) {
+            for(auto& kv : dropped) {
+                try {
+                    callback(kv.first, kv.second);
+                } catch(const std::exception& ex) {
+                    logger::error("HostSynchronizer dropped message callback throwed an exception: {}", ex.what());
+                }
+            }
+        }
+    }
+
+    for(auto& group : groups) {
+        output.push(group);
+
+        std::unique_lock<std::mutex> l(callbacksMtx);
+        for(const auto& kv : callbacks) {
+            try {
+                kv.second(group);
+            } catch(const std::exception& ex) {
+                logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
+            }
+        }
+    }
+}
+
+void HostSynchronizer::setThreshold(std::chrono::nanoseconds newThreshold) {
+    std::unique_lock<std::mutex> l(mtx);
+    threshold = newThreshold;
+}
+
+std::chrono::nanoseconds HostSynchronizer::getThreshold() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return threshold;
+}
+
+void HostSynchronizer::setMaxBufferSize(unsigned int maxSize, OverflowPolicy policy) {
+    std::unique_lock<std::mutex> l(mtx);
+    maxBufferSize = std::max(1u, maxSize);
+    overflowPolicy = policy;
+}
+
+unsigned int HostSynchronizer::getMaxBufferSize() const {
+    std::unique_lock<std::mutex> l(mtx);
+    return maxBufferSize;
+}
+
+void HostSynchronizer::setDroppedCallback(std::function<void(std::string, std::shared_ptr<ADatatype>)> callback) {
+    std::unique_lock<std::mutex> l(mtx);
+    droppedCallback = std::move(callback);
+}
+
+HostSynchronizer::CallbackId HostSynchronizer::addCallback(std::function<void(std::shared_ptr<MessageGroup>)> callback) {
+    std::unique_lock<std::mutex> l(callbacksMtx);
+    CallbackId id = uniqueCallbackId++;
+    callbacks[id] = std::move(callback);
+    return id;
+}
+
+bool HostSynchronizer::removeCallback(CallbackId callbackId) {
+    std::unique_lock<std::mutex> l(callbacksMtx);
+    if(callbacks.count(callbackId) == 0) return false;
+    callbacks.erase(callbackId);
+    return true;
+}
+
+void HostSynchronizer::setMaxSize(unsigned int maxSize) {
+    output.setMaxSize(maxSize);
+}
+
+unsigned int HostSynchronizer::getMaxSize() const {
+    return output.getMaxSize();
+}
+
+std::shared_ptr<MessageGroup> HostSynchronizer::tryGet() {
+    std::shared_ptr<MessageGroup> val = nullptr;
+    if(!output.tryPop(val)) return nullptr;
+    return val;
+}
+
+std::shared_ptr<MessageGroup> HostSynchronizer::get() {
+    std::shared_ptr<MessageGroup> val = nullptr;
+    if(!output.waitAndPop(val)) {
+        throw std::runtime_error("HostSynchronizer closed");
+    }
+    return val;
+}
+
+HostSynchronizer::Stats HostSynchronizer::getStats() const {
+    std::unique_lock<std::mutex> l(mtx);
+    Stats stats;
+    stats.numGroups = numGroups;
+    std::uint64_t received = 0, matched = 0;
+    for(const auto& stream : streams) {
+        auto streamStats = stream.stats;
+        streamStats.buffered = stream.buffer.size();
+        stats.streams[stream.name] = streamStats;
+        received += streamStats.received;
+        matched += streamStats.matched;
+    }
+    if(received > 0) stats.matchRate = static_cast<float>(matched) / received;
+    if(numGroups > 0) stats.averageLatency = std::chrono::duration_cast<std::chrono::microseconds>(latencySum / numGroups);
+    stats.maxLatency = std::chrono::duration_cast<std::chrono::microseconds>(latencyMax);
+    return stats;
+}
+
+void HostSynchronizer::resetStats() {
+    std::unique_lock<std::mutex> l(mtx);
+    for(auto& stream : streams) stream.stats = {};
+    numGroups = 0;
+    latencySum = {};
+    latencyMax = {};
+}
+
+void HostSynchronizer::close() {
+    // Detach from queues without holding the lock, as their reading threads may be inside send()
+    std::vector<std::pair<std::shared_ptr<DataOutputQueue>, DataOutputQueue::CallbackId>> queues;
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        for(auto& stream : streams) {
+            if(stream.queue) queues.emplace_back(std::move(stream.queue), stream.queueCallbackId);
+            stream.queue = nullptr;
+        }
+    }
+    for(auto& kv : queues) kv.first->removeCallback(kv.second);
+    output.destruct();
+}
+
+}  // namespace dai
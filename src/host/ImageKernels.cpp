@@ -0,0 +1,621 @@
+#include "ImageKernels.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// libraries
+#include "utility/spdlog-fmt.hpp"
+
+namespace dai {
+namespace image {
+
+using Type = RawImgFrame::Type;
+
+namespace {
+
+// Products of two weights fit into 22 bits
+constexpr int WEIGHT_ONE = 1 << WEIGHT_BITS;
+constexpr int ROUND = 1 << (2 * WEIGHT_BITS - 1);
+
+inline std::uint8_t clampByte(int value) {
+    return static_cast<std::uint8_t>(std::min(255, std::max(0, value)));
+}
+
+// BT.601 limited range, same as OpenCV YUV conversions used by ImgFrame::getCvFrame
+inline void yuvToRgb(int y, int u, int v, std::uint8_t* rgb) {
+    const int c = 298 * (y - 16) + 128;
+    const int d = u - 128;
+    const int e = v - 128;
+    rgb[0] = clampByte((c + 409 * e) >> 8);
+    rgb[1] = clampByte((c - 100 * d - 208 * e) >> 8);
+    rgb[2] = clampByte((c + 516 * d) >> 8);
+}
+
+inline std::uint8_t rgbToY(int r, int g, int b) {
+    return clampByte(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+}
+
+inline std::uint8_t rgbToU(int r, int g, int b) {
+    return clampByte(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+}
+
+inline std::uint8_t rgbToV(int r, int g, int b) {
+    return clampByte(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+// Full range luma, same as OpenCV RGB to gray
+inline std::uint8_t rgbToGray(int r, int g, int b) {
+    return static_cast<std::uint8_t>((4899 * r + 9617 * g + 1868 * b + 8192) >> 14);
+}
+
+bool isGray(Type type) {
+    return type == Type::GRAY8 || type == Type::RAW8 || type == Type::YUV400p;
+}
+
+bool isYuv(Type type) {
+    return type == Type::NV12 || type == Type::NV21 || type == Type::YUV420p;
+}
+
+ColumnTable createColumnTable(int srcWidth, int dstWidth, int channels, double scale, double offset, Interpolation interpolation) {
+    ColumnTable table;
+    table.left.resize(dstWidth);
+    table.right.resize(dstWidth);
+    table.weight.resize(dstWidth);
+    for(int x = 0; x < dstWidth; x++) {
+        const double fx = std::min<double>(srcWidth - 1, std::max(0.0, scale * x + offset));
+        int x0 = 0;
+        int weight = 0;
+        if(interpolation == Interpolation::NEAREST) {
+            x0 = std::min(srcWidth - 1, static_cast<int>(fx + 0.5));
+        } else {
+            x0 = static_cast<int>(fx);
+            weight = static_cast<int>(std::lround((fx - x0) * WEIGHT_ONE));
+        }
+        table.left[x] = x0 * channels;
+        table.right[x] = std::min(x0 + 1, srcWidth - 1) * channels;
+        table.weight[x] = weight;
+    }
+    return table;
+}
+
+template <int C>
+void resizeNearest(const Plane& src, const Plane& dst, const ColumnTable& columns, double scaleY, double offsetY) {
+    for(int y = 0; y < dst.height; y++) {
+        const double fy = std::min<double>(src.height - 1, std::max(0.0, scaleY * y + offsetY));
+        const int sy = std::min(src.height - 1, static_cast<int>(fy + 0.5));
+        const std::uint8_t* s = src.data + static_cast<std::ptrdiff_t>(sy) * src.stride;
+        std::uint8_t* d = dst.data + static_cast<std::ptrdiff_t>(y) * dst.stride;
+        for(int x = 0; x < dst.width; x++) {
+            for(int c = 0; c < C; c++) d[x * C + c] = s[columns.left[x] + c];
+        }
+    }
+}
+
+template <int C>
+void interpolateRow(const std::uint8_t* s, const ColumnTable& columns, int width, int* row) {
+    for(int x = 0; x < width; x++) {
+        const int w1 = columns.weight[x];
+        const int w0 = WEIGHT_ONE - w1;
+        const std::uint8_t* p0 = s + columns.left[x];
+        const std::uint8_t* p1 = s + columns.right[x];
+        for(int c = 0; c < C; c++) row[x * C + c] = p0[c] * w0 + p1[c] * w1;
+    }
+}
+
+template <int C>
+void warpImpl(const Plane& src, const Plane& dst, const Matrix3& m, Interpolation interpolation, Border border, const std::uint8_t* fill) {
+    const bool affine = m[6] == 0.0 && m[7] == 0.0;
+    for(int y = 0; y < dst.height; y++) {
+        std::uint8_t* d = dst.data + static_cast<std::ptrdiff_t>(y) * dst.stride;
+        double X = m[1] * y + m[2];
+        double Y = m[4] * y + m[5];
+        double W = m[7] * y + m[8];
+        for(int x = 0; x < dst.width; x++, X += m[0], Y += m[3], W += m[6], d += C) {
+            double fx = X;
+            double fy = Y;
+            if(!affine) {
+                const double inv = W != 0.0 ? 1.0 / W : 0.0;
+                fx *= inv;
+                fy *= inv;
+            }
+
+            auto pixel = [&](int px, int py) -> const std::uint8_t* {
+                if(px < 0 || py < 0 || px >= src.width || py >= src.height) {
+                    if(border == Border::CONSTANT) return fill;
+                    px = std::min(src.width - 1, std::max(0, px));
+                    py = std::min(src.height - 1, std::max(0, py));
+                }
+                return src.data + static_cast<std::ptrdiff_t>(py) * src.stride + px * C;
+            };
+
+            if(interpolation == Interpolation::NEAREST) {
+                const auto* p = pixel(static_cast<int>(std::floor(fx + 0.5)), static_cast<int>(std::floor(fy + 0.5)));
+                for(int c = 0; c < C; c++) d[c] = p[c];
+                continue;
+            }
+
+            const double flx = std::floor(fx);
+            const double fly = std::floor(fy);
+            // Far outside, avoids overflow on conversion
+            if(flx < -2.0 || fly < -2.0 || flx > src.width + 1.0 || fly > src.height + 1.0) {
+                const auto* p = pixel(static_cast<int>(std::max(-1.0, std::min<double>(src.width, flx))),
+                                      static_cast<int>(std::max(-1.0, std::min<double>(src.height, fly))));
+                for(int c = 0; c < C; c++) d[c] = p[c];
+                continue;
+            }
+            const int x0 = static_cast<int>(flx);
+            const int y0 = static_cast<int>(fly);
+            const int wx1 = static_cast<int>((fx - flx) * WEIGHT_ONE + 0.5);
+            const int wy1 = static_cast<int>((fy - fly) * WEIGHT_ONE + 0.5);
+            const int wx0 = WEIGHT_ONE - wx1;
+            const int wy0 = WEIGHT_ONE - wy1;
+
+            const std::uint8_t *p00, *p01, *p10, *p11;
+            if(x0 >= 0 && y0 >= 0 && x0 + 1 < src.width && y0 + 1 < src.height) {
+                p00 = src.data + static_cast<std::ptrdiff_t>(y0) * src.stride + x0 * C;
+                p01 = p00 + C;
+                p10 = p00 + src.stride;
+                p11 = p10 + C;
+            } else {
+                p00 = pixel(x0, y0);
+                p01 = pixel(x0 + 1, y0);
+                p10 = pixel(x0, y0 + 1);
+                p11 = pixel(x0 + 1, y0 + 1);
+            }
+            for(int c = 0; c < C; c++) {
+                const int top = p00[c] * wx0 + p01[c] * wx1;
+                const int bottom = p10[c] * wx0 + p11[c] * wx1;
+                d[c] = static_cast<std::uint8_t>((top * wy0 + bottom * wy1 + ROUND) >> (2 * WEIGHT_BITS));
+            }
+        }
+    }
+}
+
+void copyPlane(const Plane& src, const Plane& dst) {
+    const std::size_t rowBytes = static_cast<std::size_t>(dst.width) * dst.channels;
+    for(int y = 0; y < dst.height; y++) {
+        std::memcpy(dst.data + static_cast<std::ptrdiff_t>(y) * dst.stride, src.data + static_cast<std::ptrdiff_t>(y) * src.stride, rowBytes);
+    }
+}
+
+// Chroma planes of a YUV image, as U and V pointers with a step between samples
+void getChroma(const Image& image, std::uint8_t*& u, std::uint8_t*& v, int& step, int& stride) {
+    const auto& planes = image.planes;
+    if(image.type == Type::YUV420p) {
+        u = planes[1].data;
+        v = planes[2].data;
+        step = 1;
+    } else {
+        u = planes[1].data + (image.type == Type::NV21 ? 1 : 0);
+        v = planes[1].data + (image.type == Type::NV21 ? 0 : 1);
+        step = 2;
+    }
+    stride = planes[1].stride;
+}
+
+void toRgb(const Image& src, std::uint8_t* rgb) {
+    const int w = src.width;
+    const int h = src.height;
+    const auto& planes = src.planes;
+    if(isGray(src.type)) {
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            std::uint8_t* d = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            for(int x = 0; x < w; x++) d[3 * x] = d[3 * x + 1] = d[3 * x + 2] = s[x];
+        }
+    } else if(src.type == Type::RGB888i || src.type == Type::BGR888i) {
+        const bool swap = src.type == Type::BGR888i;
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            std::uint8_t* d = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            if(!swap) {
+                std::memcpy(d, s, static_cast<std::size_t>(w) * 3);
+                continue;
+            }
+            for(int x = 0; x < w; x++) {
+                d[3 * x] = s[3 * x + 2];
+                d[3 * x + 1] = s[3 * x + 1];
+                d[3 * x + 2] = s[3 * x];
+            }
+        }
+    } else if(src.type == Type::RGB888p || src.type == Type::BGR888p) {
+        const bool swap = src.type == Type::BGR888p;
+        const auto& r = planes[swap ? 2 : 0];
+        const auto& g = planes[1];
+        const auto& b = planes[swap ? 0 : 2];
+        for(int y = 0; y < h; y++) {
+            const std::ptrdiff_t o = static_cast<std::ptrdiff_t>(y) * r.stride;
+            std::uint8_t* d = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            for(int x = 0; x < w; x++) {
+                d[3 * x] = r.data[o + x];
+                d[3 * x + 1] = g.data[o + x];
+                d[3 * x + 2] = b.data[o + x];
+            }
+        }
+    } else {
+        std::uint8_t *u, *v;
+        int step, stride;
+        getChroma(src, u, v, step, stride);
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            const std::ptrdiff_t co = static_cast<std::ptrdiff_t>(y / 2) * stride;
+            std::uint8_t* d = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            for(int x = 0; x < w; x++) yuvToRgb(s[x], u[co + (x / 2) * step], v[co + (x / 2) * step], d + 3 * x);
+        }
+    }
+}
+
+void fromRgb(const std::uint8_t* rgb, const Image& dst) {
+    const int w = dst.width;
+    const int h = dst.height;
+    const auto& planes = dst.planes;
+    if(isGray(dst.type)) {
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            std::uint8_t* d = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            for(int x = 0; x < w; x++) d[x] = rgbToGray(s[3 * x], s[3 * x + 1], s[3 * x + 2]);
+        }
+    } else if(dst.type == Type::RGB888i || dst.type == Type::BGR888i) {
+        const bool swap = dst.type == Type::BGR888i;
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            std::uint8_t* d = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            if(!swap) {
+                std::memcpy(d, s, static_cast<std::size_t>(w) * 3);
+                continue;
+            }
+            for(int x = 0; x < w; x++) {
+                d[3 * x] = s[3 * x + 2];
+                d[3 * x + 1] = s[3 * x + 1];
+                d[3 * x + 2] = s[3 * x];
+            }
+        }
+    } else if(dst.type == Type::RGB888p || dst.type == Type::BGR888p) {
+        const bool swap = dst.type == Type::BGR888p;
+        const auto& r = planes[swap ? 2 : 0];
+        const auto& g = planes[1];
+        const auto& b = planes[swap ? 0 : 2];
+        for(int y = 0; y < h; y++) {
+            const std::ptrdiff_t o = static_cast<std::ptrdiff_t>(y) * r.stride;
+            const std::uint8_t* s = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            for(int x = 0; x < w; x++) {
+                r.data[o + x] = s[3 * x];
+                g.data[o + x] = s[3 * x + 1];
+                b.data[o + x] = s[3 * x + 2];
+            }
+        }
+    } else {
+        std::uint8_t *u, *v;
+        int step, stride;
+        getChroma(dst, u, v, step, stride);
+        for(int y = 0; y < h; y++) {
+            const std::uint8_t* s = rgb + static_cast<std::ptrdiff_t>(y) * w * 3;
+            std::uint8_t* d = planes[0].data + static_cast<std::ptrdiff_t>(y) * planes[0].stride;
+            for(int x = 0; x < w; x++) d[x] = rgbToY(s[3 * x], s[3 * x + 1], s[3 * x + 2]);
+        }
+        // Chroma of each 2x2 block from its average color
+        for(int y = 0; y < h / 2; y++) {
+            const std::uint8_t* s0 = rgb + static_cast<std::ptrdiff_t>(2 * y) * w * 3;
+            const std::uint8_t* s1 = s0 + static_cast<std::ptrdiff_t>(w) * 3;
+            const std::ptrdiff_t co = static_cast<std::ptrdiff_t>(y) * stride;
+            for(int x = 0; x < w / 2; x++) {
+                int sum[3];
+                for(int c = 0; c < 3; c++) sum[c] = (s0[6 * x + c] + s0[6 * x + 3 + c] + s1[6 * x + c] + s1[6 * x + 3 + c] + 2) >> 2;
+                u[co + x * step] = rgbToU(sum[0], sum[1], sum[2]);
+                v[co + x * step] = rgbToV(sum[0], sum[1], sum[2]);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+bool isSupported(Type type) {
+    switch(type) {
+        case Type::GRAY8:
+        case Type::RAW8:
+        case Type::YUV400p:
+        case Type::RGB888i:
+        case Type::BGR888i:
+        case Type::RGB888p:
+        case Type::BGR888p:
+        case Type::NV12:
+        case Type::NV21:
+        case Type::YUV420p:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isSubsampled(Type type) {
+    return isYuv(type);
+}
+
+std::size_t getSize(Type type, int width, int height) {
+    const auto area = static_cast<std::size_t>(width) * height;
+    if(isGray(type)) return area;
+    if(isYuv(type)) return area + 2 * (static_cast<std::size_t>(width / 2) * (height / 2));
+    return area * 3;
+}
+
+Image wrap(Type type, int width, int height, std::uint8_t* data) {
+    if(!isSupported(type)) throw std::runtime_error(fmt::format("Image type {} isn't supported on host", static_cast<int>(type)));
+    Image image;
+    image.type = type;
+    image.width = width;
+    image.height = height;
+    const auto area = static_cast<std::ptrdiff_t>(width) * height;
+    if(isGray(type)) {
+        image.planes.push_back({data, width, height, width, 1});
+    } else if(type == Type::RGB888i || type == Type::BGR888i) {
+        image.planes.push_back({data, width, height, width * 3, 3});
+    } else if(type == Type::RGB888p || type == Type::BGR888p) {
+        for(int i = 0; i < 3; i++) image.planes.push_back({data + i * area, width, height, width, 1});
+    } else if(type == Type::YUV420p) {
+        const auto chroma = static_cast<std::ptrdiff_t>(width / 2) * (height / 2);
+        image.planes.push_back({data, width, height, width, 1});
+        image.planes.push_back({data + area, width / 2, height / 2, width / 2, 1});
+        image.planes.push_back({data + area + chroma, width / 2, height / 2, width / 2, 1});
+    } else {
+        image.planes.push_back({data, width, height, width, 1});
+        image.planes.push_back({data + area, width / 2, height / 2, (width / 2) * 2, 2});
+    }
+    return image;
+}
+
+std::vector<std::array<std::uint8_t, 3>> getFillValues(Type type, std::uint8_t red, std::uint8_t green, std::uint8_t blue) {
+    const std::uint8_t y = rgbToY(red, green, blue);
+    const std::uint8_t u = rgbToU(red, green, blue);
+    const std::uint8_t v = rgbToV(red, green, blue);
+    switch(type) {
+        case Type::RGB888i:
+            return {{red, green, blue}};
+        case Type::BGR888i:
+            return {{blue, green, red}};
+        case Type::RGB888p:
+            return {{red}, {green}, {blue}};
+        case Type::BGR888p:
+            return {{blue}, {green}, {red}};
+        case Type::NV12:
+            return {{y}, {u, v}};
+        case Type::NV21:
+            return {{y}, {v, u}};
+        case Type::YUV420p:
+            return {{y}, {u}, {v}};
+        default:
+            return {{rgbToGray(red, green, blue)}};
+    }
+}
+
+Matrix3 multiply(const Matrix3& a, const Matrix3& b) {
+    Matrix3 r{};
+    for(int i = 0; i < 3; i++) {
+        for(int j = 0; j < 3; j++) {
+            for(int k = 0; k < 3; k++) r[i * 3 + j] += a[i * 3 + k] * b[k * 3 + j];
+        }
+    }
+    return r;
+}
+
+bool invert(const Matrix3& m, Matrix3& inverse) {
+    const double c0 = m[4] * m[8] - m[5] * m[7];
+    const double c1 = m[5] * m[6] - m[3] * m[8];
+    const double c2 = m[3] * m[7] - m[4] * m[6];
+    const double det = m[0] * c0 + m[1] * c1 + m[2] * c2;
+    if(std::abs(det) < 1e-12) return false;
+    const double inv = 1.0 / det;
+    inverse = {c0 * inv,
+               (m[2] * m[7] - m[1] * m[8]) * inv,
+               (m[1] * m[5] - m[2] * m[4]) * inv,
+               c1 * inv,
+               (m[0] * m[8] - m[2] * m[6]) * inv,
+               (m[2] * m[3] - m[0] * m[5]) * inv,
+               c2 * inv,
+               (m[1] * m[6] - m[0] * m[7]) * inv,
+               (m[0] * m[4] - m[1] * m[3]) * inv};
+    return true;
+}
+
+bool getPerspectiveTransform(double width, double height, const std::array<double, 8>& points, Matrix3& transform) {
+    // Solves for h0..h7 (h8 = 1) with Gaussian elimination, two equations per corner
+    const double corners[8] = {0.0, 0.0, width, 0.0, width, height, 0.0, height};
+    double a[8][9] = {};
+    for(int i = 0; i < 4; i++) {
+        const double x = corners[2 * i];
+        const double y = corners[2 * i + 1];
+        const double u = points[2 * i];
+        const double v = points[2 * i + 1];
+        double* r0 = a[2 * i];
+        double* r1 = a[2 * i + 1];
+        r0[0] = x, r0[1] = y, r0[2] = 1.0, r0[6] = -x * u, r0[7] = -y * u, r0[8] = u;
+        r1[3] = x, r1[4] = y, r1[5] = 1.0, r1[6] = -x * v, r1[7] = -y * v, r1[8] = v;
+    }
+    for(int col = 0; col < 8; col++) {
+        int pivot = col;
+        for(int row = col + 1; row < 8; row++) {
+            if(std::abs(a[row][col]) > std::abs(a[pivot][col])) pivot = row;
+        }
+        if(std::abs(a[pivot][col]) < 1e-12) return false;
+        std::swap(a[col], a[pivot]);
+        for(int row = 0; row < 8; row++) {
+            if(row == col) continue;
+            const double factor = a[row][col] / a[col][col];
+            for(int k = col; k < 9; k++) a[row][k] -= factor * a[col][k];
+        }
+    }
+    for(int i = 0; i < 8; i++) transform[i] = a[i][8] / a[i][i];
+    transform[8] = 1.0;
+    return true;
+}
+
+RowResampler::RowResampler(const Plane& src, int dstWidth, double scaleX, double offsetX, double scaleY, double offsetY)
+    : src(src),
+      dstWidth(dstWidth),
+      scaleY(scaleY),
+      offsetY(offsetY),
+      columns(createColumnTable(src.width, dstWidth, src.channels, scaleX, offsetX, Interpolation::BILINEAR)) {
+    if(src.channels < 1 || src.channels > 3) throw std::invalid_argument("Unsupported number of channels");
+    const auto n = static_cast<std::size_t>(dstWidth) * src.channels;
+    rows[0].resize(n);
+    rows[1].resize(n);
+    result.resize(n);
+}
+
+void RowResampler::interpolate(int sy, int* row) const {
+    const std::uint8_t* s = src.data + static_cast<std::ptrdiff_t>(sy) * src.stride;
+    switch(src.channels) {
+        case 1:
+            interpolateRow<1>(s, columns, dstWidth, row);
+            break;
+        case 2:
+            interpolateRow<2>(s, columns, dstWidth, row);
+            break;
+        default:
+            interpolateRow<3>(s, columns, dstWidth, row);
+            break;
+    }
+}
+
+const int* RowResampler::getRow(int y) {
+    const double fy = std::min<double>(src.height - 1, std::max(0.0, scaleY * y + offsetY));
+    const int y0 = static_cast<int>(fy);
+    const int y1 = std::min(y0 + 1, src.height - 1);
+    const int w1 = static_cast<int>(std::lround((fy - y0) * WEIGHT_ONE));
+    const int w0 = WEIGHT_ONE - w1;
+
+    // Reuse rows of the previous destination row, common when upscaling
+    if(cached[0] != y0) {
+        if(cached[1] == y0) {
+            std::swap(rows[0], rows[1]);
+            std::swap(cached[0], cached[1]);
+        } else {
+            interpolate(y0, rows[0].data());
+            cached[0] = y0;
+        }
+    }
+    if(cached[1] != y1) {
+        interpolate(y1, rows[1].data());
+        cached[1] = y1;
+    }
+
+    const int* r0 = rows[0].data();
+    const int* r1 = rows[1].data();
+    int* r = result.data();
+    const auto n = result.size();
+    for(std::size_t i = 0; i < n; i++) r[i] = r0[i] * w0 + r1[i] * w1;
+    return r;
+}
+
+void resize(const Plane& src, const Plane& dst, double scaleX, double offsetX, double scaleY, double offsetY, Interpolation interpolation) {
+    if(src.channels != dst.channels) throw std::invalid_argument("Number of channels of source and destination must match");
+    if(dst.width <= 0 || dst.height <= 0) return;
+    if(interpolation == Interpolation::BILINEAR) {
+        RowResampler resampler(src, dst.width, scaleX, offsetX, scaleY, offsetY);
+        const int n = dst.width * dst.channels;
+        for(int y = 0; y < dst.height; y++) {
+            const int* row = resampler.getRow(y);
+            std::uint8_t* d = dst.data + static_cast<std::ptrdiff_t>(y) * dst.stride;
+            for(int i = 0; i < n; i++) d[i] = static_cast<std::uint8_t>((row[i] + ROUND) >> (2 * WEIGHT_BITS));
+        }
+        return;
+    }
+    const auto columns = createColumnTable(src.width, dst.width, src.channels, scaleX, offsetX, interpolation);
+    switch(src.channels) {
+        case 1:
+            resizeNearest<1>(src, dst, columns, scaleY, offsetY);
+            break;
+        case 2:
+            resizeNearest<2>(src, dst, columns, scaleY, offsetY);
+            break;
+        case 3:
+            resizeNearest<3>(src, dst, columns, scaleY, offsetY);
+            break;
+        default:
+            throw std::invalid_argument("Unsupported number of channels");
+    }
+}
+
+void warp(const Plane& src, const Plane& dst, const Matrix3& transform, Interpolation interpolation, Border border, const std::uint8_t* fill) {
+    if(src.channels != dst.channels) throw std::invalid_argument("Number of channels of source and destination must match");
+    Matrix3 m = transform;
+    // Normalized, so affine transforms skip the division
+    if(m[8] != 0.0) {
+        for(auto& v : m) v /= transform[8];
+    }
+    switch(src.channels) {
+        case 1:
+            warpImpl<1>(src, dst, m, interpolation, border, fill);
+            break;
+        case 2:
+            warpImpl<2>(src, dst, m, interpolation, border, fill);
+            break;
+        case 3:
+            warpImpl<3>(src, dst, m, interpolation, border, fill);
+            break;
+        default:
+            throw std::invalid_argument("Unsupported number of channels");
+    }
+}
+
+void fill(const Plane& dst, const std::uint8_t* value) {
+    for(int y = 0; y < dst.height; y++) {
+        std::uint8_t* d = dst.data + static_cast<std::ptrdiff_t>(y) * dst.stride;
+        if(dst.channels == 1) {
+            std::memset(d, value[0], static_cast<std::size_t>(dst.width));
+            continue;
+        }
+        for(int x = 0; x < dst.width; x++) {
+            for(int c = 0; c < dst.channels; c++) d[x * dst.channels + c] = value[c];
+        }
+    }
+}
+
+void convert(const Image& src, const Image& dst, std::vector<std::uint8_t>& scratch) {
+    if(src.width != dst.width || src.height != dst.height) throw std::invalid_argument("Converted images must be of the same size");
+    if(src.type == dst.type) {
+        for(std::size_t i = 0; i < src.planes.size(); i++) copyPlane(src.planes[i], dst.planes[i]);
+        return;
+    }
+    // Luma is kept as is
+    if(isGray(dst.type) && (isGray(src.type) || isYuv(src.type))) {
+        copyPlane(src.planes[0], dst.planes[0]);
+        return;
+    }
+    if(isYuv(src.type) && isYuv(dst.type)) {
+        copyPlane(src.planes[0], dst.planes[0]);
+        std::uint8_t *su, *sv, *du, *dv;
+        int sstep, sstride, dstep, dstride;
+        getChroma(src, su, sv, sstep, sstride);
+        getChroma(dst, du, dv, dstep, dstride);
+        for(int y = 0; y < dst.height / 2; y++) {
+            for(int x = 0; x < dst.width / 2; x++) {
+                du[y * dstride + x * dstep] = su[y * sstride + x * sstep];
+                dv[y * dstride + x * dstep] = sv[y * sstride + x * sstep];
+            }
+        }
+        return;
+    }
+    scratch.resize(static_cast<std::size_t>(src.width) * src.height * 3);
+    toRgb(src, scratch.data());
+    fromRgb(scratch.data(), dst);
+}
+
+void applyLut(const Plane& gray, const Plane& rgb, const std::array<std::array<std::uint8_t, 3>, 256>& lut) {
+    for(int y = 0; y < gray.height; y++) {
+        const std::uint8_t* s = gray.data + static_cast<std::ptrdiff_t>(y) * gray.stride;
+        std::uint8_t* d = rgb.data + static_cast<std::ptrdiff_t>(y) * rgb.stride;
+        for(int x = 0; x < gray.width; x++) {
+            const auto& color = lut[s[x]];
+            d[3 * x] = color[0];
+            d[3 * x + 1] = color[1];
+            d[3 * x + 2] = color[2];
+        }
+    }
+}
+
+}  // namespace image
+}  // namespace dai
@@ -0,0 +1,144 @@
+#pragma once
+
+// std
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// shared
+#include "depthai-shared/datatype/RawImgFrame.hpp"
+
+namespace dai {
+namespace image {
+
+/// View of an 8 bit plane with interleaved channels
+struct Plane {
+    std::uint8_t* data = nullptr;
+    int width = 0;
+    int height = 0;
+    /// Bytes between rows
+    int stride = 0;
+    int channels = 1;
+};
+
+/// View of a tightly packed image, planes in memory order
+struct Image {
+    RawImgFrame::Type type = RawImgFrame::Type::NONE;
+    int width = 0;
+    int height = 0;
+    std::vector<Plane> planes;
+};
+
+/// Row major 3x3 matrix
+using Matrix3 = std::array<double, 9>;
+
+enum class Interpolation { NEAREST, BILINEAR };
+enum class Border { CONSTANT, REPLICATE };
+
+/// Bits of fixed point interpolation weights. Bilinear values before rounding are scaled by 2^(2 * WEIGHT_BITS)
+constexpr int WEIGHT_BITS = 11;
+
+/// Source offsets (in bytes) of both horizontal neighbors and weight of the right one, for each destination column
+struct ColumnTable {
+    std::vector<int> left;
+    std::vector<int> right;
+    std::vector<int> weight;
+};
+
+/**
+ * Bilinear resampling of a plane row by row, without rounding back to 8 bits. Used by resize and by kernels which fuse
+ * further processing (conversion, normalization) into the same pass.
+ *
+ * Destination pixel (x, y) takes source pixel (scaleX * x + offsetX, scaleY * y + offsetY), clamped to the source.
+ * Horizontally interpolated source rows are cached, so each is computed once when moving down the destination.
+ */
+class RowResampler {
+   public:
+    RowResampler(const Plane& src, int dstWidth, double scaleX, double offsetX, double scaleY, double offsetY);
+
+    /**
+     * Gets a destination row as interleaved channel values scaled by 2^(2 * WEIGHT_BITS)
+     *
+     * @param y Destination row
+     * @returns dstWidth * channels values, valid until the next call
+     */
+    const int* getRow(int y);
+
+   private:
+    Plane src;
+    int dstWidth;
+    double scaleY;
+    double offsetY;
+    ColumnTable columns;
+    std::vector<int> rows[2];
+    int cached[2] = {-1, -1};
+    std::vector<int> result;
+
+    void interpolate(int sy, int* row) const;
+};
+
+/**
+ * Checks whether the type is supported by wrap, transform and convert
+ */
+bool isSupported(RawImgFrame::Type type);
+
+/**
+ * Gets whether planes after the first are subsampled by two in both directions (YUV 4:2:0 types)
+ */
+bool isSubsampled(RawImgFrame::Type type);
+
+/**
+ * Gets number of bytes of a tightly packed image
+ */
+std::size_t getSize(RawImgFrame::Type type, int width, int height);
+
+/**
+ * Describes planes of a tightly packed image, same layout as ImgFrame::getCvFrame expects
+ */
+Image wrap(RawImgFrame::Type type, int width, int height, std::uint8_t* data);
+
+/**
+ * Gets per plane fill values of an RGB color, converted to the image type
+ */
+std::vector<std::array<std::uint8_t, 3>> getFillValues(RawImgFrame::Type type, std::uint8_t red, std::uint8_t green, std::uint8_t blue);
+
+Matrix3 multiply(const Matrix3& a, const Matrix3& b);
+bool invert(const Matrix3& m, Matrix3& inverse);
+
+/**
+ * Computes homography mapping the four corners of a width x height rectangle (clockwise from top left) to given points
+ */
+bool getPerspectiveTransform(double width, double height, const std::array<double, 8>& points, Matrix3& transform);
+
+/**
+ * Resamples a plane, where each destination pixel (x, y) takes source pixel (scaleX * x + offsetX, scaleY * y + offsetY).
+ * Coordinates are clamped to the source, so it replicates borders
+ */
+void resize(const Plane& src, const Plane& dst, double scaleX, double offsetX, double scaleY, double offsetY, Interpolation interpolation);
+
+/**
+ * Resamples a plane, where each destination pixel takes the source pixel given by the homography (pixel index coordinates)
+ *
+ * @param fill Value of each channel for CONSTANT border
+ */
+void warp(const Plane& src, const Plane& dst, const Matrix3& transform, Interpolation interpolation, Border border, const std::uint8_t* fill);
+
+/**
+ * Fills a plane with the same value of each channel
+ */
+void fill(const Plane& dst, const std::uint8_t* value);
+
+/**
+ * Converts between supported types of the same size
+ *
+ * @param scratch Buffer for intermediate RGB, reused between calls
+ */
+void convert(const Image& src, const Image& dst, std::vector<std::uint8_t>& scratch);
+
+/**
+ * Maps gray values to RGB through a lookup table
+ */
+void applyLut(const Plane& gray, const Plane& rgb, const std::array<std::array<std::uint8_t, 3>, 256>& lut);
+
+}  // namespace image
+}  // namespace dai
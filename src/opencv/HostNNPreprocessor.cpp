@@ -0,0 +1,28 @@
+#include "depthai/host/HostNNPreprocessor.hpp"
+
+#include <stdexcept>
+
+namespace dai {
+
+HostNNPreprocessor::Source HostNNPreprocessor::getSource(const cv::Mat& frame) {
+    // Referenced in place, rows may be padded
+    if(frame.empty()) throw std::invalid_argument("HostNNPreprocessor - image is empty");
+    if(frame.type() != CV_8UC3 && frame.type() != CV_8UC1) throw std::invalid_argument("HostNNPreprocessor - image must be CV_8UC3 (BGR) or CV_8UC1");
+    Source src;
+    src.type = frame.type() == CV_8UC3 ? ImgFrame::Type::BGR888i : ImgFrame::Type::GRAY8;
+    src.data = frame.data;
+    src.width = frame.cols;
+    src.height = frame.rows;
+    src.stride = static_cast<int>(frame.step[0]);
+    return src;
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::process(const cv::Mat& frame, NNData& data, const std::string& layer) {
+    return run(getSource(frame), data, layer);
+}
+
+HostNNPreprocessor::Transform HostNNPreprocessor::process(const cv::Mat& frame, ImgFrame& output) {
+    return run(getSource(frame), output);
+}
+
+}  // namespace dai
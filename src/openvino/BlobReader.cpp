@@ -25,12 +25,12 @@ namespace dai {
 namespace {
 
 template <typename T>
-T readFromBlob(const std::vector<std::uint8_t>& blob, uint32_t& offset) {
-    if(offset + sizeof(T) > blob.size()) {
+T readFromBlob(const std::uint8_t* blob, std::size_t blobSize, uint32_t& offset) {
+    if(offset + sizeof(T) > blobSize) {
         throw std::length_error("BlobReader error: Filesize is less than blob specifies. Likely corrupted");
     }
 
-    auto srcPtr = blob.data() + offset;
+    auto srcPtr = blob + offset;
     offset += sizeof(T);
 
     return *reinterpret_cast<const T*>(srcPtr);
@@ -43,24 +43,28 @@ bool isIOShapeName(std::string name) {
 }  // namespace
 
 void BlobReader::parse(const std::vector<std::uint8_t>& blob) {
-    if(blob.empty() || blob.size() < sizeof(ElfN_Ehdr) + sizeof(mv_blob_header)) {
+    parse(blob.data(), blob.size());
+}
+
+void BlobReader::parse(const std::uint8_t* blob, std::size_t blobSize) {
+    if(blob == nullptr || blobSize < sizeof(ElfN_Ehdr) + sizeof(mv_blob_header)) {
         throw std::logic_error("BlobReader error: Blob is empty");
     }
 
-    pBlob = blob.data();
+    pBlob = blob;
 
-    blobHeader = *reinterpret_cast<const mv_blob_header*>(blob.data() + sizeof(ElfN_Ehdr));
+    blobHeader = *reinterpret_cast<const mv_blob_header*>(blob + sizeof(ElfN_Ehdr));
 
     if(blobHeader.magic_number != BLOB_MAGIC_NUMBER) {
         throw std::logic_error("BlobReader error: File does not seem to be a supported neural network blob");
     }
 
-    if(blob.size() < blobHeader.file_size) {
+    if(blobSize < blobHeader.file_size) {
         throw std::length_error("BlobReader error: Filesize is less than blob specifies. Likely corrupted");
     }
 
-    const auto readIO = [this, &blob](uint32_t& ioSectionOffset, uint32_t idx) {
-        auto ioIdx = readFromBlob<uint32_t>(blob, ioSectionOffset);
+    const auto readIO = [this, blob, blobSize](uint32_t& ioSectionOffset, uint32_t idx) {
+        auto ioIdx = readFromBlob<uint32_t>(blob, blobSize, ioSectionOffset);
         if(ioIdx != idx) {
             throw std::runtime_error(
                 fmt::format("BlobReader failed on I/O processing, its' ioIdx parameter (which is {}) is "
@@ -69,33 +73,33 @@ void BlobReader::parse(const std::vector<std::uint8_t>& blob) {
                             idx));
         }
 
-        auto ioBufferOffset = readFromBlob<int32_t>(blob, ioSectionOffset);
+        auto ioBufferOffset = readFromBlob<int32_t>(blob, blobSize, ioSectionOffset);
 
-        auto nameLength = readFromBlob<uint32_t>(blob, ioSectionOffset);
+        auto nameLength = readFromBlob<uint32_t>(blob, blobSize, ioSectionOffset);
         std::string ioName(nameLength, 0);
         for(auto& c : ioName) {
-            c = readFromBlob<char>(blob, ioSectionOffset);
+            c = readFromBlob<char>(blob, blobSize, ioSectionOffset);
         }
 
         // Truncate zeros
         ioName = ioName.c_str();
 
-        auto dataType = static_cast<TensorInfo::DataType>(readFromBlob<int32_t>(blob, ioSectionOffset));
-        auto orderCode = static_cast<TensorInfo::StorageOrder>(readFromBlob<uint32_t>(blob, ioSectionOffset));
+        auto dataType = static_cast<TensorInfo::DataType>(readFromBlob<int32_t>(blob, blobSize, ioSectionOffset));
+        auto orderCode = static_cast<TensorInfo::StorageOrder>(readFromBlob<uint32_t>(blob, blobSize, ioSectionOffset));
 
-        auto numDims = readFromBlob<uint32_t>(blob, ioSectionOffset);
+        auto numDims = readFromBlob<uint32_t>(blob, blobSize, ioSectionOffset);
 
         // ignore
-        readFromBlob<int32_t>(blob, ioSectionOffset);
+        readFromBlob<int32_t>(blob, blobSize, ioSectionOffset);
 
-        auto dimsOffset = blobHeader.const_data_section_offset + readFromBlob<uint32_t>(blob, ioSectionOffset);
+        auto dimsOffset = blobHeader.const_data_section_offset + readFromBlob<uint32_t>(blob, blobSize, ioSectionOffset);
 
         // Skip strides' location and offset
         ioSectionOffset += 2 * sizeof(uint32_t);
 
         std::vector<unsigned> dims;
         for(unsigned i = 0; i < numDims; ++i) {
-            dims.push_back(readFromBlob<uint32_t>(blob, dimsOffset));
+            dims.push_back(readFromBlob<uint32_t>(blob, blobSize, dimsOffset));
         }
 
         TensorInfo io;
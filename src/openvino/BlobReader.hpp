@@ -20,6 +20,7 @@ public:
     BlobReader() = default;
 
     void parse(const std::vector<std::uint8_t>& blob);
+    void parse(const std::uint8_t* blob, std::size_t blobSize);
 
     const std::unordered_map<std::string, TensorInfo>& getNetworkInputs() const { return networkInputs; }
     const std::unordered_map<std::string, TensorInfo>& getNetworkOutputs() const { return networkOutputs; }
@@ -180,7 +180,20 @@ OpenVINO::Blob::Blob(const dai::Path& path) {
         // TODO(themarpe) - Unify exceptions into meaningful groups
         throw std::runtime_error(fmt::format("Cannot load blob, file at path {} doesn't exist.", path));
     }
-    blobInit(*this, std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {}));
+    // Read the whole file at once, into a buffer of its size
+    stream.seekg(0, std::ios::end);
+    const auto size = stream.tellg();
+    // Checked readable before allocating, as the size of e.g. a directory is bogus
+    stream.seekg(0, std::ios::beg);
+    if(!stream || size < 0 || (size > 0 && stream.peek() == std::ifstream::traits_type::eof())) {
+        throw std::runtime_error(fmt::format("Cannot load blob, couldn't retrieve size of file at path {}.", path));
+    }
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+    stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if(!stream || stream.gcount() != static_cast<std::streamsize>(data.size())) {
+        throw std::runtime_error(fmt::format("Cannot load blob, couldn't read file at path {}.", path));
+    }
+    blobInit(*this, std::move(data));
 }
 
 }  // namespace dai
@@ -1,10 +1,14 @@
 #include "depthai/pipeline/AssetManager.hpp"
 
 #include "spdlog/fmt/fmt.h"
+#include "utility/MappedFile.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 // std
-#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
 
 namespace dai {
 
@@ -12,6 +16,137 @@ std::string Asset::getRelativeUri() {
     return fmt::format("{}:{}", "asset", key);
 }
 
+const std::uint8_t* Asset::getData() const {
+    return mapped ? mapped.get() : data.data();
+}
+
+std::size_t Asset::getSize() const {
+    return mapped ? mappedSize : data.size();
+}
+
+AssetStorage::Hash AssetStorage::hash(const std::uint8_t* data, std::size_t size) {
+    // 64bit multiply-rotate hash over 8B words, fast enough to hash large blobs on every pipeline start
+    constexpr Hash PRIME1 = 0x9E3779B185EBCA87ULL;
+    constexpr Hash PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+    auto rotl = [](Hash x, int r) { return (x << r) | (x >> (64 - r)); };
+
+    Hash h = PRIME1 ^ static_cast<Hash>(size);
+    std::size_t i = 0;
+    for(; i + sizeof(Hash) <= size; i += sizeof(Hash)) {
+        Hash word;
+        std::memcpy(&word, data + i, sizeof(word));
+        h ^= rotl(word * PRIME2, 31) * PRIME1;
+        h = rotl(h, 27) * PRIME1 + PRIME2;
+    }
+    for(; i < size; i++) {
+        h ^= data[i] * PRIME1;
+        h = rotl(h, 11) * PRIME2;
+    }
+
+    // Final mixing
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME1;
+    h ^= h >> 32;
+    return h;
+}
+
+std::size_t AssetStorage::add(std::shared_ptr<const Asset> asset) {
+    const auto* data = asset->getData();
+    const auto size = asset->getSize();
+    const auto alignment = std::max<std::uint32_t>(asset->alignment, 1);
+    const auto contentHash = hash(data, size);
+
+    // Reuse identical data, if it is aligned suitably for this asset as well
+    auto& sameHash = chunksByHash[contentHash];
+    for(auto index : sameHash) {
+        const auto& chunk = chunks[index];
+        if(chunk.asset->getSize() != size || chunk.offset % alignment != 0) continue;
+        if(size > 0 && std::memcmp(chunk.asset->getData(), data, size) != 0) continue;
+        deduplicatedSize += size;
+        return chunk.offset;
+    }
+
+    // calculate additional bytes needed to offset to alignment
+    std::size_t offset = storageSize;
+    if(offset % alignment != 0) {
+        offset += alignment - (offset % alignment);
+    }
+    storageSize = offset + size;
+    sameHash.push_back(chunks.size());
+    chunks.push_back({offset, std::move(asset), contentHash});
+    return offset;
+}
+
+const std::vector<AssetStorage::Chunk>& AssetStorage::getChunks() const {
+    return chunks;
+}
+
+std::size_t AssetStorage::size() const {
+    return storageSize;
+}
+
+bool AssetStorage::empty() const {
+    return storageSize == 0;
+}
+
+void AssetStorage::write(std::size_t maxSize, const std::function<void(const std::uint8_t*, std::size_t)>& writer) const {
+    write(maxSize, writer, nullptr);
+}
+
+void AssetStorage::write(std::size_t maxSize,
+                         const std::function<void(const std::uint8_t*, std::size_t)>& writer,
+                         const std::function<bool(const Chunk&)>& skip) const {
+    if(maxSize == 0) throw std::invalid_argument("AssetStorage - maximum piece size must be greater than 0");
+
+    // Piece being assembled across chunk boundaries and padding
+    std::vector<std::uint8_t> buffer;
+    // Appends data, or zero padding if data is nullptr
+    auto append = [&](const std::uint8_t* data, std::size_t size) {
+        while(size > 0) {
+            if(buffer.empty() && data != nullptr && size >= maxSize) {
+                writer(data, maxSize);
+                data += maxSize;
+                size -= maxSize;
+                continue;
+            }
+            auto toAdd = std::min(size, maxSize - buffer.size());
+            if(data != nullptr) {
+                buffer.insert(buffer.end(), data, data + toAdd);
+                data += toAdd;
+            } else {
+                buffer.insert(buffer.end(), toAdd, 0);
+            }
+            size -= toAdd;
+            if(buffer.size() == maxSize) {
+                writer(buffer.data(), buffer.size());
+                buffer.clear();
+            }
+        }
+    };
+
+    std::size_t position = 0;
+    for(const auto& chunk : chunks) {
+        append(nullptr, chunk.offset - position);
+        if(!skip || !skip(chunk)) append(chunk.asset->getData(), chunk.asset->getSize());
+        position = chunk.offset + chunk.asset->getSize();
+    }
+    if(!buffer.empty()) writer(buffer.data(), buffer.size());
+}
+
+std::size_t AssetStorage::getDeduplicatedSize() const {
+    return deduplicatedSize;
+}
+
+std::vector<std::uint8_t> AssetStorage::toVector() const {
+    std::vector<std::uint8_t> storage(storageSize, 0);
+    for(const auto& chunk : chunks) {
+        if(chunk.asset->getSize() > 0) std::memcpy(&storage[chunk.offset], chunk.asset->getData(), chunk.asset->getSize());
+    }
+    return storage;
+}
+
 std::shared_ptr<dai::Asset> AssetManager::set(Asset asset) {
     std::string key = asset.key;
     assetMap[key] = std::make_shared<Asset>(std::move(asset));
@@ -23,22 +158,50 @@ std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, Asset asse
     Asset a(key);
     a.data = std::move(asset.data);
     a.alignment = asset.alignment;
+    a.mapped = std::move(asset.mapped);
+    a.mappedSize = asset.mappedSize;
     return set(std::move(a));
 }
 
-std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, const dai::Path& path, int alignment) {
-    // Load binary file at path
-    std::ifstream stream(path, std::ios::in | std::ios::binary);
-    if(!stream.is_open()) {
-        // Throw an error
+static std::shared_ptr<MappedFile> mapAssetFile(const dai::Path& path) {
+    try {
+        return std::make_shared<MappedFile>(path);
+    } catch(const std::system_error& ex) {
+        // Throw an error. Only opening the file throws std::system_error, mapping failures keep their own message
         // TODO(themarpe) - Unify exceptions into meaningful groups
-        throw std::runtime_error(fmt::format("Cannot load asset, file at path {} doesn't exist.", path));
+        throw std::system_error(ex.code(), fmt::format("Cannot load asset, file at path {} doesn't exist.", path));
     }
+}
+
+std::shared_ptr<dai::Asset> AssetManager::set(const std::string& key, const dai::Path& path, int alignment) {
+    // Load binary file at path, copying it from the mapping in a single pass
+    auto mapping = mapAssetFile(path);
 
     // Create an asset
     Asset binaryAsset(key);
     binaryAsset.alignment = alignment;
-    binaryAsset.data = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
+    binaryAsset.data = std::vector<std::uint8_t>(mapping->data(), mapping->data() + mapping->size());
+    // Store asset
+    return set(std::move(binaryAsset));
+}
+
+std::shared_ptr<dai::Asset> AssetManager::setMapped(const std::string& key, const dai::Path& path, int alignment) {
+    // Files smaller than this are copied into memory instead of keeping them mapped
+    constexpr std::size_t MAPPING_THRESHOLD = 1024 * 1024;
+
+    // Map binary file at path
+    auto mapping = mapAssetFile(path);
+
+    // Create an asset
+    Asset binaryAsset(key);
+    binaryAsset.alignment = alignment;
+    if(mapping->size() >= MAPPING_THRESHOLD) {
+        // Asset keeps the mapping alive
+        binaryAsset.mapped = std::shared_ptr<const std::uint8_t>(mapping, mapping->data());
+        binaryAsset.mappedSize = mapping->size();
+    } else {
+        binaryAsset.data = std::vector<std::uint8_t>(mapping->data(), mapping->data() + mapping->size());
+    }
     // Store asset
     return set(std::move(binaryAsset));
 }
@@ -127,10 +290,18 @@ void AssetManager::serialize(AssetsMutable& mutableAssets, std::vector<std::uint
         storage.resize(storage.size() + toAdd);
 
         // copy data
-        storage.insert(storage.end(), a.data.begin(), a.data.end());
+        storage.insert(storage.end(), a.getData(), a.getData() + a.getSize());
 
         // Add to map the currently added asset
-        mutableAssets.set(prefix + a.key, offset, static_cast<uint32_t>(a.data.size()), a.alignment);
+        mutableAssets.set(prefix + a.key, offset, static_cast<uint32_t>(a.getSize()), a.alignment);
+    }
+}
+
+void AssetManager::serialize(AssetsMutable& mutableAssets, AssetStorage& storage, std::string prefix) const {
+    for(auto& kv : assetMap) {
+        auto& a = *kv.second;
+        auto offset = storage.add(kv.second);
+        mutableAssets.set(prefix + a.key, static_cast<uint32_t>(offset), static_cast<uint32_t>(a.getSize()), a.alignment);
     }
 }
 
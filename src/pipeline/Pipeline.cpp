@@ -84,11 +84,17 @@ std::vector<std::shared_ptr<Node>> PipelineImpl::getAllNodes() {
 }
 
 void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, std::vector<std::uint8_t>& assetStorage, SerializationType type) const {
+    AssetStorage storage;
+    serialize(schema, assets, storage, type);
+    assetStorage = storage.toVector();
+}
+
+void PipelineImpl::serialize(PipelineSchema& schema, Assets& assets, AssetStorage& assetStorage, SerializationType type) const {
     // Set schema
     schema = getPipelineSchema(type);
 
     // Serialize all asset managers into asset storage
-    assetStorage.clear();
+    assetStorage = {};
     AssetsMutable mutableAssets;
     // Pipeline assets
     assetManager.serialize(mutableAssets, assetStorage, "/pipeline/");
@@ -297,7 +303,7 @@ void PipelineImpl::setCameraTuningBlobPath(const dai::Path& path) {
     auto asset = assetManager.set(assetKey, path);
 
     globalProperties.cameraTuningBlobUri = asset->getRelativeUri();
-    globalProperties.cameraTuningBlobSize = static_cast<uint32_t>(asset->data.size());
+    globalProperties.cameraTuningBlobSize = static_cast<uint32_t>(asset->getSize());
 }
 
 void PipelineImpl::setXLinkChunkSize(int sizeBytes) {
@@ -134,6 +134,10 @@ NNData& NNData::setLayer(const std::string& name, std::vector<double> data) {
     }
     return *this;
 }
+NNData& NNData::setLayerFp16(const std::string& name, std::vector<std::uint16_t> data) {
+    fp16Data[name] = std::move(data);
+    return *this;
+}
 
 // getters
 std::vector<std::string> NNData::getAllLayerNames() const {
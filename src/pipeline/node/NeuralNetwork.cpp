@@ -1,7 +1,11 @@
 #include "depthai/pipeline/node/NeuralNetwork.hpp"
 
+#include <system_error>
+
 #include "depthai/pipeline/Pipeline.hpp"
 #include "openvino/BlobReader.hpp"
+#include "spdlog/fmt/fmt.h"
+#include "utility/spdlog-fmt.hpp"
 
 namespace dai {
 namespace node {
@@ -24,7 +28,29 @@ tl::optional<OpenVINO::Version> NeuralNetwork::getRequiredOpenVINOVersion() {
 
 // Specify local filesystem path to load the blob (which gets loaded at loadAssets)
 void NeuralNetwork::setBlobPath(const dai::Path& path) {
-    setBlob(OpenVINO::Blob(path));
+    // Large blobs stay memory mapped until transferred to the device, only the header is parsed here
+    auto previous = assetManager.get("__blob");
+    std::shared_ptr<Asset> asset;
+    try {
+        asset = assetManager.setMapped("__blob", path);
+    } catch(const std::system_error&) {
+        // File couldn't be opened, other failures like mapping keep their own message
+        // TODO(themarpe) - Unify exceptions into meaningful groups
+        throw std::runtime_error(fmt::format("Cannot load blob, file at path {} doesn't exist.", path));
+    }
+
+    BlobReader reader;
+    try {
+        reader.parse(asset->getData(), asset->getSize());
+    } catch(const std::exception&) {
+        // Keep the previous blob
+        assetManager.remove("__blob");
+        if(previous) assetManager.addExisting({previous});
+        throw;
+    }
+    networkOpenvinoVersion = OpenVINO::getBlobVersion(reader.getVersionMajor(), reader.getVersionMinor());
+    properties.blobUri = asset->getRelativeUri();
+    properties.blobSize = static_cast<uint32_t>(asset->getSize());
 }
 
 void NeuralNetwork::setBlob(const dai::Path& path) {
@@ -35,7 +61,7 @@ void NeuralNetwork::setBlob(OpenVINO::Blob blob) {
     networkOpenvinoVersion = blob.version;
     auto asset = assetManager.set("__blob", std::move(blob.data));
     properties.blobUri = asset->getRelativeUri();
-    properties.blobSize = static_cast<uint32_t>(asset->data.size());
+    properties.blobSize = static_cast<uint32_t>(asset->getSize());
 }
 
 void NeuralNetwork::setNumPoolFrames(int numFrames) {
@@ -0,0 +1,110 @@
+#include "Compression.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// libraries
+#include "zlib.h"
+
+namespace dai {
+namespace utility {
+
+// Size of deflate window, the most a block can refer back to
+constexpr static std::size_t DICTIONARY_SIZE = 32 * 1024;
+
+// Deflates a block into raw deflate data. Non-last blocks end byte aligned and without the final bit, so blocks can be concatenated
+static std::vector<std::uint8_t> deflateBlock(
+    const std::uint8_t* dictionary, std::size_t dictionarySize, const std::uint8_t* data, std::size_t size, int level, bool last) {
+    z_stream stream = {};
+    // Negative window bits produce raw deflate data, without zlib header and trailer
+    if(deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw std::runtime_error("Couldn't initialize deflate");
+    }
+    if(dictionarySize > 0 && deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize)) != Z_OK) {
+        deflateEnd(&stream);
+        throw std::runtime_error("Couldn't set deflate dictionary");
+    }
+
+    // Room for the worst case plus the empty stored block of a sync flush
+    std::vector<std::uint8_t> out(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    int ret = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    auto produced = out.size() - stream.avail_out;
+    deflateEnd(&stream);
+    if((last && ret != Z_STREAM_END) || (!last && ret != Z_OK) || stream.avail_in != 0) {
+        throw std::runtime_error("Error while deflating block: " + std::to_string(ret));
+    }
+
+    out.resize(produced);
+    return out;
+}
+
+std::vector<std::uint8_t> deflateParallel(const std::uint8_t* data, std::size_t size, int level, std::size_t blockSize, unsigned numThreads) {
+    if(level < 0 || level > 9) throw std::invalid_argument("Compression level must be between 0 and 9");
+    // Keeps block sizes within the range of a single deflate call
+    blockSize = std::min<std::size_t>(std::max<std::size_t>(blockSize, DICTIONARY_SIZE), 256 * 1024 * 1024);
+
+    const std::size_t numBlocks = std::max<std::size_t>(1, (size + blockSize - 1) / blockSize);
+    std::vector<std::vector<std::uint8_t>> blocks(numBlocks);
+    std::vector<uLong> checksums(numBlocks);
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::string error;
+    auto worker = [&]() {
+        for(std::size_t i = next++; i < numBlocks && !failed; i = next++) {
+            const auto offset = i * blockSize;
+            const auto length = std::min(blockSize, size - offset);
+            const auto dictionarySize = std::min(offset, DICTIONARY_SIZE);
+            try {
+                blocks[i] = deflateBlock(data + offset - dictionarySize, dictionarySize, data + offset, length, level, i == numBlocks - 1);
+                checksums[i] = adler32(adler32(0L, Z_NULL, 0), data + offset, static_cast<uInt>(length));
+            } catch(const std::exception& ex) {
+                if(!failed.exchange(true)) error = ex.what();
+            }
+        }
+    };
+
+    if(numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    numThreads = static_cast<unsigned>(std::min<std::size_t>(numThreads, numBlocks));
+    std::vector<std::thread> threads;
+    for(unsigned t = 1; t < numThreads; t++) threads.emplace_back(worker);
+    worker();
+    for(auto& thread : threads) thread.join();
+    if(failed) throw std::runtime_error(error);
+
+    // Header for 32KiB window, FLEVEL and check bits as zlib writes them
+    const int flevel = level >= 7 ? 3 : (level >= 6 ? 2 : (level >= 2 ? 1 : 0));
+    std::uint16_t header = (0x78 << 8) | (flevel << 6);
+    header += 31 - (header % 31);
+
+    std::size_t total = 2 + 4;
+    for(const auto& block : blocks) total += block.size();
+    std::vector<std::uint8_t> out;
+    out.reserve(total);
+    out.push_back(static_cast<std::uint8_t>(header >> 8));
+    out.push_back(static_cast<std::uint8_t>(header & 0xFF));
+
+    // Concatenate blocks and combine their checksums
+    uLong checksum = adler32(0L, Z_NULL, 0);
+    for(std::size_t i = 0; i < numBlocks; i++) {
+        out.insert(out.end(), blocks[i].begin(), blocks[i].end());
+        const auto length = std::min(blockSize, size - std::min(size, i * blockSize));
+        checksum = adler32_combine(checksum, checksums[i], static_cast<z_off_t>(length));
+        std::vector<std::uint8_t>().swap(blocks[i]);
+    }
+
+    // Adler-32 trailer, big endian
+    for(int shift = 24; shift >= 0; shift -= 8) out.push_back(static_cast<std::uint8_t>((checksum >> shift) & 0xFF));
+    return out;
+}
+
+}  // namespace utility
+}  // namespace dai
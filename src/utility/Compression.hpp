@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dai {
+namespace utility {
+
+/**
+ * Compresses data into a single zlib stream, deflating blocks of input on multiple threads (as pigz does).
+ * Each block is primed with the preceding 32KiB of input, so the ratio stays close to single threaded compression.
+ * Output can be decompressed by any zlib inflate, e.g. uncompress().
+ *
+ * @param data Data to compress
+ * @param size Size of data
+ * @param level Compression level, 0 - 9
+ * @param blockSize Amount of input compressed by a single thread at a time
+ * @param numThreads Number of threads to use, 0 uses all hardware threads
+ * @returns zlib stream
+ */
+std::vector<std::uint8_t> deflateParallel(
+    const std::uint8_t* data, std::size_t size, int level, std::size_t blockSize = 512 * 1024, unsigned numThreads = 0);
+
+}  // namespace utility
+}  // namespace dai
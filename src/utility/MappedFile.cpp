@@ -0,0 +1,95 @@
+#include "MappedFile.hpp"
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+#include "utility/spdlog-fmt.hpp"
+
+// Platform specific
+#if defined(_WIN32)
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace dai {
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const dai::Path& path) {
+    HANDLE file = CreateFileW(path.native().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE) {
+        // Taken before formatting the message can change it
+        const auto error = static_cast<int>(GetLastError());
+        throw std::system_error(error, std::system_category(), fmt::format("Couldn't open file {}", path));
+    }
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        throw std::runtime_error(fmt::format("Couldn't retrieve size of file {}", path));
+    }
+    length = static_cast<std::size_t>(fileSize.QuadPart);
+    if(length == 0) return;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+        CloseHandle(file);
+        throw std::runtime_error(fmt::format("Couldn't map file {}", path));
+    }
+    mappingHandle = mapping;
+
+    ptr = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if(ptr == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error(fmt::format("Couldn't map file {}", path));
+    }
+}
+
+MappedFile::~MappedFile() {
+    if(ptr != nullptr) UnmapViewOfFile(ptr);
+    if(mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if(fileHandle != nullptr) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const dai::Path& path) {
+    int fd = open(path.native().c_str(), O_RDONLY);
+    if(fd < 0) {
+        // Taken before formatting the message can change it
+        const int error = errno;
+        throw std::system_error(error, std::generic_category(), fmt::format("Couldn't open file {}", path));
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error(fmt::format("Couldn't retrieve size of file {}", path));
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if(length == 0) {
+        close(fd);
+        return;
+    }
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    // Mapping stays valid after the descriptor is closed
+    close(fd);
+    if(mapped == MAP_FAILED) throw std::runtime_error(fmt::format("Couldn't map file {}", path));
+    ptr = static_cast<const std::uint8_t*>(mapped);
+}
+
+MappedFile::~MappedFile() {
+    if(ptr != nullptr) munmap(const_cast<std::uint8_t*>(ptr), length);
+}
+
+#endif
+
+}  // namespace dai
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "depthai/utility/Path.hpp"
+
+namespace dai {
+
+/**
+ * Read only memory mapping of a whole file
+ */
+class MappedFile {
+   public:
+    /**
+     * Maps the file at given path. Throws std::system_error if the file can't be opened, std::runtime_error on other failures
+     */
+    explicit MappedFile(const dai::Path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const std::uint8_t* data() const {
+        return ptr;
+    }
+    std::size_t size() const {
+        return length;
+    }
+
+   private:
+    const std::uint8_t* ptr = nullptr;
+    std::size_t length = 0;
+#if defined(_WIN32)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+}  // namespace dai
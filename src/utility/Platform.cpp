@@ -18,7 +18,10 @@
 #endif
 
 #ifndef _WIN32
+    #include <sys/stat.h>
     #include <unistd.h>
+
+    #include <cerrno>
 #endif
 
 namespace dai {
@@ -75,5 +78,20 @@ std::string getTempPath() {
     return tmpPath;
 }
 
+bool createDirectories(const std::string& path) {
+    // Create each parent in turn, existing ones are skipped
+    for(std::size_t pos = 0; pos != std::string::npos;) {
+        pos = path.find_first_of("/\\", pos + 1);
+        auto dir = path.substr(0, pos);
+        if(dir.empty() || dir.back() == ':') continue;
+#if defined(_WIN32) || defined(__USE_W32_SOCKETS)
+        if(!CreateDirectoryA(dir.c_str(), nullptr) && GetLastError() != ERROR_ALREADY_EXISTS) return false;
+#else
+        if(mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) return false;
+#endif
+    }
+    return true;
+}
+
 }  // namespace platform
 }  // namespace dai
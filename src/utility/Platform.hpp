@@ -9,6 +9,7 @@ namespace platform {
 uint32_t getIPv4AddressAsBinary(std::string address);
 std::string getIPv4AddressAsString(std::uint32_t binary);
 std::string getTempPath();
+bool createDirectories(const std::string& path);
 
 }  // namespace platform
 }  // namespace dai
@@ -1,11 +1,12 @@
 #include "Resources.hpp"
 
-#include <array>
 #include <cassert>
-#include <condition_variable>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <thread>
+#include <unordered_set>
 
 // libarchive
 #include "archive.h"
@@ -24,6 +25,8 @@
 
 // project
 #include "utility/Environment.hpp"
+#include "utility/MappedFile.hpp"
+#include "utility/Platform.hpp"
 #include "utility/spdlog-fmt.hpp"
 
 extern "C" {
@@ -53,113 +56,219 @@ constexpr static auto DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH = "depthai-device-o
 constexpr static auto DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH = "depthai-device-openvino-2021.2-" DEPTHAI_DEVICE_VERSION ".patch";
 constexpr static auto DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH = "depthai-device-openvino-2021.3-" DEPTHAI_DEVICE_VERSION ".patch";
 
-// Creates std::array without explicitly needing to state the size
-template <typename V, typename... T>
-static constexpr auto array_of(T&&... t) -> std::array<V, sizeof...(T)> {
-    return {{std::forward<T>(t)...}};
+// Optional on-disk cache of extracted resources, shared between processes
+static std::string getResourceCacheDir(const std::string& archiveName, const std::uint8_t* archive, std::size_t archiveSize) {
+    auto cacheRoot = utility::getEnv("DEPTHAI_RESOURCE_CACHE_DIR");
+    if(cacheRoot.empty()) return {};
+
+    // Keyed by archive name, which includes the version, and its checksum
+    auto stem = archiveName.substr(0, archiveName.rfind(".tar.xz"));
+    auto cacheDir = fmt::format("{}/{}-{:08x}", cacheRoot, stem, utility::checksum(archive, archiveSize));
+    if(!platform::createDirectories(cacheDir)) {
+        logger::warn("Couldn't create resource cache directory {}", cacheDir);
+        return {};
+    }
+    return cacheDir;
 }
 
-constexpr static auto RESOURCE_LIST_DEVICE = array_of<const char*>(DEPTHAI_CMD_OPENVINO_UNIVERSAL_PATH,
-                                                                   DEPTHAI_CMD_OPENVINO_2020_4_PATCH_PATH,
-                                                                   DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH,
-                                                                   DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH,
-                                                                   DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH);
+static bool loadCachedResource(const std::string& cacheDir, const std::string& name, ResourceBuffer& resource) {
+    if(cacheDir.empty()) return false;
+    try {
+        resource.mapping = std::make_shared<MappedFile>(cacheDir + "/" + name);
+    } catch(const std::exception&) {
+        return false;
+    }
+    resource.memory.clear();
+    return true;
+}
 
-std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, dai::Path pathToMvcmd) const {
-    // Wait until lazy load is complete
+static void storeCachedResource(const std::string& cacheDir, const std::string& name, const std::uint8_t* data, std::size_t size) {
+    if(cacheDir.empty()) return;
+
+    // Write to a temporary file and rename it, so other processes never map a partially written resource
+    auto path = cacheDir + "/" + name;
+    auto tmpPath = fmt::format("{}.{}.tmp", path, std::chrono::steady_clock::now().time_since_epoch().count());
     {
-        std::unique_lock<std::mutex> lock(mtxDevice);
-        cvDevice.wait(lock, [this]() { return readyDevice; });
+        std::ofstream file(tmpPath, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data), size);
+        file.close();
+        if(!file.good()) {
+            logger::warn("Couldn't write resource {} to cache directory {}", name, cacheDir);
+            std::remove(tmpPath.c_str());
+            return;
+        }
     }
+    // Might fail if another process already stored the same resource
+    if(std::rename(tmpPath.c_str(), path.c_str()) != 0) std::remove(tmpPath.c_str());
+}
 
-    std::vector<std::uint8_t> finalFwBinary;
+// Extracts given entries from an embedded tar.xz archive. Stops decompressing once all of them are found
+static void extractTarXz(const char* cmrcPath, const std::vector<std::string>& names, std::unordered_map<std::string, ResourceBuffer>& resources) {
+    using namespace std::chrono;
 
-    // Get OpenVINO version
-    auto& version = config.version;
+    // Get binaries from internal sources
+    auto fs = cmrc::depthai::get_filesystem();
+    auto tarXz = fs.open(cmrcPath);
 
-    // Check if pathToMvcmd variable is set
-    dai::Path finalFwBinaryPath;
-    if(!pathToMvcmd.empty()) {
-        finalFwBinaryPath = pathToMvcmd;
-    }
-    // Override if env variable DEPTHAI_DEVICE_BINARY is set
-    dai::Path fwBinaryPath = utility::getEnv("DEPTHAI_DEVICE_BINARY");
-    if(!fwBinaryPath.empty()) {
-        finalFwBinaryPath = fwBinaryPath;
+    auto t1 = steady_clock::now();
+
+    // Load tar.xz archive from memory
+    std::unique_ptr<struct archive, decltype(&archive_read_free)> a(archive_read_new(), &archive_read_free);
+    archive_read_support_filter_xz(a.get());
+    archive_read_support_format_tar(a.get());
+    if(archive_read_open_memory(a.get(), tarXz.begin(), tarXz.size()) != ARCHIVE_OK) {
+        throw std::runtime_error(fmt::format("Couldn't open resource archive '{}': {}", cmrcPath, archive_error_string(a.get())));
     }
-    // Return binary from file if any of above paths are present
-    if(!finalFwBinaryPath.empty()) {
-        // Load binary file at path
-        std::ifstream stream(finalFwBinaryPath, std::ios::binary);
-        if(!stream.is_open()) {
-            // Throw an error
-            // TODO(themarpe) - Unify exceptions into meaningful groups
-            throw std::runtime_error(
-                fmt::format("File at path {}{} doesn't exist.", finalFwBinaryPath, !fwBinaryPath.empty() ? " pointed to by DEPTHAI_DEVICE_BINARY" : ""));
+
+    std::unordered_set<std::string> remaining(names.begin(), names.end());
+    struct archive_entry* entry;
+    while(!remaining.empty()) {
+        int r = archive_read_next_header(a.get(), &entry);
+        if(r == ARCHIVE_EOF) break;
+        if(r != ARCHIVE_OK && r != ARCHIVE_WARN) {
+            throw std::runtime_error(fmt::format("Couldn't read resource archive '{}': {}", cmrcPath, archive_error_string(a.get())));
         }
-        logger::warn("Overriding firmware: {}", finalFwBinaryPath);
-        // Read the file and return its contents
-        finalFwBinary = std::vector<std::uint8_t>(std::istreambuf_iterator<char>(stream), {});
-    } else {
-// Binaries are resource compiled
-#ifdef DEPTHAI_RESOURCE_COMPILED_BINARIES
 
-        std::unordered_set<OpenVINO::Version> deprecatedVersions(
-            {OpenVINO::VERSION_2020_4, OpenVINO::VERSION_2021_1, OpenVINO::VERSION_2021_2, OpenVINO::VERSION_2021_3});
+        // Data of entries which aren't required is skipped by the next header read
+        std::string resPath(archive_entry_pathname(entry));
+        if(remaining.erase(resPath) == 0) continue;
+
+        // Preallocate from the size in the tar header, or grow geometrically if it isn't set
+        std::vector<std::uint8_t> resource(archive_entry_size_is_set(entry) ? archive_entry_size(entry) : 1024 * 1024);
+        std::size_t finalSize = 0;
+        while(true) {
+            if(finalSize == resource.size()) {
+                if(archive_entry_size_is_set(entry)) break;
+                resource.resize(resource.size() * 2);
+            }
+            auto size = archive_read_data(a.get(), &resource[finalSize], resource.size() - finalSize);
+            if(size < 0) {
+                throw std::runtime_error(fmt::format("Couldn't extract '{}' from resource archive '{}': {}", resPath, cmrcPath, archive_error_string(a.get())));
+            }
+            // All bytes were read
+            if(size == 0) break;
+            finalSize += size;
+        }
+        if(archive_entry_size_is_set(entry) && finalSize != resource.size()) {
+            throw std::runtime_error(fmt::format("Resource '{}' in archive '{}' is truncated", resPath, cmrcPath));
+        }
+        resource.resize(finalSize);
+        resources[resPath].memory = std::move(resource);
+    }
+    if(!remaining.empty()) {
+        throw std::runtime_error(fmt::format("Resource '{}' not found in archive '{}'", *remaining.begin(), cmrcPath));
+    }
+
+    // Debug - logs loading times
+    logger::debug("Resources - Archive '{}' extracted {} resource(s): {}", cmrcPath, names.size(), duration_cast<milliseconds>(steady_clock::now() - t1));
+}
 
-        if(deprecatedVersions.count(version)) {
-            logger::warn("OpenVINO {} is deprecated!", OpenVINO::getVersionName(version));
+std::string Resources::getCacheDir(Archive& archive) const {
+    std::unique_lock<std::mutex> lock(archive.mtx);
+    if(!archive.cacheDirResolved) {
+        auto fs = cmrc::depthai::get_filesystem();
+        auto tarXz = fs.open(archive.path);
+        archive.cacheDir = getResourceCacheDir(archive.path, reinterpret_cast<const std::uint8_t*>(tarXz.begin()), tarXz.size());
+        archive.cacheDirResolved = true;
+    }
+    return archive.cacheDir;
+}
+
+std::vector<const ResourceBuffer*> Resources::getResources(Archive& archive, const std::vector<std::string>& names) const {
+    auto cacheDir = getCacheDir(archive);
+
+    // Extractions from the same archive are serialized, so concurrent callers wait for and reuse a single pass
+    std::unique_lock<std::mutex> lock(archive.mtx);
+    std::vector<std::string> missing;
+    for(const auto& name : names) {
+        if(archive.resources.count(name)) continue;
+        ResourceBuffer cached;
+        if(loadCachedResource(cacheDir, name, cached)) {
+            archive.resources[name] = std::move(cached);
+        } else {
+            missing.push_back(name);
         }
+    }
 
-        // Main FW
-        std::vector<std::uint8_t> depthaiBinary;
-        // Patch from main to specified
-        std::vector<std::uint8_t> depthaiPatch;
-
-        switch(version) {
-            case OpenVINO::VERSION_2020_3:
-                throw std::runtime_error(fmt::format("OpenVINO {} is not available anymore", OpenVINO::getVersionName(version)));
-                break;
-
-            case OpenVINO::VERSION_2020_4:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2020_4_PATCH_PATH);
-                break;
-
-            case OpenVINO::VERSION_2021_1:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH);
-                break;
-
-            case OpenVINO::VERSION_2021_2:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH);
-                break;
-
-            case OpenVINO::VERSION_2021_3:
-                depthaiPatch = resourceMapDevice.at(DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH);
-                break;
-
-            case OpenVINO::VERSION_2021_4:
-            case OpenVINO::VERSION_2022_1:
-            case MAIN_FW_VERSION:
-                depthaiBinary = resourceMapDevice.at(MAIN_FW_PATH);
-                break;
+    if(!missing.empty()) {
+        extractTarXz(archive.path, missing, archive.resources);
+        // Store extracted resources for next processes
+        for(const auto& name : missing) {
+            const auto& resource = archive.resources.at(name);
+            storeCachedResource(cacheDir, name, resource.data(), resource.size());
         }
+    }
+
+    // Elements of an unordered_map keep their address, and resources aren't modified once extracted
+    std::vector<const ResourceBuffer*> result;
+    for(const auto& name : names) {
+        result.push_back(&archive.resources.at(name));
+    }
+    return result;
+}
+
+std::shared_ptr<const ResourceBuffer> Resources::getBaseDeviceFirmware(OpenVINO::Version version) const {
+    auto firmware = std::make_shared<ResourceBuffer>();
+
+#ifdef DEPTHAI_RESOURCE_COMPILED_BINARIES
+    std::unordered_set<OpenVINO::Version> deprecatedVersions(
+        {OpenVINO::VERSION_2020_4, OpenVINO::VERSION_2021_1, OpenVINO::VERSION_2021_2, OpenVINO::VERSION_2021_3});
+
+    if(deprecatedVersions.count(version)) {
+        logger::warn("OpenVINO {} is deprecated!", OpenVINO::getVersionName(version));
+    }
+
+    // Patch from main to specified
+    std::string patchPath;
+
+    switch(version) {
+        case OpenVINO::VERSION_2020_3:
+            throw std::runtime_error(fmt::format("OpenVINO {} is not available anymore", OpenVINO::getVersionName(version)));
+            break;
+
+        case OpenVINO::VERSION_2020_4:
+            patchPath = DEPTHAI_CMD_OPENVINO_2020_4_PATCH_PATH;
+            break;
+
+        case OpenVINO::VERSION_2021_1:
+            patchPath = DEPTHAI_CMD_OPENVINO_2021_1_PATCH_PATH;
+            break;
+
+        case OpenVINO::VERSION_2021_2:
+            patchPath = DEPTHAI_CMD_OPENVINO_2021_2_PATCH_PATH;
+            break;
+
+        case OpenVINO::VERSION_2021_3:
+            patchPath = DEPTHAI_CMD_OPENVINO_2021_3_PATCH_PATH;
+            break;
+
+        case OpenVINO::VERSION_2021_4:
+        case OpenVINO::VERSION_2022_1:
+        case MAIN_FW_VERSION:
+            break;
+    }
 
-        // is patching required?
-        if(!depthaiPatch.empty()) {
+    // is patching required?
+    if(!patchPath.empty()) {
+        // Patched variant might already be in the resource cache
+        auto cacheDir = getCacheDir(archiveDevice);
+        auto patchedPath = patchPath.substr(0, patchPath.rfind(".patch")) + ".cmd";
+        if(!loadCachedResource(cacheDir, patchedPath, *firmware)) {
             logger::debug("Patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version));
 
-            // Load full binary for patch
-            depthaiBinary = resourceMapDevice.at(MAIN_FW_PATH);
+            // Main FW and only the required patch
+            auto resources = getResources(archiveDevice, {MAIN_FW_PATH, patchPath});
+            const auto& depthaiBinary = *resources[0];
+            const auto& depthaiPatch = *resources[1];
 
             // Get new size
             int64_t patchedSize = bspatch_mem_get_newsize(depthaiPatch.data(), depthaiPatch.size());
 
             // Reserve space for patched binary
-            std::vector<std::uint8_t> tmpDepthaiBinary{};
-            tmpDepthaiBinary.resize(patchedSize);
+            firmware->memory.resize(patchedSize);
 
             // Patch
-            int error = bspatch_mem(depthaiBinary.data(), depthaiBinary.size(), depthaiPatch.data(), depthaiPatch.size(), tmpDepthaiBinary.data());
+            int error = bspatch_mem(depthaiBinary.data(), depthaiBinary.size(), depthaiPatch.data(), depthaiPatch.size(), firmware->memory.data());
 
             // if patch not successful
             if(error > 0) {
@@ -167,25 +276,86 @@ std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, da
                     "Error while patching OpenVINO FW version from {} to {}", OpenVINO::getVersionName(MAIN_FW_VERSION), OpenVINO::getVersionName(version)));
             }
 
-            // Change depthaiBinary to tmpDepthaiBinary
-            depthaiBinary = std::move(tmpDepthaiBinary);
+            storeCachedResource(cacheDir, patchedPath, firmware->data(), firmware->size());
         }
+    } else {
+        // Archive entries live as long as Resources, so the main firmware is referenced instead of copied
+        return std::shared_ptr<const ResourceBuffer>(getResources(archiveDevice, {MAIN_FW_PATH})[0], [](const ResourceBuffer*) {});
+    }
+#endif
 
-        finalFwBinary = std::move(depthaiBinary);
+    return firmware;
+}
 
-#else
-        // Binaries from default path (TODO)
+std::vector<std::uint8_t> Resources::getDeviceFirmware(Device::Config config, dai::Path pathToMvcmd) const {
+    return *getDeviceFirmwareImage(std::move(config), std::move(pathToMvcmd));
+}
 
-#endif
-    }
+std::shared_ptr<const std::vector<std::uint8_t>> Resources::getDeviceFirmwareImage(Device::Config config, dai::Path pathToMvcmd) const {
+    // Get OpenVINO version
+    auto& version = config.version;
 
-    // Prepend preboot config
-    // Serialize preboot
+    // Serialize preboot, which is prepended to the firmware
     auto prebootPayload = utility::serialize(config.board);
     auto prebootHeader = createPrebootHeader(prebootPayload, BOARD_CONFIG_MAGIC1, BOARD_CONFIG_MAGIC2);
-    finalFwBinary.insert(finalFwBinary.begin(), prebootHeader.begin(), prebootHeader.end());
 
-    // Return created firmware
+    // Check if pathToMvcmd variable is set
+    dai::Path finalFwBinaryPath;
+    if(!pathToMvcmd.empty()) {
+        finalFwBinaryPath = pathToMvcmd;
+    }
+    // Override if env variable DEPTHAI_DEVICE_BINARY is set
+    dai::Path fwBinaryPath = utility::getEnv("DEPTHAI_DEVICE_BINARY");
+    if(!fwBinaryPath.empty()) {
+        finalFwBinaryPath = fwBinaryPath;
+    }
+    // Return binary from file if any of above paths are present. Not cached, as the file may change
+    if(!finalFwBinaryPath.empty()) {
+        // Load binary file at path
+        std::ifstream stream(finalFwBinaryPath, std::ios::binary);
+        if(!stream.is_open()) {
+            // Throw an error
+            // TODO(themarpe) - Unify exceptions into meaningful groups
+            throw std::runtime_error(
+                fmt::format("File at path {}{} doesn't exist.", finalFwBinaryPath, !fwBinaryPath.empty() ? " pointed to by DEPTHAI_DEVICE_BINARY" : ""));
+        }
+        logger::warn("Overriding firmware: {}", finalFwBinaryPath);
+        // Read the file and prepend preboot config
+        auto finalFwBinary = std::make_shared<std::vector<std::uint8_t>>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        finalFwBinary->insert(finalFwBinary->begin(), prebootHeader.begin(), prebootHeader.end());
+        return finalFwBinary;
+    }
+
+    // Images are only referenced by the cache, so boots of multiple devices share a single one while any of them holds it,
+    // and it is released (and created again when needed) afterwards
+    std::unique_lock<std::mutex> lock(mtxFirmwareCache);
+    auto key = std::make_pair(version, std::move(prebootPayload));
+    auto cached = firmwareCache.find(key);
+    if(cached != firmwareCache.end()) {
+        if(auto image = cached->second.lock()) return image;
+    }
+    // Drop entries of released images
+    for(auto it = firmwareCache.begin(); it != firmwareCache.end();) {
+        if(it->second.expired()) {
+            it = firmwareCache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    auto finalFwBinary = std::make_shared<std::vector<std::uint8_t>>(prebootHeader);
+// Binaries are resource compiled
+#ifdef DEPTHAI_RESOURCE_COMPILED_BINARIES
+    // Patched binaries are only kept until the image is created
+    auto firmware = getBaseDeviceFirmware(version);
+    finalFwBinary->reserve(prebootHeader.size() + firmware->size());
+    finalFwBinary->insert(finalFwBinary->end(), firmware->data(), firmware->data() + firmware->size());
+#else
+    // Binaries from default path (TODO)
+
+#endif
+
+    firmwareCache[std::move(key)] = finalFwBinary;
     return finalFwBinary;
 }
 
@@ -193,18 +363,7 @@ constexpr static auto CMRC_DEPTHAI_BOOTLOADER_TAR_XZ = "depthai-bootloader-fwp-"
 constexpr static auto DEVICE_BOOTLOADER_USB_PATH = "depthai-bootloader-usb.cmd";
 constexpr static auto DEVICE_BOOTLOADER_ETH_PATH = "depthai-bootloader-eth.cmd";
 
-constexpr static std::array<const char*, 2> RESOURCE_LIST_BOOTLOADER = {
-    DEVICE_BOOTLOADER_USB_PATH,
-    DEVICE_BOOTLOADER_ETH_PATH,
-};
-
 std::vector<std::uint8_t> Resources::getBootloaderFirmware(dai::bootloader::Type type) const {
-    // Wait until lazy load is complete
-    {
-        std::unique_lock<std::mutex> lock(mtxBootloader);
-        cvDevice.wait(lock, [this]() { return readyBootloader; });
-    }
-
     // Check if env variable DEPTHAI_BOOTLOADER_BINARY_USB/_ETH is set
     std::string blEnvVar;
     if(type == dai::bootloader::Type::USB) {
@@ -232,11 +391,11 @@ std::vector<std::uint8_t> Resources::getBootloaderFirmware(dai::bootloader::Type
             break;
 
         case dai::bootloader::Type::USB:
-            return resourceMapBootloader.at(DEVICE_BOOTLOADER_USB_PATH);
+            return getResources(archiveBootloader, {DEVICE_BOOTLOADER_USB_PATH})[0]->toVector();
             break;
 
         case dai::bootloader::Type::NETWORK:
-            return resourceMapBootloader.at(DEVICE_BOOTLOADER_ETH_PATH);
+            return getResources(archiveBootloader, {DEVICE_BOOTLOADER_ETH_PATH})[0]->toVector();
             break;
 
         default:
@@ -250,99 +409,6 @@ Resources& Resources::getInstance() {
     return instance;
 }
 
-template <typename CV, typename BOOL, typename MTX, typename PATH, typename LIST, typename MAP>
-std::function<void()> getLazyTarXzFunction(MTX& mtx, CV& cv, BOOL& ready, PATH cmrcPath, LIST& resourceList, MAP& resourceMap) {
-    return [&mtx, &cv, &ready, cmrcPath, &resourceList, &resourceMap] {
-        using namespace std::chrono;
-
-        // Get binaries from internal sources
-        auto fs = cmrc::depthai::get_filesystem();
-        auto tarXz = fs.open(cmrcPath);
-
-        auto t1 = steady_clock::now();
-
-        // Load tar.xz archive from memory
-        struct archive* a = archive_read_new();
-        archive_read_support_filter_xz(a);
-        archive_read_support_format_tar(a);
-        int r = archive_read_open_memory(a, tarXz.begin(), tarXz.size());
-        assert(r == ARCHIVE_OK);
-
-        auto t2 = steady_clock::now();
-
-        struct archive_entry* entry;
-        while(archive_read_next_header(a, &entry) == ARCHIVE_OK) {
-            // Check whether filename matches to one of required resources
-            for(const auto& cpath : resourceList) {
-                std::string resPath(cpath);
-                if(resPath == std::string(archive_entry_pathname(entry))) {
-                    // Create an emtpy entry
-                    resourceMap[resPath] = std::vector<std::uint8_t>();
-
-                    // Read size, 16KiB
-                    std::size_t readSize = 16 * 1024;
-                    if(archive_entry_size_is_set(entry)) {
-                        // if size is specified, use that for read size
-                        readSize = archive_entry_size(entry);
-                    }
-
-                    // Record number of bytes actually read
-                    long long finalSize = 0;
-
-                    while(true) {
-                        // Current size, as a offset to write next data to
-                        auto currentSize = resourceMap[resPath].size();
-
-                        // Resize to accomodate for extra data
-                        resourceMap[resPath].resize(currentSize + readSize);
-                        long long size = archive_read_data(a, &resourceMap[resPath][currentSize], readSize);
-
-                        // Assert that no errors occurred
-                        assert(size >= 0);
-
-                        // Append number of bytes actually read to finalSize
-                        finalSize += size;
-
-                        // All bytes were read
-                        if(size == 0) {
-                            break;
-                        }
-                    }
-
-                    // Resize vector to actual read size
-                    resourceMap[resPath].resize(finalSize);
-
-                    // Entry found - go to next required resource
-                    break;
-                }
-            }
-        }
-        r = archive_read_free(a);  // Note 3
-        assert(r == ARCHIVE_OK);
-        // Ignore 'r' variable when in Release build
-        (void)r;
-
-        // Check that all resources were read
-        for(const auto& cpath : resourceList) {
-            std::string resPath(cpath);
-            assert(resourceMap.count(resPath) > 0);
-        }
-
-        auto t3 = steady_clock::now();
-
-        // Debug - logs loading times
-        logger::debug(
-            "Resources - Archive '{}' open: {}, archive read: {}", cmrcPath, duration_cast<milliseconds>(t2 - t1), duration_cast<milliseconds>(t3 - t2));
-
-        // Notify that that preload is finished
-        {
-            std::unique_lock<std::mutex> l(mtx);
-            ready = true;
-        }
-        cv.notify_all();
-    };
-}
-
 Resources::Resources() {
     // Preinit libarchive
     struct archive* a = archive_read_new();
@@ -351,20 +417,24 @@ Resources::Resources() {
     // Ignore 'r' variable when in Release build
     (void)r;
 
-    // Device resources
-    // Create a thread which lazy-loads firmware resources package
-    lazyThreadDevice = std::thread(getLazyTarXzFunction(mtxDevice, cvDevice, readyDevice, CMRC_DEPTHAI_DEVICE_TAR_XZ, RESOURCE_LIST_DEVICE, resourceMapDevice));
-
-    // Bootloader resources
-    // Create a thread which lazy-loads firmware resources package
-    lazyThreadBootloader = std::thread(
-        getLazyTarXzFunction(mtxBootloader, cvBootloader, readyBootloader, CMRC_DEPTHAI_BOOTLOADER_TAR_XZ, RESOURCE_LIST_BOOTLOADER, resourceMapBootloader));
+    archiveDevice.path = CMRC_DEPTHAI_DEVICE_TAR_XZ;
+    archiveBootloader.path = CMRC_DEPTHAI_BOOTLOADER_TAR_XZ;
+
+    // Create a thread which lazy-loads only the main device firmware, as nearly every process boots a device.
+    // Patches and bootloaders are extracted on first request
+    lazyThreadDevice = std::thread([this]() {
+        try {
+            getResources(archiveDevice, {MAIN_FW_PATH});
+        } catch(const std::exception& ex) {
+            // Reported again when the firmware is requested
+            logger::debug("Resources - Couldn't preload device firmware: {}", ex.what());
+        }
+    });
 }
 
 Resources::~Resources() {
-    // join the lazy threads
+    // join the lazy thread
     if(lazyThreadDevice.joinable()) lazyThreadDevice.join();
-    if(lazyThreadBootloader.joinable()) lazyThreadBootloader.join();
 }
 
 // Get device firmware
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
@@ -13,24 +15,54 @@
 #include <depthai/openvino/OpenVINO.hpp>
 #include <depthai/utility/Path.hpp>
 
+#include "MappedFile.hpp"
+
 namespace dai {
 
+/**
+ * Contents of a resource, either decompressed into memory or mapped from the resource cache directory
+ */
+struct ResourceBuffer {
+    std::vector<std::uint8_t> memory;
+    std::shared_ptr<MappedFile> mapping;
+
+    const std::uint8_t* data() const {
+        return mapping ? mapping->data() : memory.data();
+    }
+    std::size_t size() const {
+        return mapping ? mapping->size() : memory.size();
+    }
+    std::vector<std::uint8_t> toVector() const {
+        return std::vector<std::uint8_t>(data(), data() + size());
+    }
+};
+
 class Resources {
     // private constructor
     Resources();
     ~Resources();
 
-    mutable std::mutex mtxDevice;
-    mutable std::condition_variable cvDevice;
+    // Embedded tar.xz archive, whose entries are extracted on first use
+    struct Archive {
+        const char* path = nullptr;
+        std::mutex mtx;
+        std::unordered_map<std::string, ResourceBuffer> resources;
+        bool cacheDirResolved = false;
+        std::string cacheDir;
+    };
+    mutable Archive archiveDevice;
+    mutable Archive archiveBootloader;
     std::thread lazyThreadDevice;
-    bool readyDevice;
-    std::unordered_map<std::string, std::vector<std::uint8_t>> resourceMapDevice;
 
-    mutable std::mutex mtxBootloader;
-    mutable std::condition_variable cvBootloader;
-    std::thread lazyThreadBootloader;
-    bool readyBootloader;
-    std::unordered_map<std::string, std::vector<std::uint8_t>> resourceMapBootloader;
+    // Returns given entries of an archive, extracting the missing ones in a single pass
+    std::vector<const ResourceBuffer*> getResources(Archive& archive, const std::vector<std::string>& names) const;
+    std::string getCacheDir(Archive& archive) const;
+
+    // Device firmware images in use, with prepended preboot config, per OpenVINO version and serialized board config
+    mutable std::mutex mtxFirmwareCache;
+    mutable std::map<std::pair<OpenVINO::Version, std::vector<std::uint8_t>>, std::weak_ptr<const std::vector<std::uint8_t>>> firmwareCache;
+    // Main firmware or its patched variant for given OpenVINO version
+    std::shared_ptr<const ResourceBuffer> getBaseDeviceFirmware(OpenVINO::Version version) const;
 
 public:
     static Resources& getInstance();
@@ -40,6 +72,8 @@ public:
     // Available resources
     std::vector<std::uint8_t> getDeviceFirmware(bool usb2Mode, OpenVINO::Version version = OpenVINO::VERSION_UNIVERSAL) const;
     std::vector<std::uint8_t> getDeviceFirmware(Device::Config config, dai::Path pathToMvcmd = {}) const;
+    // Same as getDeviceFirmware, but shares the image with other holders of the same one instead of copying it
+    std::shared_ptr<const std::vector<std::uint8_t>> getDeviceFirmwareImage(Device::Config config, dai::Path pathToMvcmd = {}) const;
     std::vector<std::uint8_t> getBootloaderFirmware(DeviceBootloader::Type type = DeviceBootloader::Type::USB) const;
 
 };
@@ -0,0 +1,97 @@
+#include "WorkStealingPool.hpp"
+
+// std
+#include <algorithm>
+
+// project
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+namespace {
+// Pool and deque index of the current worker thread
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+}  // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t numThreads) {
+    if(numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    for(std::size_t i = 0; i < numThreads; i++) queues.push_back(std::make_unique<Worker>());
+    for(std::size_t i = 0; i < numThreads; i++) {
+        threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        running = false;
+    }
+    cv.notify_all();
+    for(auto& thread : threads) {
+        if(thread.joinable()) thread.join();
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    const std::size_t index = isWorkerThread() ? currentIndex : nextQueue++ % queues.size();
+    {
+        std::unique_lock<std::mutex> lock(queues[index]->mtx);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    {
+        // Counted under the lock, so a worker checking before it sleeps can't miss it
+        std::unique_lock<std::mutex> lock(mtx);
+        numPending++;
+    }
+    cv.notify_one();
+}
+
+std::size_t WorkStealingPool::getNumThreads() const {
+    return threads.size();
+}
+
+bool WorkStealingPool::isWorkerThread() const {
+    return currentPool == this;
+}
+
+bool WorkStealingPool::tryRun(std::size_t index) {
+    Task task;
+    // Own tasks newest first, then steal oldest from the others
+    for(std::size_t i = 0; i < queues.size() && !task; i++) {
+        auto& queue = *queues[(index + i) % queues.size()];
+        std::unique_lock<std::mutex> lock(queue.mtx);
+        if(queue.tasks.empty()) continue;
+        if(i == 0) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if(!task) return false;
+    numPending--;
+
+    try {
+        task();
+    } catch(const std::exception& ex) {
+        logger::error("Work stealing pool task throwed an exception: {}", ex.what());
+    }
+    return true;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while(true) {
+        if(tryRun(index)) continue;
+
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return !running || numPending > 0; });
+        if(!running) break;
+        // Pending task may be claimed by another worker in the meantime, so just try again
+    }
+}
+
+}  // namespace dai
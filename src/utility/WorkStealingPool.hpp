@@ -0,0 +1,73 @@
+#pragma once
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dai {
+
+/**
+ * Thread pool with a task deque per worker.
+ *
+ * Tasks submitted from a worker go to its own deque and are run newest first, so data a task just produced is
+ * consumed while still in cache. Tasks submitted from other threads are spread across workers round robin.
+ * Idle workers steal the oldest tasks of others.
+ */
+class WorkStealingPool {
+   public:
+    using Task = std::function<void()>;
+
+    /**
+     * @param numThreads Number of worker threads, zero for one per hardware thread
+     */
+    explicit WorkStealingPool(std::size_t numThreads = 0);
+
+    /**
+     * Stops and joins all workers. Tasks which didn't start yet are discarded
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Submits a task. Exceptions thrown by tasks are logged and otherwise ignored
+     */
+    void submit(Task task);
+
+    /**
+     * Gets number of worker threads
+     */
+    std::size_t getNumThreads() const;
+
+    /**
+     * Checks whether the calling thread is a worker of this pool
+     */
+    bool isWorkerThread() const;
+
+   private:
+    struct Worker {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Worker>> queues;
+    std::vector<std::thread> threads;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool running = true;
+    std::atomic<std::size_t> numPending{0};
+    std::atomic<std::size_t> nextQueue{0};
+
+    bool tryRun(std::size_t index);
+    void workerLoop(std::size_t index);
+};
+
+}  // namespace dai
@@ -0,0 +1,253 @@
+#include "depthai/xlink/DeviceDiscovery.hpp"
+
+// std
+#include <algorithm>
+#include <utility>
+
+// libraries
+#include <XLink/XLink.h>
+
+#include "utility/Logging.hpp"
+
+namespace dai {
+
+// STATIC
+constexpr std::chrono::milliseconds DeviceDiscovery::DEFAULT_SCAN_INTERVAL;
+constexpr std::chrono::milliseconds DeviceDiscovery::DEFAULT_IDLE_TIMEOUT;
+
+static bool isSameDevice(const DeviceInfo& a, const DeviceInfo& b) {
+    // MX ID is stable across boots, name (e.g. USB path) might not be
+    if(!a.mxid.empty() && !b.mxid.empty()) return a.mxid == b.mxid && a.protocol == b.protocol;
+    return a.name == b.name && a.protocol == b.protocol;
+}
+
+static bool hasDeviceChanged(const DeviceInfo& a, const DeviceInfo& b) {
+    return a.state != b.state || a.status != b.status || a.name != b.name || a.mxid != b.mxid || a.platform != b.platform;
+}
+
+DeviceDiscovery& DeviceDiscovery::getInstance() {
+    static DeviceDiscovery instance;
+    return instance;
+}
+
+DeviceDiscovery::~DeviceDiscovery() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+    if(scannerThread.joinable()) scannerThread.join();
+}
+
+std::vector<DeviceInfo> DeviceDiscovery::getDevices(bool skipInvalidDevices) {
+    std::unique_lock<std::mutex> lock(mtx);
+    lastAccess = std::chrono::steady_clock::now();
+    if(!isFresh()) scan(lock);
+    ensureScanner();
+
+    std::vector<DeviceInfo> result;
+    for(const auto& device : devices) {
+        if(skipInvalidDevices && device.status != X_LINK_SUCCESS) continue;
+        result.push_back(device);
+    }
+    return result;
+}
+
+std::vector<DeviceInfo> DeviceDiscovery::waitFor(const std::function<bool(const std::vector<DeviceInfo>&)>& predicate, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    numWaiters++;
+    try {
+        if(!isFresh()) scan(lock);
+        ensureScanner();
+        // Scanner wakes us up after each scan
+        while(!predicate(devices) && !stopping && std::chrono::steady_clock::now() < deadline) {
+            auto currentGeneration = generation;
+            cv.wait_until(lock, deadline, [this, currentGeneration]() { return generation != currentGeneration || stopping; });
+        }
+    } catch(const std::exception&) {
+        numWaiters--;
+        throw;
+    }
+    numWaiters--;
+    lastAccess = std::chrono::steady_clock::now();
+
+    return devices;
+}
+
+DeviceDiscovery::CallbackId DeviceDiscovery::addCallback(std::function<void(Event, DeviceInfo)> callback) {
+    CallbackId id;
+    {
+        std::unique_lock<std::mutex> l(callbacksMtx);
+        id = uniqueCallbackId++;
+        callbacks[id] = std::move(callback);
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    numCallbacks++;
+    ensureScanner();
+    return id;
+}
+
+bool DeviceDiscovery::removeCallback(CallbackId callbackId) {
+    {
+        std::unique_lock<std::mutex> l(callbacksMtx);
+        if(callbacks.count(callbackId) == 0) return false;
+        callbacks.erase(callbackId);
+    }
+
+    std::unique_lock<std::mutex> lock(mtx);
+    numCallbacks--;
+    lastAccess = std::chrono::steady_clock::now();
+    return true;
+}
+
+void DeviceDiscovery::setScanInterval(std::chrono::milliseconds interval) {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        scanInterval = interval;
+    }
+    cv.notify_all();
+}
+
+std::chrono::milliseconds DeviceDiscovery::getScanInterval() const {
+    std::unique_lock<std::mutex> lock(mtx);
+    return scanInterval;
+}
+
+void DeviceDiscovery::invalidate() {
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        lastScan = {};
+    }
+    cv.notify_all();
+}
+
+bool DeviceDiscovery::isFresh() const {
+    return lastScan != std::chrono::steady_clock::time_point{} && std::chrono::steady_clock::now() - lastScan <= scanInterval;
+}
+
+void DeviceDiscovery::scan(std::unique_lock<std::mutex>& lock) {
+    // Single scan at a time, concurrent callers share its result
+    if(scanning) {
+        auto currentGeneration = generation;
+        cv.wait(lock, [this, currentGeneration]() { return generation != currentGeneration || !scanning; });
+        return;
+    }
+    scanning = true;
+    lock.unlock();
+
+    std::vector<DeviceInfo> found;
+    try {
+        found = XLinkConnection::getAllConnectedDevices(X_LINK_ANY_STATE, false);
+    } catch(const std::exception&) {
+        lock.lock();
+        scanning = false;
+        cv.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    std::vector<std::pair<Event, DeviceInfo>> events;
+    for(const auto& device : found) {
+        auto previous = std::find_if(devices.begin(), devices.end(), [&device](const DeviceInfo& d) { return isSameDevice(d, device); });
+        if(previous == devices.end()) {
+            events.emplace_back(Event::ADDED, device);
+        } else if(hasDeviceChanged(*previous, device)) {
+            events.emplace_back(Event::CHANGED, device);
+        } else {
+            continue;
+        }
+
+        if(device.status == X_LINK_INSUFFICIENT_PERMISSIONS) {
+            logger::warn("Insufficient permissions to communicate with {} device having name \"{}\". Make sure udev rules are set",
+                         XLinkDeviceStateToStr(device.state),
+                         device.name);
+        } else if(device.status != X_LINK_SUCCESS) {
+            logger::warn("skipping {} device having name \"{}\"", XLinkDeviceStateToStr(device.state), device.name);
+        }
+    }
+    for(const auto& device : devices) {
+        auto current = std::find_if(found.begin(), found.end(), [&device](const DeviceInfo& d) { return isSameDevice(d, device); });
+        if(current == found.end()) events.emplace_back(Event::REMOVED, device);
+    }
+
+    devices = std::move(found);
+    lastScan = std::chrono::steady_clock::now();
+    generation++;
+    // Queued while the table is still locked, so events keep the order of scans
+    if(!events.empty()) {
+        std::unique_lock<std::mutex> l(eventsMtx);
+        for(auto& event : events) pendingEvents.push_back(std::move(event));
+    }
+    scanning = false;
+    cv.notify_all();
+
+    // Callbacks may use the table, so no lock is held while they run
+    if(!events.empty()) {
+        lock.unlock();
+        deliverEvents();
+        lock.lock();
+    }
+}
+
+void DeviceDiscovery::deliverEvents() {
+    std::unique_lock<std::mutex> l(eventsMtx);
+    // Thread already delivering (possibly this one, scanning from within a callback) picks up the queued events
+    if(delivering) return;
+    delivering = true;
+    while(!pendingEvents.empty()) {
+        auto event = std::move(pendingEvents.front());
+        pendingEvents.pop_front();
+        l.unlock();
+
+        // Copy, so callbacks can add or remove callbacks
+        std::vector<std::pair<CallbackId, std::function<void(Event, DeviceInfo)>>> current;
+        {
+            std::unique_lock<std::mutex> lc(callbacksMtx);
+            current.assign(callbacks.begin(), callbacks.end());
+        }
+        for(const auto& kv : current) {
+            try {
+                kv.second(event.first, event.second);
+            } catch(const std::exception& ex) {
+                logger::error("Callback with id: {} throwed an exception: {}", kv.first, ex.what());
+            }
+        }
+
+        l.lock();
+    }
+    delivering = false;
+}
+
+void DeviceDiscovery::ensureScanner() {
+    if(scannerRunning || stopping) return;
+    // Previous scanner already exited on its own
+    if(scannerThread.joinable()) scannerThread.join();
+    scannerRunning = true;
+    scannerThread = std::thread([this]() { scannerLoop(); });
+}
+
+void DeviceDiscovery::scannerLoop() {
+    std::unique_lock<std::mutex> lock(mtx);
+    while(!stopping) {
+        cv.wait_until(lock, lastScan + scanInterval, [this]() { return stopping || !isFresh(); });
+        if(stopping) break;
+
+        // Keep running only while the table is in use
+        bool inUse = numWaiters > 0 || numCallbacks > 0 || std::chrono::steady_clock::now() - lastAccess < DEFAULT_IDLE_TIMEOUT;
+        if(!inUse) break;
+
+        try {
+            scan(lock);
+        } catch(const std::exception& ex) {
+            logger::debug("Device discovery scan failed: {}", ex.what());
+            // Retry after an interval
+            lastScan = std::chrono::steady_clock::now();
+        }
+    }
+    scannerRunning = false;
+}
+
+}  // namespace dai
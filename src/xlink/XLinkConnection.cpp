@@ -6,11 +6,13 @@
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
 #include <thread>
 #include <vector>
 
 // project
 #include "depthai/utility/Initialization.hpp"
+#include "depthai/xlink/DeviceDiscovery.hpp"
 #include "utility/Environment.hpp"
 #include "utility/spdlog-fmt.hpp"
 
@@ -283,7 +285,13 @@ DeviceInfo XLinkConnection::bootBootloader(const DeviceInfo& deviceInfo) {
 }
 
 XLinkConnection::XLinkConnection(const DeviceInfo& deviceDesc, std::vector<std::uint8_t> mvcmdBinary, XLinkDeviceState_t expectedState)
+    : XLinkConnection(deviceDesc, std::make_shared<const std::vector<std::uint8_t>>(std::move(mvcmdBinary)), expectedState) {}
+
+XLinkConnection::XLinkConnection(const DeviceInfo& deviceDesc,
+                                 std::shared_ptr<const std::vector<std::uint8_t>> mvcmdBinary,
+                                 XLinkDeviceState_t expectedState)
     : bootWithPath(false), mvcmd(std::move(mvcmdBinary)) {
+    if(!mvcmd) throw std::invalid_argument("XLinkConnection - firmware image is null");
     initialize();
     initDevice(deviceDesc, expectedState);
 }
@@ -372,7 +380,7 @@ bool XLinkConnection::bootAvailableDevice(const deviceDesc_t& deviceToBoot, cons
     return bootAvailableDevice(deviceToBoot, package);
 }
 
-bool XLinkConnection::bootAvailableDevice(const deviceDesc_t& deviceToBoot, std::vector<std::uint8_t>& mvcmd) {
+bool XLinkConnection::bootAvailableDevice(const deviceDesc_t& deviceToBoot, const std::vector<std::uint8_t>& mvcmd) {
     auto status = XLinkBootMemory(&deviceToBoot, mvcmd.data(), static_cast<unsigned long>(mvcmd.size()));
     return status == X_LINK_SUCCESS;
 }
@@ -438,7 +446,7 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         if(bootWithPath) {
             bootStatus = bootAvailableDevice(foundDeviceDesc, pathToMvcmd);
         } else {
-            bootStatus = bootAvailableDevice(foundDeviceDesc, mvcmd);
+            bootStatus = bootAvailableDevice(foundDeviceDesc, *mvcmd);
         }
         if(!bootStatus) {
             throw std::runtime_error("Failed to boot device!");
@@ -494,6 +502,9 @@ void XLinkConnection::initDevice(const DeviceInfo& deviceToInit, XLinkDeviceStat
         deviceInfo = lastDeviceInfo;
         deviceInfo.state = X_LINK_BOOTED;
     }
+
+    // Device changed state, don't let others see it as available
+    DeviceDiscovery::getInstance().invalidate();
 }
 
 int XLinkConnection::getLinkId() const {
@@ -515,6 +526,68 @@ ProfilingData XLinkConnection::getGlobalProfilingData() {
     return data;
 }
 
+std::shared_ptr<StreamProfilingCounters> XLinkConnection::getStreamProfilingCounters(const std::string& name) {
+    std::unique_lock<std::mutex> lock(streamProfilingMtx);
+    auto& counters = streamProfilingCounters[name];
+    if(!counters) counters = std::make_shared<StreamProfilingCounters>();
+    return counters;
+}
+
+std::unordered_map<std::string, StreamProfilingData> XLinkConnection::getStreamProfilingData() {
+    std::unique_lock<std::mutex> lock(streamProfilingMtx);
+    std::unordered_map<std::string, StreamProfilingData> data;
+    for(const auto& kv : streamProfilingCounters) data[kv.first] = kv.second->get();
+    return data;
+}
+
+std::unordered_map<std::string, StreamProfilingData> XLinkConnection::getStreamProfilingData(std::chrono::milliseconds window) {
+    // Bounds on kept snapshots, enough for windows of several minutes queried every second
+    constexpr std::size_t MAX_SNAPSHOTS = 512;
+    constexpr std::chrono::minutes MAX_SNAPSHOT_AGE{10};
+
+    auto current = getStreamProfilingData();
+    const auto now = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(streamProfilingMtx);
+    // Newest snapshot which is at least 'window' old
+    const StreamProfilingSnapshot* base = nullptr;
+    for(auto it = streamProfilingHistory.rbegin(); it != streamProfilingHistory.rend(); ++it) {
+        if(now - it->first >= window) {
+            base = &*it;
+            break;
+        }
+    }
+    const auto since = base != nullptr ? base->first : streamProfilingStart;
+    const float elapsed = std::chrono::duration<float>(now - since).count();
+
+    std::unordered_map<std::string, StreamProfilingData> data;
+    for(const auto& kv : current) {
+        auto delta = kv.second;
+        if(base != nullptr) {
+            auto prev = base->second.find(kv.first);
+            if(prev != base->second.end()) {
+                delta.numBytesWritten -= prev->second.numBytesWritten;
+                delta.numBytesRead -= prev->second.numBytesRead;
+                delta.numPacketsWritten -= prev->second.numPacketsWritten;
+                delta.numPacketsRead -= prev->second.numPacketsRead;
+                delta.writeStallTime -= prev->second.writeStallTime;
+                delta.readWaitTime -= prev->second.readWaitTime;
+            }
+        }
+        if(elapsed > 0.0f) {
+            delta.writeRate = delta.numBytesWritten / elapsed;
+            delta.readRate = delta.numBytesRead / elapsed;
+        }
+        data[kv.first] = delta;
+    }
+
+    streamProfilingHistory.emplace_back(now, std::move(current));
+    while(streamProfilingHistory.size() > MAX_SNAPSHOTS || now - streamProfilingHistory.front().first > MAX_SNAPSHOT_AGE) {
+        streamProfilingHistory.pop_front();
+    }
+    return data;
+}
+
 ProfilingData XLinkConnection::getProfilingData() {
     ProfilingData data;
     XLinkProf_t prof;
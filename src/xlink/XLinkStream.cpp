@@ -30,11 +30,16 @@ XLinkStream::XLinkStream(const std::shared_ptr<XLinkConnection> conn, const std:
     }
 
     if(streamId == INVALID_STREAM_ID) throw std::runtime_error("Couldn't open stream");
+
+    profilingCounters = connection->getStreamProfilingCounters(streamName);
 }
 
 // Move constructor
 XLinkStream::XLinkStream(XLinkStream&& other)
-    : connection(std::move(other.connection)), streamName(std::exchange(other.streamName, {})), streamId(std::exchange(other.streamId, INVALID_STREAM_ID)) {
+    : connection(std::move(other.connection)),
+      streamName(std::exchange(other.streamName, {})),
+      streamId(std::exchange(other.streamId, INVALID_STREAM_ID)),
+      profilingCounters(std::move(other.profilingCounters)) {
     // Set other's streamId to INVALID_STREAM_ID to prevent closing
 }
 
@@ -43,6 +48,7 @@ XLinkStream& XLinkStream::operator=(XLinkStream&& other) {
         connection = std::move(other.connection);
         streamId = std::exchange(other.streamId, INVALID_STREAM_ID);
         streamName = std::exchange(other.streamName, {});
+        profilingCounters = std::move(other.profilingCounters);
     }
     return *this;
 }
@@ -78,10 +84,12 @@ StreamPacketDesc::~StreamPacketDesc() noexcept {
 ////////////////////
 
 void XLinkStream::write(const std::uint8_t* data, std::size_t size) {
+    const auto t1 = std::chrono::steady_clock::now();
     auto status = XLinkWriteData(streamId, data, static_cast<int>(size));
     if(status != X_LINK_SUCCESS) {
         throw XLinkWriteError(status, streamName);
     }
+    profilingCounters->recordWrite(size, std::chrono::steady_clock::now() - t1);
 }
 void XLinkStream::write(const void* data, std::size_t size) {
     write(reinterpret_cast<const uint8_t*>(data), size);
@@ -93,19 +101,23 @@ void XLinkStream::write(const std::vector<std::uint8_t>& data) {
 
 void XLinkStream::read(std::vector<std::uint8_t>& data) {
     StreamPacketDesc packet;
+    const auto t1 = std::chrono::steady_clock::now();
     const auto status = XLinkReadMoveData(streamId, &packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
+    profilingCounters->recordRead(packet.length, std::chrono::steady_clock::now() - t1);
     data = std::vector<std::uint8_t>(packet.data, packet.data + packet.length);
 }
 
 void XLinkStream::read(std::vector<std::uint8_t>& data, XLinkTimespec& timestampReceived) {
     StreamPacketDesc packet;
+    const auto t1 = std::chrono::steady_clock::now();
     const auto status = XLinkReadMoveData(streamId, &packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
+    profilingCounters->recordRead(packet.length, std::chrono::steady_clock::now() - t1);
     data = std::vector<std::uint8_t>(packet.data, packet.data + packet.length);
     timestampReceived = packet.tReceived;
 }
@@ -124,20 +136,24 @@ std::vector<std::uint8_t> XLinkStream::read(XLinkTimespec& timestampReceived) {
 
 StreamPacketDesc XLinkStream::readMove() {
     StreamPacketDesc packet;
+    const auto t1 = std::chrono::steady_clock::now();
     const auto status = XLinkReadMoveData(streamId, &packet);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
+    profilingCounters->recordRead(packet.length, std::chrono::steady_clock::now() - t1);
     return packet;
 }
 
 // USE ONLY WHEN COPYING DATA AT LATER STAGES
 streamPacketDesc_t* XLinkStream::readRaw() {
     streamPacketDesc_t* pPacket = nullptr;
+    const auto t1 = std::chrono::steady_clock::now();
     auto status = XLinkReadData(streamId, &pPacket);
     if(status != X_LINK_SUCCESS) {
         throw XLinkReadError(status, streamName);
     }
+    profilingCounters->recordRead(pPacket->length, std::chrono::steady_clock::now() - t1);
     return pPacket;
 }
 
@@ -156,10 +172,12 @@ void XLinkStream::writeSplit(const void* d, std::size_t size, std::size_t split)
     XLinkError_t ret = X_LINK_SUCCESS;
     while(remaining > 0) {
         sizeToTransmit = remaining > split ? split : remaining;
+        const auto t1 = std::chrono::steady_clock::now();
         ret = XLinkWriteData(streamId, data + currentOffset, static_cast<int>(sizeToTransmit));
         if(ret != X_LINK_SUCCESS) {
             throw XLinkWriteError(ret, streamName);
         }
+        profilingCounters->recordWrite(sizeToTransmit, std::chrono::steady_clock::now() - t1);
         currentOffset += sizeToTransmit;
         remaining = size - currentOffset;
     }
@@ -174,8 +192,10 @@ void XLinkStream::writeSplit(const std::vector<uint8_t>& data, std::size_t split
 //////////////////////
 
 bool XLinkStream::write(const std::uint8_t* data, std::size_t size, std::chrono::milliseconds timeout) {
+    const auto t1 = std::chrono::steady_clock::now();
     auto status = XLinkWriteDataWithTimeout(streamId, data, static_cast<int>(size), static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
+        profilingCounters->recordWrite(size, std::chrono::steady_clock::now() - t1);
         return true;
     } else if(status == X_LINK_TIMEOUT) {
         return false;
@@ -194,8 +214,10 @@ bool XLinkStream::write(const std::vector<std::uint8_t>& data, std::chrono::mill
 
 bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::milliseconds timeout) {
     StreamPacketDesc packet;
+    const auto t1 = std::chrono::steady_clock::now();
     const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
+        profilingCounters->recordRead(packet.length, std::chrono::steady_clock::now() - t1);
         data = std::vector<std::uint8_t>(packet.data, packet.data + packet.length);
         return true;
     } else if(status == X_LINK_TIMEOUT) {
@@ -206,8 +228,10 @@ bool XLinkStream::read(std::vector<std::uint8_t>& data, std::chrono::millisecond
 }
 
 bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::milliseconds timeout) {
+    const auto t1 = std::chrono::steady_clock::now();
     const auto status = XLinkReadMoveDataWithTimeout(streamId, &packet, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
+        profilingCounters->recordRead(packet.length, std::chrono::steady_clock::now() - t1);
         return true;
     } else if(status == X_LINK_TIMEOUT) {
         return false;
@@ -217,8 +241,10 @@ bool XLinkStream::readMove(StreamPacketDesc& packet, const std::chrono::millisec
 }
 
 bool XLinkStream::readRaw(streamPacketDesc_t*& pPacket, std::chrono::milliseconds timeout) {
+    const auto t1 = std::chrono::steady_clock::now();
     auto status = XLinkReadDataWithTimeout(streamId, &pPacket, static_cast<unsigned int>(timeout.count()));
     if(status == X_LINK_SUCCESS) {
+        profilingCounters->recordRead(pPacket->length, std::chrono::steady_clock::now() - t1);
         return true;
     } else if(status == X_LINK_TIMEOUT) {
         return false;
@@ -0,0 +1,306 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/device/AdaptiveQueuePolicy.hpp"
+#include "depthai/utility/LockingQueue.hpp"
+
+using dai::AdaptiveQueuePolicy;
+
+TEST_CASE("Budget is shared max-min fairly") {
+    // Small demands are met, the rest is split equally among the large ones
+    auto shares = AdaptiveQueuePolicy::shareBudget({100.0, 4000.0, 6000.0}, 2100.0);
+    REQUIRE(shares[0] == Catch::Approx(100.0));
+    REQUIRE(shares[1] == Catch::Approx(1000.0));
+    REQUIRE(shares[2] == Catch::Approx(1000.0));
+
+    // Everything fits
+    shares = AdaptiveQueuePolicy::shareBudget({100.0, 200.0}, 1000.0);
+    REQUIRE(shares[0] == Catch::Approx(100.0));
+    REQUIRE(shares[1] == Catch::Approx(200.0));
+
+    // Leftover of a smaller demand goes to larger ones
+    shares = AdaptiveQueuePolicy::shareBudget({900.0, 300.0, 1200.0}, 1500.0);
+    REQUIRE(shares[1] == Catch::Approx(300.0));
+    REQUIRE(shares[0] == Catch::Approx(600.0));
+    REQUIRE(shares[2] == Catch::Approx(600.0));
+
+    REQUIRE(AdaptiveQueuePolicy::shareBudget({}, 100.0).empty());
+}
+
+TEST_CASE("Overwriting queue counts dropped messages") {
+    dai::LockingQueue<int> queue(2, false);
+    for(int i = 0; i < 5; i++) queue.push(i);
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.getNumDropped() == 3);
+
+    int value = -1;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 3);
+
+    // Blocking queue never drops
+    dai::LockingQueue<int> blocking(2, true);
+    blocking.tryWaitAndPush(0, std::chrono::milliseconds(1));
+    blocking.tryWaitAndPush(1, std::chrono::milliseconds(1));
+    REQUIRE(!blocking.tryWaitAndPush(2, std::chrono::milliseconds(1)));
+    REQUIRE(blocking.getNumDropped() == 0);
+}
+
+TEST_CASE("Invalid policy configuration is rejected") {
+    AdaptiveQueuePolicy::Config config;
+    config.minSize = 0;
+    REQUIRE_THROWS_AS(AdaptiveQueuePolicy(config), std::invalid_argument);
+
+    config = {};
+    config.maxSize = 1;
+    config.minSize = 4;
+    REQUIRE_THROWS_AS(AdaptiveQueuePolicy(config), std::invalid_argument);
+
+    config = {};
+    config.smoothing = 0.0f;
+    REQUIRE_THROWS_AS(AdaptiveQueuePolicy(config), std::invalid_argument);
+
+    AdaptiveQueuePolicy policy;
+    REQUIRE_THROWS_AS(policy.addQueue(std::shared_ptr<dai::DataOutputQueue>()), std::invalid_argument);
+    REQUIRE_THROWS_AS(policy.addQueue(std::shared_ptr<AdaptiveQueuePolicy::Queue>()), std::invalid_argument);
+    policy.update();
+    REQUIRE(policy.getStates().empty());
+    REQUIRE(policy.getAdjustments().empty());
+    REQUIRE(policy.getNumDropped() == 0);
+}
+
+// Queue drained and fed at given rates, in 1ms steps. A full blocking queue stalls the producer, which then skips
+// messages as a device would
+class SimulatedQueue : public AdaptiveQueuePolicy::Queue {
+   public:
+    SimulatedQueue(unsigned maxSize, bool blocking) {
+        stats.name = "simulated";
+        stats.maxSize = maxSize;
+        stats.blocking = blocking;
+    }
+    dai::QueueStats getStats() const override {
+        return stats;
+    }
+    void setMaxSize(unsigned maxSize) override {
+        stats.maxSize = maxSize;
+    }
+    void setBlocking(bool blocking) override {
+        stats.blocking = blocking;
+    }
+    bool isClosed() const override {
+        return closed;
+    }
+
+    /**
+     * @param consumerPeriod If set, the consumer takes all messages once per period instead of at 'consumerRate'
+     */
+    void run(double producerRate,
+             double consumerRate,
+             std::chrono::milliseconds duration,
+             std::size_t bytes = 1000,
+             std::chrono::milliseconds consumerPeriod = std::chrono::milliseconds(0)) {
+        for(long ms = 0; ms < duration.count(); ms++, time++) {
+            if(consumerPeriod.count() > 0) {
+                if(time % consumerPeriod.count() == 0) pop(stats.size);
+            } else {
+                consumed = std::min(consumed + consumerRate / 1000.0, stats.size + 1.0);
+                const auto count = std::min<std::size_t>(static_cast<std::size_t>(consumed), stats.size);
+                consumed -= static_cast<double>(count);
+                pop(count);
+            }
+            produced += producerRate / 1000.0;
+            while(produced >= 1.0) {
+                if(stats.size >= stats.maxSize) {
+                    if(stats.blocking) {
+                        produced = 1.0;
+                        break;
+                    }
+                    stats.numDropped += stats.size - stats.maxSize + 1;
+                    stats.size = stats.maxSize - 1;
+                }
+                stats.size++;
+                stats.numPushed++;
+                stats.numBytesPushed += bytes;
+                produced -= 1.0;
+            }
+        }
+    }
+
+    dai::QueueStats stats;
+    bool closed = false;
+
+   private:
+    double produced = 0.0;
+    double consumed = 0.0;
+    long time = 0;
+
+    void pop(std::size_t count) {
+        stats.size -= count;
+        stats.numPopped += count;
+    }
+};
+
+// Runs the queues for a period each, then updates the policy
+class Simulation {
+   public:
+    explicit Simulation(AdaptiveQueuePolicy& policy) : policy(policy), now(std::chrono::steady_clock::now()) {}
+    template <typename Run>
+    void step(Run run) {
+        run(PERIOD);
+        now += PERIOD;
+        policy.update(now);
+    }
+    static constexpr std::chrono::milliseconds PERIOD{500};
+
+   private:
+    AdaptiveQueuePolicy& policy;
+    std::chrono::steady_clock::time_point now;
+};
+constexpr std::chrono::milliseconds Simulation::PERIOD;
+
+TEST_CASE("Queue of a consumer keeping up is kept small") {
+    AdaptiveQueuePolicy policy;
+    auto queue = std::make_shared<SimulatedQueue>(16, true);
+    policy.addQueue(queue);
+    Simulation simulation(policy);
+
+    for(int i = 0; i < 3; i++) simulation.step([&](std::chrono::milliseconds duration) { queue->run(30.0, 60.0, duration); });
+    REQUIRE(queue->stats.maxSize == 2);
+    REQUIRE(queue->stats.blocking);
+    REQUIRE(queue->stats.numDropped == 0);
+
+    const auto state = policy.getStates().at(0);
+    REQUIRE(state.producerRate == Catch::Approx(30.0).margin(2.0));
+    REQUIRE(state.consumerRate == Catch::Approx(30.0).margin(2.0));
+    REQUIRE(state.messageBytes == Catch::Approx(1000.0));
+    REQUIRE(policy.getAdjustments().size() == 1);
+}
+
+TEST_CASE("Queue of a bursty consumer grows") {
+    AdaptiveQueuePolicy policy;
+    auto queue = std::make_shared<SimulatedQueue>(4, true);
+    policy.addQueue(queue);
+    Simulation simulation(policy);
+
+    // Consumer takes all messages every 250ms
+    auto bursty = [&](std::chrono::milliseconds duration) { queue->run(30.0, 0.0, duration, 1000, std::chrono::milliseconds(250)); };
+    for(int i = 0; i < 3; i++) simulation.step(bursty);
+    REQUIRE(queue->stats.maxSize > 4);
+    REQUIRE(queue->stats.maxSize <= 15);
+    REQUIRE(queue->stats.blocking);
+}
+
+TEST_CASE("Lagging consumer switches to overwriting and back once caught up") {
+    AdaptiveQueuePolicy::Config config;
+    config.slowUpdates = 3;
+    AdaptiveQueuePolicy policy(config);
+    auto queue = std::make_shared<SimulatedQueue>(8, true);
+    policy.addQueue(queue);
+    Simulation simulation(policy);
+    auto lagging = [&](std::chrono::milliseconds duration) { queue->run(30.0, 10.0, duration); };
+
+    // Full, but switched only after 'slowUpdates' updates
+    simulation.step(lagging);
+    simulation.step(lagging);
+    REQUIRE(queue->stats.blocking);
+    simulation.step(lagging);
+    REQUIRE_FALSE(queue->stats.blocking);
+    REQUIRE(policy.getStates().at(0).overwriting);
+
+    // Depth is bounded by what the consumer drains within the target latency
+    simulation.step(lagging);
+    simulation.step(lagging);
+    const auto state = policy.getStates().at(0);
+    REQUIRE(state.producerRate > 2.0f * state.consumerRate);
+    REQUIRE(queue->stats.maxSize == 5);
+    REQUIRE(queue->stats.numDropped > 0);
+
+    // Stays overwriting until caught up for 'slowUpdates' updates
+    auto fast = [&](std::chrono::milliseconds duration) { queue->run(30.0, 60.0, duration); };
+    simulation.step(fast);
+    simulation.step(fast);
+    REQUIRE_FALSE(queue->stats.blocking);
+    simulation.step(fast);
+    REQUIRE(queue->stats.blocking);
+    REQUIRE_FALSE(policy.getStates().at(0).overwriting);
+}
+
+TEST_CASE("Memory budget is enforced") {
+    AdaptiveQueuePolicy::Config config;
+    config.memoryBudget = 3 * 1000 * 1000 + 1000;
+    config.minSize = 1;
+    AdaptiveQueuePolicy policy(config);
+    auto frames = std::make_shared<SimulatedQueue>(8, false);
+    auto metadata = std::make_shared<SimulatedQueue>(8, false);
+    policy.addQueue(frames);
+    policy.addQueue(metadata);
+    Simulation simulation(policy);
+
+    // Both lag, so want 5 messages each
+    for(int i = 0; i < 2; i++) {
+        simulation.step([&](std::chrono::milliseconds duration) {
+            frames->run(30.0, 10.0, duration, 1000 * 1000);
+            metadata->run(30.0, 10.0, duration, 100);
+        });
+    }
+    REQUIRE(metadata->stats.maxSize == 5);
+    REQUIRE(frames->stats.maxSize == 3);
+}
+
+TEST_CASE("Rates are smoothed and closed queues released") {
+    AdaptiveQueuePolicy::Config config;
+    config.smoothing = 0.5f;
+    AdaptiveQueuePolicy policy(config);
+    auto queue = std::make_shared<SimulatedQueue>(64, false);
+    policy.addQueue(queue);
+    policy.addQueue(queue);
+    Simulation simulation(policy);
+
+    // First measurement is taken as is
+    simulation.step([&](std::chrono::milliseconds duration) { queue->run(40.0, 100.0, duration); });
+    REQUIRE(policy.getStates().size() == 1);
+    REQUIRE(policy.getStates().at(0).producerRate == Catch::Approx(40.0).margin(2.0));
+    simulation.step([&](std::chrono::milliseconds duration) { queue->run(20.0, 100.0, duration); });
+    REQUIRE(policy.getStates().at(0).producerRate == Catch::Approx(30.0).margin(2.0));
+
+    queue->closed = true;
+    policy.update();
+    REQUIRE(policy.getStates().empty());
+}
+
+TEST_CASE("Unbuffered queue is left alone") {
+    AdaptiveQueuePolicy policy;
+    auto queue = std::make_shared<SimulatedQueue>(0, true);
+    policy.addQueue(queue);
+    Simulation simulation(policy);
+
+    for(int i = 0; i < 6; i++) {
+        simulation.step([&](std::chrono::milliseconds) {
+            queue->stats.numPushed += 15;
+            queue->stats.numBytesPushed += 15 * 1000;
+        });
+    }
+    REQUIRE(queue->stats.maxSize == 0);
+    REQUIRE(queue->stats.blocking);
+    REQUIRE(policy.getAdjustments().empty());
+}
+
+TEST_CASE("Removed queue is no longer managed") {
+    AdaptiveQueuePolicy policy;
+    auto kept = std::make_shared<SimulatedQueue>(16, true);
+    auto removed = std::make_shared<SimulatedQueue>(16, true);
+    policy.addQueue(kept);
+    policy.addQueue(removed);
+    REQUIRE(policy.removeQueue(removed));
+    REQUIRE_FALSE(policy.removeQueue(removed));
+    REQUIRE_FALSE(policy.removeQueue(std::shared_ptr<dai::DataOutputQueue>()));
+    Simulation simulation(policy);
+
+    for(int i = 0; i < 3; i++) {
+        simulation.step([&](std::chrono::milliseconds duration) {
+            kept->run(30.0, 60.0, duration);
+            removed->run(30.0, 60.0, duration);
+        });
+    }
+    REQUIRE(kept->stats.maxSize == 2);
+    REQUIRE(removed->stats.maxSize == 16);
+    REQUIRE(policy.getStates().size() == 1);
+}
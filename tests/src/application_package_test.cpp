@@ -0,0 +1,33 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+
+static dai::Pipeline createPipeline() {
+    dai::Pipeline pipeline;
+    auto xin = pipeline.create<dai::node::XLinkIn>();
+    auto xout = pipeline.create<dai::node::XLinkOut>();
+    xin->setStreamName("in");
+    xout->setStreamName("out");
+    xin->out.link(xout->input);
+    return pipeline;
+}
+
+TEST_CASE("Compressed application package is reproducible") {
+    auto pipeline = createPipeline();
+
+    // Second package reuses the cached compressed firmware
+    auto first = dai::DeviceBootloader::createDepthaiApplicationPackage(pipeline, true, "app");
+    auto second = dai::DeviceBootloader::createDepthaiApplicationPackage(pipeline, true, "app");
+    REQUIRE(first == second);
+
+    auto uncompressed = dai::DeviceBootloader::createDepthaiApplicationPackage(pipeline, false, "app");
+    REQUIRE(first.size() < uncompressed.size());
+
+    // Application specific sections are still rebuilt
+    auto other = dai::DeviceBootloader::createDepthaiApplicationPackage(pipeline, true, "other");
+    REQUIRE(other != first);
+}
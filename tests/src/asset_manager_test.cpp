@@ -0,0 +1,187 @@
+#include <catch2/catch_all.hpp>
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <vector>
+
+// Include depthai library
+#include <depthai/depthai.hpp>
+
+static std::vector<std::uint8_t> makeData(std::size_t size, std::uint8_t seed) {
+    std::vector<std::uint8_t> data(size);
+    for(std::size_t i = 0; i < size; i++) data[i] = static_cast<std::uint8_t>(seed + i * 7);
+    return data;
+}
+
+TEST_CASE("AssetStorage layout matches contiguous serialization") {
+    dai::AssetManager manager;
+    manager.set("a", makeData(100, 1), 64);
+    manager.set("b", makeData(3, 2), 1);
+    manager.set("c", makeData(1000, 3), 64);
+    manager.set("empty", std::vector<std::uint8_t>{}, 64);
+
+    dai::AssetsMutable assetsVector, assetsStorage;
+    std::vector<std::uint8_t> vector;
+    manager.serialize(assetsVector, vector);
+    dai::AssetStorage storage;
+    manager.serialize(assetsStorage, storage);
+
+    REQUIRE(storage.size() == vector.size());
+    REQUIRE(storage.toVector() == vector);
+    REQUIRE(assetsStorage.map.size() == assetsVector.map.size());
+    for(const auto& kv : assetsVector.map) {
+        REQUIRE(assetsStorage.map.at(kv.first).offset == kv.second.offset);
+        REQUIRE(assetsStorage.map.at(kv.first).size == kv.second.size);
+    }
+
+    // Pieces are full sized, except the last one, and concatenate to the same contents
+    for(std::size_t maxSize : {1, 7, 64, 100, 5000}) {
+        std::vector<std::uint8_t> written;
+        std::vector<std::size_t> sizes;
+        storage.write(maxSize, [&](const std::uint8_t* data, std::size_t size) {
+            written.insert(written.end(), data, data + size);
+            sizes.push_back(size);
+        });
+        REQUIRE(written == vector);
+        for(std::size_t i = 0; i + 1 < sizes.size(); i++) REQUIRE(sizes[i] == maxSize);
+    }
+    REQUIRE_THROWS_AS(storage.write(0, [](const std::uint8_t*, std::size_t) {}), std::invalid_argument);
+}
+
+TEST_CASE("AssetManager maps large files") {
+    const std::string path = std::string(std::tmpnam(nullptr)) + "_asset.bin";
+    auto large = makeData(3 * 1024 * 1024 + 5, 4);
+    auto small = makeData(10, 5);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(large.data()), large.size());
+    }
+
+    dai::AssetManager manager;
+    manager.set("small", small);
+
+    // Plain set keeps loading into data
+    auto copied = manager.set("copied", dai::Path(path));
+    REQUIRE(copied->mapped == nullptr);
+    REQUIRE(copied->data == large);
+    manager.remove("copied");
+
+    auto asset = manager.setMapped("large", dai::Path(path));
+    REQUIRE(asset->mapped != nullptr);
+    REQUIRE(asset->data.empty());
+    REQUIRE(asset->getSize() == large.size());
+    REQUIRE(std::vector<std::uint8_t>(asset->getData(), asset->getData() + asset->getSize()) == large);
+
+    // Renaming an asset keeps the mapping
+    auto renamed = manager.set("renamed", *asset);
+    REQUIRE(renamed->getSize() == large.size());
+    REQUIRE(renamed->getData() == asset->getData());
+
+    dai::AssetsMutable assets;
+    dai::AssetStorage storage;
+    manager.serialize(assets, storage, "/test/");
+    auto contents = storage.toVector();
+    const auto& internal = assets.map.at("/test/large");
+    REQUIRE(internal.size == large.size());
+    REQUIRE(std::vector<std::uint8_t>(contents.begin() + internal.offset, contents.begin() + internal.offset + internal.size) == large);
+
+    manager.remove("large");
+    manager.remove("renamed");
+    storage = {};
+    asset.reset();
+    renamed.reset();
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS_WITH(manager.set("missing", dai::Path(path)), Catch::Matchers::ContainsSubstring("Cannot load asset"));
+    REQUIRE_THROWS_WITH(manager.setMapped("missing", dai::Path(path)), Catch::Matchers::ContainsSubstring("Cannot load asset"));
+}
+
+TEST_CASE("AssetStorage stores identical assets once") {
+    auto blob = makeData(10000, 6);
+    dai::AssetManager pipelineAssets, nodeAssets;
+    pipelineAssets.set("blob", blob, 64);
+    nodeAssets.set("__blob", blob, 64);
+    nodeAssets.set("other", makeData(10000, 7), 64);
+    // Same data, but existing copy isn't aligned suitably
+    pipelineAssets.set("unaligned", makeData(1, 8), 1);
+    nodeAssets.set("aligned", makeData(1, 8), 128);
+
+    dai::AssetsMutable assets;
+    dai::AssetStorage storage;
+    pipelineAssets.serialize(assets, storage, "/pipeline/");
+    nodeAssets.serialize(assets, storage, "/node/0/");
+
+    REQUIRE(assets.map.at("/pipeline/blob").offset == assets.map.at("/node/0/__blob").offset);
+    REQUIRE(assets.map.at("/pipeline/blob").offset != assets.map.at("/node/0/other").offset);
+    REQUIRE(assets.map.at("/pipeline/unaligned").offset % 128 != 0);
+    REQUIRE(assets.map.at("/node/0/aligned").offset % 128 == 0);
+    REQUIRE(storage.getChunks().size() == 4);
+    REQUIRE(storage.getDeduplicatedSize() == blob.size());
+
+    // Every key resolves to its data
+    auto contents = storage.toVector();
+    const auto& internal = assets.map.at("/node/0/__blob");
+    REQUIRE(std::vector<std::uint8_t>(contents.begin() + internal.offset, contents.begin() + internal.offset + internal.size) == blob);
+}
+
+// Stand-in for a receiver which keeps asset data by hash across pipeline starts
+class CachingReceiver {
+    std::map<dai::AssetStorage::Hash, std::vector<std::uint8_t>> held;
+
+   public:
+    std::size_t received = 0;
+
+    bool holds(const dai::AssetStorage::Chunk& chunk) const {
+        return held.count(chunk.hash) > 0;
+    }
+
+    std::vector<std::uint8_t> upload(const dai::AssetStorage& storage) {
+        std::vector<std::uint8_t> stream;
+        auto writer = [&stream](const std::uint8_t* data, std::size_t size) { stream.insert(stream.end(), data, data + size); };
+        storage.write(4096, writer, [this](const dai::AssetStorage::Chunk& chunk) { return holds(chunk); });
+        received += stream.size();
+
+        // Rebuild storage from the layout, the stream and held data
+        std::vector<std::uint8_t> result;
+        std::size_t streamOffset = 0;
+        for(const auto& chunk : storage.getChunks()) {
+            auto padding = chunk.offset - result.size();
+            result.insert(result.end(), stream.begin() + streamOffset, stream.begin() + streamOffset + padding);
+            streamOffset += padding;
+            if(!holds(chunk)) {
+                auto size = chunk.asset->getSize();
+                held[chunk.hash] = std::vector<std::uint8_t>(stream.begin() + streamOffset, stream.begin() + streamOffset + size);
+                streamOffset += size;
+            }
+            const auto& data = held.at(chunk.hash);
+            result.insert(result.end(), data.begin(), data.end());
+        }
+        REQUIRE(streamOffset == stream.size());
+        return result;
+    }
+};
+
+TEST_CASE("AssetStorage upload skips assets held by the receiver") {
+    dai::AssetManager manager;
+    manager.set("a", makeData(100000, 9), 64);
+    manager.set("b", makeData(50000, 10), 64);
+
+    CachingReceiver receiver;
+    dai::AssetsMutable assets;
+    dai::AssetStorage storage;
+    manager.serialize(assets, storage);
+    REQUIRE(receiver.upload(storage) == storage.toVector());
+    REQUIRE(receiver.received == storage.size());
+
+    // Restart with one asset changed, only that one is transferred again
+    manager.set("b", makeData(50000, 11), 64);
+    dai::AssetsMutable assets2;
+    dai::AssetStorage storage2;
+    manager.serialize(assets2, storage2);
+    receiver.received = 0;
+    REQUIRE(receiver.upload(storage2) == storage2.toVector());
+    REQUIRE(receiver.received < 50000 + 64);
+    REQUIRE(receiver.received >= 50000);
+}
@@ -0,0 +1,67 @@
+#include <catch2/catch_all.hpp>
+#include <cmath>
+
+#include "depthai/device/CalibrationHandler.hpp"
+
+using namespace dai;
+
+static CalibrationHandler createCalibration() {
+    const float s = std::sin(0.3f), c = std::cos(0.3f);
+    std::vector<std::vector<float>> rotation = {{c, -s, 0}, {s, c, 0}, {0, 0, 1}};
+    std::vector<std::vector<float>> identity = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}};
+
+    CalibrationHandler calib;
+    calib.setCameraIntrinsics(CameraBoardSocket::CAM_A, identity, 1920, 1080);
+    calib.setCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C, rotation, {7.5f, 0, 0}, {7.5f, 0, 0});
+    calib.setCameraExtrinsics(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A, rotation, {-3.75f, 1, 0});
+    calib.setImuExtrinsics(CameraBoardSocket::CAM_C, rotation, {1, 2, 3});
+    return calib;
+}
+
+static void requireEqual(const std::vector<std::vector<float>>& a, const Matrix4f& b) {
+    REQUIRE(a.size() == 4);
+    for(size_t i = 0; i < 4; i++) {
+        REQUIRE(a[i].size() == 4);
+        for(size_t j = 0; j < 4; j++) {
+            REQUIRE(a[i][j] == Catch::Approx(b[i][j]).margin(1e-5));
+        }
+    }
+}
+
+TEST_CASE("Camera extrinsics chain and inverse") {
+    auto calib = createCalibration();
+    auto bc = calib.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C);
+    auto ca = calib.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A);
+
+    requireEqual(calib.getCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_A), matrix::multiply(ca, bc));
+    requireEqual(calib.getCameraExtrinsics(CameraBoardSocket::CAM_A, CameraBoardSocket::CAM_B), matrix::invertSe3(matrix::multiply(ca, bc)));
+    REQUIRE(calib.getBaselineDistance(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C, false) == Catch::Approx(7.5f));
+}
+
+TEST_CASE("IMU extrinsics") {
+    auto calib = createCalibration();
+    auto imuToC = calib.getImuToCameraExtrinsicsMatrix(CameraBoardSocket::CAM_C);
+    auto ca = calib.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_C, CameraBoardSocket::CAM_A);
+
+    requireEqual(calib.getImuToCameraExtrinsics(CameraBoardSocket::CAM_A), matrix::multiply(ca, imuToC));
+    requireEqual(calib.getCameraToImuExtrinsics(CameraBoardSocket::CAM_A), matrix::invertSe3(matrix::multiply(ca, imuToC)));
+}
+
+TEST_CASE("Extrinsics errors") {
+    auto calib = createCalibration();
+    // CAM_C -> CAM_A has no spec translation
+    REQUIRE_THROWS_AS(calib.getCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_A, true), std::runtime_error);
+    REQUIRE_NOTHROW(calib.getCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C, true));
+    REQUIRE_THROWS_AS(calib.getCameraExtrinsics(CameraBoardSocket::CAM_A, CameraBoardSocket::CAM_A), std::runtime_error);
+    REQUIRE_THROWS_AS(calib.getCameraExtrinsics(CameraBoardSocket::CAM_D, CameraBoardSocket::CAM_A), std::runtime_error);
+    REQUIRE_THROWS_AS(CalibrationHandler().getImuToCameraExtrinsics(CameraBoardSocket::CAM_A), std::runtime_error);
+}
+
+TEST_CASE("Extrinsics are updated after modification") {
+    auto calib = createCalibration();
+    auto before = calib.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C);
+    calib.setCameraExtrinsics(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C, {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}, {5.0f, 0, 0});
+    auto after = calib.getCameraExtrinsicsMatrix(CameraBoardSocket::CAM_B, CameraBoardSocket::CAM_C);
+    REQUIRE(before[0][3] == Catch::Approx(7.5f));
+    REQUIRE(after[0][3] == Catch::Approx(5.0f));
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch_all.hpp>
+
+#include <random>
+
+#include "depthai/device/ClockSync.hpp"
+
+using namespace std::chrono_literals;
+using TimePoint = std::chrono::steady_clock::time_point;
+
+static std::chrono::nanoseconds absDiff(std::chrono::nanoseconds d) {
+    return d < 0ns ? -d : d;
+}
+
+TEST_CASE("Estimator without samples is invalid") {
+    dai::ClockSyncEstimator estimator;
+    REQUIRE(!estimator.getModel().valid);
+    REQUIRE_THROWS_AS(dai::ClockSyncEstimator(1s, 0ms), std::invalid_argument);
+}
+
+TEST_CASE("Offset and drift are recovered under latency spikes") {
+    dai::ClockSyncEstimator estimator(5min, 1s);
+
+    // Host runs 40 ppm faster than device and is 12.5 s ahead of it
+    const double drift = 40e-6;
+    const auto offset = 12500ms;
+    const TimePoint deviceStart{1000s};
+    auto trueHost = [&](TimePoint device) {
+        const auto since = std::chrono::duration<double, std::nano>(device - deviceStart).count();
+        return device + offset + std::chrono::nanoseconds(static_cast<std::int64_t>(drift * since));
+    };
+
+    // Minimal link latency of 80 us with exponential jitter and occasional bursts where the link is congested
+    std::mt19937 rng(42);
+    std::exponential_distribution<double> jitter(1.0 / 200e3);
+    const auto minLatency = 80us;
+    for(int burst = 0; burst < 60; burst++) {
+        const bool congested = burst % 7 == 3;
+        for(int i = 0; i < 10; i++) {
+            const TimePoint device = deviceStart + burst * 5s + i * 10ms;
+            auto latency = minLatency + std::chrono::nanoseconds(static_cast<std::int64_t>(jitter(rng)));
+            if(congested) latency += 8ms;
+            estimator.addSample(device, trueHost(device) + latency);
+        }
+    }
+
+    const auto model = estimator.getModel();
+    REQUIRE(model.valid);
+    // Congested bursts are rejected
+    REQUIRE(model.numSamples == 60 - 60 / 7 - 1);
+    REQUIRE(model.drift == Catch::Approx(drift).margin(1e-6));
+    REQUIRE(model.error < 100us);
+
+    // Mapping is off by about the minimal latency, which one way samples can't observe, and within the error otherwise
+    for(auto device : {deviceStart, deviceStart + 150s, deviceStart + 300s}) {
+        const auto error = model.toHost(device) - trueHost(device) - minLatency;
+        REQUIRE(absDiff(error) < 200us);
+        REQUIRE(absDiff(model.toDevice(model.toHost(device)) - device) < 1us);
+    }
+    REQUIRE(model.getError(deviceStart + 600s) > model.getError(model.deviceReference));
+}
+
+TEST_CASE("Device clock going backwards resets the estimate") {
+    dai::ClockSyncEstimator estimator;
+    for(int i = 0; i < 10; i++) estimator.addSample(TimePoint{100s + i * 1s}, TimePoint{200s + i * 1s});
+    REQUIRE(estimator.getModel().numSamples == 10);
+
+    estimator.addSample(TimePoint{5s}, TimePoint{300s});
+    const auto model = estimator.getModel();
+    REQUIRE(model.numSamples == 1);
+    REQUIRE(model.offset == 295s);
+    REQUIRE(model.driftError == dai::ClockSyncEstimator::DEFAULT_DRIFT_BOUND);
+}
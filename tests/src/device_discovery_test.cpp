@@ -0,0 +1,83 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+
+#include "depthai/depthai.hpp"
+#include "depthai/xlink/DeviceDiscovery.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Reads are served from the device table") {
+    auto& discovery = dai::DeviceDiscovery::getInstance();
+    auto devices = discovery.getDevices();
+    REQUIRE(!devices.empty());
+
+    // Table was just refreshed, subsequent reads don't enumerate again
+    auto t1 = std::chrono::steady_clock::now();
+    for(int i = 0; i < 10; i++) {
+        REQUIRE(dai::Device::getAllConnectedDevices().size() == devices.size());
+    }
+    REQUIRE(std::chrono::steady_clock::now() - t1 < discovery.getScanInterval() * 10);
+}
+
+TEST_CASE("Subscribers are notified when a device is booted") {
+    auto& discovery = dai::DeviceDiscovery::getInstance();
+
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::vector<dai::DeviceInfo> changed;  // added or changed
+    auto id = discovery.addCallback([&](dai::DeviceDiscovery::Event event, dai::DeviceInfo info) {
+        if(event == dai::DeviceDiscovery::Event::REMOVED) return;
+        std::unique_lock<std::mutex> l(mtx);
+        changed.push_back(info);
+        cv.notify_all();
+    });
+
+    bool found = false;
+    dai::DeviceInfo deviceInfo;
+    std::tie(found, deviceInfo) = dai::Device::getAnyAvailableDevice();
+    REQUIRE(found);
+    dai::Device device(deviceInfo);
+
+    {
+        std::unique_lock<std::mutex> l(mtx);
+        REQUIRE(cv.wait_for(l, 5s, [&]() {
+            for(const auto& info : changed) {
+                if(info.getMxId() == device.getMxId() && info.state == X_LINK_BOOTED) return true;
+            }
+            return false;
+        }));
+    }
+    REQUIRE(discovery.removeCallback(id));
+    REQUIRE_FALSE(discovery.removeCallback(id));
+}
+
+TEST_CASE("Callback can remove itself and use the table") {
+    auto& discovery = dai::DeviceDiscovery::getInstance();
+
+    std::atomic<int> id{-1};
+    std::atomic<int> calls{0};
+    std::atomic<bool> removed{false}, done{false};
+    id = discovery.addCallback([&](dai::DeviceDiscovery::Event, dai::DeviceInfo) {
+        // Ignore events delivered before the id is known
+        if(id < 0) return;
+        calls++;
+        removed = discovery.removeCallback(id);
+        // Rescans from within a callback
+        discovery.invalidate();
+        discovery.getDevices();
+        done = true;
+    });
+
+    bool found = false;
+    dai::DeviceInfo deviceInfo;
+    std::tie(found, deviceInfo) = dai::Device::getAnyAvailableDevice();
+    REQUIRE(found);
+    dai::Device device(deviceInfo);
+
+    auto t1 = std::chrono::steady_clock::now();
+    while(!done && std::chrono::steady_clock::now() - t1 < 5s) std::this_thread::sleep_for(10ms);
+    REQUIRE(done);
+    REQUIRE(calls == 1);
+    REQUIRE(removed);
+    REQUIRE_FALSE(discovery.removeCallback(id));
+}
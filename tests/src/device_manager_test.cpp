@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/depthai.hpp"
+
+using namespace std::chrono_literals;
+
+static dai::Pipeline createPipeline() {
+    dai::Pipeline pipeline;
+    auto xin = pipeline.create<dai::node::XLinkIn>();
+    auto xout = pipeline.create<dai::node::XLinkOut>();
+    xin->setStreamName("in");
+    xout->setStreamName("out");
+    xin->out.link(xout->input);
+    return pipeline;
+}
+
+TEST_CASE("Concurrent bring-up with a shared pipeline") {
+    auto devices = dai::DeviceManager::discover(2, 3s);
+    REQUIRE(!devices.empty());
+
+    dai::DeviceManager manager;
+    auto results = manager.open(devices, createPipeline());
+    REQUIRE(results.size() == devices.size());
+    for(const auto& result : results) {
+        INFO(result.error);
+        REQUIRE(result.success());
+        REQUIRE(result.timings.total >= result.timings.boot + result.timings.pipeline);
+
+        auto in = result.device->getInputQueue("in");
+        auto out = result.device->getOutputQueue("out");
+        dai::Buffer buffer;
+        buffer.setData(std::vector<std::uint8_t>(1024, 0xAB));
+        in->send(buffer);
+        bool timedOut = false;
+        auto received = out->get<dai::Buffer>(1s, timedOut);
+        REQUIRE(!timedOut);
+        REQUIRE(received->getData().size() == 1024);
+    }
+}
+
+TEST_CASE("Per device pipelines and failures") {
+    auto devices = dai::DeviceManager::discover(1, 3s);
+    REQUIRE(!devices.empty());
+
+    // Invalid device is reported without affecting the others
+    devices.push_back(dai::DeviceInfo("0.0.0.0-invalid"));
+
+    dai::DeviceManager manager;
+    manager.setMaxConcurrency(2);
+    int numCalls = 0;
+    auto results = manager.open(devices, [&numCalls](const dai::DeviceInfo&) {
+        numCalls++;
+        return createPipeline();
+    });
+    REQUIRE(numCalls == static_cast<int>(devices.size()));
+    REQUIRE(results.size() == devices.size());
+    for(std::size_t i = 0; i + 1 < results.size(); i++) {
+        INFO(results[i].error);
+        REQUIRE(results[i].success());
+    }
+    REQUIRE_FALSE(results.back().success());
+    REQUIRE_FALSE(results.back().error.empty());
+}
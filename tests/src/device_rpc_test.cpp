@@ -0,0 +1,42 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/depthai.hpp"
+
+TEST_CASE("Concurrent RPC calls") {
+    dai::Device device;
+    const auto mxId = device.getMxId();
+
+    // Pipelined calls from many threads must each get their own response
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 8; t++) {
+        threads.emplace_back([&]() {
+            for(int i = 0; i < 20; i++) {
+                if(device.getMxId() != mxId) mismatches++;
+                if(device.getDdrMemoryUsage().total <= 0) mismatches++;
+                if(device.isPipelineRunning()) mismatches++;
+            }
+        });
+    }
+    for(auto& thread : threads) thread.join();
+    REQUIRE(mismatches == 0);
+}
+
+TEST_CASE("Batched system information") {
+    dai::Device device;
+    auto info = device.getSystemInformation();
+    auto ddr = device.getDdrMemoryUsage();
+    REQUIRE(info.ddrMemoryUsage.total == ddr.total);
+    REQUIRE(info.cmxMemoryUsage.total > 0);
+    REQUIRE(info.leonCssMemoryUsage.total > 0);
+    REQUIRE(info.leonMssMemoryUsage.total > 0);
+    REQUIRE(info.chipTemperature.average > 0.0f);
+}
+
+TEST_CASE("Batched status") {
+    dai::Device device;
+    auto status = device.getStatus();
+    REQUIRE(status.systemInformation.ddrMemoryUsage.total > 0);
+    REQUIRE(status.connectedCameras == device.getConnectedCameras());
+    REQUIRE(status.pipelineRunning == device.isPipelineRunning());
+}
@@ -0,0 +1,148 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "../../src/device/DeviceRuntime.hpp"
+
+using namespace std::chrono_literals;
+using dai::DeviceRuntime;
+using Clock = std::chrono::steady_clock;
+
+template <typename Predicate>
+static bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = 2s) {
+    const auto deadline = Clock::now() + timeout;
+    while(!predicate()) {
+        if(Clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+TEST_CASE("Task is rescheduled by its return value until STOP") {
+    DeviceRuntime runtime(2);
+    std::atomic<int> count{0};
+    const auto scheduled = Clock::now();
+    Clock::time_point last;
+    runtime.schedule(10ms, [&]() {
+        last = Clock::now();
+        return ++count < 3 ? 20ms : DeviceRuntime::STOP;
+    });
+
+    REQUIRE(waitFor([&]() { return count == 3; }));
+    REQUIRE(last - scheduled >= 50ms);
+
+    // Stopped task doesn't run again
+    std::this_thread::sleep_for(50ms);
+    REQUIRE(count == 3);
+}
+
+TEST_CASE("Earlier deadline wakes an idle timer") {
+    DeviceRuntime runtime(1);
+    std::atomic<bool> late{false}, early{false};
+    runtime.schedule(10s, [&]() {
+        late = true;
+        return DeviceRuntime::STOP;
+    });
+    std::this_thread::sleep_for(10ms);
+
+    const auto scheduled = Clock::now();
+    runtime.schedule(5ms, [&]() {
+        early = true;
+        return DeviceRuntime::STOP;
+    });
+    REQUIRE(waitFor([&]() { return early.load(); }));
+    REQUIRE(Clock::now() - scheduled < 1s);
+    REQUIRE_FALSE(late);
+}
+
+TEST_CASE("Cancel waits for a running task") {
+    DeviceRuntime runtime(2);
+    std::atomic<bool> started{false}, finished{false};
+    std::atomic<int> count{0};
+    auto id = runtime.schedule(0ms, [&]() {
+        count++;
+        started = true;
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+        return 1ms;
+    });
+
+    REQUIRE(waitFor([&]() { return started.load(); }));
+    runtime.cancel(id);
+    REQUIRE(finished);
+    const int runs = count;
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(count == runs);
+
+    // Cancelling again or an unknown id is a no-op
+    runtime.cancel(id);
+    runtime.cancel(12345);
+}
+
+TEST_CASE("Cancel before the first run") {
+    DeviceRuntime runtime(1);
+    std::atomic<bool> ran{false};
+    auto id = runtime.schedule(20ms, [&]() {
+        ran = true;
+        return DeviceRuntime::STOP;
+    });
+    runtime.cancel(id);
+    std::this_thread::sleep_for(50ms);
+    REQUIRE_FALSE(ran);
+}
+
+TEST_CASE("Task can cancel itself") {
+    DeviceRuntime runtime(1);
+    std::atomic<DeviceRuntime::TaskId> id{0};
+    std::atomic<int> count{0};
+    id = runtime.schedule(10ms, [&]() {
+        count++;
+        runtime.cancel(id);
+        return 1ms;
+    });
+
+    REQUIRE(waitFor([&]() { return count == 1; }));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(count == 1);
+
+    // Runtime keeps serving other tasks
+    std::atomic<bool> ran{false};
+    runtime.schedule(0ms, [&]() {
+        ran = true;
+        return DeviceRuntime::STOP;
+    });
+    REQUIRE(waitFor([&]() { return ran.load(); }));
+}
+
+TEST_CASE("Task doesn't run concurrently with itself") {
+    DeviceRuntime runtime(4);
+    std::atomic<int> active{0}, maxActive{0}, count{0};
+    runtime.schedule(0ms, [&]() {
+        maxActive = std::max(maxActive.load(), ++active);
+        std::this_thread::sleep_for(2ms);
+        active--;
+        return ++count < 20 ? 0ms : DeviceRuntime::STOP;
+    });
+    REQUIRE(waitFor([&]() { return count == 20; }));
+    REQUIRE(maxActive == 1);
+}
+
+TEST_CASE("Throwing task is stopped") {
+    DeviceRuntime runtime(1);
+    std::atomic<int> count{0};
+    runtime.schedule(0ms, [&]() -> std::chrono::milliseconds {
+        count++;
+        throw std::runtime_error("Task failed");
+    });
+    REQUIRE(waitFor([&]() { return count == 1; }));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(count == 1);
+}
+
+TEST_CASE("Invalid runtime arguments") {
+    REQUIRE_THROWS_AS(DeviceRuntime(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(DeviceRuntime(1, 0ms), std::invalid_argument);
+    DeviceRuntime runtime(1);
+    REQUIRE_THROWS_AS(runtime.schedule(0ms, nullptr), std::invalid_argument);
+}
@@ -0,0 +1,25 @@
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+#include "depthai/depthai.hpp"
+
+TEST_CASE("Devices stay alive on shared runtime") {
+    dai::DeviceBase::Config config;
+    config.sharedRuntime = true;
+
+    std::vector<std::unique_ptr<dai::Device>> devices;
+    for(const auto& info : dai::Device::getAllAvailableDevices()) {
+        devices.push_back(std::make_unique<dai::Device>(config, info));
+    }
+    REQUIRE(!devices.empty());
+
+    // Several watchdog periods must pass without the monitor closing any device
+    std::this_thread::sleep_for(std::chrono::seconds(8));
+    for(auto& device : devices) {
+        REQUIRE(!device->isClosed());
+        // Timesync samples are serviced by the runtime
+        REQUIRE(device->getClockModel().valid);
+        REQUIRE(!device->getMxId().empty());
+    }
+}
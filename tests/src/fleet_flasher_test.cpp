@@ -0,0 +1,45 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/depthai.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Empty package is rejected") {
+    dai::FleetFlasher flasher;
+    REQUIRE_THROWS_AS(flasher.flash({dai::DeviceInfo("0.0.0.0-invalid")}, std::vector<uint8_t>{}), std::invalid_argument);
+}
+
+TEST_CASE("Failures are reported per device") {
+    std::vector<dai::DeviceInfo> devices = {dai::DeviceInfo("0.0.0.0-invalid-1"), dai::DeviceInfo("0.0.0.0-invalid-2")};
+
+    dai::FleetFlasher flasher;
+    flasher.setMaxConcurrency(1);
+    flasher.setRetries(1, 10ms);
+
+    std::mutex mtx;
+    std::vector<dai::FleetFlasher::Progress> updates;
+    flasher.setProgressCallback([&](const dai::FleetFlasher::Progress& progress) {
+        std::unique_lock<std::mutex> l(mtx);
+        updates.push_back(progress);
+    });
+
+    auto results = flasher.flash(devices, std::vector<uint8_t>(1024, 0xFF));
+    REQUIRE(results.size() == devices.size());
+    for(std::size_t i = 0; i < results.size(); i++) {
+        REQUIRE(results[i].deviceInfo.name == devices[i].name);
+        REQUIRE(!results[i].success());
+        REQUIRE(!results[i].error.empty());
+        // Device not being found is transient, so it is retried
+        REQUIRE(results[i].attempts == 2);
+    }
+
+    // Each device ends in a failed state and overall progress reaches completion
+    REQUIRE(!updates.empty());
+    REQUIRE(updates.back().overall == Catch::Approx(1.0f));
+    for(std::size_t i = 0; i < devices.size(); i++) {
+        auto failed = std::count_if(updates.begin(), updates.end(), [i](const dai::FleetFlasher::Progress& p) {
+            return p.index == i && p.stage == dai::FleetFlasher::Stage::FAILED;
+        });
+        REQUIRE(failed == 1);
+    }
+}
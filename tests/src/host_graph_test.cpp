@@ -0,0 +1,178 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "depthai/host/HostGraph.hpp"
+#include "depthai/pipeline/datatype/Buffer.hpp"
+
+using namespace std::chrono_literals;
+
+static std::shared_ptr<dai::Buffer> createMessage(int64_t seq) {
+    auto msg = std::make_shared<dai::Buffer>();
+    msg->setSequenceNum(seq);
+    return msg;
+}
+
+// Collects received sequence numbers
+class Collector : public dai::HostNode {
+   public:
+    Input<dai::Buffer> input{*this, "in"};
+    std::mutex mtx;
+    std::vector<int64_t> received;
+
+    Collector() : HostNode("collector") {}
+
+    std::vector<int64_t> get() {
+        std::unique_lock<std::mutex> lock(mtx);
+        return received;
+    }
+
+   protected:
+    void process() override {
+        auto msg = input.tryGet();
+        if(!msg) return;
+        std::unique_lock<std::mutex> lock(mtx);
+        received.push_back(msg->getSequenceNum());
+    }
+};
+
+// Sums messages of two inputs, only once both have one
+class Adder : public dai::HostNode {
+   public:
+    Input<dai::Buffer> left{*this, "left", true, 8, true};
+    Input<dai::Buffer> right{*this, "right", true, 8, true};
+    Output<dai::Buffer> output{*this, "out"};
+
+    Adder() : HostNode("adder") {}
+
+   protected:
+    void process() override {
+        output.send(createMessage(left.tryGet()->getSequenceNum() + right.tryGet()->getSequenceNum()));
+    }
+};
+
+template <typename F>
+static bool waitFor(F condition) {
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while(!condition()) {
+        if(std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+TEST_CASE("Messages flow through linked nodes in order") {
+    dai::HostGraph graph(4);
+    auto doubler = graph.create<dai::FunctionNode<dai::Buffer, dai::Buffer>>(
+        "doubler", [](std::shared_ptr<dai::Buffer> msg) { return createMessage(msg->getSequenceNum() * 2); });
+    auto collector = graph.create<Collector>();
+    doubler->output.link(collector->input);
+
+    // Messages sent before start are kept
+    doubler->input.send(createMessage(0));
+    graph.start();
+    for(int i = 1; i < 100; i++) doubler->input.send(createMessage(i));
+
+    REQUIRE(waitFor([&]() { return collector->get().size() == 100; }));
+    const auto received = collector->get();
+    for(int i = 0; i < 100; i++) REQUIRE(received[i] == i * 2);
+
+    graph.stop();
+    const auto stats = doubler->getStats();
+    REQUIRE(stats.numRuns == 100);
+    REQUIRE(stats.numErrors == 0);
+    REQUIRE(stats.inputs.size() == 1);
+    REQUIRE(stats.inputs[0].numReceived == 100);
+    REQUIRE(stats.inputs[0].numDropped == 0);
+    REQUIRE(graph.getStats().size() == 2);
+}
+
+TEST_CASE("Node waits for all inputs which wait for messages") {
+    dai::HostGraph graph(2);
+    auto adder = graph.create<Adder>();
+    auto collector = graph.create<Collector>();
+    adder->output.link(collector->input);
+    graph.start();
+
+    adder->left.send(createMessage(1));
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(collector->get().empty());
+    adder->right.send(createMessage(2));
+    REQUIRE(waitFor([&]() { return collector->get().size() == 1; }));
+    REQUIRE(collector->get()[0] == 3);
+}
+
+TEST_CASE("Full blocking input holds back producers") {
+    dai::HostGraph graph(4);
+    std::atomic<bool> release{false};
+    auto source = graph.create<dai::FunctionNode<dai::Buffer, dai::Buffer>>("source", [](std::shared_ptr<dai::Buffer> msg) { return msg; });
+    auto slow = graph.create<dai::FunctionNode<dai::Buffer, dai::ADatatype>>("slow", [&release](std::shared_ptr<dai::Buffer>) {
+        while(!release) std::this_thread::sleep_for(1ms);
+        return std::shared_ptr<dai::ADatatype>();
+    });
+    source->output.link(slow->input);
+    slow->input.setQueueSize(2);
+    source->input.setQueueSize(2);
+    graph.start();
+
+    // Sending from outside the graph blocks once the chain is full
+    std::atomic<int> numSent{0};
+    std::thread producer([&]() {
+        for(int i = 0; i < 20; i++) {
+            source->input.send(createMessage(i));
+            numSent++;
+        }
+    });
+    std::this_thread::sleep_for(100ms);
+    REQUIRE(numSent < 20);
+    REQUIRE(slow->input.size() <= 2);
+
+    release = true;
+    producer.join();
+    REQUIRE(waitFor([&]() { return slow->getStats().numRuns == 20; }));
+    REQUIRE(slow->getStats().inputs[0].numDropped == 0);
+}
+
+TEST_CASE("Non blocking input drops oldest and stateless nodes run concurrently") {
+    dai::HostGraph graph(4);
+    std::atomic<int> running{0};
+    std::atomic<int> maxRunning{0};
+    auto worker = graph.create<dai::FunctionNode<dai::Buffer, dai::ADatatype>>("worker", [&](std::shared_ptr<dai::Buffer>) {
+        const int now = ++running;
+        int expected = maxRunning;
+        while(now > expected && !maxRunning.compare_exchange_weak(expected, now)) {
+        }
+        std::this_thread::sleep_for(20ms);
+        running--;
+        return std::shared_ptr<dai::ADatatype>();
+    });
+    worker->setMaxConcurrency(4);
+    worker->input.setQueueSize(4);
+    worker->input.setBlocking(false);
+
+    // Before start nothing is consumed, so the queue overflows
+    for(int i = 0; i < 10; i++) worker->input.send(createMessage(i));
+    REQUIRE(worker->input.size() == 4);
+    graph.start();
+    REQUIRE(waitFor([&]() { return worker->getStats().numRuns == 4; }));
+    REQUIRE(maxRunning > 1);
+    REQUIRE(worker->getStats().inputs[0].numDropped == 6);
+}
+
+TEST_CASE("Exceptions in process are counted") {
+    dai::HostGraph graph(1);
+    auto failing = graph.create<dai::FunctionNode<dai::Buffer, dai::Buffer>>(
+        "failing", [](std::shared_ptr<dai::Buffer>) -> std::shared_ptr<dai::Buffer> { throw std::runtime_error("failed"); });
+    graph.start();
+    failing->input.send(createMessage(0));
+    failing->input.send(createMessage(1));
+    REQUIRE(waitFor([&]() { return failing->getStats().numErrors == 2; }));
+
+    // Nodes can only be part of one graph, and only added and linked while it is stopped
+    dai::HostGraph other;
+    REQUIRE_THROWS_AS(other.add(failing), std::invalid_argument);
+    REQUIRE_THROWS_AS(graph.create<Collector>(), std::runtime_error);
+    auto collector = other.create<Collector>();
+    REQUIRE_THROWS_AS(failing->output.link(collector->input), std::runtime_error);
+}
@@ -0,0 +1,219 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/host/HostImageManip.hpp"
+
+using PixelFn = std::uint8_t (*)(unsigned int, unsigned int, unsigned int);
+
+static dai::ImgFrame createFrame(dai::ImgFrame::Type type, unsigned int width, unsigned int height, PixelFn fn) {
+    const unsigned int channels = type == dai::ImgFrame::Type::BGR888i || type == dai::ImgFrame::Type::RGB888i ? 3 : 1;
+    std::vector<std::uint8_t> data(width * height * channels);
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            for(unsigned int c = 0; c < channels; c++) data[(y * width + x) * channels + c] = fn(x, y, c);
+        }
+    }
+    dai::ImgFrame frame;
+    frame.setType(type);
+    frame.setSize(width, height);
+    frame.setData(std::move(data));
+    return frame;
+}
+
+static std::uint8_t gradient(unsigned int x, unsigned int y, unsigned int) {
+    return static_cast<std::uint8_t>(x * 4 + y);
+}
+
+static std::uint8_t at(const dai::ImgFrame& frame, unsigned int x, unsigned int y, unsigned int c = 0, unsigned int channels = 1) {
+    return frame.getData()[(y * frame.getWidth() + x) * channels + c];
+}
+
+TEST_CASE("Empty config copies the frame and its metadata") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 32, 16, gradient);
+    frame.setSequenceNum(42);
+    frame.setInstanceNum(2);
+
+    dai::HostImageManip manip;
+    auto out = manip.apply(frame);
+    REQUIRE(out->getType() == dai::ImgFrame::Type::GRAY8);
+    REQUIRE(out->getWidth() == 32);
+    REQUIRE(out->getHeight() == 16);
+    REQUIRE(out->getData() == frame.getData());
+    REQUIRE(out->getSequenceNum() == 42);
+    REQUIRE(out->getInstanceNum() == 2);
+}
+
+TEST_CASE("Crop and resize") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 64, 32, gradient);
+    dai::HostImageManip manip;
+
+    SECTION("Crop without resize keeps source pixels") {
+        dai::ImageManipConfig config;
+        config.setCropRect(0.25f, 0.5f, 0.75f, 1.0f);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getWidth() == 32);
+        REQUIRE(out->getHeight() == 16);
+        for(unsigned int y = 0; y < 16; y++) {
+            for(unsigned int x = 0; x < 32; x++) REQUIRE(at(*out, x, y) == gradient(x + 16, y + 16, 0));
+        }
+    }
+
+    SECTION("Downscale by two averages pixel pairs") {
+        dai::ImageManipConfig config;
+        config.setResize(32, 16);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getWidth() == 32);
+        REQUIRE(out->getHeight() == 16);
+        // Each output pixel is centered between four source pixels, away from where the gradient wraps
+        for(unsigned int y = 0; y < 15; y++) {
+            for(unsigned int x = 0; x < 28; x++) REQUIRE(std::abs(at(*out, x, y) - (gradient(2 * x, 2 * y, 0) + 2 + 0.5)) <= 1.0);
+        }
+    }
+
+    SECTION("keepAspectRatio crops the center") {
+        dai::ImageManipConfig config;
+        config.setResize(32, 32);
+        config.setKeepAspectRatio(true);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getWidth() == 32);
+        REQUIRE(out->getHeight() == 32);
+        REQUIRE(at(*out, 0, 0) == gradient(16, 0, 0));
+        REQUIRE(at(*out, 31, 31) == gradient(47, 31, 0));
+    }
+
+    SECTION("Stretch without keepAspectRatio") {
+        dai::ImageManipConfig config;
+        config.setResize(32, 32);
+        config.setKeepAspectRatio(false);
+        auto out = manip.apply(frame, config);
+        REQUIRE(at(*out, 0, 0) <= gradient(1, 0, 0));
+        REQUIRE(at(*out, 31, 31) >= gradient(62, 31, 0) - 1);
+    }
+}
+
+TEST_CASE("Thumbnail letterboxes with background color") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 100, 50, [](unsigned int, unsigned int, unsigned int) -> std::uint8_t { return 200; });
+    dai::ImageManipConfig config;
+    config.setResizeThumbnail(60, 60, 10, 10, 10);
+
+    dai::HostImageManip manip;
+    auto out = manip.apply(frame, config);
+    REQUIRE(out->getWidth() == 60);
+    REQUIRE(out->getHeight() == 60);
+    // Content is 60x30, centered
+    REQUIRE(at(*out, 30, 0) == at(*out, 30, 14));
+    REQUIRE(at(*out, 30, 0) != 200);
+    REQUIRE(at(*out, 0, 15) == 200);
+    REQUIRE(at(*out, 59, 44) == 200);
+    REQUIRE(at(*out, 30, 45) == at(*out, 30, 0));
+}
+
+TEST_CASE("Flip and rotation") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 8, 4, gradient);
+    dai::HostImageManip manip;
+
+    SECTION("Horizontal flip") {
+        dai::ImageManipConfig config;
+        config.setHorizontalFlip(true);
+        auto out = manip.apply(frame, config);
+        for(unsigned int y = 0; y < 4; y++) {
+            for(unsigned int x = 0; x < 8; x++) REQUIRE(at(*out, x, y) == gradient(7 - x, y, 0));
+        }
+    }
+
+    SECTION("Rotation by 90 degrees is clockwise") {
+        dai::ImageManipConfig config;
+        config.setRotationDegrees(90.0f);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getWidth() == 4);
+        REQUIRE(out->getHeight() == 8);
+        for(unsigned int y = 0; y < 8; y++) {
+            for(unsigned int x = 0; x < 4; x++) REQUIRE(at(*out, x, y) == gradient(y, 3 - x, 0));
+        }
+    }
+}
+
+TEST_CASE("Warp") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 32, 32, gradient);
+    dai::HostImageManip manip;
+
+    SECTION("Four points at the corners keep the image") {
+        dai::ImageManipConfig config;
+        config.setWarpTransformFourPoints({{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}, true);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getWidth() == 32);
+        REQUIRE(out->getHeight() == 32);
+        for(unsigned int y = 0; y < 32; y++) {
+            for(unsigned int x = 0; x < 32; x++) REQUIRE(std::abs(at(*out, x, y) - gradient(x, y, 0)) <= 1);
+        }
+    }
+
+    SECTION("Matrix translation with constant border") {
+        dai::ImageManipConfig config;
+        config.setWarpTransformMatrix3x3({1.0f, 0.0f, 4.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+        config.setWarpBorderFillColor(0, 0, 0);
+        auto out = manip.apply(frame, config);
+        for(unsigned int x = 0; x < 4; x++) REQUIRE(at(*out, x, 10) == 0);
+        for(unsigned int x = 4; x < 32; x++) REQUIRE(at(*out, x, 10) == gradient(x - 4, 10, 0));
+    }
+}
+
+TEST_CASE("Type conversion") {
+    auto frame = createFrame(dai::ImgFrame::Type::BGR888i, 16, 8, [](unsigned int x, unsigned int y, unsigned int c) -> std::uint8_t {
+        return static_cast<std::uint8_t>(c == 0 ? 40 + x : c == 1 ? 100 + y : 180);
+    });
+    dai::HostImageManip manip;
+
+    SECTION("BGR interleaved to RGB planar") {
+        dai::ImageManipConfig config;
+        config.setFrameType(dai::ImgFrame::Type::RGB888p);
+        auto out = manip.apply(frame, config);
+        REQUIRE(out->getType() == dai::ImgFrame::Type::RGB888p);
+        REQUIRE(out->getData().size() == 16 * 8 * 3);
+        const auto& data = out->getData();
+        for(unsigned int i = 0; i < 16 * 8; i++) {
+            REQUIRE(data[i] == frame.getData()[i * 3 + 2]);
+            REQUIRE(data[16 * 8 + i] == frame.getData()[i * 3 + 1]);
+            REQUIRE(data[2 * 16 * 8 + i] == frame.getData()[i * 3]);
+        }
+    }
+
+    SECTION("NV12 round trip") {
+        dai::ImageManipConfig toNv12;
+        toNv12.setFrameType(dai::ImgFrame::Type::NV12);
+        auto nv12 = manip.apply(frame, toNv12);
+        REQUIRE(nv12->getData().size() == 16 * 8 * 3 / 2);
+
+        dai::ImageManipConfig toBgr;
+        toBgr.setFrameType(dai::ImgFrame::Type::BGR888i);
+        auto bgr = manip.apply(*nv12, toBgr);
+        for(unsigned int i = 0; i < bgr->getData().size(); i++) REQUIRE(std::abs(bgr->getData()[i] - frame.getData()[i]) <= 4);
+    }
+
+    SECTION("Odd size can't be YUV 4:2:0") {
+        dai::ImageManipConfig config;
+        config.setResize(15, 8);
+        config.setFrameType(dai::ImgFrame::Type::NV12);
+        REQUIRE_THROWS_AS(manip.apply(frame, config), std::invalid_argument);
+    }
+
+    SECTION("Unsupported type") {
+        dai::ImageManipConfig config;
+        config.setFrameType(dai::ImgFrame::Type::RAW16);
+        REQUIRE_THROWS_AS(manip.apply(frame, config), std::runtime_error);
+    }
+}
+
+TEST_CASE("Output frames are pooled") {
+    auto frame = createFrame(dai::ImgFrame::Type::GRAY8, 16, 16, gradient);
+    dai::HostImageManip manip;
+    manip.setMaxPoolSize(1);
+
+    auto first = manip.apply(frame);
+    auto* firstPtr = first.get();
+    auto second = manip.apply(frame);
+    REQUIRE(second.get() != firstPtr);
+
+    first.reset();
+    auto third = manip.apply(frame);
+    REQUIRE(third.get() == firstPtr);
+}
@@ -0,0 +1,214 @@
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "depthai/host/HostInferenceWindow.hpp"
+
+using namespace std::chrono_literals;
+using Window = dai::HostInferenceWindow;
+
+// Stand-in device: answers each request with NNData of the same sequence number after a delay, optionally in reverse
+// order of arrival or not at all
+class Loopback {
+   public:
+    std::chrono::milliseconds delay{2};
+    bool reverse = false;
+    std::set<std::int64_t> drop;
+    std::atomic<std::size_t> maxOutstanding{0};
+
+    // Answers for a window while in scope, so it stops before the window is destroyed
+    struct Running {
+        Loopback& device;
+        Running(Loopback& device, Window& window) : device(device) {
+            device.start(window);
+        }
+        ~Running() {
+            device.stop();
+        }
+    };
+
+    void start(Window& window) {
+        thread = std::thread([this, &window]() {
+            std::unique_lock<std::mutex> lock(mtx);
+            while(true) {
+                cv.wait(lock, [this]() { return !running || !pending.empty(); });
+                if(!running) return;
+                // Lets requests pile up when reversing
+                lock.unlock();
+                std::this_thread::sleep_for(delay);
+                lock.lock();
+                std::deque<std::shared_ptr<dai::ADatatype>> batch;
+                batch.swap(pending);
+                if(reverse) std::reverse(batch.begin(), batch.end());
+                lock.unlock();
+                for(auto& request : batch) {
+                    auto seq = std::dynamic_pointer_cast<dai::Buffer>(request)->getSequenceNum();
+                    if(drop.count(seq) == 0) {
+                        auto response = std::make_shared<dai::NNData>();
+                        response->setSequenceNum(seq);
+                        outstanding--;
+                        window.receive(response);
+                    } else {
+                        outstanding--;
+                    }
+                }
+                lock.lock();
+            }
+        });
+    }
+
+    void stop() {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            running = false;
+        }
+        cv.notify_all();
+        if(thread.joinable()) thread.join();
+    }
+
+    Window::Sender sender() {
+        return [this](const std::shared_ptr<dai::ADatatype>& request) {
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                pending.push_back(request);
+                auto count = ++outstanding;
+                if(count > maxOutstanding) maxOutstanding = count;
+            }
+            cv.notify_all();
+        };
+    }
+
+   private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<std::shared_ptr<dai::ADatatype>> pending;
+    std::atomic<std::size_t> outstanding{0};
+    bool running = true;
+    std::thread thread;
+};
+
+TEST_CASE("Responses complete their requests") {
+    Loopback device;
+    device.reverse = true;
+    Window::Config config;
+    config.maxInFlight = 3;
+    Window window(device.sender(), config);
+    Loopback::Running running(device, window);
+
+    std::vector<std::future<std::shared_ptr<dai::NNData>>> futures;
+    std::vector<std::shared_ptr<dai::NNData>> requests;
+    for(int i = 0; i < 20; i++) {
+        auto request = std::make_shared<dai::NNData>();
+        requests.push_back(request);
+        futures.push_back(window.infer(request));
+        REQUIRE(window.getNumInFlight() <= 3);
+    }
+    for(std::size_t i = 0; i < futures.size(); i++) {
+        REQUIRE(futures[i].wait_for(5s) == std::future_status::ready);
+        REQUIRE(futures[i].get()->getSequenceNum() == requests[i]->getSequenceNum());
+        REQUIRE(requests[i]->getSequenceNum() == static_cast<std::int64_t>(i));
+    }
+    REQUIRE(window.waitIdle(1s));
+    REQUIRE(device.maxOutstanding <= 3);
+
+    auto stats = window.getStats();
+    REQUIRE(stats.numSent == 20);
+    REQUIRE(stats.numCompleted == 20);
+    REQUIRE(stats.numTimedOut == 0);
+    REQUIRE(stats.numUnmatched == 0);
+    REQUIRE(stats.numInFlight == 0);
+    REQUIRE(stats.throughput > 0.0f);
+    REQUIRE(stats.minLatency <= stats.averageLatency);
+    REQUIRE(stats.averageLatency <= stats.maxLatency);
+    REQUIRE(stats.minLatency >= 2ms);
+}
+
+TEST_CASE("Full window waits for a free slot") {
+    std::vector<std::shared_ptr<dai::ADatatype>> sent;
+    Window::Config config;
+    config.maxInFlight = 2;
+    Window window([&sent](const std::shared_ptr<dai::ADatatype>& request) { sent.push_back(request); }, config);
+
+    std::atomic<int> completed{0};
+    auto callback = [&completed](std::shared_ptr<dai::ADatatype> response, std::exception_ptr error) {
+        if(response && !error) completed++;
+    };
+    REQUIRE(window.infer(std::make_shared<dai::NNData>(), callback, 0ms));
+    REQUIRE(window.infer(std::make_shared<dai::NNData>(), callback, 0ms));
+    REQUIRE_FALSE(window.infer(std::make_shared<dai::NNData>(), callback, 10ms));
+    REQUIRE(sent.size() == 2);
+
+    window.receive(sent[1]);
+    REQUIRE(completed == 1);
+    REQUIRE(window.infer(std::make_shared<dai::NNData>(), callback, 0ms));
+
+    window.setMaxInFlight(3);
+    REQUIRE(window.infer(std::make_shared<dai::NNData>(), callback, 0ms));
+    REQUIRE(window.getNumInFlight() == 3);
+    REQUIRE_THROWS_AS(window.setMaxInFlight(0), std::invalid_argument);
+}
+
+TEST_CASE("Lost responses time out") {
+    Loopback device;
+    device.drop = {1};
+    Window::Config config;
+    config.timeout = 50ms;
+    Window window(device.sender(), config);
+    Loopback::Running running(device, window);
+
+    auto ok = window.infer(std::make_shared<dai::NNData>());
+    auto lost = window.infer(std::make_shared<dai::NNData>());
+    REQUIRE(ok.get()->getSequenceNum() == 0);
+    REQUIRE(lost.wait_for(2s) == std::future_status::ready);
+    REQUIRE_THROWS_AS(lost.get(), std::runtime_error);
+    REQUIRE(window.getNumInFlight() == 0);
+
+    // A response arriving after its request timed out is ignored
+    auto late = std::make_shared<dai::NNData>();
+    late->setSequenceNum(1);
+    window.receive(late);
+
+    auto stats = window.getStats();
+    REQUIRE(stats.numSent == 2);
+    REQUIRE(stats.numCompleted == 1);
+    REQUIRE(stats.numTimedOut == 1);
+    REQUIRE(stats.numUnmatched == 1);
+}
+
+TEST_CASE("Own sequence numbers") {
+    std::vector<std::shared_ptr<dai::ADatatype>> sent;
+    Window::Config config;
+    config.assignSequenceNumbers = false;
+    std::unique_ptr<Window> window(new Window([&sent](const std::shared_ptr<dai::ADatatype>& request) { sent.push_back(request); }, config));
+
+    auto request = std::make_shared<dai::NNData>();
+    request->setSequenceNum(42);
+    auto future = window->infer(request);
+    REQUIRE_THROWS_AS(window->infer(request), std::invalid_argument);
+    REQUIRE(window->getNumInFlight() == 1);
+
+    // Response of another type
+    auto frame = std::make_shared<dai::Buffer>();
+    frame->setSequenceNum(42);
+    window->receive(frame);
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+
+    // Pending requests fail on destruction
+    future = window->infer(request);
+    window.reset();
+    REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+}
+
+TEST_CASE("Failed send frees the slot") {
+    Window::Config config;
+    config.maxInFlight = 1;
+    Window window([](const std::shared_ptr<dai::ADatatype>&) { throw std::runtime_error("Link down"); }, config);
+    REQUIRE_THROWS_AS(window.infer(std::make_shared<dai::NNData>(), [](std::shared_ptr<dai::ADatatype>, std::exception_ptr) {}), std::runtime_error);
+    REQUIRE(window.getNumInFlight() == 0);
+    REQUIRE(window.getStats().numSent == 0);
+}
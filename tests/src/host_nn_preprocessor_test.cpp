@@ -0,0 +1,194 @@
+#include <catch2/catch_all.hpp>
+#include <cmath>
+
+#include "depthai/host/HostNNPreprocessor.hpp"
+
+using Preprocessor = dai::HostNNPreprocessor;
+
+static dai::ImgFrame createBgrFrame(unsigned int width, unsigned int height, std::uint8_t (*fn)(unsigned int, unsigned int, unsigned int)) {
+    std::vector<std::uint8_t> data(width * height * 3);
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            for(unsigned int c = 0; c < 3; c++) data[(y * width + x) * 3 + c] = fn(x, y, c);
+        }
+    }
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::BGR888i);
+    frame.setSize(width, height);
+    frame.setData(std::move(data));
+    return frame;
+}
+
+static std::uint8_t pattern(unsigned int x, unsigned int y, unsigned int c) {
+    return static_cast<std::uint8_t>(x * 3 + y * 5 + c * 70);
+}
+
+static std::uint8_t constant(unsigned int, unsigned int, unsigned int) {
+    return 128;
+}
+
+TEST_CASE("Same size output is planarized input") {
+    auto frame = createBgrFrame(16, 8, pattern);
+    frame.setSequenceNum(7);
+
+    Preprocessor::Config config;
+    Preprocessor preprocessor(config);
+    dai::ImgFrame output;
+    preprocessor.process(frame, output);
+    REQUIRE(output.getType() == dai::ImgFrame::Type::BGR888p);
+    REQUIRE(output.getWidth() == 16);
+    REQUIRE(output.getHeight() == 8);
+    REQUIRE(output.getSequenceNum() == 7);
+
+    const auto& data = output.getData();
+    REQUIRE(data.size() == 16 * 8 * 3);
+    for(unsigned int c = 0; c < 3; c++) {
+        for(unsigned int i = 0; i < 16 * 8; i++) REQUIRE(data[c * 16 * 8 + i] == frame.getData()[i * 3 + c]);
+    }
+
+    SECTION("RGB order swaps planes") {
+        config.colorOrder = Preprocessor::ColorOrder::RGB;
+        preprocessor.setConfig(config);
+        preprocessor.process(frame, output);
+        REQUIRE(output.getType() == dai::ImgFrame::Type::RGB888p);
+        for(unsigned int i = 0; i < 16 * 8; i++) REQUIRE(output.getData()[i] == frame.getData()[i * 3 + 2]);
+    }
+
+    SECTION("Interleaved output keeps the layout") {
+        config.planar = false;
+        preprocessor.setConfig(config);
+        preprocessor.process(frame, output);
+        REQUIRE(output.getType() == dai::ImgFrame::Type::BGR888i);
+        REQUIRE(output.getData() == frame.getData());
+    }
+}
+
+TEST_CASE("Letterbox") {
+    auto frame = createBgrFrame(100, 50, constant);
+
+    Preprocessor::Config config;
+    config.width = 64;
+    config.height = 64;
+    config.background = {{10, 20, 30}};
+    Preprocessor preprocessor(config);
+
+    dai::ImgFrame output;
+    auto transform = preprocessor.process(frame, output);
+    const auto& data = output.getData();
+    REQUIRE(data.size() == 64 * 64 * 3);
+
+    // Content is 64x32, centered
+    for(unsigned int c = 0; c < 3; c++) {
+        const auto* plane = data.data() + c * 64 * 64;
+        REQUIRE(plane[0] == config.background[c]);
+        REQUIRE(plane[15 * 64 + 32] == config.background[c]);
+        REQUIRE(plane[16 * 64 + 0] == 128);
+        REQUIRE(plane[47 * 64 + 63] == 128);
+        REQUIRE(plane[48 * 64 + 32] == config.background[c]);
+    }
+
+    // Output center maps to input center
+    REQUIRE(32.0f * transform.scaleX + transform.offsetX == Catch::Approx(50.0f));
+    REQUIRE(32.0f * transform.scaleY + transform.offsetY == Catch::Approx(25.0f));
+}
+
+TEST_CASE("Center crop") {
+    auto frame = createBgrFrame(200, 100, pattern);
+
+    Preprocessor::Config config;
+    config.width = 100;
+    config.height = 100;
+    config.resizeMode = Preprocessor::ResizeMode::CROP;
+    Preprocessor preprocessor(config);
+
+    dai::ImgFrame output;
+    auto transform = preprocessor.process(frame, output);
+    REQUIRE(transform.scaleX == Catch::Approx(1.0f));
+    REQUIRE(transform.offsetX == Catch::Approx(50.0f));
+    for(unsigned int y = 0; y < 100; y += 9) {
+        for(unsigned int x = 0; x < 100; x += 7) REQUIRE(output.getData()[y * 100 + x] == pattern(x + 50, y, 0));
+    }
+}
+
+static float halfToFloat(std::uint16_t half) {
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+    const float value = exponent == 0 ? std::ldexp(static_cast<float>(mantissa), -24) : std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+    return (half & 0x8000) ? -value : value;
+}
+
+TEST_CASE("FP16 normalized output") {
+    auto frame = createBgrFrame(32, 32, constant);
+    frame.setSequenceNum(3);
+
+    Preprocessor::Config config;
+    config.width = 16;
+    config.height = 16;
+    config.dataType = Preprocessor::DataType::FP16;
+    config.mean = {{128.0f, 0.0f, 64.0f}};
+    config.scale = {{1.0f, 255.0f, 2.0f}};
+    Preprocessor preprocessor(config);
+
+    dai::ImgFrame output;
+    preprocessor.process(frame, output);
+    REQUIRE(output.getType() == dai::ImgFrame::Type::BGRF16F16F16p);
+    REQUIRE(output.getData().size() == 16 * 16 * 3 * 2);
+    const auto* values = reinterpret_cast<const std::uint16_t*>(output.getData().data());
+    for(unsigned int i = 0; i < 16 * 16; i++) {
+        REQUIRE(halfToFloat(values[i]) == Catch::Approx(0.0f).margin(1e-3));
+        REQUIRE(halfToFloat(values[16 * 16 + i]) == Catch::Approx(128.0f / 255.0f).epsilon(1e-3));
+        REQUIRE(halfToFloat(values[2 * 16 * 16 + i]) == Catch::Approx(32.0f).epsilon(1e-3));
+    }
+
+    SECTION("NNData layer") {
+        dai::NNData data;
+        preprocessor.process(frame, data, "input");
+        REQUIRE(data.getSequenceNum() == 3);
+    }
+
+    SECTION("Interleaved") {
+        config.planar = false;
+        preprocessor.setConfig(config);
+        preprocessor.process(frame, output);
+        REQUIRE(output.getType() == dai::ImgFrame::Type::BGRF16F16F16i);
+        values = reinterpret_cast<const std::uint16_t*>(output.getData().data());
+        REQUIRE(halfToFloat(values[3 * 10 + 2]) == Catch::Approx(32.0f).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("NV12 input is converted to BGR") {
+    const unsigned int width = 32;
+    const unsigned int height = 16;
+    std::vector<std::uint8_t> data(width * height * 3 / 2, 128);
+    std::fill(data.begin(), data.begin() + width * height, 126);
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::NV12);
+    frame.setSize(width, height);
+    frame.setData(std::move(data));
+
+    Preprocessor::Config config;
+    config.width = 20;
+    config.height = 10;
+    config.resizeMode = Preprocessor::ResizeMode::STRETCH;
+    Preprocessor preprocessor(config);
+    dai::ImgFrame output;
+    preprocessor.process(frame, output);
+    for(auto value : output.getData()) REQUIRE(value == 128);
+}
+
+TEST_CASE("Invalid input") {
+    Preprocessor preprocessor;
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::RAW16);
+    frame.setSize(4, 4);
+    frame.setData(std::vector<std::uint8_t>(32));
+    dai::ImgFrame output;
+    REQUIRE_THROWS_AS(preprocessor.process(frame, output), std::runtime_error);
+
+    frame.setType(dai::ImgFrame::Type::BGR888i);
+    REQUIRE_THROWS_AS(preprocessor.process(frame, output), std::invalid_argument);
+
+    Preprocessor::Config config;
+    config.scale = {{1.0f, 0.0f, 1.0f}};
+    REQUIRE_THROWS_AS(preprocessor.setConfig(config), std::invalid_argument);
+}
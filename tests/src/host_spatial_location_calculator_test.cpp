@@ -0,0 +1,111 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/host/HostSpatialLocationCalculator.hpp"
+
+static dai::ImgFrame createDepthFrame(unsigned int width, unsigned int height, std::uint16_t (*fn)(unsigned int, unsigned int)) {
+    std::vector<std::uint8_t> data(width * height * sizeof(std::uint16_t));
+    auto* depth = reinterpret_cast<std::uint16_t*>(data.data());
+    for(unsigned int y = 0; y < height; y++) {
+        for(unsigned int x = 0; x < width; x++) {
+            depth[y * width + x] = fn(x, y);
+        }
+    }
+    dai::ImgFrame frame;
+    frame.setType(dai::ImgFrame::Type::RAW16);
+    frame.setSize(width, height);
+    frame.setData(std::move(data));
+    return frame;
+}
+
+static dai::SpatialLocationCalculatorConfigData roi(dai::Rect rect, dai::SpatialLocationCalculatorAlgorithm algorithm, int stepSize = -1) {
+    dai::SpatialLocationCalculatorConfigData config;
+    config.roi = rect;
+    config.calculationAlgorithm = algorithm;
+    config.stepSize = stepSize;
+    return config;
+}
+
+TEST_CASE("Statistics of a gradient") {
+    // Depth increases with x: 1000 + x, every 7th pixel is invalid
+    auto depth = createDepthFrame(640, 400, [](unsigned int x, unsigned int y) -> std::uint16_t { return (x + y) % 7 == 0 ? 0 : 1000 + x; });
+    dai::HostSpatialLocationCalculator calculator(72.0f);
+
+    using Algorithm = dai::SpatialLocationCalculatorAlgorithm;
+    std::vector<dai::SpatialLocationCalculatorConfigData> rois = {
+        roi(dai::Rect(100, 50, 200, 100), Algorithm::AVERAGE),
+        roi(dai::Rect(100, 50, 200, 100), Algorithm::MIN),
+        roi(dai::Rect(100, 50, 200, 100), Algorithm::MAX),
+        roi(dai::Rect(100, 50, 200, 100), Algorithm::MEDIAN, 1),
+        roi(dai::Rect(100, 50, 200, 100), Algorithm::AVERAGE, 3),
+        roi(dai::Rect(0.0f, 0.0f, 0.5f, 1.0f), Algorithm::MIN),
+    };
+    auto data = calculator.calculate(depth, rois);
+    auto& locations = data->getSpatialLocations();
+    REQUIRE(locations.size() == rois.size());
+
+    // Brute force reference
+    for(size_t i = 0; i < rois.size(); i++) {
+        auto r = rois[i].roi.denormalize(640, 400);
+        int step = rois[i].stepSize == -1 ? 1 : rois[i].stepSize;
+        uint64_t sum = 0;
+        uint32_t count = 0;
+        uint16_t mn = 65535, mx = 0;
+        for(int y = (int)r.y; y < (int)(r.y + r.height); y += step) {
+            for(int x = (int)r.x; x < (int)(r.x + r.width); x += step) {
+                uint16_t v = (x + y) % 7 == 0 ? 0 : 1000 + x;
+                if(v == 0) continue;
+                sum += v;
+                count++;
+                mn = std::min(mn, v);
+                mx = std::max(mx, v);
+            }
+        }
+        REQUIRE(locations[i].depthAveragePixelCount == count);
+        REQUIRE(locations[i].depthAverage == Catch::Approx(static_cast<double>(sum) / count));
+        REQUIRE(locations[i].depthMin == mn);
+        REQUIRE(locations[i].depthMax == mx);
+    }
+    REQUIRE(locations[1].spatialCoordinates.z == 1100.0f);
+    REQUIRE(locations[2].spatialCoordinates.z == 1299.0f);
+    REQUIRE(locations[3].depthMedian == Catch::Approx(1200.0f).margin(1.0f));
+    // ROI left of center has negative X, above center positive Y
+    REQUIRE(locations[0].spatialCoordinates.x < 0.0f);
+    REQUIRE(locations[0].spatialCoordinates.y > 0.0f);
+}
+
+TEST_CASE("Thresholds and mode") {
+    auto depth = createDepthFrame(320, 200, [](unsigned int x, unsigned int) -> std::uint16_t { return x < 100 ? 500 : 2000; });
+    dai::HostSpatialLocationCalculator calculator(72.0f);
+    calculator.setNumThreads(2);
+
+    auto mode = roi(dai::Rect(0, 0, 320, 200), dai::SpatialLocationCalculatorAlgorithm::MODE);
+    auto thresholded = roi(dai::Rect(0, 0, 320, 200), dai::SpatialLocationCalculatorAlgorithm::MIN);
+    thresholded.depthThresholds.lowerThreshold = 1000;
+    auto data = calculator.calculate(depth, std::vector<dai::SpatialLocationCalculatorConfigData>{mode, thresholded});
+    REQUIRE(data->getSpatialLocations()[0].depthMode == 2000.0f);
+    REQUIRE(data->getSpatialLocations()[1].depthMin == 2000);
+}
+
+TEST_CASE("Detections") {
+    auto depth = createDepthFrame(320, 200, [](unsigned int, unsigned int) -> std::uint16_t { return 1500; });
+    dai::HostSpatialLocationCalculator calculator(72.0f);
+
+    dai::ImgDetections detections;
+    detections.setSequenceNum(42);
+    dai::ImgDetection det;
+    det.label = 3;
+    det.xmin = 0.4f;
+    det.ymin = 0.4f;
+    det.xmax = 0.6f;
+    det.ymax = 0.6f;
+    detections.detections = {det, det};
+
+    auto spatial = calculator.calculate(depth, detections, {}, 0.5f);
+    REQUIRE(spatial->getSequenceNum() == 42);
+    REQUIRE(spatial->detections.size() == 2);
+    REQUIRE(spatial->detections[0].label == 3);
+    REQUIRE(spatial->detections[0].spatialCoordinates.z == 1500.0f);
+    REQUIRE(spatial->detections[0].spatialCoordinates.x == Catch::Approx(0.0f).margin(1e-3));
+    REQUIRE(spatial->detections[0].boundingBoxMapping.roi.width == Catch::Approx(0.1f));
+    REQUIRE_THROWS(calculator.calculate(depth, detections, {}, 0.0f));
+}
@@ -0,0 +1,123 @@
+#include <catch2/catch_all.hpp>
+
+#include "depthai/host/HostSynchronizer.hpp"
+
+using namespace std::chrono_literals;
+
+static std::shared_ptr<dai::Buffer> createMessage(std::chrono::steady_clock::time_point base, std::chrono::milliseconds offset, int64_t seq) {
+    auto msg = std::make_shared<dai::Buffer>();
+    msg->setTimestamp(base + offset);
+    msg->setTimestampDevice(base + offset);
+    msg->setSequenceNum(seq);
+    return msg;
+}
+
+TEST_CASE("Groups messages within threshold") {
+    dai::HostSynchronizer sync(10ms);
+    sync.addStream("left");
+    sync.addStream("right");
+
+    const auto base = std::chrono::steady_clock::now();
+    for(int i = 0; i < 5; i++) {
+        sync.send("left", createMessage(base, std::chrono::milliseconds(i * 33), i));
+        REQUIRE(sync.tryGet() == nullptr);
+        sync.send("right", createMessage(base, std::chrono::milliseconds(i * 33 + 3), i));
+
+        auto group = sync.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->getNumMessages() == 2);
+        REQUIRE(group->get<dai::Buffer>("left")->getSequenceNum() == i);
+        REQUIRE(group->get<dai::Buffer>("right")->getSequenceNum() == i);
+        REQUIRE(group->isSynced(std::chrono::nanoseconds(10ms).count()));
+        REQUIRE(group->getSequenceNum() == i);
+    }
+
+    auto stats = sync.getStats();
+    REQUIRE(stats.numGroups == 5);
+    REQUIRE(stats.matchRate == Catch::Approx(1.0f));
+    REQUIRE(stats.streams["left"].dropped == 0);
+}
+
+TEST_CASE("Drops unmatched messages") {
+    dai::HostSynchronizer sync(5ms);
+    sync.addStream("a");
+    sync.addStream("b");
+
+    std::vector<int64_t> dropped;
+    sync.setDroppedCallback([&dropped](std::string name, std::shared_ptr<dai::ADatatype> msg) {
+        REQUIRE(name == "a");
+        dropped.push_back(std::dynamic_pointer_cast<dai::Buffer>(msg)->getSequenceNum());
+    });
+
+    // Stream "a" runs at twice the rate of "b"
+    const auto base = std::chrono::steady_clock::now();
+    for(int i = 0; i < 4; i++) sync.send("a", createMessage(base, std::chrono::milliseconds(i * 20), i));
+    sync.send("b", createMessage(base, 41ms, 0));
+
+    auto group = sync.tryGet();
+    REQUIRE(group != nullptr);
+    REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == 2);
+    REQUIRE(dropped == std::vector<int64_t>{0, 1});
+    REQUIRE(sync.getStats().streams["a"].buffered == 1);
+}
+
+TEST_CASE("Orders out of order messages") {
+    dai::HostSynchronizer sync(2ms);
+    sync.addStream("a");
+    sync.addStream("b");
+
+    const auto base = std::chrono::steady_clock::now();
+    sync.send("a", createMessage(base, 10ms, 1));
+    sync.send("a", createMessage(base, 0ms, 0));
+    sync.send("b", createMessage(base, 1ms, 0));
+    sync.send("b", createMessage(base, 11ms, 1));
+
+    for(int i = 0; i < 2; i++) {
+        auto group = sync.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == i);
+        REQUIRE(group->get<dai::Buffer>("b")->getSequenceNum() == i);
+    }
+}
+
+TEST_CASE("Buffer overflow policy") {
+    dai::HostSynchronizer sync(1ms);
+    sync.addStream("a");
+    sync.addStream("b");
+
+    const auto base = std::chrono::steady_clock::now();
+    SECTION("Drop oldest") {
+        sync.setMaxBufferSize(2, dai::HostSynchronizer::OverflowPolicy::DROP_OLDEST);
+        for(int i = 0; i < 3; i++) sync.send("a", createMessage(base, std::chrono::milliseconds(i), i));
+        sync.send("b", createMessage(base, 2ms, 0));
+        auto group = sync.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == 2);
+    }
+    SECTION("Drop newest") {
+        sync.setMaxBufferSize(2, dai::HostSynchronizer::OverflowPolicy::DROP_NEWEST);
+        for(int i = 0; i < 3; i++) sync.send("a", createMessage(base, std::chrono::milliseconds(i), i));
+        sync.send("b", createMessage(base, 2ms, 0));
+        auto group = sync.tryGet();
+        REQUIRE(group != nullptr);
+        REQUIRE(group->get<dai::Buffer>("a")->getSequenceNum() == 1);
+    }
+    REQUIRE(sync.getStats().streams["a"].dropped == 2);
+}
+
+TEST_CASE("Callbacks and close") {
+    dai::HostSynchronizer sync(1ms);
+    sync.addStream("a");
+    REQUIRE_THROWS_AS(sync.addStream("a"), std::invalid_argument);
+    REQUIRE_THROWS_AS(sync.send("b", std::make_shared<dai::Buffer>()), std::invalid_argument);
+
+    int numCallbacks = 0;
+    auto id = sync.addCallback([&numCallbacks](std::shared_ptr<dai::MessageGroup>) { numCallbacks++; });
+    sync.send("a", createMessage(std::chrono::steady_clock::now(), 0ms, 0));
+    REQUIRE(numCallbacks == 1);
+    REQUIRE(sync.removeCallback(id));
+    REQUIRE_FALSE(sync.removeCallback(id));
+
+    sync.close();
+    REQUIRE_THROWS_AS(sync.get(), std::runtime_error);
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch_all.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include "depthai/device/LatencyTracer.hpp"
+
+using namespace std::chrono_literals;
+using Stage = dai::LatencyTracer::Stage;
+
+static dai::LatencyTracer::Trace createTrace(std::int64_t sequenceNum, dai::LatencyTracer::TimePoint capture) {
+    dai::LatencyTracer::Trace trace;
+    trace.stream = "rgb";
+    trace.sequenceNum = sequenceNum;
+    trace.set(Stage::DEVICE_CAPTURE, capture);
+    trace.set(Stage::DEVICE_SEND, capture + 5ms);
+    trace.set(Stage::HOST_RECEIVE, capture + 20ms);
+    trace.set(Stage::PARSE_START, capture + 21ms);
+    trace.set(Stage::PARSE_END, capture + 22ms);
+    return trace;
+}
+
+TEST_CASE("Traces are bounded and stages recorded by message") {
+    dai::LatencyTracer tracer(4);
+    const auto now = std::chrono::steady_clock::now();
+    int messages[6];
+    for(int i = 0; i < 6; i++) tracer.record(createTrace(i, now + i * 33ms), &messages[i]);
+
+    auto traces = tracer.getTraces();
+    REQUIRE(traces.size() == 4);
+    REQUIRE(traces.front().sequenceNum == 2);
+    REQUIRE(traces.back().sequenceNum == 5);
+
+    // Overwritten messages are no longer traced
+    REQUIRE(!tracer.mark(&messages[0], Stage::USER_POP));
+    REQUIRE(tracer.mark(&messages[5], Stage::USER_POP, now + 5 * 33ms + 80ms));
+    // Only first retrieval counts
+    REQUIRE(tracer.mark(&messages[5], Stage::USER_POP, now + 5 * 33ms + 90ms));
+
+    const auto trace = tracer.getTraces().back();
+    REQUIRE(trace.latency(Stage::DEVICE_CAPTURE, Stage::USER_POP) == 80ms);
+    REQUIRE(trace.latency(Stage::DEVICE_SEND, Stage::HOST_RECEIVE) == 15ms);
+    REQUIRE(trace.latency(Stage::QUEUE_PUSH, Stage::USER_POP) == 0ms);
+
+    tracer.clear();
+    REQUIRE(tracer.getTraces().empty());
+}
+
+TEST_CASE("Chrome trace export") {
+    dai::LatencyTracer tracer(8);
+    const auto now = std::chrono::steady_clock::now();
+    int message;
+    auto id = tracer.record(createTrace(7, now), &message);
+    tracer.mark(id, Stage::QUEUE_PUSH, now + 23ms);
+    tracer.mark(id, Stage::CALLBACK_END, now + 25ms);
+    tracer.mark(&message, Stage::USER_POP, now + 40ms);
+
+    auto json = nlohmann::json::parse(tracer.toChromeTrace());
+    const auto& events = json["traceEvents"];
+    // Outer slice, 6 slices between 7 stages, callback slice
+    REQUIRE(events.size() == 2 * 8);
+
+    int begins = 0;
+    for(const auto& event : events) {
+        REQUIRE(event["cat"] == "rgb");
+        REQUIRE(event["id"] == id);
+        if(event["ph"] == "b") begins++;
+    }
+    REQUIRE(begins == 8);
+
+    const auto& outer = events.front();
+    REQUIRE(outer["name"] == "rgb #7");
+    REQUIRE(outer["args"]["sequenceNum"] == 7);
+    REQUIRE(outer["args"]["latency_ms"].get<double>() == Catch::Approx(40.0));
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+
+#include "depthai/utility/LockingQueue.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Overwriting queue drops oldest elements to stay within bytes") {
+    dai::LockingQueue<int> queue(100, false);
+    queue.setMaxBytes(1000);
+    queue.push(0, 400);
+    queue.push(1, 400);
+    REQUIRE(queue.getBytes() == 800);
+
+    // Doesn't fit, oldest is dropped
+    queue.push(2, 500);
+    REQUIRE(queue.size() == 2);
+    REQUIRE(queue.getBytes() == 900);
+    REQUIRE(queue.getNumDropped() == 1);
+
+    // Larger than the limit, replaces everything
+    queue.push(3, 5000);
+    REQUIRE(queue.size() == 1);
+    REQUIRE(queue.getBytes() == 5000);
+    REQUIRE(queue.getNumDropped() == 3);
+
+    int value = -1;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(value == 3);
+    REQUIRE(queue.getBytes() == 0);
+}
+
+TEST_CASE("Blocking queue waits until bytes are freed") {
+    dai::LockingQueue<int> queue(100, true);
+    queue.setMaxBytes(1000);
+    REQUIRE(queue.tryWaitAndPush(0, 1ms, 600));
+    REQUIRE(!queue.tryWaitAndPush(1, 1ms, 600));
+    REQUIRE(queue.tryWaitAndPush(1, 1ms, 400));
+
+    std::thread consumer([&queue]() {
+        std::this_thread::sleep_for(20ms);
+        int value = -1;
+        queue.tryPop(value);
+    });
+    REQUIRE(queue.push(2, 500));
+    consumer.join();
+    REQUIRE(queue.getBytes() == 900);
+    REQUIRE(queue.getNumDropped() == 0);
+
+    // Raising the limit releases a waiting push
+    std::thread producer([&queue]() { queue.push(3, 1000); });
+    std::this_thread::sleep_for(20ms);
+    REQUIRE(queue.size() == 2);
+    queue.setMaxBytes(0);
+    producer.join();
+    REQUIRE(queue.size() == 3);
+
+    // Element count limit still applies
+    queue.setMaxSize(3);
+    REQUIRE(!queue.tryWaitAndPush(4, 1ms, 1));
+}
+
+TEST_CASE("Bytes of elements queued before a limit is set are accounted") {
+    dai::LockingQueue<int> queue(100, true);
+    queue.push(0, 600);
+    REQUIRE(queue.tryWaitAndPush(1, 1ms, 300));
+    REQUIRE(queue.getBytes() == 900);
+
+    queue.setMaxBytes(1000);
+    REQUIRE(!queue.tryWaitAndPush(2, 1ms, 200));
+    REQUIRE(queue.tryWaitAndPush(2, 1ms, 100));
+
+    int value = -1;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(queue.getBytes() == 400);
+    REQUIRE(queue.tryWaitAndPush(3, 1ms, 600));
+    REQUIRE(!queue.tryWaitAndPush(4, 1ms, 1));
+    REQUIRE(queue.getBytes() == 1000);
+}
+
+TEST_CASE("Unbuffered queue doesn't count passing elements as dropped") {
+    dai::LockingQueue<int> queue(2, false);
+    queue.push(0);
+
+    // Queued element is dropped when buffering is turned off, later ones pass through
+    queue.setMaxSize(0);
+    for(int i = 1; i < 5; i++) queue.push(i);
+    REQUIRE(queue.tryWaitAndPush(5, 1ms));
+    REQUIRE(queue.empty());
+    REQUIRE(queue.getNumDropped() == 1);
+}
+
+TEST_CASE("Measured elements are only measured while a limit is set") {
+    dai::LockingQueue<int> queue(100, true);
+    int numMeasured = 0;
+    queue.setMeasure([&numMeasured](const int& value) {
+        numMeasured++;
+        return static_cast<std::size_t>(value);
+    });
+    queue.push(300, 1);
+    REQUIRE(queue.tryWaitAndPush(500, 1ms));
+    REQUIRE(numMeasured == 0);
+    REQUIRE(queue.getBytes() == 0);
+
+    // Queued elements are measured once limited
+    queue.setMaxBytes(1000);
+    REQUIRE(numMeasured == 2);
+    REQUIRE(queue.getBytes() == 800);
+    REQUIRE(!queue.tryWaitAndPush(300, 1ms));
+    REQUIRE(queue.tryWaitAndPush(200, 1ms));
+    REQUIRE(queue.getBytes() == 1000);
+
+    int value = -1;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(queue.getBytes() == 700);
+
+    // And no longer accounted once the limit is removed
+    queue.setMaxBytes(0);
+    REQUIRE(queue.getBytes() == 0);
+    numMeasured = 0;
+    queue.push(400);
+    REQUIRE(numMeasured == 0);
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(queue.getBytes() == 0);
+}
@@ -209,6 +209,11 @@ TEST_CASE("OpenVINO corrupted blob") {
     REQUIRE_THROWS(dai::OpenVINO::Blob(blobData));
 }
 
+// Check if a path which can't be read is reported instead of allocating its bogus size
+TEST_CASE("OpenVINO unreadable blob path") {
+    REQUIRE_THROWS_WITH(dai::OpenVINO::Blob(dai::Path(".")), Catch::Matchers::ContainsSubstring("Cannot load blob"));
+}
+
 // TEST UNIVERSAL FW
 
 TEST_CASE("OpenVINO 2020.4 blob, test with universal FW") {
@@ -0,0 +1,126 @@
+#include <catch2/catch_all.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/device/RpcTransport.hpp"
+
+using dai::RpcTransport;
+
+// Stream of a device serving requests in order, responding to each with the request followed by a marker. Responses
+// are only read once released, to control the order in which waiting callers are woken up
+class FakeStream {
+   public:
+    void write(RpcTransport::Buffer request) {
+        std::unique_lock<std::mutex> lock(mtx);
+        if(failWrite) throw std::runtime_error("write failed");
+        request.push_back(0xFF);
+        responses.push_back(std::move(request));
+        cv.notify_all();
+    }
+    RpcTransport::Buffer read() {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return failRead || (released > 0 && !responses.empty()); });
+        if(failRead) throw std::runtime_error("read failed");
+        released--;
+        auto response = std::move(responses.front());
+        responses.pop_front();
+        return response;
+    }
+    void release(int count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        released += count;
+        cv.notify_all();
+    }
+    void setFailRead() {
+        std::unique_lock<std::mutex> lock(mtx);
+        failRead = true;
+        cv.notify_all();
+    }
+    bool failWrite = false;
+
+   private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<RpcTransport::Buffer> responses;
+    int released = 0;
+    bool failRead = false;
+};
+
+// Transport over a fake stream, no device needed
+struct Fixture {
+    FakeStream stream;
+    RpcTransport transport{[this](RpcTransport::Buffer request) { stream.write(std::move(request)); }, [this]() { return stream.read(); }};
+};
+
+TEST_CASE("Responses are matched to requests received out of order") {
+    Fixture f;
+    const auto first = f.transport.send({1});
+    const auto second = f.transport.send({2});
+    const auto third = f.transport.send({3});
+    REQUIRE(f.transport.getMaxInFlight() == 3);
+
+    // Receiving the last one reads responses of the earlier ones on their behalf
+    f.stream.release(3);
+    REQUIRE(f.transport.receive(third) == RpcTransport::Buffer{3, 0xFF});
+    REQUIRE(f.transport.receive(first) == RpcTransport::Buffer{1, 0xFF});
+    REQUIRE(f.transport.receive(second) == RpcTransport::Buffer{2, 0xFF});
+}
+
+TEST_CASE("Concurrent callers each get their own response") {
+    Fixture f;
+    std::vector<std::thread> threads;
+    std::vector<RpcTransport::Buffer> responses(8);
+    for(std::uint8_t i = 0; i < 8; i++) {
+        threads.emplace_back([&f, &responses, i]() { responses[i] = f.transport.call(RpcTransport::Buffer{i}); });
+    }
+    f.stream.release(8);
+    for(auto& thread : threads) thread.join();
+    for(std::uint8_t i = 0; i < 8; i++) REQUIRE(responses[i] == RpcTransport::Buffer{i, 0xFF});
+}
+
+TEST_CASE("Batch results are in order of requests") {
+    Fixture f;
+    f.stream.release(4);
+    auto responses = f.transport.call(std::vector<RpcTransport::Buffer>{{4}, {3}, {2}, {1}});
+    REQUIRE(responses == std::vector<RpcTransport::Buffer>{{4, 0xFF}, {3, 0xFF}, {2, 0xFF}, {1, 0xFF}});
+    REQUIRE(f.transport.getMaxInFlight() == 4);
+    REQUIRE(f.transport.call(std::vector<RpcTransport::Buffer>{}).empty());
+}
+
+TEST_CASE("Read error is propagated to all waiting callers") {
+    Fixture f;
+    const auto first = f.transport.send({1});
+    const auto second = f.transport.send({2});
+    std::vector<std::string> errors(2);
+    std::vector<std::thread> threads;
+    for(auto id : {first, second}) {
+        threads.emplace_back([&f, &errors, id]() {
+            try {
+                f.transport.receive(id);
+            } catch(const std::runtime_error& ex) {
+                errors[id] = ex.what();
+            }
+        });
+    }
+    f.stream.setFailRead();
+    for(auto& thread : threads) thread.join();
+    REQUIRE(errors == std::vector<std::string>{"read failed", "read failed"});
+
+    // Transport stays failed, as later responses couldn't be matched anymore
+    REQUIRE_THROWS_WITH(f.transport.send({3}), "read failed");
+    REQUIRE_THROWS_WITH(f.transport.call(std::vector<RpcTransport::Buffer>{{4}, {5}}), "read failed");
+}
+
+TEST_CASE("Write error fails the batch and later calls") {
+    Fixture f;
+    f.stream.failWrite = true;
+    REQUIRE_THROWS_WITH(f.transport.call(std::vector<RpcTransport::Buffer>{{1}, {2}}), "write failed");
+    f.stream.failWrite = false;
+    REQUIRE_THROWS_WITH(f.transport.call(RpcTransport::Buffer{3}), "write failed");
+}
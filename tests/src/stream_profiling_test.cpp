@@ -0,0 +1,47 @@
+#include <catch2/catch_all.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "depthai/utility/ProfilingData.hpp"
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Stream profiling counters accumulate traffic") {
+    dai::StreamProfilingCounters counters;
+    auto data = counters.get();
+    REQUIRE(data.numPacketsWritten == 0);
+    REQUIRE(data.minPacketSize == 0);
+    REQUIRE(data.maxPacketSize == 0);
+
+    counters.recordWrite(100, 2ms);
+    counters.recordWrite(300, 1ms);
+    counters.recordRead(50, 5ms);
+
+    data = counters.get();
+    REQUIRE(data.numBytesWritten == 400);
+    REQUIRE(data.numPacketsWritten == 2);
+    REQUIRE(data.numBytesRead == 50);
+    REQUIRE(data.numPacketsRead == 1);
+    REQUIRE(data.writeStallTime == 3ms);
+    REQUIRE(data.readWaitTime == 5ms);
+    REQUIRE(data.minPacketSize == 50);
+    REQUIRE(data.maxPacketSize == 300);
+}
+
+TEST_CASE("Stream profiling counters are thread safe") {
+    dai::StreamProfilingCounters counters;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++) {
+        threads.emplace_back([&counters, t]() {
+            for(int i = 1; i <= 1000; i++) counters.recordWrite(i + t * 1000, 0ns);
+        });
+    }
+    for(auto& thread : threads) thread.join();
+
+    auto data = counters.get();
+    REQUIRE(data.numPacketsWritten == 4000);
+    REQUIRE(data.numBytesWritten == 4000LL * 4001 / 2);
+    REQUIRE(data.minPacketSize == 1);
+    REQUIRE(data.maxPacketSize == 4000);
+}
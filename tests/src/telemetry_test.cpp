@@ -0,0 +1,80 @@
+#include <catch2/catch_all.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include "depthai/device/Telemetry.hpp"
+
+using namespace std::chrono_literals;
+
+static dai::TelemetrySample createSample(std::chrono::steady_clock::time_point ts, float temperature) {
+    dai::TelemetrySample sample = {};
+    sample.timestamp = ts;
+    sample.chipTemperature.average = temperature;
+    sample.ddrMemoryUsage.used = static_cast<int64_t>(temperature) * 1024;
+    sample.ddrMemoryUsage.total = 512 * 1024 * 1024;
+    return sample;
+}
+
+TEST_CASE("Latest sample and window statistics") {
+    dai::TelemetryBuffer buffer(8);
+    dai::TelemetrySample sample;
+    REQUIRE(!buffer.latest(sample));
+    REQUIRE(buffer.stats(dai::TelemetryMetric::CHIP_TEMPERATURE, 1h).count == 0);
+
+    auto now = std::chrono::steady_clock::now();
+    for(int i = 0; i < 5; i++) buffer.push(createSample(now - std::chrono::seconds(10 - i), 40.0f + i));
+
+    REQUIRE(buffer.latest(sample));
+    REQUIRE(sample.chipTemperature.average == 44.0f);
+
+    auto all = buffer.stats(dai::TelemetryMetric::CHIP_TEMPERATURE, 1h);
+    REQUIRE(all.count == 5);
+    REQUIRE(all.min == 40.0f);
+    REQUIRE(all.max == 44.0f);
+    REQUIRE(all.average == Catch::Approx(42.0f));
+
+    // Only the last two samples are within 7.5 seconds
+    auto recent = buffer.stats(dai::TelemetryMetric::CHIP_TEMPERATURE, 7500ms);
+    REQUIRE(recent.count == 2);
+    REQUIRE(recent.min == 43.0f);
+}
+
+TEST_CASE("Older samples are overwritten") {
+    dai::TelemetryBuffer buffer(4);
+    auto now = std::chrono::steady_clock::now();
+    for(int i = 0; i < 10; i++) buffer.push(createSample(now, static_cast<float>(i)));
+
+    REQUIRE(buffer.getNumPushed() == 10);
+    auto samples = buffer.window(1h);
+    REQUIRE(samples.size() == 4);
+    for(std::size_t i = 0; i < samples.size(); i++) REQUIRE(samples[i].chipTemperature.average == 6.0f + i);
+}
+
+TEST_CASE("Readers never observe torn samples") {
+    dai::TelemetryBuffer buffer(16);
+    std::atomic<bool> running{true};
+    std::thread writer([&]() {
+        float i = 0.0f;
+        while(running) buffer.push(createSample(std::chrono::steady_clock::now(), i++));
+    });
+
+    int torn = 0;
+    for(int i = 0; i < 100000; i++) {
+        dai::TelemetrySample sample;
+        if(buffer.latest(sample) && sample.ddrMemoryUsage.used != static_cast<int64_t>(sample.chipTemperature.average) * 1024) torn++;
+    }
+    running = false;
+    writer.join();
+    REQUIRE(torn == 0);
+}
+
+TEST_CASE("Text exposition") {
+    dai::TelemetryBuffer buffer(4);
+    REQUIRE(buffer.toText("mxid").empty());
+    buffer.push(createSample(std::chrono::steady_clock::now(), 45.5f));
+    auto text = buffer.toText("mxid");
+    REQUIRE_THAT(text, Catch::Matchers::ContainsSubstring("depthai_chip_temperature_celsius{device=\"mxid\"} 45.5"));
+    REQUIRE_THAT(text, Catch::Matchers::ContainsSubstring("depthai_memory_used_bytes{device=\"mxid\",memory=\"ddr\"} 46080"));
+    REQUIRE_THAT(text, Catch::Matchers::ContainsSubstring("# TYPE depthai_xlink_read_bytes_total counter"));
+}